@@ -84,6 +84,10 @@ namespace Lynx
                 {
                     SaveSceneAs();
                 }
+                if (ImGui::MenuItem("Export Scene as JSON"))
+                {
+                    ExportSceneJson();
+                }
                 if (ImGui::MenuItem("Open Scene", "Ctrl+O"))
                 {
                     OpenScene();
@@ -156,6 +160,19 @@ namespace Lynx
                 m_Engine->GetRenderer().SetShowUI(m_ShowUI);
             }
 
+            if (ImGui::BeginMenu("Layers"))
+            {
+                uint32_t mask = m_Engine->GetRenderer().GetEditorCullingMask();
+                for (uint32_t i = 0; i < RenderLayer::Count; i++)
+                {
+                    uint32_t bit = 1u << i;
+                    bool visible = (mask & bit) != 0;
+                    if (ImGui::MenuItem(RenderLayer::GetName(i).c_str(), nullptr, &visible))
+                        m_Engine->GetRenderer().SetEditorCullingMask(visible ? mask | bit : mask & ~bit);
+                }
+                ImGui::EndMenu();
+            }
+
             ImGui::PopItemFlag();
             ImGui::EndPopup();
         }
@@ -210,12 +227,7 @@ namespace Lynx
 
     void EditorLayer::OnScenePlay()
     {
-        SceneSerializer serializer(m_EditorScene);
-        std::string data = serializer.SerializeToString();
-
-        m_RuntimeScene = std::make_shared<Scene>();
-        SceneSerializer runtimeSerializer(m_RuntimeScene);
-        runtimeSerializer.DeserializeFromString(data);
+        m_RuntimeScene = Scene::Copy(*m_EditorScene);
 
         m_Engine->StartPlay(m_RuntimeScene);
         
@@ -334,12 +346,25 @@ namespace Lynx
         }
     }
 
+    void EditorLayer::ExportSceneJson()
+    {
+        std::string filepath = FileDialogs::SaveFile("Scene JSON (*.json)\0*.json\0");
+        if (!filepath.empty())
+        {
+            SceneSerializer serializer(m_EditorScene);
+            serializer.ExportJson(filepath);
+        }
+    }
+
     void EditorLayer::OpenScene()
     {
         std::string filepath = FileDialogs::OpenFile(AssetUtils::GetFilterForAssetType(AssetType::Scene));
         if (!filepath.empty())
         {
             m_EditorScene = Engine::Get().GetAssetManager().GetAsset<Scene>(filepath, AssetLoadMode::Blocking);
+            // The editor always works on the whole world
+            if (m_EditorScene)
+                m_EditorScene->GetWorldPartition()->LoadAll(*m_EditorScene);
             m_Engine->LoadScene(m_EditorScene);
         }
     }
@@ -347,6 +372,8 @@ namespace Lynx
     void EditorLayer::OpenScene(AssetHandle handle)
     {
         m_EditorScene = Engine::Get().GetAssetManager().GetAsset<Scene>(handle, AssetLoadMode::Blocking);
+        if (m_EditorScene)
+            m_EditorScene->GetWorldPartition()->LoadAll(*m_EditorScene);
         m_Engine->LoadScene(m_EditorScene);
     }
 
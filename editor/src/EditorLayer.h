@@ -24,6 +24,7 @@ namespace Lynx
         void NewScene();
         void SaveSceneAs();
         void SaveScene();
+        void ExportSceneJson();
         void OpenScene();
         void OpenScene(AssetHandle handle);
 
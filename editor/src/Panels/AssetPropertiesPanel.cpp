@@ -43,13 +43,29 @@ namespace Lynx
         
         LXUI::BeginPropertyGrid();
 
-        std::vector<std::string> formatStrings = { "None", "RGBA8", "RG16F", "RG32F", "R32I", "R8", "Depth32", "Depth24Stencil8" };
+        std::vector<std::string> formatStrings = { "None", "RGBA8", "RG16F", "RG32F", "R32I", "R8", "Depth32", "Depth24Stencil8", "BC1", "BC3", "BC5", "BC7" };
         int currFormat = (int)m_EditingSpec.Format;
         
-        ImGui::Text("Format: %s", formatStrings[currFormat]);
+        ImGui::Text("Format: %s", formatStrings[currFormat].c_str());
         if (LXUI::DrawCheckBox("Generate Mips", m_EditingSpec.GenerateMips)) m_IsDirty = true;
         if (LXUI::DrawCheckBox("Is sRGB", m_EditingSpec.IsSRGB)) m_IsDirty = true;
 
+        std::vector<std::string> usageOptions = { "Color", "Normal Map", "Data" };
+        int currentUsage = (int)m_EditingSpec.Usage;
+        if (LXUI::DrawComboControl("Usage", currentUsage, usageOptions))
+        {
+            m_EditingSpec.Usage = (TextureUsage)currentUsage;
+            m_IsDirty = true;
+        }
+
+        std::vector<std::string> compressionOptions = { "None", "Auto", "BC1", "BC3", "BC5", "BC7" };
+        int currentCompression = (int)m_EditingSpec.Compression;
+        if (LXUI::DrawComboControl("Compression", currentCompression, compressionOptions))
+        {
+            m_EditingSpec.Compression = (TextureCompression)currentCompression;
+            m_IsDirty = true;
+        }
+
         std::vector<std::string> filterOptions = { "Bilinear", "Nearest", "Trilinear" };
         int currentFilter = (int)m_EditingSpec.SamplerSettings.FilterMode;
         if (LXUI::DrawComboControl("Filter Mode", currentFilter, filterOptions))
@@ -121,6 +137,17 @@ namespace Lynx
             m_IsDirty = true;
         }
 
+        if (material->Mode == AlphaMode::Translucent)
+        {
+            std::vector<std::string> transparencyModes = { "Sorted", "Weighted Blended (OIT)" };
+            int currentTransparency = (int)material->Transparency;
+            if (LXUI::DrawComboControl("Transparency", currentTransparency, transparencyModes))
+            {
+                material->Transparency = (TransparencyMode)currentTransparency;
+                m_IsDirty = true;
+            }
+        }
+
         if (LXUI::DrawColorControl("Albedo Color", material->AlbedoColor))
             m_IsDirty = true;
 
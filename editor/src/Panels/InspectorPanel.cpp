@@ -28,7 +28,7 @@ namespace Lynx
                 ImGui::SameLine();
                 if (ImGui::InputText("##Tag", buffer, sizeof(buffer)))
                 {
-                    tag = std::string(buffer);
+                    m_Context->Reg().patch<TagComponent>(m_Selection, [&](TagComponent& t) { t.Tag = buffer; });
                 }
                 
                 ImGui::SameLine();
@@ -239,6 +239,21 @@ namespace Lynx
             m_SelectedUIElement->OnInspect();
             LXUI::EndPropertyGrid();
         }
+        else if (m_Context)
+        {
+            // Nothing selected, show the scene settings
+            if (ImGui::CollapsingHeader("World Partition", ImGuiTreeNodeFlags_DefaultOpen))
+            {
+                auto& settings = m_Context->GetWorldPartition()->GetSettings();
+                ImGui::Checkbox("Enabled##WorldPartition", &settings.Enabled);
+                ImGui::DragFloat("Cell Size", &settings.CellSize, 1.0f, 8.0f, 4096.0f);
+                ImGui::DragFloatRange2("Load / Unload Radius", &settings.LoadRadius, &settings.UnloadRadius, 1.0f, 0.0f, 16384.0f);
+                int entitiesPerFrame = (int)settings.EntitiesPerFrame;
+                if (ImGui::DragInt("Entities Per Frame", &entitiesPerFrame, 1.0f, 1, 65536))
+                    settings.EntitiesPerFrame = (uint32_t)entitiesPerFrame;
+                ImGui::TextDisabled("Streamed roots get saved into cells, the cell size applies on the next save");
+            }
+        }
         ImGui::End();
     }
 
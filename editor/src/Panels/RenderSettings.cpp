@@ -27,6 +27,45 @@ namespace Lynx
                 if (ImGui::Checkbox("Enable FXAA", &fxaa))
                     renderer.SetFXAAEnabled(fxaa);
             }
+
+            if (ImGui::CollapsingHeader("Dynamic Resolution", ImGuiTreeNodeFlags_DefaultOpen))
+            {
+                auto& dynRes = renderer.GetDynamicResolutionSettings();
+                ImGui::Checkbox("Enabled##DynRes", &dynRes.Enabled);
+                ImGui::DragFloat("Target Frame Time (ms)", &dynRes.TargetFrameTime, 0.1f, 1.0f, 100.0f);
+                ImGui::DragFloatRange2("Scale Range", &dynRes.MinScale, &dynRes.MaxScale, 0.01f, 0.25f, 1.0f);
+                ImGui::DragFloat("Hysteresis", &dynRes.Hysteresis, 0.01f, 0.0f, 0.5f);
+                ImGui::Text("Current Scale: %.2f", renderer.GetRenderScale());
+            }
+
+            if (ImGui::CollapsingHeader("Command Recording", ImGuiTreeNodeFlags_DefaultOpen))
+            {
+                bool parallel = renderer.GetParallelRecording();
+                if (ImGui::Checkbox("Parallel Recording", &parallel))
+                    renderer.SetParallelRecording(parallel);
+            }
+
+            if (ImGui::CollapsingHeader("Static Batching", ImGuiTreeNodeFlags_DefaultOpen))
+            {
+                bool staticBatching = renderer.GetStaticBatching();
+                if (ImGui::Checkbox("Batch Static Meshes", &staticBatching))
+                    renderer.SetStaticBatching(staticBatching);
+            }
+
+            if (auto* streamer = renderer.GetTextureStreamer())
+            {
+                if (ImGui::CollapsingHeader("Texture Streaming", ImGuiTreeNodeFlags_DefaultOpen))
+                {
+                    auto& streaming = streamer->GetSettings();
+                    ImGui::Checkbox("Enabled##TexStreaming", &streaming.Enabled);
+                    int budget = (int)streaming.BudgetMB;
+                    if (ImGui::DragInt("Budget (MB)", &budget, 4.0f, 16, 8192))
+                        streaming.BudgetMB = (uint32_t)budget;
+                    int uploads = (int)streaming.MaxUploadsPerFrame;
+                    if (ImGui::DragInt("Max Uploads Per Frame", &uploads, 0.1f, 1, 64))
+                        streaming.MaxUploadsPerFrame = (uint32_t)uploads;
+                }
+            }
         }
         ImGui::End();
     }
@@ -31,6 +31,48 @@ namespace Lynx
 
         ImGui::Text("Frame Time: %.3f ms", m_DisplayFrameTime);
         ImGui::Text("FPS: %.1f", m_DisplayFPS);
+        ImGui::Text("GPU Time: %.3f ms", stats.GPUFrameTime);
+        ImGui::Text("Render Resolution: %ux%u (%.0f%%)", stats.RenderWidth, stats.RenderHeight, stats.RenderScale * 100.0f);
+
+        if (auto* streamer = Engine::Get().GetRenderer().GetTextureStreamer())
+        {
+            const auto& streaming = streamer->GetStats();
+            ImGui::Separator();
+            ImGui::Text("Texture Memory: %.1f / %.1f MB (resident / requested)", streaming.ResidentBytes / (1024.0f * 1024.0f), streaming.RequestedBytes / (1024.0f * 1024.0f));
+            ImGui::Text("Streaming Textures: %u (%u pending, mip bias %u)", streaming.StreamingTextures, streaming.PendingLoads, streaming.MipBias);
+        }
+
+        if (auto scene = Engine::Get().GetActiveScene())
+        {
+            const auto& animation = scene->GetAnimationSystem()->GetStats();
+            ImGui::Separator();
+            ImGui::Text("Animated Entities: %u (%.3f ms)", animation.AnimatedEntities, animation.EvaluationTime);
+
+            const auto& batching = scene->GetStaticBatcher()->GetStats();
+            ImGui::Text("Static Batches: %u clusters (%u entities)", batching.Clusters, batching.BatchedEntities);
+
+            const auto& hierarchy = scene->GetTransformHierarchy()->GetStats();
+            ImGui::Text("Transforms: %u updated of %u, depth %u (%.3f ms, %u rebuilds)", hierarchy.Updated, hierarchy.Nodes, hierarchy.Depth, hierarchy.UpdateTime, hierarchy.Rebuilds);
+
+            const auto& pools = scene->GetEntityPool()->GetStats();
+            ImGui::Text("Entity Pools: %u (%u idle, %u reused, %u created)", pools.Pools, pools.Idle, pools.Reused, pools.Created);
+
+            const auto& commands = scene->GetCommandStats();
+            ImGui::Text("Commands: %u played back (%u buffers)", commands.Commands, commands.Buffers);
+
+            const auto& spatial = scene->GetSpatialIndex()->GetStats();
+            ImGui::Text("Spatial Index: %u entities in %u cells (%u moves)", spatial.Entities, spatial.Cells, spatial.Moves);
+
+            const auto& partition = scene->GetWorldPartition()->GetStats();
+            ImGui::Text("World Partition: %u/%u cells loaded, %u loading (%u stitched)", partition.Loaded, partition.Cells, partition.Loading, partition.Stitched);
+
+            auto* systems = scene->GetSystemManager();
+            bool accessChecks = systems->GetAccessChecks();
+            if (ImGui::Checkbox("System access checks", &accessChecks))
+                systems->SetAccessChecks(accessChecks);
+            for (const auto& timing : systems->GetTimings())
+                ImGui::Text("  [%u] %s: %.3f / %.3f / %.3f ms", timing.Wave, timing.Name.c_str(), timing.Update, timing.FixedUpdate, timing.LateUpdate);
+        }
 
         ImGui::End();
     }
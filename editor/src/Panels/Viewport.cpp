@@ -9,6 +9,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "Lynx/Scene/Entity.h"
+#include "Lynx/Scene/Components/AnimationComponents.h"
 #include "Lynx/Scene/Components/Components.h"
 
 namespace Lynx
@@ -208,9 +209,9 @@ namespace Lynx
                 float matrixTranslation[3], matrixRotation[3], matrixScale[3];
                 ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(localMatrix), matrixTranslation, matrixRotation, matrixScale);
 
-                tc.Translation = glm::vec3(matrixTranslation[0], matrixTranslation[1], matrixTranslation[2]);
+                tc.SetTranslation(glm::vec3(matrixTranslation[0], matrixTranslation[1], matrixTranslation[2]));
                 tc.SetRotationEuler(glm::radians(glm::vec3(matrixRotation[0], matrixRotation[1], matrixRotation[2])));
-                tc.Scale = glm::vec3(matrixScale[0], matrixScale[1], matrixScale[2]);
+                tc.SetScale(glm::vec3(matrixScale[0], matrixScale[1], matrixScale[2]));
             }
         }
 
@@ -263,6 +264,15 @@ namespace Lynx
                 auto& meshComp = newEntity.AddComponent<MeshComponent>();
                 meshComp.Mesh = AssetHandle(data);
             }
+            if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload(AssetUtils::GetDragDropPayload(AssetType::SkeletalMesh)))
+            {
+                uint64_t data = *(const uint64_t*)payload->Data;
+
+                Scene* currScene = Engine::Get().GetActiveScene().get();
+                auto newEntity = currScene->CreateEntity();
+                auto& animator = newEntity.AddComponent<AnimatorComponent>();
+                animator.Mesh = AssetHandle(data);
+            }
             ImGui::EndDragDropTarget();
         }
         
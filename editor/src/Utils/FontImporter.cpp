@@ -103,6 +103,7 @@ namespace Lynx
         specification->GenerateMips = false;
         specification->Format = TextureFormat::RGBA8; // TODO: Add RGB8!
         specification->IsSRGB = false;
+        specification->Compression = TextureCompression::None; // Block compression breaks the MSDF distances
         specification->SamplerSettings = { TextureWrap::Clamp, TextureFilter::Bilinear };
         AssetHandle textureAtlasHandle = Engine::Get().GetAssetRegistry().ImportAssetFromTemp(tempPath, texturePath, specification);
 
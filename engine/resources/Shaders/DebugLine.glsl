@@ -2,7 +2,6 @@
 #version 450
 
 layout(location = 0) in vec3 a_Position;
-layout(location = 1) in vec4 a_Color;
 
 layout(location = 0) out vec4 v_Color;
 
@@ -11,10 +10,23 @@ layout(set = 0, binding = 0) uniform SceneData
     mat4 ViewProjection;
 } u_Scene;
 
+struct DebugInstance
+{
+    mat4 Transform;
+    vec4 Color;
+};
+
+layout(set = 0, binding = 1) readonly buffer InstanceBuffer
+{
+    DebugInstance instances[];
+};
+
 void main()
 {
-    v_Color = a_Color;
-    gl_Position = u_Scene.ViewProjection * vec4(a_Position, 1.0);
+    // gl_InstanceIndex includes the first instance, so it indexes the whole buffer
+    DebugInstance instance = instances[gl_InstanceIndex];
+    v_Color = instance.Color;
+    gl_Position = u_Scene.ViewProjection * instance.Transform * vec4(a_Position, 1.0);
 }
 
 #type pixel
@@ -26,4 +38,4 @@ layout(location = 0) out vec4 o_Color;
 void main()
 {
     o_Color = v_Color;
-}
\ No newline at end of file
+}
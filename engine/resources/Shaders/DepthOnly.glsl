@@ -18,17 +18,46 @@ struct InstanceData
 {
     mat4 Model;
     int EntityID;
-    float Padding[3];
+    int BoneOffset; // -1 if not skinned
+    float Padding[2];
 };
 
 layout(std430, set = 0, binding = 10) readonly buffer InstanceBuffer {
     InstanceData instances[];
 } u_Instances;
 
+struct SkinVertex
+{
+    uvec4 Joints;
+    vec4 Weights;
+};
+
+// Skinning palettes of all skinned instances, InstanceData.BoneOffset points at the first one
+layout(std430, set = 0, binding = 11) readonly buffer BoneBuffer {
+    mat4 bones[];
+} u_Bones;
+
+// Per submesh, indexed with gl_VertexIndex. Unskinned meshes bind a dummy buffer
+layout(std430, set = 2, binding = 0) readonly buffer SkinBuffer {
+    SkinVertex vertices[];
+} u_Skin;
+
+mat4 GetSkinMatrix(int boneOffset)
+{
+    if (boneOffset < 0)
+        return mat4(1.0);
+
+    SkinVertex skin = u_Skin.vertices[gl_VertexIndex];
+    return u_Bones.bones[boneOffset + skin.Joints.x] * skin.Weights.x +
+           u_Bones.bones[boneOffset + skin.Joints.y] * skin.Weights.y +
+           u_Bones.bones[boneOffset + skin.Joints.z] * skin.Weights.z +
+           u_Bones.bones[boneOffset + skin.Joints.w] * skin.Weights.w;
+}
+
 void main() {
     InstanceData data = u_Instances.instances[gl_InstanceIndex];
     v_TexCoord = a_TexCoord;
-    gl_Position = ubo.u_ViewProjection * data.Model * vec4(a_Position, 1.0);
+    gl_Position = ubo.u_ViewProjection * data.Model * GetSkinMatrix(data.BoneOffset) * vec4(a_Position, 1.0);
 }
 
 #type pixel
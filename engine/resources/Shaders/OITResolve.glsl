@@ -0,0 +1,34 @@
+#type vertex
+#version 450
+
+void main()
+{
+    // Fullscreen Triangle trick
+    vec2 uv = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    gl_Position = vec4(uv * 2.0f - 1.0f, 0.0f, 1.0f);
+}
+
+#type pixel
+#version 450
+layout (location = 0) out vec4 outColor;
+
+layout (set = 0, binding = 0) uniform texture2D u_Accumulation;
+layout (set = 0, binding = 1) uniform texture2D u_Revealage;
+
+void main()
+{
+    // Same resolution as the scene color, so plain texel fetches
+    ivec2 coord = ivec2(gl_FragCoord.xy);
+    float revealage = texelFetch(u_Revealage, coord, 0).r;
+    if (revealage >= 0.9999)
+        discard;
+
+    vec4 accumulation = texelFetch(u_Accumulation, coord, 0);
+    // Weights can get big, keep the sum finite
+    if (isinf(max(max(abs(accumulation.r), abs(accumulation.g)), abs(accumulation.b))))
+        accumulation.rgb = vec3(accumulation.a);
+
+    vec3 average = accumulation.rgb / max(accumulation.a, 1e-5);
+    // Blended with SrcAlpha/InvSrcAlpha, so the scene behind gets multiplied by the revealage
+    outColor = vec4(average, 1.0 - revealage);
+}
@@ -25,13 +25,42 @@ struct InstanceData
 {
     mat4 Model;
     int EntityID;
-    float Padding[3];
+    int BoneOffset; // -1 if not skinned
+    float Padding[2];
 };
 
 layout(std430, set = 0, binding = 10) readonly buffer InstanceBuffer {
     InstanceData instances[];
 } u_Instances;
 
+struct SkinVertex
+{
+    uvec4 Joints;
+    vec4 Weights;
+};
+
+// Skinning palettes of all skinned instances, InstanceData.BoneOffset points at the first one
+layout(std430, set = 0, binding = 11) readonly buffer BoneBuffer {
+    mat4 bones[];
+} u_Bones;
+
+// Per submesh, indexed with gl_VertexIndex. Unskinned meshes bind a dummy buffer
+layout(std430, set = 2, binding = 0) readonly buffer SkinBuffer {
+    SkinVertex vertices[];
+} u_Skin;
+
+mat4 GetSkinMatrix(int boneOffset)
+{
+    if (boneOffset < 0)
+        return mat4(1.0);
+
+    SkinVertex skin = u_Skin.vertices[gl_VertexIndex];
+    return u_Bones.bones[boneOffset + skin.Joints.x] * skin.Weights.x +
+           u_Bones.bones[boneOffset + skin.Joints.y] * skin.Weights.y +
+           u_Bones.bones[boneOffset + skin.Joints.z] * skin.Weights.z +
+           u_Bones.bones[boneOffset + skin.Joints.w] * skin.Weights.w;
+}
+
 layout(push_constant) uniform PushConsts {
     vec4 u_AlbedoColor;
     vec4 u_EmissiveColorStrength;
@@ -46,12 +75,14 @@ void main() {
     v_TexCoord = a_TexCoord;
     v_VertexColor = a_Color;
 
-    vec4 worldPos = data.Model * vec4(a_Position, 1.0);
+    mat4 model = data.Model * GetSkinMatrix(data.BoneOffset);
+
+    vec4 worldPos = model * vec4(a_Position, 1.0);
     v_WorldPos = worldPos.xyz;
 
     // TODO: This is maybe needed?
     //mat3 normalMatrix = transpose(inverse(mat3(push.u_Model)));
-    mat3 normalMatrix = mat3(data.Model);
+    mat3 normalMatrix = mat3(model);
     v_Normal = normalize(normalMatrix * a_Normal);
 
     // Pass tangent and its handedness
@@ -183,8 +214,10 @@ void main() {
     vec3 B = cross(N, T) * v_Tangent.w;
     mat3 TBN = mat3(T, B, N);
 
-    vec3 normalMap = texture(sampler2D(u_NormalMap, u_Sampler), v_TexCoord).rgb;
-    normalMap = normalMap * 2.0 - 1.0;
+    vec3 normalMap;
+    normalMap.xy = texture(sampler2D(u_NormalMap, u_Sampler), v_TexCoord).rg * 2.0 - 1.0;
+    // Rebuild Z, BC5 normal maps only store XY
+    normalMap.z = sqrt(max(1.0 - dot(normalMap.xy, normalMap.xy), 0.0));
     //normalMap.y *= -1.0;
     N = normalize(TBN * normalMap);
    
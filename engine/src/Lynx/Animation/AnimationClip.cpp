@@ -0,0 +1,226 @@
+#include "AnimationClip.h"
+
+#include "Lynx/Utils/SimdMath.h"
+
+namespace Lynx
+{
+    namespace Helpers
+    {
+        static uint16_t Quantize(float value, float min, float extent)
+        {
+            if (extent <= 0.0f)
+                return 0;
+
+            float normalized = glm::clamp((value - min) / extent, 0.0f, 1.0f);
+            return (uint16_t)(normalized * 65535.0f + 0.5f);
+        }
+
+        static float Dequantize(uint16_t value, float min, float extent)
+        {
+            return min + ((float)value / 65535.0f) * extent;
+        }
+
+        static float MaxError(const glm::vec4& a, const glm::vec4& b)
+        {
+            glm::vec4 error = glm::abs(a - b);
+            return std::max(std::max(error.x, error.y), std::max(error.z, error.w));
+        }
+
+        static glm::vec4 Interpolate(const glm::vec4& a, const glm::vec4& b, float t, bool isRotation)
+        {
+            glm::vec4 result = a + (b - a) * t;
+            return isRotation ? glm::normalize(result) : result;
+        }
+
+        // Returns the keys that have to stay, every dropped key is within tolerance of its interpolated neighbours
+        static std::vector<uint32_t> ReduceKeys(const std::vector<glm::vec4>& values, float tolerance, bool isRotation)
+        {
+            std::vector<uint32_t> kept = { 0 };
+            uint32_t count = (uint32_t)values.size();
+            uint32_t start = 0;
+
+            for (uint32_t end = 2; end < count; end++)
+            {
+                for (uint32_t i = start + 1; i < end; i++)
+                {
+                    float t = (float)(i - start) / (float)(end - start);
+                    if (MaxError(Interpolate(values[start], values[end], t, isRotation), values[i]) > tolerance)
+                    {
+                        // end - 1 was still fine, so it becomes the next start
+                        start = end - 1;
+                        kept.push_back(start);
+                        break;
+                    }
+                }
+            }
+
+            if (count > 1)
+                kept.push_back(count - 1);
+
+            // Constant track
+            if (kept.size() == 2 && MaxError(values[0], values[count - 1]) <= tolerance)
+                kept.resize(1);
+
+            return kept;
+        }
+    }
+
+    void AnimationClip::Compress(const std::string& name, float duration, const std::vector<RawJointTrack>& tracks, const AnimationCompressionSettings& settings)
+    {
+        m_Name = name;
+        m_Duration = duration;
+        m_SampleRate = settings.SampleRate;
+        m_FrameCount = 1;
+        m_RawSize = 0;
+        m_Tracks.clear();
+        m_KeyFrames.clear();
+        m_KeyValues.clear();
+
+        std::vector<glm::vec4> values;
+        for (const auto& joint : tracks)
+        {
+            m_FrameCount = std::max({ m_FrameCount, (uint32_t)joint.Translations.size(), (uint32_t)joint.Rotations.size(), (uint32_t)joint.Scales.size() });
+            m_RawSize += joint.Translations.size() * sizeof(glm::vec3) + joint.Rotations.size() * sizeof(glm::quat) + joint.Scales.size() * sizeof(glm::vec3);
+
+            values.clear();
+            for (const auto& translation : joint.Translations)
+                values.push_back(glm::vec4(translation, 0.0f));
+            if (values.empty())
+                values.push_back(glm::vec4(0.0f));
+            AddTrack(values, Translation, settings.TranslationTolerance);
+
+            // q and -q are the same rotation, keep neighbours in the same hemisphere so they interpolate the short way
+            values.clear();
+            for (const auto& rotation : joint.Rotations)
+            {
+                glm::vec4 value(rotation.x, rotation.y, rotation.z, rotation.w);
+                if (!values.empty() && glm::dot(value, values.back()) < 0.0f)
+                    value = -value;
+                values.push_back(value);
+            }
+            if (values.empty())
+                values.push_back(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+            AddTrack(values, Rotation, settings.RotationTolerance);
+
+            values.clear();
+            for (const auto& scale : joint.Scales)
+                values.push_back(glm::vec4(scale, 0.0f));
+            if (values.empty())
+                values.push_back(glm::vec4(1.0f, 1.0f, 1.0f, 0.0f));
+            AddTrack(values, Scale, settings.ScaleTolerance);
+        }
+
+        if (m_FrameCount > std::numeric_limits<uint16_t>::max())
+            LX_CORE_WARN("Animation '{0}' has {1} frames, only the first 65535 can be addressed!", name, m_FrameCount);
+    }
+
+    void AnimationClip::AddTrack(const std::vector<glm::vec4>& values, TrackType type, float tolerance)
+    {
+        Track track;
+        track.FirstKey = (uint32_t)m_KeyFrames.size();
+
+        if (type == Rotation)
+        {
+            track.Min = glm::vec3(-1.0f);
+            track.Extent = glm::vec3(2.0f);
+        }
+        else
+        {
+            glm::vec3 min = glm::vec3(values[0]);
+            glm::vec3 max = min;
+            for (const auto& value : values)
+            {
+                min = glm::min(min, glm::vec3(value));
+                max = glm::max(max, glm::vec3(value));
+            }
+            track.Min = min;
+            track.Extent = max - min;
+        }
+
+        for (uint32_t index : Helpers::ReduceKeys(values, tolerance, type == Rotation))
+        {
+            const glm::vec4& value = values[index];
+            std::array<uint16_t, 4> key;
+            if (type == Rotation)
+            {
+                for (int c = 0; c < 4; c++)
+                    key[c] = Helpers::Quantize(value[c], -1.0f, 2.0f);
+            }
+            else
+            {
+                for (int c = 0; c < 3; c++)
+                    key[c] = Helpers::Quantize(value[c], track.Min[c], track.Extent[c]);
+                key[3] = 0;
+            }
+
+            m_KeyFrames.push_back((uint16_t)std::min(index, (uint32_t)std::numeric_limits<uint16_t>::max()));
+            m_KeyValues.push_back(key);
+        }
+
+        track.KeyCount = (uint32_t)m_KeyFrames.size() - track.FirstKey;
+        m_Tracks.push_back(track);
+    }
+
+    glm::vec4 AnimationClip::DecodeKey(const Track& track, uint32_t key, TrackType type) const
+    {
+        const auto& value = m_KeyValues[track.FirstKey + key];
+        if (type == Rotation)
+        {
+            return glm::vec4(
+                Helpers::Dequantize(value[0], -1.0f, 2.0f),
+                Helpers::Dequantize(value[1], -1.0f, 2.0f),
+                Helpers::Dequantize(value[2], -1.0f, 2.0f),
+                Helpers::Dequantize(value[3], -1.0f, 2.0f));
+        }
+
+        return glm::vec4(
+            Helpers::Dequantize(value[0], track.Min.x, track.Extent.x),
+            Helpers::Dequantize(value[1], track.Min.y, track.Extent.y),
+            Helpers::Dequantize(value[2], track.Min.z, track.Extent.z),
+            0.0f);
+    }
+
+    void AnimationClip::SampleTrack(const Track& track, TrackType type, float frame, glm::vec4& out) const
+    {
+        if (track.KeyCount == 1)
+        {
+            out = DecodeKey(track, 0, type);
+        }
+        else
+        {
+            const uint16_t* frames = &m_KeyFrames[track.FirstKey];
+            const uint16_t* upper = std::upper_bound(frames, frames + track.KeyCount, frame, [](float f, uint16_t keyFrame) { return f < (float)keyFrame; });
+
+            uint32_t next = std::clamp((uint32_t)(upper - frames), 1u, track.KeyCount - 1);
+            uint32_t prev = next - 1;
+            float t = glm::clamp((frame - frames[prev]) / (float)(frames[next] - frames[prev]), 0.0f, 1.0f);
+
+            SimdMath::Lerp(DecodeKey(track, prev, type), DecodeKey(track, next, type), t, out);
+        }
+
+        if (type == Rotation)
+            out = glm::normalize(out);
+    }
+
+    void AnimationClip::Sample(float time, JointTransform* outPose, size_t jointCount) const
+    {
+        float frame = glm::clamp(time * m_SampleRate, 0.0f, (float)(m_FrameCount - 1));
+        size_t count = std::min(jointCount, GetJointCount());
+
+        for (size_t joint = 0; joint < count; joint++)
+        {
+            const Track* tracks = &m_Tracks[joint * 3];
+            SampleTrack(tracks[Translation], Translation, frame, outPose[joint].Translation);
+            SampleTrack(tracks[Scale], Scale, frame, outPose[joint].Scale);
+
+            glm::vec4 rotation;
+            SampleTrack(tracks[Rotation], Rotation, frame, rotation);
+            outPose[joint].Rotation = glm::quat(rotation.w, rotation.x, rotation.y, rotation.z);
+        }
+    }
+
+    size_t AnimationClip::GetCompressedSize() const
+    {
+        return m_Tracks.size() * sizeof(Track) + m_KeyFrames.size() * sizeof(uint16_t) + m_KeyValues.size() * sizeof(m_KeyValues[0]);
+    }
+}
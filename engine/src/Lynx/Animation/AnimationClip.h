@@ -0,0 +1,76 @@
+#pragma once
+#include "Pose.h"
+
+#include <array>
+
+namespace Lynx
+{
+    // Uncompressed input, one key per frame at AnimationCompressionSettings::SampleRate
+    struct RawJointTrack
+    {
+        std::vector<glm::vec3> Translations;
+        std::vector<glm::quat> Rotations;
+        std::vector<glm::vec3> Scales;
+    };
+
+    struct AnimationCompressionSettings
+    {
+        float SampleRate = 30.0f;
+        // Max error allowed when dropping keys
+        float TranslationTolerance = 0.0005f;
+        float RotationTolerance = 0.0002f;
+        float ScaleTolerance = 0.0005f;
+    };
+
+    // Keys are resampled to a fixed rate, then every key that can be reconstructed by interpolating its neighbours
+    // is dropped (curve reduction). What's left gets quantized to 16 bits per component.
+    class LX_API AnimationClip
+    {
+    public:
+        AnimationClip() = default;
+
+        void Compress(const std::string& name, float duration, const std::vector<RawJointTrack>& tracks, const AnimationCompressionSettings& settings = {});
+
+        // Time gets clamped to the clip, looping is up to the caller
+        void Sample(float time, JointTransform* outPose, size_t jointCount) const;
+
+        const std::string& GetName() const { return m_Name; }
+        float GetDuration() const { return m_Duration; }
+        size_t GetJointCount() const { return m_Tracks.size() / 3; }
+        size_t GetCompressedSize() const;
+        size_t GetRawSize() const { return m_RawSize; }
+
+    private:
+        enum TrackType : uint32_t
+        {
+            Translation = 0,
+            Rotation,
+            Scale
+        };
+
+        struct Track
+        {
+            uint32_t FirstKey = 0;
+            uint32_t KeyCount = 0;
+            // Quantization range, rotations always use [-1, 1]
+            glm::vec3 Min = glm::vec3(0.0f);
+            glm::vec3 Extent = glm::vec3(0.0f);
+        };
+
+        void AddTrack(const std::vector<glm::vec4>& values, TrackType type, float tolerance);
+        glm::vec4 DecodeKey(const Track& track, uint32_t key, TrackType type) const;
+        void SampleTrack(const Track& track, TrackType type, float frame, glm::vec4& out) const;
+
+    private:
+        std::string m_Name;
+        float m_Duration = 0.0f;
+        float m_SampleRate = 30.0f;
+        uint32_t m_FrameCount = 0;
+        size_t m_RawSize = 0;
+
+        // Translation, rotation, scale per joint
+        std::vector<Track> m_Tracks;
+        std::vector<uint16_t> m_KeyFrames;
+        std::vector<std::array<uint16_t, 4>> m_KeyValues;
+    };
+}
@@ -0,0 +1,59 @@
+#include "Pose.h"
+
+#include "Lynx/Utils/SimdMath.h"
+
+namespace Lynx
+{
+    int Skeleton::FindJoint(const std::string& name) const
+    {
+        for (size_t i = 0; i < JointNames.size(); i++)
+        {
+            if (JointNames[i] == name)
+                return (int)i;
+        }
+        return -1;
+    }
+
+    namespace PoseUtils
+    {
+        void Blend(const JointTransform* a, const JointTransform* b, float weight, JointTransform* out, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                SimdMath::NLerpQuat(a[i].Rotation, b[i].Rotation, weight, out[i].Rotation);
+                SimdMath::Lerp(a[i].Translation, b[i].Translation, weight, out[i].Translation);
+                SimdMath::Lerp(a[i].Scale, b[i].Scale, weight, out[i].Scale);
+            }
+        }
+
+        glm::mat4 ToMatrix(const JointTransform& transform)
+        {
+            glm::mat3 rotation = glm::mat3_cast(transform.Rotation);
+            glm::mat4 result(1.0f);
+            result[0] = glm::vec4(rotation[0] * transform.Scale.x, 0.0f);
+            result[1] = glm::vec4(rotation[1] * transform.Scale.y, 0.0f);
+            result[2] = glm::vec4(rotation[2] * transform.Scale.z, 0.0f);
+            result[3] = glm::vec4(glm::vec3(transform.Translation), 1.0f);
+            return result;
+        }
+
+        void LocalToModel(const Skeleton& skeleton, const JointTransform* local, glm::mat4* outModel)
+        {
+            // Parents come first, so a single pass is enough
+            static const glm::mat4 s_Identity(1.0f);
+            for (size_t i = 0; i < skeleton.GetJointCount(); i++)
+            {
+                glm::mat4 localMatrix = ToMatrix(local[i]);
+                int parent = skeleton.Parents[i];
+                const glm::mat4& parentMatrix = parent >= 0 ? outModel[parent] : i < skeleton.RootTransforms.size() ? skeleton.RootTransforms[i] : s_Identity;
+                SimdMath::MulMat4(parentMatrix, localMatrix, outModel[i]);
+            }
+        }
+
+        void BuildSkinningPalette(const Skeleton& skeleton, const glm::mat4* model, glm::mat4* outPalette)
+        {
+            for (size_t i = 0; i < skeleton.GetJointCount(); i++)
+                SimdMath::MulMat4(model[i], skeleton.InverseBindMatrices[i], outPalette[i]);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "Lynx/Core.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace Lynx
+{
+    // Local joint transform, laid out so every part can be loaded into a single SIMD register
+    struct JointTransform
+    {
+        glm::quat Rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        glm::vec4 Translation = glm::vec4(0.0f); // w unused
+        glm::vec4 Scale = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f); // w unused
+    };
+
+    struct Skeleton
+    {
+        std::vector<std::string> JointNames;
+        // Parents always come before their children, -1 for roots
+        std::vector<int> Parents;
+        std::vector<glm::mat4> InverseBindMatrices;
+        std::vector<JointTransform> BindPose;
+        // Transform of the nodes above each root joint, roots are the first joints
+        std::vector<glm::mat4> RootTransforms;
+
+        size_t GetJointCount() const { return Parents.size(); }
+        int FindJoint(const std::string& name) const;
+    };
+
+    namespace PoseUtils
+    {
+        // out = lerp(a, b, weight), out may alias a or b
+        LX_API void Blend(const JointTransform* a, const JointTransform* b, float weight, JointTransform* out, size_t count);
+        LX_API glm::mat4 ToMatrix(const JointTransform& transform);
+        // Model space matrices of every joint, includes Skeleton::RootTransforms
+        LX_API void LocalToModel(const Skeleton& skeleton, const JointTransform* local, glm::mat4* outModel);
+        // What ends up on the GPU, model * inverse bind
+        LX_API void BuildSkinningPalette(const Skeleton& skeleton, const glm::mat4* model, glm::mat4* outPalette);
+    }
+}
@@ -8,6 +8,7 @@
 #include "Prefab.h"
 #include "Script.h"
 #include "Shader.h"
+#include "SkeletalMesh.h"
 #include "Sprite.h"
 #include "Lynx/Engine.h"
 #include "Lynx/Event/AssetEvents.h"
@@ -71,14 +72,9 @@ namespace Lynx
                     {
                         if (newAsset->GetType() == AssetType::Texture)
                         {
-                            std::lock_guard<std::mutex> lock(m_AssetsMutex);
-                            for (auto& [handle, asset] : m_LoadedAssets)
-                            {
-                                if (asset->GetType() == AssetType::Material && asset->DependsOn(newAsset->GetHandle()))
-                                {
-                                    asset->IncrementVersion();
-                                }
-                            }
+                            InvalidateDependents(newAsset->GetHandle());
+                            if (auto* streamer = Engine::Get().GetRenderer().GetTextureStreamer())
+                                streamer->Register(std::static_pointer_cast<Texture>(newAsset));
                         }
                         newAsset->SetState(AssetState::Ready);
                         if (onLoaded) onLoaded(newAsset->GetHandle());
@@ -104,9 +100,7 @@ namespace Lynx
         }
         else
         {
-            // TODO: Note: std::async w/ launch::async works too, but we don't need the future here
-            // Ideally use a thread pool later.
-            std::thread(loadTask).detach();
+            Engine::Get().GetJobSystem().RunBackground(loadTask);
         }
 
         return newAsset;
@@ -131,6 +125,9 @@ namespace Lynx
             case AssetType::StaticMesh:
                 newAsset = std::make_shared<StaticMesh>(metadata.FilePath.string());
                 break;
+            case AssetType::SkeletalMesh:
+                newAsset = std::make_shared<SkeletalMesh>(metadata.FilePath.string());
+                break;
             case AssetType::Script:
                 newAsset = std::make_shared<Script>(metadata.FilePath.string());
                 break;
@@ -153,7 +150,6 @@ namespace Lynx
                 newAsset = std::make_shared<Prefab>(metadata.FilePath.string());
                 break;
             case AssetType::None:
-            case AssetType::SkeletalMesh:
             default: LX_CORE_ERROR("AssetType not supported yet ({0})!", static_cast<int>(metadata.Type)); return nullptr;
         }
 
@@ -170,22 +166,28 @@ namespace Lynx
         if (asset->Reload())
         {
             LX_CORE_INFO("Asset reloaded successfully");
+            InvalidateDependents(asset->GetHandle());
+            asset->IncrementVersion();
+            if (asset->GetType() == AssetType::Texture)
             {
-                std::lock_guard<std::mutex> lock(m_AssetsMutex);
-                for (auto& [otherHandle, otherAsset] : m_LoadedAssets)
-                {
-                    if (otherAsset->DependsOn(asset->GetHandle()))
-                    {
-                        otherAsset->IncrementVersion();
-                    }
-                }
+                if (auto* streamer = Engine::Get().GetRenderer().GetTextureStreamer())
+                    streamer->Register(std::static_pointer_cast<Texture>(asset));
             }
-            asset->IncrementVersion();
             AssetReloadedEvent e(handle);
             Engine::Get().OnEvent(e);
         }
     }
 
+    void AssetManager::InvalidateDependents(AssetHandle handle)
+    {
+        std::lock_guard<std::mutex> lock(m_AssetsMutex);
+        for (auto& [otherHandle, otherAsset] : m_LoadedAssets)
+        {
+            if (otherAsset->DependsOn(handle))
+                otherAsset->IncrementVersion();
+        }
+    }
+
     void AssetManager::UnloadAsset(AssetHandle handle)
     {
         // TODO: Are there possible bugs with this?
@@ -66,6 +66,8 @@ namespace Lynx
 
         void Update();
         void ReloadAsset(AssetHandle handle);
+        // Bumps the version of everything that depends on handle, so cached binding sets get rebuilt
+        void InvalidateDependents(AssetHandle handle);
         void UnloadAsset(AssetHandle handle);
         
         void UnloadAllGameAssets();
@@ -4,11 +4,29 @@
 #include <nlohmann/json.hpp>
 
 #include "MeshSpecification.h"
+#include "TextureCompiler.h"
 #include "TextureSpecification.h"
 
 
 namespace Lynx
 {
+    namespace Helpers
+    {
+        // Skinned glTFs become skeletal meshes, only the JSON is parsed, buffers are left alone
+        static bool HasGLTFSkin(const std::filesystem::path& path)
+        {
+            std::ifstream file(path);
+            if (!file)
+                return false;
+
+            nlohmann::json j = nlohmann::json::parse(file, nullptr, false);
+            if (j.is_discarded())
+                return false;
+
+            return j.contains("skins") && j["skins"].is_array() && !j["skins"].empty();
+        }
+    }
+
     void AssetRegistry::LoadRegistry(const std::filesystem::path& projectAssetDir, const std::filesystem::path& engineResourceDir)
     {
         m_AssetMetadata.clear();
@@ -227,7 +245,8 @@ namespace Lynx
             // Load existing metadata
             metadata = ReadMetadata(metaPath);
             AssetType type = AssetUtils::GetAssetTypeFromExtension(path);
-            LX_ASSERT(type == metadata.Type, "Asset type mismatch in metadata and file extension!");
+            bool isSkinned = type == AssetType::StaticMesh && metadata.Type == AssetType::SkeletalMesh;
+            LX_ASSERT(type == metadata.Type || isSkinned, "Asset type mismatch in metadata and file extension!");
             metadata.FilePath = path.string(); // Update path in case it moved
         }
         else
@@ -236,13 +255,22 @@ namespace Lynx
             metadata.Handle = AssetHandle();
             metadata.FilePath = path;
             metadata.Type = AssetUtils::GetAssetTypeFromExtension(path);
+            if (metadata.Type == AssetType::StaticMesh && Helpers::HasGLTFSkin(path))
+                metadata.Type = AssetType::SkeletalMesh;
+
             if (specification)
             {
                 metadata.Specification = specification;
             }
             else if (metadata.Type == AssetType::Texture)
             {
-                metadata.Specification = std::make_shared<TextureSpecification>();
+                auto texSpec = std::make_shared<TextureSpecification>();
+                // Guess normal maps from the usual naming conventions, can be changed in the asset properties
+                std::string stem = path.stem().string();
+                std::ranges::transform(stem, stem.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+                if (stem.ends_with("_normal") || stem.ends_with("_n") || stem.ends_with("_nrm"))
+                    texSpec->Usage = TextureUsage::NormalMap;
+                metadata.Specification = texSpec;
             }
             WriteMetadata(metadata);
         }
@@ -317,6 +345,7 @@ namespace Lynx
             {
                 std::filesystem::remove(metaPath);
             }
+            TextureCompiler::DeleteCache(assetPath);
             
             m_ProcessedChangedAssets.push_back(handle);
         }
@@ -349,6 +378,9 @@ namespace Lynx
                 LX_CORE_ERROR("AssetRegistry: Failed to rename meta file: {0}", e.what());
             }
         }
+
+        // Cheaper to rebuild than to track, it gets recreated on next load
+        TextureCompiler::DeleteCache(oldPath);
     }
 
     const AssetMetadata& AssetRegistry::Get(AssetHandle handle) const
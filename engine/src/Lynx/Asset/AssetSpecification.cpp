@@ -10,7 +10,8 @@ namespace Lynx
         switch (type)
         {
             case AssetType::Texture: return std::make_shared<TextureSpecification>();
-            case AssetType::StaticMesh: return std::make_shared<StaticMeshSpecification>();
+            case AssetType::StaticMesh:
+            case AssetType::SkeletalMesh: return std::make_shared<StaticMeshSpecification>();
             default: return nullptr;
         }
     }
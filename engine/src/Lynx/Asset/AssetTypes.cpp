@@ -18,7 +18,7 @@ namespace Lynx::AssetUtils
 
     static const std::unordered_map<AssetType, AssetFilter> s_AssetFilters = {
         { AssetType::Scene, { "Lynx Scene", { "*.lxscene" }, "ASSET_SCENE" } },
-        { AssetType::Texture, {"Texture File",  { "*.png", "*.jpg", "*.jpeg", "*.tga" },"ASSET_TEXTURE" } },
+        { AssetType::Texture, {"Texture File",  { "*.png", "*.jpg", "*.jpeg", "*.tga", "*.dds" },"ASSET_TEXTURE" } },
         { AssetType::Material, { "Material File", { "*.lxmat" },"ASSET_MATERIAL" } },
         { AssetType::Shader, { "Shader File", { "*.glsl" },"ASSET_SHADER" } },
         //{ AssetType::Mesh, { "3D Model",      { "*.fbx", "*.obj", "*.gltf" } } }
@@ -136,6 +136,10 @@ namespace Lynx::AssetUtils
 
     const char* GetDragDropPayload(AssetType type)
     {
+        // Shares the glTF extension with static meshes, so it has no filter entry
+        if (type == AssetType::SkeletalMesh)
+            return "ASSET_SKELETALMESH";
+
         const auto& filter = s_AssetFilters.at(type);
         return filter.DragDropPayload;
     }
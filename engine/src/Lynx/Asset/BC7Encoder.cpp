@@ -0,0 +1,239 @@
+#include "BC7Encoder.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace Lynx
+{
+    static constexpr int s_Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    struct Endpoints
+    {
+        int Values[2][4]; // 7 bit per channel
+        int PBits[2];
+    };
+
+    static int Dequantize(int value, int pBit)
+    {
+        return (value << 1) | pBit;
+    }
+
+    static int Quantize(float value, int pBit)
+    {
+        return std::clamp((int)std::lround((value - pBit) * 0.5f), 0, 127);
+    }
+
+    static int Interpolate(int a, int b, int weight)
+    {
+        return ((64 - weight) * a + weight * b + 32) >> 6;
+    }
+
+    // Picks the closest of the 16 palette entries for every pixel, returns the summed squared error
+    static uint32_t FindIndices(const uint8_t* rgba, const Endpoints& endpoints, uint8_t* outIndices)
+    {
+        int palette[16][4];
+        for (int c = 0; c < 4; c++)
+        {
+            int a = Dequantize(endpoints.Values[0][c], endpoints.PBits[0]);
+            int b = Dequantize(endpoints.Values[1][c], endpoints.PBits[1]);
+            for (int i = 0; i < 16; i++)
+                palette[i][c] = Interpolate(a, b, s_Weights[i]);
+        }
+
+        uint32_t totalError = 0;
+        for (int p = 0; p < 16; p++)
+        {
+            const uint8_t* pixel = rgba + p * 4;
+            uint32_t bestError = UINT32_MAX;
+            for (int i = 0; i < 16; i++)
+            {
+                uint32_t error = 0;
+                for (int c = 0; c < 4; c++)
+                {
+                    int d = palette[i][c] - pixel[c];
+                    error += d * d;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    outIndices[p] = (uint8_t)i;
+                }
+            }
+            totalError += bestError;
+        }
+        return totalError;
+    }
+
+    // Tries the p-bit combinations for the float endpoints, keeps the one with the lowest block error.
+    // Opaque blocks need both p-bits set, otherwise alpha can't hit 255 exactly and trades it for a bit of color.
+    static uint32_t QuantizeEndpoints(const uint8_t* rgba, const float (&ends)[2][4], bool opaque, Endpoints& outEndpoints, uint8_t* outIndices)
+    {
+        uint32_t bestError = UINT32_MAX;
+        Endpoints candidate;
+        uint8_t indices[16];
+        for (int pBits = opaque ? 3 : 0; pBits < 4; pBits++)
+        {
+            for (int e = 0; e < 2; e++)
+            {
+                candidate.PBits[e] = (pBits >> e) & 1;
+                for (int c = 0; c < 4; c++)
+                    candidate.Values[e][c] = Quantize(ends[e][c], candidate.PBits[e]);
+            }
+
+            uint32_t error = FindIndices(rgba, candidate, indices);
+            if (error < bestError)
+            {
+                bestError = error;
+                outEndpoints = candidate;
+                memcpy(outIndices, indices, 16);
+            }
+        }
+        return bestError;
+    }
+
+    class BitWriter
+    {
+    public:
+        BitWriter(uint8_t* dst) : m_Dst(dst) { memset(dst, 0, 16); }
+
+        void Write(uint32_t value, int bits)
+        {
+            for (int i = 0; i < bits; i++, m_Position++)
+            {
+                if (value & (1u << i))
+                    m_Dst[m_Position >> 3] |= (uint8_t)(1u << (m_Position & 7));
+            }
+        }
+
+    private:
+        uint8_t* m_Dst;
+        int m_Position = 0;
+    };
+
+    void BC7Encoder::CompressBlock(uint8_t* dst, const uint8_t* rgba)
+    {
+        // Principal axis through the pixels, a few rounds of power iteration on the covariance
+        float mean[4] = {};
+        bool opaque = true;
+        for (int p = 0; p < 16; p++)
+        {
+            opaque &= rgba[p * 4 + 3] == 255;
+            for (int c = 0; c < 4; c++)
+                mean[c] += rgba[p * 4 + c] / 16.0f;
+        }
+
+        float covariance[4][4] = {};
+        for (int p = 0; p < 16; p++)
+        {
+            float d[4];
+            for (int c = 0; c < 4; c++)
+                d[c] = rgba[p * 4 + c] - mean[c];
+            for (int i = 0; i < 4; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                    covariance[i][j] += d[i] * d[j];
+            }
+        }
+
+        float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        for (int iteration = 0; iteration < 8; iteration++)
+        {
+            float next[4] = {};
+            for (int i = 0; i < 4; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                    next[i] += covariance[i][j] * axis[j];
+            }
+
+            float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3]);
+            if (length < 1e-6f)
+                break; // Flat block, any axis does
+            for (int i = 0; i < 4; i++)
+                axis[i] = next[i] / length;
+        }
+
+        float minT = FLT_MAX;
+        float maxT = -FLT_MAX;
+        for (int p = 0; p < 16; p++)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < 4; c++)
+                t += (rgba[p * 4 + c] - mean[c]) * axis[c];
+            minT = std::min(minT, t);
+            maxT = std::max(maxT, t);
+        }
+
+        float ends[2][4];
+        for (int c = 0; c < 4; c++)
+        {
+            ends[0][c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+            ends[1][c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+        }
+
+        Endpoints endpoints;
+        uint8_t indices[16];
+        uint32_t error = QuantizeEndpoints(rgba, ends, opaque, endpoints, indices);
+
+        // One least squares pass: with the indices fixed, the best endpoints per channel are a 2x2 solve
+        if (error > 0)
+        {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ax[4] = {}, bx[4] = {};
+            for (int p = 0; p < 16; p++)
+            {
+                float w = s_Weights[indices[p]] / 64.0f;
+                float a = 1.0f - w;
+                aa += a * a;
+                ab += a * w;
+                bb += w * w;
+                for (int c = 0; c < 4; c++)
+                {
+                    ax[c] += a * rgba[p * 4 + c];
+                    bx[c] += w * rgba[p * 4 + c];
+                }
+            }
+
+            float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) > 1e-6f)
+            {
+                float refined[2][4];
+                for (int c = 0; c < 4; c++)
+                {
+                    refined[0][c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+                    refined[1][c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+                }
+
+                Endpoints refinedEndpoints;
+                uint8_t refinedIndices[16];
+                if (QuantizeEndpoints(rgba, refined, opaque, refinedEndpoints, refinedIndices) < error)
+                {
+                    endpoints = refinedEndpoints;
+                    memcpy(indices, refinedIndices, 16);
+                }
+            }
+        }
+
+        // The first index only stores 3 bits, its top bit has to be 0. Swapping the endpoints flips all indices.
+        if (indices[0] & 8)
+        {
+            std::swap(endpoints.Values[0], endpoints.Values[1]);
+            std::swap(endpoints.PBits[0], endpoints.PBits[1]);
+            for (int p = 0; p < 16; p++)
+                indices[p] = (uint8_t)(15 - indices[p]);
+        }
+
+        BitWriter writer(dst);
+        writer.Write(1u << 6, 7); // Mode 6
+        for (int c = 0; c < 4; c++)
+        {
+            writer.Write(endpoints.Values[0][c], 7);
+            writer.Write(endpoints.Values[1][c], 7);
+        }
+        writer.Write(endpoints.PBits[0], 1);
+        writer.Write(endpoints.PBits[1], 1);
+        writer.Write(indices[0], 3);
+        for (int p = 1; p < 16; p++)
+            writer.Write(indices[p], 4);
+    }
+}
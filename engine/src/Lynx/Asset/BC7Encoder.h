@@ -0,0 +1,14 @@
+#pragma once
+#include "Lynx/Core.h"
+
+namespace Lynx
+{
+    // BC7 mode 6 only: one subset, RGBA endpoints with 7 bits plus a p-bit each, 16 weights.
+    // Way better than BC3 for color + alpha at the same size, though it doesn't search the partitioned modes.
+    class LX_API BC7Encoder
+    {
+    public:
+        // rgba is a 4x4 block, row by row. Writes 16 bytes.
+        static void CompressBlock(uint8_t* dst, const uint8_t* rgba);
+    };
+}
@@ -5,12 +5,13 @@
 #include <tiny_gltf.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace Lynx::GLTFHelpers
 {
     // Reads a generic float buffer from an accessor
     // Handles component types (BYTE, SHORT, FLOAT...) and normalization
-    std::vector<float> ReadFloatBuffer(const tinygltf::Model& model, const tinygltf::Accessor& accessor)
+    inline std::vector<float> ReadFloatBuffer(const tinygltf::Model& model, const tinygltf::Accessor& accessor)
     {
         std::vector<float> output;
 
@@ -24,6 +25,8 @@ namespace Lynx::GLTFHelpers
             numComponents = 3;
         else if (accessor.type == TINYGLTF_TYPE_VEC4)
             numComponents = 4;
+        else if (accessor.type == TINYGLTF_TYPE_MAT4)
+            numComponents = 16;
 
         output.resize(count * numComponents);
 
@@ -78,7 +81,7 @@ namespace Lynx::GLTFHelpers
         return output;
     }
 
-    glm::mat4 GetLocalTransform(const tinygltf::Node& node)
+    inline glm::mat4 GetLocalTransform(const tinygltf::Node& node)
     {
         glm::mat4 transform(1.0f);
 
@@ -104,4 +107,29 @@ namespace Lynx::GLTFHelpers
         }
         return transform;
     }
-}
\ No newline at end of file
+
+    // Same as GetLocalTransform, but split up. Matrices get decomposed (no shear support)
+    inline void GetLocalTRS(const tinygltf::Node& node, glm::vec3& translation, glm::quat& rotation, glm::vec3& scale)
+    {
+        translation = glm::vec3(0.0f);
+        rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        scale = glm::vec3(1.0f);
+
+        if (node.matrix.size() == 16)
+        {
+            glm::mat4 matrix = glm::make_mat4(node.matrix.data());
+            translation = glm::vec3(matrix[3]);
+            scale = glm::vec3(glm::length(glm::vec3(matrix[0])), glm::length(glm::vec3(matrix[1])), glm::length(glm::vec3(matrix[2])));
+            glm::mat3 rotationMatrix(glm::vec3(matrix[0]) / scale.x, glm::vec3(matrix[1]) / scale.y, glm::vec3(matrix[2]) / scale.z);
+            rotation = glm::normalize(glm::quat_cast(rotationMatrix));
+            return;
+        }
+
+        if (node.translation.size() == 3)
+            translation = glm::vec3(node.translation[0], node.translation[1], node.translation[2]);
+        if (node.rotation.size() == 4)
+            rotation = glm::quat((float)node.rotation[3], (float)node.rotation[0], (float)node.rotation[1], (float)node.rotation[2]);
+        if (node.scale.size() == 3)
+            scale = glm::vec3(node.scale[0], node.scale[1], node.scale[2]);
+    }
+}
@@ -5,6 +5,8 @@
 namespace Lynx
 {
     enum class AlphaMode { Opaque, Mask, Translucent, Additive };
+    // How translucent surfaces get composited. WeightedBlended needs no sorting but is an approximation
+    enum class TransparencyMode { Sorted, WeightedBlended };
     
     class LX_API Material : public Asset
     {
@@ -25,6 +27,9 @@ namespace Lynx
         float EmissiveStrength = 0.0f;
         AlphaMode Mode = AlphaMode::Opaque;
         float AlphaCutoff = 0.5f;
+        TransparencyMode Transparency = TransparencyMode::Sorted; // Only used by Translucent
+
+        bool IsWeightedBlended() const { return Mode == AlphaMode::Translucent && Transparency == TransparencyMode::WeightedBlended; }
 
         glm::vec2 Tiling = { 1.0f, 1.0f };
 
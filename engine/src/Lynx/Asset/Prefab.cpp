@@ -1,5 +1,7 @@
 #include "Prefab.h"
 
+#include "Lynx/Scene/PrefabTemplate.h"
+
 namespace Lynx
 {
     Prefab::Prefab(const std::string& filePath)
@@ -7,9 +9,22 @@ namespace Lynx
     {
     }
 
+    Prefab::~Prefab() = default;
+
+    PrefabTemplate& Prefab::GetTemplate()
+    {
+        if (!m_Template)
+        {
+            m_Template = std::make_unique<PrefabTemplate>();
+            m_Template->Compile(m_Data);
+        }
+        return *m_Template;
+    }
+
     bool Prefab::LoadSourceData()
     {
         m_Data.clear();
+        m_Template.reset();
         
         if (m_FilePath.empty())
             return true;
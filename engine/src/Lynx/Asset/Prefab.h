@@ -3,22 +3,27 @@
 
 namespace Lynx
 {
+    class PrefabTemplate;
+
     class LX_API Prefab : public Asset
     {
     public:
         Prefab(const std::string& filePath);
-        virtual ~Prefab() override = default;
+        virtual ~Prefab() override;
         
         static AssetType GetStaticType() { return AssetType::Prefab; }
         AssetType GetType() const override { return GetStaticType(); }
         
         const nlohmann::json& GetData() const { return m_Data; }
+        // Compiled on first use, dropped again on reload
+        PrefabTemplate& GetTemplate();
         
         bool LoadSourceData() override;
         bool Reload() override;
 
     private:
         nlohmann::json m_Data;
+        std::unique_ptr<PrefabTemplate> m_Template;
     };
 }
 
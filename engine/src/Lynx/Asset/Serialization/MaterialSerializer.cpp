@@ -18,6 +18,7 @@ namespace Lynx
 
         // Serialize Enums (as int for simplicity, or string for readability)
         json["Mode"] = (int)material->Mode;
+        json["Transparency"] = (int)material->Transparency;
 
         // Serialize Textures (Handles)
         json["UseNormalMap"] = material->UseNormalMap;
@@ -78,6 +79,7 @@ namespace Lynx
         if (json.contains("Tiling")) outMaterial.Tiling = getVec2(json["Tiling"]);
 
         if (json.contains("Mode")) outMaterial.Mode = (AlphaMode)json["Mode"];
+        if (json.contains("Transparency")) outMaterial.Transparency = (TransparencyMode)json["Transparency"];
         if (json.contains("UseNormalMap")) outMaterial.UseNormalMap = json["UseNormalMap"];
 
         if (json.contains("Textures"))
@@ -0,0 +1,383 @@
+#include "SkeletalMesh.h"
+#include "GLTFHelpers.h"
+
+#include "Lynx/Engine.h"
+
+namespace Lynx
+{
+    // Lives in StaticMesh.cpp
+    void ProcessMesh(const tinygltf::Model& model, const tinygltf::Mesh& mesh, const glm::mat4& transform, std::vector<SubmeshSourceData>& submeshes, const std::string& filePath, AABB& bounds);
+
+    namespace Helpers
+    {
+        static glm::mat4 GetGlobalTransform(const tinygltf::Model& model, const std::vector<int>& nodeParents, int node)
+        {
+            glm::mat4 transform(1.0f);
+            while (node >= 0)
+            {
+                transform = GLTFHelpers::GetLocalTransform(model.nodes[node]) * transform;
+                node = nodeParents[node];
+            }
+            return transform;
+        }
+
+        // Cubic splines store in-tangent, value, out-tangent per key, only the values are used
+        static void SampleChannel(const std::vector<float>& times, const std::vector<float>& values, int components, bool isRotation, const std::string& interpolation, float time, float* out)
+        {
+            bool cubic = interpolation == "CUBICSPLINE";
+            size_t stride = cubic ? components * 3 : components;
+            size_t offset = cubic ? components : 0;
+            size_t count = times.size();
+            if (count == 0 || values.size() < count * stride)
+                return;
+
+            auto value = [&](size_t key, int component) { return values[key * stride + offset + component]; };
+
+            size_t prev = 0;
+            size_t next = 0;
+            float t = 0.0f;
+            if (time >= times.back())
+            {
+                prev = next = count - 1;
+            }
+            else if (time > times.front())
+            {
+                next = std::upper_bound(times.begin(), times.end(), time) - times.begin();
+                prev = next - 1;
+                t = interpolation == "STEP" ? 0.0f : (time - times[prev]) / (times[next] - times[prev]);
+            }
+
+            if (isRotation)
+            {
+                glm::quat a(value(prev, 3), value(prev, 0), value(prev, 1), value(prev, 2));
+                glm::quat b(value(next, 3), value(next, 0), value(next, 1), value(next, 2));
+                glm::quat result = glm::normalize(glm::slerp(a, b, t));
+                out[0] = result.x;
+                out[1] = result.y;
+                out[2] = result.z;
+                out[3] = result.w;
+            }
+            else
+            {
+                for (int c = 0; c < components; c++)
+                    out[c] = glm::mix(value(prev, c), value(next, c), t);
+            }
+        }
+    }
+
+    SkeletalMesh::SkeletalMesh(const std::string& filepath)
+        : StaticMesh(filepath)
+    {
+    }
+
+    int SkeletalMesh::FindAnimation(const std::string& name) const
+    {
+        for (size_t i = 0; i < m_Animations.size(); i++)
+        {
+            if (m_Animations[i].GetName() == name)
+                return (int)i;
+        }
+        return -1;
+    }
+
+    bool SkeletalMesh::LoadSourceData()
+    {
+        tinygltf::Model model;
+        tinygltf::TinyGLTF loader;
+        std::string err, warn;
+
+        bool ret = loader.LoadASCIIFromFile(&model, &err, &warn, m_FilePath);
+        if (!ret)
+        {
+            ret = loader.LoadBinaryFromFile(&model, &err, &warn, m_FilePath);
+        }
+
+        if (!ret)
+        {
+            LX_CORE_ERROR("Failed to load glTF: {0}", err);
+            return false;
+        }
+
+        if (model.skins.empty())
+        {
+            LX_CORE_ERROR("Skeletal mesh '{0}' has no skin!", m_FilePath);
+            return false;
+        }
+
+        if (model.skins.size() > 1)
+            LX_CORE_WARN("Skeletal mesh '{0}' has {1} skins, only the first one is used", m_FilePath, model.skins.size());
+
+        const tinygltf::Skin& skin = model.skins[0];
+
+        std::vector<int> nodeParents(model.nodes.size(), -1);
+        for (size_t i = 0; i < model.nodes.size(); i++)
+        {
+            for (int child : model.nodes[i].children)
+                nodeParents[child] = (int)i;
+        }
+
+        // 1. Skeleton, sorted so parents always come before their children
+        std::unordered_map<int, int> nodeToJoint;
+        for (size_t i = 0; i < skin.joints.size(); i++)
+            nodeToJoint[skin.joints[i]] = (int)i;
+
+        size_t jointCount = skin.joints.size();
+        std::vector<int> gltfParents(jointCount, -1);
+        std::vector<int> depths(jointCount, 0);
+        for (size_t i = 0; i < jointCount; i++)
+        {
+            for (int node = nodeParents[skin.joints[i]]; node >= 0; node = nodeParents[node])
+            {
+                auto it = nodeToJoint.find(node);
+                if (it == nodeToJoint.end())
+                    continue;
+
+                if (gltfParents[i] < 0)
+                    gltfParents[i] = it->second;
+                depths[i]++;
+            }
+        }
+
+        std::vector<int> order(jointCount);
+        for (size_t i = 0; i < jointCount; i++)
+            order[i] = (int)i;
+        std::ranges::stable_sort(order, [&](int a, int b) { return depths[a] < depths[b]; });
+
+        std::vector<uint32_t> remap(jointCount);
+        for (size_t i = 0; i < jointCount; i++)
+            remap[order[i]] = (uint32_t)i;
+
+        std::vector<float> inverseBind;
+        if (skin.inverseBindMatrices >= 0)
+            inverseBind = GLTFHelpers::ReadFloatBuffer(model, model.accessors[skin.inverseBindMatrices]);
+
+        Skeleton skeleton;
+        for (int gltfJoint : order)
+        {
+            const tinygltf::Node& node = model.nodes[skin.joints[gltfJoint]];
+            skeleton.JointNames.push_back(node.name);
+            skeleton.Parents.push_back(gltfParents[gltfJoint] >= 0 ? (int)remap[gltfParents[gltfJoint]] : -1);
+
+            if (inverseBind.size() >= (gltfJoint + 1) * 16)
+                skeleton.InverseBindMatrices.push_back(glm::make_mat4(&inverseBind[gltfJoint * 16]));
+            else
+                skeleton.InverseBindMatrices.push_back(glm::mat4(1.0f));
+
+            JointTransform& bind = skeleton.BindPose.emplace_back();
+            glm::vec3 translation, scale;
+            GLTFHelpers::GetLocalTRS(node, translation, bind.Rotation, scale);
+            bind.Translation = glm::vec4(translation, 0.0f);
+            bind.Scale = glm::vec4(scale, 0.0f);
+        }
+
+        // Roots are sorted to the front, each one keeps whatever node it hangs off
+        for (size_t i = 0; i < jointCount && skeleton.Parents[i] < 0; i++)
+            skeleton.RootTransforms.push_back(Helpers::GetGlobalTransform(model, nodeParents, nodeParents[skin.joints[order[i]]]));
+
+        // 2. Geometry, skinned vertices are already in mesh space so node transforms are ignored
+        AABB bounds;
+        std::vector<SubmeshSourceData> sourceData;
+        std::vector<std::vector<SkinVertex>> skinSourceData;
+        for (const auto& node : model.nodes)
+        {
+            if (node.mesh < 0 || node.skin < 0)
+                continue;
+
+            if (node.skin != 0)
+            {
+                LX_CORE_WARN("Skipping mesh '{0}', it uses a different skin", node.name);
+                continue;
+            }
+
+            const tinygltf::Mesh& mesh = model.meshes[node.mesh];
+            size_t firstSubmesh = sourceData.size();
+            ProcessMesh(model, mesh, glm::mat4(1.0f), sourceData, m_FilePath, bounds);
+
+            for (size_t p = 0; p < mesh.primitives.size(); p++)
+            {
+                const auto& primitive = mesh.primitives[p];
+                std::vector<SkinVertex>& skinVertices = skinSourceData.emplace_back(sourceData[firstSubmesh + p].Vertices.size());
+
+                std::vector<float> joints;
+                std::vector<float> weights;
+                if (primitive.attributes.count("JOINTS_0"))
+                    joints = GLTFHelpers::ReadFloatBuffer(model, model.accessors[primitive.attributes.at("JOINTS_0")]);
+                if (primitive.attributes.count("WEIGHTS_0"))
+                    weights = GLTFHelpers::ReadFloatBuffer(model, model.accessors[primitive.attributes.at("WEIGHTS_0")]);
+
+                for (size_t v = 0; v < skinVertices.size(); v++)
+                {
+                    SkinVertex& skinVertex = skinVertices[v];
+                    if (joints.size() < (v + 1) * 4 || weights.size() < (v + 1) * 4)
+                    {
+                        skinVertex.Weights = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+                        continue;
+                    }
+
+                    for (int c = 0; c < 4; c++)
+                    {
+                        uint32_t joint = std::min((uint32_t)joints[v * 4 + c], (uint32_t)jointCount - 1);
+                        skinVertex.Joints[c] = remap[joint];
+                        skinVertex.Weights[c] = weights[v * 4 + c];
+                    }
+
+                    float totalWeight = skinVertex.Weights.x + skinVertex.Weights.y + skinVertex.Weights.z + skinVertex.Weights.w;
+                    if (totalWeight > 0.0f)
+                        skinVertex.Weights /= totalWeight;
+                    else
+                        skinVertex.Weights = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+                }
+            }
+        }
+
+        if (sourceData.empty())
+        {
+            LX_CORE_ERROR("Skeletal mesh '{0}' has no skinned geometry!", m_FilePath);
+            return false;
+        }
+
+        // Bounding sphere of every vertex a joint moves, in bind pose. Posed bounds are these pushed through the palette
+        std::vector<AABB> jointBoxes(jointCount);
+        auto forEachInfluence = [&](auto&& func)
+        {
+            for (size_t s = 0; s < sourceData.size(); s++)
+            {
+                const auto& vertices = sourceData[s].Vertices;
+                const auto& skinVertices = skinSourceData[s];
+                for (size_t v = 0; v < vertices.size(); v++)
+                {
+                    for (int c = 0; c < 4; c++)
+                    {
+                        if (skinVertices[v].Weights[c] > 0.0f)
+                            func(skinVertices[v].Joints[c], vertices[v].Position);
+                    }
+                }
+            }
+        };
+        forEachInfluence([&](uint32_t joint, const glm::vec3& position) { jointBoxes[joint].Expand(position); });
+
+        std::vector<glm::vec4> jointBounds(jointCount, glm::vec4(0.0f, 0.0f, 0.0f, -1.0f));
+        for (size_t j = 0; j < jointCount; j++)
+        {
+            if (jointBoxes[j].Min.x <= jointBoxes[j].Max.x)
+                jointBounds[j] = glm::vec4((jointBoxes[j].Min + jointBoxes[j].Max) * 0.5f, 0.0f);
+        }
+        forEachInfluence([&](uint32_t joint, const glm::vec3& position)
+        {
+            glm::vec4& sphere = jointBounds[joint];
+            sphere.w = std::max(sphere.w, glm::distance(glm::vec3(sphere), position));
+        });
+
+        // 3. Animations, resampled to the clip rate and compressed
+        AnimationCompressionSettings compression;
+        std::vector<AnimationClip> animations;
+        for (size_t a = 0; a < model.animations.size(); a++)
+        {
+            const tinygltf::Animation& animation = model.animations[a];
+
+            float duration = 0.0f;
+            for (const auto& sampler : animation.samplers)
+            {
+                const tinygltf::Accessor& input = model.accessors[sampler.input];
+                if (!input.maxValues.empty())
+                    duration = std::max(duration, (float)input.maxValues[0]);
+            }
+
+            uint32_t frameCount = (uint32_t)std::ceil(duration * compression.SampleRate) + 1;
+            std::vector<RawJointTrack> tracks(jointCount);
+            for (size_t j = 0; j < jointCount; j++)
+            {
+                const JointTransform& bind = skeleton.BindPose[j];
+                tracks[j].Translations.assign(frameCount, glm::vec3(bind.Translation));
+                tracks[j].Rotations.assign(frameCount, bind.Rotation);
+                tracks[j].Scales.assign(frameCount, glm::vec3(bind.Scale));
+            }
+
+            for (const auto& channel : animation.channels)
+            {
+                auto jointIt = nodeToJoint.find(channel.target_node);
+                if (jointIt == nodeToJoint.end())
+                    continue;
+
+                bool isRotation = channel.target_path == "rotation";
+                if (!isRotation && channel.target_path != "translation" && channel.target_path != "scale")
+                    continue; // Morph target weights
+
+                const tinygltf::AnimationSampler& sampler = animation.samplers[channel.sampler];
+                std::vector<float> times = GLTFHelpers::ReadFloatBuffer(model, model.accessors[sampler.input]);
+                std::vector<float> values = GLTFHelpers::ReadFloatBuffer(model, model.accessors[sampler.output]);
+
+                RawJointTrack& track = tracks[remap[jointIt->second]];
+                for (uint32_t f = 0; f < frameCount; f++)
+                {
+                    float time = (float)f / compression.SampleRate;
+                    float value[4] = {};
+                    Helpers::SampleChannel(times, values, isRotation ? 4 : 3, isRotation, sampler.interpolation, time, value);
+
+                    if (isRotation)
+                        track.Rotations[f] = glm::quat(value[3], value[0], value[1], value[2]);
+                    else if (channel.target_path == "translation")
+                        track.Translations[f] = glm::vec3(value[0], value[1], value[2]);
+                    else
+                        track.Scales[f] = glm::vec3(value[0], value[1], value[2]);
+                }
+            }
+
+            std::string name = animation.name.empty() ? "Animation " + std::to_string(a) : animation.name;
+            AnimationClip& clip = animations.emplace_back();
+            clip.Compress(name, duration, tracks, compression);
+            LX_CORE_TRACE("Compressed animation '{0}': {1} KB -> {2} KB", name, clip.GetRawSize() / 1024, clip.GetCompressedSize() / 1024);
+        }
+
+        m_Skeleton = std::move(skeleton);
+        m_Animations = std::move(animations);
+        m_SourceData = std::move(sourceData);
+        m_SkinSourceData = std::move(skinSourceData);
+        m_Bounds = bounds;
+        m_JointBounds = std::move(jointBounds);
+        return true;
+    }
+
+    AABB SkeletalMesh::GetPoseBounds(const std::vector<glm::mat4>& palette) const
+    {
+        if (palette.size() != m_JointBounds.size())
+            return m_Bounds;
+
+        AABB bounds;
+        for (size_t j = 0; j < palette.size(); j++)
+        {
+            const glm::vec4& sphere = m_JointBounds[j];
+            if (sphere.w < 0.0f)
+                continue;
+
+            const glm::mat4& matrix = palette[j];
+            float scale = std::sqrt(std::max({ glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0])),
+                                               glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1])),
+                                               glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2])) }));
+            glm::vec3 center = glm::vec3(matrix * glm::vec4(glm::vec3(sphere), 1.0f));
+            glm::vec3 extent(sphere.w * scale);
+            bounds.Expand(center - extent);
+            bounds.Expand(center + extent);
+        }
+        return bounds.Min.x <= bounds.Max.x ? bounds : m_Bounds;
+    }
+
+    bool SkeletalMesh::CreateRenderResources()
+    {
+        auto skinSourceData = std::move(m_SkinSourceData);
+        m_SkinSourceData.clear();
+
+        if (!StaticMesh::CreateRenderResources())
+            return false;
+
+        auto& renderer = Engine::Get().GetRenderer();
+        for (size_t i = 0; i < m_Submeshes.size() && i < skinSourceData.size(); i++)
+        {
+            auto [skinBuffer, bindingSet] = renderer.CreateSkinBuffer(skinSourceData[i]);
+            m_Submeshes[i].SkinBuffer = skinBuffer;
+            m_Submeshes[i].SkinBindingSet = bindingSet;
+        }
+
+        return true;
+    }
+}
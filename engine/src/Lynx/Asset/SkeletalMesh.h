@@ -0,0 +1,36 @@
+#pragma once
+#include "StaticMesh.h"
+#include "Lynx/Animation/AnimationClip.h"
+
+namespace Lynx
+{
+    // Skinned glTF mesh. Geometry and materials work like StaticMesh (so it batches the same way),
+    // on top of that every submesh has a SkinBuffer and the file's skeleton and animations get imported.
+    class LX_API SkeletalMesh : public StaticMesh
+    {
+    public:
+        SkeletalMesh(const std::string& filepath);
+        virtual ~SkeletalMesh() = default;
+
+        static AssetType GetStaticType() { return AssetType::SkeletalMesh; }
+        virtual AssetType GetType() const override { return GetStaticType(); }
+
+        const Skeleton& GetSkeleton() const { return m_Skeleton; }
+        const std::vector<AnimationClip>& GetAnimations() const { return m_Animations; }
+        int FindAnimation(const std::string& name) const;
+        // Mesh space bounds of a posed mesh, palette as built by PoseUtils::BuildSkinningPalette
+        AABB GetPoseBounds(const std::vector<glm::mat4>& palette) const;
+
+        virtual bool LoadSourceData() override;
+        virtual bool CreateRenderResources() override;
+
+    private:
+        Skeleton m_Skeleton;
+        std::vector<AnimationClip> m_Animations;
+        // Bind pose sphere per joint around the vertices it moves, w < 0 if it moves none
+        std::vector<glm::vec4> m_JointBounds;
+
+        // Same order as m_SourceData
+        std::vector<std::vector<SkinVertex>> m_SkinSourceData;
+    };
+}
@@ -12,6 +12,34 @@ namespace Lynx
 {
     void TraverseNodes(const tinygltf::Model& model, const tinygltf::Node& node, const glm::mat4& parentTransform, std::vector<SubmeshSourceData>& submeshes, const std::string& filePath, AABB& bounds);
     void ProcessMesh(const tinygltf::Model& model, const tinygltf::Mesh& mesh, const glm::mat4& transform, std::vector<SubmeshSourceData>& submeshes, const std::string& filePath, AABB& bounds);
+
+    static bool LoadGLTF(const std::string& filePath, std::vector<SubmeshSourceData>& submeshes, AABB& bounds)
+    {
+        tinygltf::Model model;
+        tinygltf::TinyGLTF loader;
+        std::string err, warn;
+
+        bool ret = loader.LoadASCIIFromFile(&model, &err, &warn, filePath);
+        if (!ret)
+        {
+            ret = loader.LoadBinaryFromFile(&model, &err, &warn, filePath);
+        }
+
+        if (!ret)
+        {
+            LX_CORE_ERROR("Failed to load glTF: {0}", err);
+            return false;
+        }
+
+        const tinygltf::Scene& scene = model.scenes[model.defaultScene > -1 ? model.defaultScene : 0];
+
+        for (int nodeIndex : scene.nodes)
+        {
+            TraverseNodes(model, model.nodes[nodeIndex], glm::mat4(1.0f), submeshes, filePath, bounds);
+        }
+
+        return !submeshes.empty();
+    }
     
     StaticMesh::StaticMesh(const std::string& filepath)
         : Asset(filepath)
@@ -36,6 +64,27 @@ namespace Lynx
         sub.Name = "RuntimeCreated";
 
         m_Submeshes.push_back(sub);
+        m_CPUGeometry.push_back({ std::move(vertices), std::move(indices) });
+        m_State = AssetState::Ready;
+    }
+
+    StaticMesh::StaticMesh(const std::vector<MeshGeometry>& geometry, const std::vector<std::shared_ptr<Material>>& materials, const std::string& name)
+    {
+        for (size_t i = 0; i < geometry.size(); i++)
+        {
+            for (const auto& vertex : geometry[i].Vertices)
+                m_Bounds.Expand(vertex.Position);
+
+            auto [vb, ib] = Engine::Get().GetRenderer().CreateMeshBuffers(geometry[i].Vertices, geometry[i].Indices);
+            Submesh sub;
+            sub.VertexBuffer = vb;
+            sub.IndexBuffer = ib;
+            sub.IndexCount = (uint32_t)geometry[i].Indices.size();
+            sub.Material = materials[i];
+            sub.Name = name;
+            m_Submeshes.push_back(sub);
+        }
+
         m_State = AssetState::Ready;
     }
 
@@ -56,35 +105,32 @@ namespace Lynx
         m_Submeshes.clear();
         m_Bounds = AABB();
 
-        tinygltf::Model model;
-        tinygltf::TinyGLTF loader;
-        std::string err, warn;
+        return LoadGLTF(m_FilePath, m_SourceData, m_Bounds);
+    }
 
-        bool ret = loader.LoadASCIIFromFile(&model, &err, &warn, m_FilePath);
-        if (!ret)
-        {
-            ret = loader.LoadBinaryFromFile(&model, &err, &warn, m_FilePath);
-        }
+    bool StaticMesh::LoadCPUGeometry()
+    {
+        if (!m_CPUGeometry.empty())
+            return true;
 
-        if (!ret)
-        {
-            LX_CORE_ERROR("Failed to load glTF: {0}", err);
+        if (m_FilePath.empty())
             return false;
-        }
-
-        const tinygltf::Scene& scene = model.scenes[model.defaultScene > -1 ? model.defaultScene : 0];
 
-        for (int nodeIndex : scene.nodes)
-        {
-            TraverseNodes(model, model.nodes[nodeIndex], glm::mat4(1.0f), m_SourceData, m_FilePath, m_Bounds);
-        }
+        // Parses the file again, the source data is gone after upload
+        std::vector<SubmeshSourceData> sourceData;
+        AABB bounds;
+        if (!LoadGLTF(m_FilePath, sourceData, bounds) || sourceData.size() != m_Submeshes.size())
+            return false;
 
-        return !m_SourceData.empty();
+        for (auto& source : sourceData)
+            m_CPUGeometry.push_back({ std::move(source.Vertices), std::move(source.Indices) });
+        return true;
     }
 
     bool StaticMesh::CreateRenderResources()
     {
         m_Submeshes.clear();
+        m_CPUGeometry.clear();
 
         // TODO: We should add a JobSystem to be able to load multiple assets simoultaniously here.
         // So we don't need this intermediate data. 
@@ -127,6 +173,9 @@ namespace Lynx
             sub.Material = material;
             sub.Name = source.Name;
             m_Submeshes.push_back(sub);
+
+            if (m_Specification.KeepCPUData)
+                m_CPUGeometry.push_back({ source.Vertices, source.Indices });
         }
 
         m_SourceData.clear();
@@ -19,6 +19,13 @@ namespace Lynx
         glm::vec4 Color;
     };
 
+    // Separate stream for skinned meshes, read in the vertex shader through gl_VertexIndex
+    struct SkinVertex
+    {
+        glm::uvec4 Joints = glm::uvec4(0);
+        glm::vec4 Weights = glm::vec4(0.0f);
+    };
+
     struct Submesh
     {
         nvrhi::BufferHandle VertexBuffer;
@@ -26,6 +33,16 @@ namespace Lynx
         uint32_t IndexCount;
         std::shared_ptr<Material> Material;
         std::string Name;
+
+        // Only set on skeletal meshes
+        nvrhi::BufferHandle SkinBuffer;
+        nvrhi::BindingSetHandle SkinBindingSet;
+    };
+
+    struct MeshGeometry
+    {
+        std::vector<Vertex> Vertices;
+        std::vector<uint32_t> Indices;
     };
 
     struct SubmeshSourceData
@@ -57,6 +74,8 @@ namespace Lynx
     public:
         StaticMesh(const std::string& filepath);
         StaticMesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices);
+        // Runtime mesh with one submesh per geometry
+        StaticMesh(const std::vector<MeshGeometry>& geometry, const std::vector<std::shared_ptr<Material>>& materials, const std::string& name);
         virtual ~StaticMesh() = default;
 
         static AssetType GetStaticType() { return AssetType::StaticMesh; }
@@ -66,17 +85,22 @@ namespace Lynx
         const std::vector<Submesh>& GetSubmeshes() const { return m_Submeshes; }
         const AABB& GetBounds() const { return m_Bounds; }
 
+        // CPU copy of the geometry, same order as the submeshes. Only there with KeepCPUData or after LoadCPUGeometry
+        const std::vector<MeshGeometry>& GetCPUGeometry() const { return m_CPUGeometry; }
+        bool LoadCPUGeometry();
+
         virtual bool Reload() override;
 
         virtual bool LoadSourceData() override;
         virtual bool CreateRenderResources() override;
 
-    private:
+    protected:
         std::vector<Submesh> m_Submeshes;
         StaticMeshSpecification m_Specification;
         AABB m_Bounds;
 
         std::vector<SubmeshSourceData> m_SourceData;
+        std::vector<MeshGeometry> m_CPUGeometry;
     };
 }
 
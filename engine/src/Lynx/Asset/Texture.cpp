@@ -4,6 +4,7 @@
 #include <stb_image.h>
 
 #include "Lynx/Engine.h"
+#include "Lynx/Renderer/TextureStreamer.h"
 
 namespace Lynx
 {
@@ -41,6 +42,39 @@ namespace Lynx
             return false;
         }
 
+        m_Specification.DebugName = m_FilePath;
+        m_StreamSource.clear();
+        m_StreamGeneration++;
+        m_MipCount = 1;
+        m_ResidentMip = 0;
+        m_TailMip = 0;
+
+        if (TextureCompiler::IsCompressedSource(m_FilePath) || m_Specification.Compression != TextureCompression::None)
+        {
+            // Only the tail gets loaded here, the rest is streamed in on demand
+            if (TextureCompiler::LoadOrCompile(m_FilePath, m_Specification, m_CompressedData, TextureStreamer::TailSize))
+            {
+                m_Specification.Width = m_CompressedData.GetWidth();
+                m_Specification.Height = m_CompressedData.GetHeight();
+                m_Specification.Format = m_CompressedData.Format;
+                if (TextureCompiler::IsCompressedSource(m_FilePath))
+                    m_Specification.IsSRGB = m_CompressedData.IsSRGB;
+
+                std::filesystem::path source = TextureCompiler::IsCompressedSource(m_FilePath) ? std::filesystem::path(m_FilePath) : TextureCompiler::GetCachePath(m_FilePath);
+                if (std::filesystem::exists(source))
+                    m_StreamSource = source;
+                m_MipCount = m_CompressedData.MipCount;
+                m_ResidentMip = m_CompressedData.FirstMip;
+                m_TailMip = m_CompressedData.FirstMip;
+                return true;
+            }
+
+            if (TextureCompiler::IsCompressedSource(m_FilePath))
+                return false;
+
+            LX_CORE_WARN("Failed to compress texture {0}, falling back to uncompressed", m_FilePath);
+        }
+
         int width, height, channels;
         m_PixelData = stbi_load(m_FilePath.c_str(), &width, &height, &channels, 0);
 
@@ -52,7 +86,6 @@ namespace Lynx
 
         m_Specification.Width = width;
         m_Specification.Height = height;
-        m_Specification.DebugName = m_FilePath;
 
         if (channels == 4)
         {
@@ -75,15 +108,23 @@ namespace Lynx
 
     bool Texture::CreateRenderResources()
     {
-        if (!m_PixelData)
-            return false;
+        if (m_CompressedData.IsValid())
+        {
+            m_TextureHandle = Engine::Get().GetRenderer().CreateTexture(m_Specification, m_CompressedData);
+            m_CompressedData = TextureData();
+        }
+        else
+        {
+            if (!m_PixelData)
+                return false;
         
-        m_TextureHandle = Engine::Get().GetRenderer().CreateTexture(m_Specification, m_PixelData);
+            m_TextureHandle = Engine::Get().GetRenderer().CreateTexture(m_Specification, m_PixelData);
 
-        if (!m_FilePath.empty())
-            stbi_image_free(m_PixelData);
+            if (!m_FilePath.empty())
+                stbi_image_free(m_PixelData);
         
-        m_PixelData = nullptr;
+            m_PixelData = nullptr;
+        }
         
         if (m_TextureHandle)
         {
@@ -95,6 +136,28 @@ namespace Lynx
         return false;
     }
 
+    uint64_t Texture::GetMipChainSize(uint32_t firstMip) const
+    {
+        uint64_t size = 0;
+        for (uint32_t mip = firstMip; mip < m_MipCount; mip++)
+        {
+            uint32_t width = std::max(1u, GetWidth() >> mip);
+            uint32_t height = std::max(1u, GetHeight() >> mip);
+            if (TextureCompiler::IsBlockCompressed(m_Specification.Format))
+                size += TextureCompiler::GetMipByteSize(m_Specification.Format, width, height);
+            else
+                size += (uint64_t)width * height * 4;
+        }
+        return size;
+    }
+
+    void Texture::SetResidentMips(nvrhi::TextureHandle handle, uint32_t firstMip)
+    {
+        m_TextureHandle = handle;
+        m_ResidentMip = firstMip;
+        IncrementVersion();
+    }
+
     bool Texture::Reload()
     {
         // TODO: This could be done async too. Add later and keep old texture handle alive until new one is loaded.
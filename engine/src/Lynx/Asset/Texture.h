@@ -4,6 +4,7 @@
 #include <nvrhi/nvrhi.h>
 
 #include "TextureSpecification.h"
+#include "TextureCompiler.h"
 
 namespace Lynx
 {
@@ -31,11 +32,34 @@ namespace Lynx
         virtual bool CreateRenderResources() override;
         virtual bool Reload() override;
 
+        // Mip streaming, see TextureStreamer. Only block compressed textures with a DDS on disk stream.
+        bool IsStreamable() const { return !m_StreamSource.empty() && m_MipCount > 1; }
+        const std::filesystem::path& GetStreamSource() const { return m_StreamSource; }
+        uint32_t GetStreamGeneration() const { return m_StreamGeneration; }
+        uint32_t GetMipCount() const { return m_MipCount; }
+        uint32_t GetResidentMip() const { return m_ResidentMip; }
+        uint32_t GetTailMip() const { return m_TailMip; }
+        // Bytes of mips firstMip..MipCount-1
+        uint64_t GetMipChainSize(uint32_t firstMip) const;
+
+    private:
+        void SetResidentMips(nvrhi::TextureHandle handle, uint32_t firstMip);
+
     private:
         TextureSpecification m_Specification;
         nvrhi::TextureHandle m_TextureHandle;
 
         unsigned char* m_PixelData = nullptr;
+        // Block compressed data incl. mips, used instead of m_PixelData when compression is on
+        TextureData m_CompressedData;
+
+        std::filesystem::path m_StreamSource;
+        uint32_t m_StreamGeneration = 0;
+        uint32_t m_MipCount = 1;
+        uint32_t m_ResidentMip = 0;
+        uint32_t m_TailMip = 0;
+
+        friend class TextureStreamer;
     };
 }
 
@@ -0,0 +1,521 @@
+#include "TextureCompiler.h"
+#include "BC7Encoder.h"
+
+#include <fstream>
+#include <glm/glm.hpp>
+#include <stb_image.h>
+
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+namespace Lynx
+{
+    namespace DDS
+    {
+        constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+        {
+            return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+        }
+
+        constexpr uint32_t Magic = MakeFourCC('D', 'D', 'S', ' ');
+        constexpr uint32_t PixelFormatFourCC = 0x4;
+        constexpr uint32_t HeaderFlags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000; // Caps, Height, Width, PixelFormat, MipMapCount, LinearSize
+        constexpr uint32_t CapsTexture = 0x1000;
+        constexpr uint32_t CapsMipMap = 0x400008; // Complex | MipMap
+
+        // Stored in the reserved header fields, lets us detect stale caches after settings changes.
+        constexpr uint32_t CacheMagic = MakeFourCC('L', 'Y', 'N', 'X');
+        constexpr uint32_t CacheVersion = 2; // 2: BC7 is encoded for real, before it fell back to BC3
+
+        struct PixelFormatDesc
+        {
+            uint32_t Size;
+            uint32_t Flags;
+            uint32_t FourCC;
+            uint32_t RGBBitCount;
+            uint32_t RBitMask;
+            uint32_t GBitMask;
+            uint32_t BBitMask;
+            uint32_t ABitMask;
+        };
+
+        struct Header
+        {
+            uint32_t Size;
+            uint32_t Flags;
+            uint32_t Height;
+            uint32_t Width;
+            uint32_t PitchOrLinearSize;
+            uint32_t Depth;
+            uint32_t MipMapCount;
+            uint32_t Reserved1[11];
+            PixelFormatDesc PixelFormat;
+            uint32_t Caps;
+            uint32_t Caps2;
+            uint32_t Caps3;
+            uint32_t Caps4;
+            uint32_t Reserved2;
+        };
+        static_assert(sizeof(Header) == 124, "DDS header has to be 124 bytes");
+
+        struct HeaderDX10
+        {
+            uint32_t DXGIFormat;
+            uint32_t ResourceDimension;
+            uint32_t MiscFlag;
+            uint32_t ArraySize;
+            uint32_t MiscFlags2;
+        };
+
+        static uint32_t ToDXGIFormat(TextureFormat format, bool sRGB)
+        {
+            switch (format)
+            {
+                case TextureFormat::BC1: return sRGB ? 72 : 71;
+                case TextureFormat::BC3: return sRGB ? 78 : 77;
+                case TextureFormat::BC5: return 83;
+                case TextureFormat::BC7: return sRGB ? 99 : 98;
+                default: return 0;
+            }
+        }
+
+        static TextureFormat FromDXGIFormat(uint32_t dxgiFormat, bool& outSRGB)
+        {
+            outSRGB = false;
+            switch (dxgiFormat)
+            {
+                case 72: outSRGB = true; [[fallthrough]];
+                case 71: return TextureFormat::BC1;
+                case 78: outSRGB = true; [[fallthrough]];
+                case 77: return TextureFormat::BC3;
+                case 83: return TextureFormat::BC5;
+                case 99: outSRGB = true; [[fallthrough]];
+                case 98: return TextureFormat::BC7;
+                default: return TextureFormat::None;
+            }
+        }
+    }
+
+    static float SRGBToLinear(float value)
+    {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    static float LinearToSRGB(float value)
+    {
+        return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    static TextureMip CompressLevel(const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height, TextureFormat format)
+    {
+        TextureMip mip;
+        mip.Width = width;
+        mip.Height = height;
+        mip.RowPitch = TextureCompiler::GetRowPitch(format, width);
+
+        uint32_t blocksX = (width + 3) / 4;
+        uint32_t blocksY = (height + 3) / 4;
+        uint32_t blockSize = mip.RowPitch / blocksX;
+        mip.Data.resize((size_t)mip.RowPitch * blocksY);
+
+        uint8_t block[64];
+        uint8_t rgBlock[32];
+        for (uint32_t by = 0; by < blocksY; by++)
+        {
+            for (uint32_t bx = 0; bx < blocksX; bx++)
+            {
+                // Gather 4x4 pixels, edges are clamped for sizes that aren't a multiple of 4
+                for (uint32_t py = 0; py < 4; py++)
+                {
+                    uint32_t y = std::min(by * 4 + py, height - 1);
+                    for (uint32_t px = 0; px < 4; px++)
+                    {
+                        uint32_t x = std::min(bx * 4 + px, width - 1);
+                        memcpy(&block[(py * 4 + px) * 4], &rgba[((size_t)y * width + x) * 4], 4);
+                    }
+                }
+
+                uint8_t* dst = mip.Data.data() + ((size_t)by * blocksX + bx) * blockSize;
+                switch (format)
+                {
+                    case TextureFormat::BC1:
+                        stb_compress_dxt_block(dst, block, 0, STB_DXT_HIGHQUAL);
+                        break;
+                    case TextureFormat::BC3:
+                        stb_compress_dxt_block(dst, block, 1, STB_DXT_HIGHQUAL);
+                        break;
+                    case TextureFormat::BC5:
+                        for (int i = 0; i < 16; i++)
+                        {
+                            rgBlock[i * 2 + 0] = block[i * 4 + 0];
+                            rgBlock[i * 2 + 1] = block[i * 4 + 1];
+                        }
+                        stb_compress_bc5_block(dst, rgBlock);
+                        break;
+                    case TextureFormat::BC7:
+                        BC7Encoder::CompressBlock(dst, block);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        return mip;
+    }
+
+    bool TextureCompiler::LoadOrCompile(const std::filesystem::path& sourcePath, const TextureSpecification& spec, TextureData& outData, uint32_t maxSize)
+    {
+        if (IsCompressedSource(sourcePath))
+            return LoadDDS(sourcePath, outData, nullptr, 0, maxSize);
+
+        std::filesystem::path cachePath = GetCachePath(sourcePath);
+        uint32_t cacheKey = GetCacheKey(spec);
+
+        std::error_code ec;
+        if (std::filesystem::exists(cachePath, ec))
+        {
+            bool isStale = std::filesystem::last_write_time(cachePath, ec) < std::filesystem::last_write_time(sourcePath, ec);
+            uint32_t cachedKey = 0;
+            if (!isStale && LoadDDS(cachePath, outData, &cachedKey, 0, maxSize) && cachedKey == cacheKey)
+                return true;
+
+            outData = TextureData();
+        }
+
+        if (!Compile(sourcePath, spec, outData))
+            return false;
+
+        if (!WriteDDS(cachePath, outData, cacheKey))
+        {
+            // Nothing to stream the upper mips from, keep everything
+            LX_CORE_WARN("Failed to write texture cache: {0}", cachePath.string());
+            return true;
+        }
+
+        LX_CORE_TRACE("Compiled texture {0} ({1} mips)", sourcePath.string(), outData.Mips.size());
+        DropMipsAbove(outData, maxSize);
+        return true;
+    }
+
+    bool TextureCompiler::Compile(const std::filesystem::path& sourcePath, const TextureSpecification& spec, TextureData& outData)
+    {
+        int width, height, channels;
+        stbi_uc* pixels = stbi_load(sourcePath.string().c_str(), &width, &height, &channels, 4);
+        if (!pixels)
+        {
+            LX_CORE_ERROR("Failed to load texture for compression: {0}", sourcePath.string());
+            return false;
+        }
+
+        bool hasAlpha = false;
+        if (channels == 2 || channels == 4)
+        {
+            for (size_t i = 0; i < (size_t)width * height; i++)
+            {
+                if (pixels[i * 4 + 3] < 255)
+                {
+                    hasAlpha = true;
+                    break;
+                }
+            }
+        }
+
+        TextureFormat format = ResolveFormat(spec, hasAlpha);
+        if (!IsBlockCompressed(format))
+        {
+            stbi_image_free(pixels);
+            return false;
+        }
+
+        bool isNormalMap = spec.Usage == TextureUsage::NormalMap;
+        bool isSRGB = spec.IsSRGB && format != TextureFormat::BC5;
+        // Filter in linear space, otherwise sRGB mips get too dark
+        bool filterLinear = isSRGB && spec.Usage == TextureUsage::Color;
+
+        uint32_t w = (uint32_t)width;
+        uint32_t h = (uint32_t)height;
+        std::vector<glm::vec4> level((size_t)w * h);
+        for (size_t i = 0; i < level.size(); i++)
+        {
+            glm::vec4 texel = glm::vec4(pixels[i * 4 + 0], pixels[i * 4 + 1], pixels[i * 4 + 2], pixels[i * 4 + 3]) / 255.0f;
+            if (filterLinear)
+                texel = glm::vec4(SRGBToLinear(texel.r), SRGBToLinear(texel.g), SRGBToLinear(texel.b), texel.a);
+            level[i] = texel;
+        }
+        stbi_image_free(pixels);
+
+        outData = TextureData();
+        outData.Format = format;
+        outData.IsSRGB = isSRGB;
+        outData.Width = w;
+        outData.Height = h;
+
+        std::vector<uint8_t> rgba;
+        while (true)
+        {
+            rgba.resize(level.size() * 4);
+            for (size_t i = 0; i < level.size(); i++)
+            {
+                glm::vec4 texel = level[i];
+                if (filterLinear)
+                    texel = glm::vec4(LinearToSRGB(texel.r), LinearToSRGB(texel.g), LinearToSRGB(texel.b), texel.a);
+                texel = glm::clamp(texel, 0.0f, 1.0f) * 255.0f + 0.5f;
+                rgba[i * 4 + 0] = (uint8_t)texel.r;
+                rgba[i * 4 + 1] = (uint8_t)texel.g;
+                rgba[i * 4 + 2] = (uint8_t)texel.b;
+                rgba[i * 4 + 3] = (uint8_t)texel.a;
+            }
+
+            outData.Mips.push_back(CompressLevel(rgba, w, h, format));
+
+            if (!spec.GenerateMips || (w == 1 && h == 1))
+                break;
+
+            // 2x2 box filter
+            uint32_t nextW = std::max(1u, w / 2);
+            uint32_t nextH = std::max(1u, h / 2);
+            std::vector<glm::vec4> next((size_t)nextW * nextH);
+            for (uint32_t y = 0; y < nextH; y++)
+            {
+                uint32_t y0 = std::min(y * 2, h - 1);
+                uint32_t y1 = std::min(y * 2 + 1, h - 1);
+                for (uint32_t x = 0; x < nextW; x++)
+                {
+                    uint32_t x0 = std::min(x * 2, w - 1);
+                    uint32_t x1 = std::min(x * 2 + 1, w - 1);
+                    glm::vec4 texel = (level[(size_t)y0 * w + x0] + level[(size_t)y0 * w + x1] +
+                                       level[(size_t)y1 * w + x0] + level[(size_t)y1 * w + x1]) * 0.25f;
+
+                    if (isNormalMap)
+                    {
+                        glm::vec3 n = glm::vec3(texel) * 2.0f - 1.0f;
+                        float len = glm::length(n);
+                        if (len > 0.0001f)
+                            n /= len;
+                        texel = glm::vec4(n * 0.5f + 0.5f, texel.a);
+                    }
+
+                    next[(size_t)y * nextW + x] = texel;
+                }
+            }
+
+            level = std::move(next);
+            w = nextW;
+            h = nextH;
+        }
+
+        outData.MipCount = (uint32_t)outData.Mips.size();
+        return true;
+    }
+
+    bool TextureCompiler::LoadDDS(const std::filesystem::path& path, TextureData& outData, uint32_t* outCacheKey, uint32_t firstMip, uint32_t maxSize,
+        uint32_t mipCount)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            LX_CORE_ERROR("Failed to open DDS file: {0}", path.string());
+            return false;
+        }
+
+        uint32_t magic = 0;
+        DDS::Header header = {};
+        file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || magic != DDS::Magic || header.Size != sizeof(DDS::Header))
+        {
+            LX_CORE_ERROR("Invalid DDS file: {0}", path.string());
+            return false;
+        }
+
+        TextureFormat format = TextureFormat::None;
+        bool isSRGB = false;
+        if (header.PixelFormat.Flags & DDS::PixelFormatFourCC)
+        {
+            uint32_t fourCC = header.PixelFormat.FourCC;
+            if (fourCC == DDS::MakeFourCC('D', 'X', '1', '0'))
+            {
+                DDS::HeaderDX10 dx10 = {};
+                file.read(reinterpret_cast<char*>(&dx10), sizeof(dx10));
+                format = DDS::FromDXGIFormat(dx10.DXGIFormat, isSRGB);
+            }
+            else if (fourCC == DDS::MakeFourCC('D', 'X', 'T', '1'))
+                format = TextureFormat::BC1;
+            else if (fourCC == DDS::MakeFourCC('D', 'X', 'T', '5'))
+                format = TextureFormat::BC3;
+            else if (fourCC == DDS::MakeFourCC('A', 'T', 'I', '2') || fourCC == DDS::MakeFourCC('B', 'C', '5', 'U'))
+                format = TextureFormat::BC5;
+        }
+
+        if (format == TextureFormat::None)
+        {
+            LX_CORE_ERROR("Unsupported DDS format (only BC1/BC3/BC5/BC7 are supported): {0}", path.string());
+            return false;
+        }
+
+        outData = TextureData();
+        outData.Format = format;
+        outData.IsSRGB = isSRGB;
+        outData.Width = header.Width;
+        outData.Height = header.Height;
+        outData.MipCount = std::max(1u, header.MipMapCount);
+
+        // Skip mips we don't want resident yet, the last one is always loaded
+        outData.FirstMip = std::min(firstMip, outData.MipCount - 1);
+        if (maxSize > 0)
+        {
+            while (outData.FirstMip < outData.MipCount - 1 &&
+                   std::max(header.Width >> outData.FirstMip, header.Height >> outData.FirstMip) > maxSize)
+                outData.FirstMip++;
+        }
+
+        uint64_t skipBytes = 0;
+        for (uint32_t i = 0; i < outData.FirstMip; i++)
+            skipBytes += GetMipByteSize(format, std::max(1u, header.Width >> i), std::max(1u, header.Height >> i));
+        file.seekg((std::streamoff)skipBytes, std::ios::cur);
+
+        uint32_t endMip = mipCount > 0 ? std::min(outData.MipCount, outData.FirstMip + mipCount) : outData.MipCount;
+        outData.Mips.reserve(endMip - outData.FirstMip);
+        for (uint32_t i = outData.FirstMip; i < endMip; i++)
+        {
+            TextureMip mip;
+            mip.Width = std::max(1u, header.Width >> i);
+            mip.Height = std::max(1u, header.Height >> i);
+            mip.RowPitch = GetRowPitch(format, mip.Width);
+            mip.Data.resize(GetMipByteSize(format, mip.Width, mip.Height));
+            file.read(reinterpret_cast<char*>(mip.Data.data()), mip.Data.size());
+            if (!file)
+            {
+                LX_CORE_ERROR("DDS file is truncated: {0}", path.string());
+                outData = TextureData();
+                return false;
+            }
+            outData.Mips.push_back(std::move(mip));
+        }
+
+        if (outCacheKey)
+            *outCacheKey = header.Reserved1[0] == DDS::CacheMagic ? header.Reserved1[1] : 0;
+
+        return true;
+    }
+
+    bool TextureCompiler::WriteDDS(const std::filesystem::path& path, const TextureData& data, uint32_t cacheKey)
+    {
+        if (!data.IsValid() || data.FirstMip != 0 || !IsBlockCompressed(data.Format))
+            return false;
+
+        DDS::Header header = {};
+        header.Size = sizeof(DDS::Header);
+        header.Flags = DDS::HeaderFlags;
+        header.Width = data.GetWidth();
+        header.Height = data.GetHeight();
+        header.PitchOrLinearSize = (uint32_t)data.Mips[0].Data.size();
+        header.MipMapCount = (uint32_t)data.Mips.size();
+        header.Reserved1[0] = DDS::CacheMagic;
+        header.Reserved1[1] = cacheKey;
+        header.PixelFormat.Size = sizeof(DDS::PixelFormatDesc);
+        header.PixelFormat.Flags = DDS::PixelFormatFourCC;
+        header.PixelFormat.FourCC = DDS::MakeFourCC('D', 'X', '1', '0');
+        header.Caps = DDS::CapsTexture | (data.Mips.size() > 1 ? DDS::CapsMipMap : 0);
+
+        DDS::HeaderDX10 dx10 = {};
+        dx10.DXGIFormat = DDS::ToDXGIFormat(data.Format, data.IsSRGB);
+        dx10.ResourceDimension = 3; // Texture2D
+        dx10.ArraySize = 1;
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        file.write(reinterpret_cast<const char*>(&DDS::Magic), sizeof(DDS::Magic));
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(&dx10), sizeof(dx10));
+        for (const auto& mip : data.Mips)
+            file.write(reinterpret_cast<const char*>(mip.Data.data()), mip.Data.size());
+
+        return (bool)file;
+    }
+
+    std::filesystem::path TextureCompiler::GetCachePath(const std::filesystem::path& sourcePath)
+    {
+        // DDS container, but not with a .dds extension so the registry doesn't import it as a texture
+        return sourcePath.string() + ".lxtex";
+    }
+
+    bool TextureCompiler::IsCompressedSource(const std::filesystem::path& path)
+    {
+        return path.extension() == ".dds";
+    }
+
+    void TextureCompiler::DeleteCache(const std::filesystem::path& sourcePath)
+    {
+        std::error_code ec;
+        std::filesystem::remove(GetCachePath(sourcePath), ec);
+    }
+
+    TextureFormat TextureCompiler::ResolveFormat(const TextureSpecification& spec, bool hasAlpha)
+    {
+        switch (spec.Compression)
+        {
+            case TextureCompression::BC1: return TextureFormat::BC1;
+            case TextureCompression::BC3: return TextureFormat::BC3;
+            case TextureCompression::BC5: return TextureFormat::BC5;
+            case TextureCompression::BC7: return TextureFormat::BC7;
+            case TextureCompression::Auto:
+            {
+                if (spec.Usage == TextureUsage::NormalMap)
+                    return TextureFormat::BC5;
+                // BC7 over BC3, same size but a lot less blocky
+                return hasAlpha ? TextureFormat::BC7 : TextureFormat::BC1;
+            }
+            case TextureCompression::None:
+            default:
+                return TextureFormat::None;
+        }
+    }
+
+    bool TextureCompiler::IsBlockCompressed(TextureFormat format)
+    {
+        return format == TextureFormat::BC1 || format == TextureFormat::BC3 || format == TextureFormat::BC5 || format == TextureFormat::BC7;
+    }
+
+    uint32_t TextureCompiler::GetRowPitch(TextureFormat format, uint32_t width)
+    {
+        uint32_t blocks = (std::max(1u, width) + 3) / 4;
+        return blocks * (format == TextureFormat::BC1 ? 8 : 16);
+    }
+
+    uint32_t TextureCompiler::GetRowCount(TextureFormat format, uint32_t height)
+    {
+        return IsBlockCompressed(format) ? (std::max(1u, height) + 3) / 4 : height;
+    }
+
+    uint64_t TextureCompiler::GetMipByteSize(TextureFormat format, uint32_t width, uint32_t height)
+    {
+        return (uint64_t)GetRowPitch(format, width) * GetRowCount(format, height);
+    }
+
+    void TextureCompiler::DropMipsAbove(TextureData& data, uint32_t maxSize)
+    {
+        if (maxSize == 0)
+            return;
+
+        uint32_t drop = 0;
+        while (drop < data.Mips.size() - 1 && std::max(data.Mips[drop].Width, data.Mips[drop].Height) > maxSize)
+            drop++;
+
+        data.Mips.erase(data.Mips.begin(), data.Mips.begin() + drop);
+        data.FirstMip += drop;
+    }
+
+    uint32_t TextureCompiler::GetCacheKey(const TextureSpecification& spec)
+    {
+        uint32_t key = DDS::CacheVersion;
+        key = key * 31 + (uint32_t)spec.Compression;
+        key = key * 31 + (uint32_t)spec.Usage;
+        key = key * 31 + (spec.IsSRGB ? 1u : 0u);
+        key = key * 31 + (spec.GenerateMips ? 1u : 0u);
+        return key;
+    }
+}
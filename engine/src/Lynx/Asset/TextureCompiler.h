@@ -0,0 +1,62 @@
+#pragma once
+#include "Lynx/Core.h"
+#include <filesystem>
+
+#include "TextureSpecification.h"
+
+namespace Lynx
+{
+    struct TextureMip
+    {
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        uint32_t RowPitch = 0; // Bytes per row of blocks for BC formats
+        std::vector<uint8_t> Data;
+    };
+
+    // CPU side texture with (a part of) its mip chain, uploaded as is.
+    struct TextureData
+    {
+        TextureFormat Format = TextureFormat::None;
+        bool IsSRGB = false;
+        // Size and mip count of the full chain, Mips might only hold a part of it starting at FirstMip
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        uint32_t MipCount = 0;
+        uint32_t FirstMip = 0;
+        std::vector<TextureMip> Mips;
+
+        uint32_t GetWidth() const { return Width; }
+        uint32_t GetHeight() const { return Height; }
+        bool IsValid() const { return !Mips.empty(); }
+    };
+
+    // Converts source images (png, jpg, ...) into block compressed textures with a prebuilt mip chain.
+    // Results are cached as DDS files next to the .lxmeta, so this only runs when the source or its settings change.
+    class LX_API TextureCompiler
+    {
+    public:
+        // maxSize skips mips larger than that (0 = load everything), used to only load the streaming tail.
+        static bool LoadOrCompile(const std::filesystem::path& sourcePath, const TextureSpecification& spec, TextureData& outData, uint32_t maxSize = 0);
+
+        // mipCount limits how many mips get read from firstMip on, 0 reads up to the smallest one
+        static bool LoadDDS(const std::filesystem::path& path, TextureData& outData, uint32_t* outCacheKey = nullptr, uint32_t firstMip = 0, uint32_t maxSize = 0,
+            uint32_t mipCount = 0);
+        static bool WriteDDS(const std::filesystem::path& path, const TextureData& data, uint32_t cacheKey = 0);
+
+        static std::filesystem::path GetCachePath(const std::filesystem::path& sourcePath);
+        static bool IsCompressedSource(const std::filesystem::path& path);
+        static void DeleteCache(const std::filesystem::path& sourcePath);
+
+        static TextureFormat ResolveFormat(const TextureSpecification& spec, bool hasAlpha);
+        static bool IsBlockCompressed(TextureFormat format);
+        static uint32_t GetRowPitch(TextureFormat format, uint32_t width);
+        static uint32_t GetRowCount(TextureFormat format, uint32_t height);
+        static uint64_t GetMipByteSize(TextureFormat format, uint32_t width, uint32_t height);
+
+    private:
+        static bool Compile(const std::filesystem::path& sourcePath, const TextureSpecification& spec, TextureData& outData);
+        static uint32_t GetCacheKey(const TextureSpecification& spec);
+        static void DropMipsAbove(TextureData& data, uint32_t maxSize);
+    };
+}
@@ -30,6 +30,27 @@ namespace Lynx
         R8,
         Depth32,            // Depth Buffer
         Depth24Stencil8,    // Depth Buffer + Stencil
+        BC1,                // RGB, 1 bit alpha (4bpp)
+        BC3,                // RGBA (8bpp)
+        BC5,                // Two channel, normal maps (8bpp)
+        BC7,                // High quality RGBA (8bpp)
+    };
+
+    enum class TextureUsage
+    {
+        Color = 0,
+        NormalMap,
+        Data
+    };
+
+    enum class TextureCompression
+    {
+        None = 0,
+        Auto,   // Picked from usage and alpha
+        BC1,
+        BC3,
+        BC5,
+        BC7
     };
 
     struct SamplerSettings
@@ -52,11 +73,13 @@ namespace Lynx
         SamplerSettings SamplerSettings;
         bool GenerateMips = true;
         bool IsSRGB = false;
+        TextureUsage Usage = TextureUsage::Color;
+        TextureCompression Compression = TextureCompression::Auto;
         std::string DebugName = "Texture";
 
         TextureSpecification() = default;
 
-        virtual uint32_t GetCurrentVersion() const override { return 2; }
+        virtual uint32_t GetCurrentVersion() const override { return 3; }
 
         virtual void Serialize(nlohmann::json& json) const override
         {
@@ -67,6 +90,8 @@ namespace Lynx
             json["IsSRGB"] = IsSRGB;
             json["GenerateMips"] = GenerateMips;
             json["UseAnisotropy"] = SamplerSettings.UseAnisotropy;
+            json["Usage"] = Usage;
+            json["Compression"] = Compression;
         }
 
         virtual void Deserialize(const nlohmann::json& json) override
@@ -77,6 +102,9 @@ namespace Lynx
             IsSRGB = json.value("IsSRGB", false);
             GenerateMips = json.value("GenerateMips", true);
             SamplerSettings.UseAnisotropy = json.value("UseAnisotropy", true);
+            Usage = (TextureUsage)json.value("Usage", (int)TextureUsage::Color);
+            // v2 had no compression. Textures without mips are mostly UI/font atlases, keep those uncompressed.
+            Compression = (TextureCompression)json.value("Compression", (int)(GenerateMips ? TextureCompression::Auto : TextureCompression::None));
         }
 
         bool operator==(const TextureSpecification& other) const
@@ -84,7 +112,9 @@ namespace Lynx
             return Format == other.Format &&
                     SamplerSettings == other.SamplerSettings &&
                     GenerateMips == other.GenerateMips &&
-                    IsSRGB == other.IsSRGB;
+                    IsSRGB == other.IsSRGB &&
+                    Usage == other.Usage &&
+                    Compression == other.Compression;
         }
         bool operator!=(const TextureSpecification& other) const { return !(*this == other); }
     };
@@ -0,0 +1,312 @@
+#include "JobSystem.h"
+
+namespace Lynx
+{
+    // Which worker of which job system this thread is, -1 for everybody else
+    static thread_local const JobSystem* t_Owner = nullptr;
+    static thread_local int32_t t_WorkerIndex = -1;
+
+    JobSystem::JobSystem(uint32_t workerCount)
+        : m_MainThread(std::this_thread::get_id())
+    {
+        if (workerCount == 0)
+            workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+        for (uint32_t i = 0; i < workerCount; i++)
+            m_Queues.push_back(std::make_unique<WorkerQueue>());
+        for (uint32_t i = 0; i < workerCount; i++)
+            m_Workers.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+
+    JobSystem::~JobSystem()
+    {
+        // Workers drain everything that's queued before they stop, pending loads still finish
+        {
+            std::lock_guard lock(m_SleepMutex);
+            m_Stop = true;
+        }
+        m_WakeCondition.notify_all();
+
+        for (auto& worker : m_Workers)
+            worker.join();
+    }
+
+    void JobSystem::Run(JobFunc job, Counter* counter)
+    {
+        if (counter)
+            counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+        Push({ std::move(job), counter });
+        WakeWorkers(false);
+    }
+
+    void JobSystem::RunAfter(Counter& dependency, JobFunc job, Counter* counter)
+    {
+        if (counter)
+            counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+        {
+            // Finish takes the same lock when it brings the count to zero, so we either see zero or get picked up by it
+            std::lock_guard lock(dependency.m_Mutex);
+            if (!dependency.IsDone())
+            {
+                dependency.m_Continuations.emplace_back(std::move(job), counter);
+                return;
+            }
+        }
+
+        Push({ std::move(job), counter });
+        WakeWorkers(false);
+    }
+
+    void JobSystem::RunOnMainThread(JobFunc job, Counter* counter)
+    {
+        if (counter)
+            counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard lock(m_MainThreadMutex);
+        m_MainThreadJobs.push_back({ std::move(job), counter });
+    }
+
+    void JobSystem::RunBackground(JobFunc job)
+    {
+        // Counted before it's visible, a worker that pops it right away must not take the count below zero
+        m_QueuedJobs.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard lock(m_SharedMutex);
+            m_BackgroundJobs.push_back({ std::move(job), nullptr });
+        }
+        WakeWorkers(false);
+    }
+
+    void JobSystem::Wait(Counter& counter)
+    {
+        bool mainThread = IsMainThread();
+        while (!counter.IsDone())
+        {
+            if (mainThread && RunMainThreadJob())
+                continue;
+
+            Job job;
+            if (TryPop(job, false))
+            {
+                Execute(job);
+                continue;
+            }
+
+            std::this_thread::yield();
+        }
+
+        // The last Finish might still hold the lock, wait for it before the counter can go away
+        std::lock_guard lock(counter.m_Mutex);
+    }
+
+    uint32_t JobSystem::GetChunkCount(size_t count, size_t minChunkSize) const
+    {
+        size_t chunks = (count + std::max<size_t>(minChunkSize, 1) - 1) / std::max<size_t>(minChunkSize, 1);
+        return (uint32_t)std::clamp<size_t>(chunks, 1, m_Workers.size() + 1);
+    }
+
+    void JobSystem::ParallelFor(size_t count, size_t minChunkSize, const RangeFunc& func)
+    {
+        if (count == 0)
+            return;
+
+        uint32_t chunkCount = GetChunkCount(count, minChunkSize);
+        if (chunkCount == 1)
+        {
+            func(0, count, 0);
+            return;
+        }
+
+        Counter counter;
+        for (uint32_t chunk = 1; chunk < chunkCount; chunk++)
+        {
+            size_t begin = count * chunk / chunkCount;
+            size_t end = count * (chunk + 1) / chunkCount;
+            counter.m_Count.fetch_add(1, std::memory_order_relaxed);
+            Push({ [&func, begin, end, chunk]() { func(begin, end, chunk); }, &counter });
+        }
+        WakeWorkers(true);
+
+        func(0, count / chunkCount, 0);
+        Wait(counter);
+    }
+
+    void JobSystem::ProcessMainThreadJobs()
+    {
+        std::deque<Job> jobs;
+        {
+            std::lock_guard lock(m_MainThreadMutex);
+            jobs.swap(m_MainThreadJobs);
+        }
+
+        for (Job& job : jobs)
+            Execute(job);
+    }
+
+    void JobSystem::Push(Job job)
+    {
+        // Counted before it's visible, see RunBackground. A worker that sees the count early just finds nothing and looks again.
+        m_QueuedJobs.fetch_add(1, std::memory_order_release);
+        if (t_Owner == this)
+        {
+            WorkerQueue& queue = *m_Queues[t_WorkerIndex];
+            std::lock_guard lock(queue.Mutex);
+            queue.Jobs.push_back(std::move(job));
+        }
+        else
+        {
+            std::lock_guard lock(m_SharedMutex);
+            m_SharedJobs.push_back(std::move(job));
+        }
+    }
+
+    bool JobSystem::TryPop(Job& outJob, bool allowBackground)
+    {
+        if (m_QueuedJobs.load(std::memory_order_acquire) == 0)
+            return false;
+
+        int32_t self = t_Owner == this ? t_WorkerIndex : -1;
+
+        // Own jobs newest first, they're the most likely to still be in cache
+        if (self >= 0)
+        {
+            WorkerQueue& queue = *m_Queues[self];
+            std::lock_guard lock(queue.Mutex);
+            if (!queue.Jobs.empty())
+            {
+                outJob = std::move(queue.Jobs.back());
+                queue.Jobs.pop_back();
+                m_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        {
+            std::lock_guard lock(m_SharedMutex);
+            if (!m_SharedJobs.empty())
+            {
+                outJob = std::move(m_SharedJobs.front());
+                m_SharedJobs.pop_front();
+                m_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        // Steal the oldest job of somebody else, starting with our neighbour so the thieves spread out
+        size_t queueCount = m_Queues.size();
+        for (size_t i = 1; i <= queueCount; i++)
+        {
+            size_t victim = (size_t)(self + (int32_t)i) % queueCount;
+            if ((int32_t)victim == self)
+                continue;
+
+            WorkerQueue& queue = *m_Queues[victim];
+            std::lock_guard lock(queue.Mutex);
+            if (!queue.Jobs.empty())
+            {
+                outJob = std::move(queue.Jobs.front());
+                queue.Jobs.pop_front();
+                m_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        if (allowBackground)
+        {
+            std::lock_guard lock(m_SharedMutex);
+            if (!m_BackgroundJobs.empty())
+            {
+                outJob = std::move(m_BackgroundJobs.front());
+                m_BackgroundJobs.pop_front();
+                m_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool JobSystem::RunMainThreadJob()
+    {
+        Job job;
+        {
+            std::lock_guard lock(m_MainThreadMutex);
+            if (m_MainThreadJobs.empty())
+                return false;
+
+            job = std::move(m_MainThreadJobs.front());
+            m_MainThreadJobs.pop_front();
+        }
+
+        Execute(job);
+        return true;
+    }
+
+    void JobSystem::Execute(Job& job)
+    {
+        job.Func();
+        if (job.Signal)
+            Finish(job.Signal);
+    }
+
+    void JobSystem::Finish(Counter* counter)
+    {
+        uint32_t count = counter->m_Count.load(std::memory_order_relaxed);
+        while (count > 1)
+        {
+            // Not the last one, nobody can be done waiting on it yet
+            if (counter->m_Count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel))
+                return;
+        }
+
+        std::vector<std::pair<JobFunc, Counter*>> continuations;
+        {
+            std::lock_guard lock(counter->m_Mutex);
+            // Somebody might have added a job in the meantime
+            if (counter->m_Count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                continuations.swap(counter->m_Continuations);
+        }
+
+        // Don't touch the counter from here on, a waiter might have returned already
+        for (auto& [func, next] : continuations)
+            Push({ std::move(func), next });
+        if (!continuations.empty())
+            WakeWorkers(continuations.size() > 1);
+    }
+
+    void JobSystem::WakeWorkers(bool all)
+    {
+        // Take the lock so a worker that just found nothing can't miss this between its check and going to sleep
+        {
+            std::lock_guard lock(m_SleepMutex);
+        }
+
+        if (all)
+            m_WakeCondition.notify_all();
+        else
+            m_WakeCondition.notify_one();
+    }
+
+    void JobSystem::WorkerLoop(uint32_t index)
+    {
+        t_Owner = this;
+        t_WorkerIndex = (int32_t)index;
+
+        while (true)
+        {
+            Job job;
+            if (TryPop(job, true))
+            {
+                Execute(job);
+                continue;
+            }
+
+            std::unique_lock lock(m_SleepMutex);
+            m_WakeCondition.wait(lock, [this]() { return m_Stop || m_QueuedJobs.load(std::memory_order_acquire) > 0; });
+            if (m_Stop && m_QueuedJobs.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+}
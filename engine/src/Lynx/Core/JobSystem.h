@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Lynx/Core.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Lynx
+{
+    // Engine wide worker pool. Every worker owns a deque: it pushes and pops its own jobs at the back and steals from
+    // the front of the others when it runs dry. Jobs pushed from other threads go through a shared queue.
+    // Waiting never blocks a thread, it runs other jobs until the counter is done.
+    class LX_API JobSystem
+    {
+    public:
+        using JobFunc = std::function<void()>;
+        using RangeFunc = std::function<void(size_t begin, size_t end, uint32_t chunk)>;
+
+        // Number of unfinished jobs that were started with it. Only destroy it after Wait returned.
+        class Counter
+        {
+        public:
+            Counter() = default;
+            Counter(const Counter&) = delete;
+            Counter& operator=(const Counter&) = delete;
+
+            bool IsDone() const { return m_Count.load(std::memory_order_acquire) == 0; }
+
+        private:
+            std::atomic<uint32_t> m_Count = 0;
+            std::mutex m_Mutex;
+            // Jobs started with RunAfter, pushed once the count hits zero
+            std::vector<std::pair<JobFunc, Counter*>> m_Continuations;
+
+            friend class JobSystem;
+        };
+
+        // 0 workers means one less than the hardware threads, the main thread helps out while it waits
+        explicit JobSystem(uint32_t workerCount = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        void Run(JobFunc job, Counter* counter = nullptr);
+        // Starts once dependency is done
+        void RunAfter(Counter& dependency, JobFunc job, Counter* counter = nullptr);
+        // Picked up by ProcessMainThreadJobs (once per frame) or by the main thread while it waits
+        void RunOnMainThread(JobFunc job, Counter* counter = nullptr);
+        // Long running work like asset loads. Only idle workers take these, never a thread that waits on something else.
+        void RunBackground(JobFunc job);
+
+        void Wait(Counter& counter);
+
+        // Splits [0, count) into chunks of at least minChunkSize and waits for all of them. Chunk 0 runs on the calling thread.
+        void ParallelFor(size_t count, size_t minChunkSize, const RangeFunc& func);
+        uint32_t GetChunkCount(size_t count, size_t minChunkSize) const;
+
+        void ProcessMainThreadJobs();
+
+        uint32_t GetWorkerCount() const { return (uint32_t)m_Workers.size(); }
+        bool IsMainThread() const { return std::this_thread::get_id() == m_MainThread; }
+
+    private:
+        struct Job
+        {
+            JobFunc Func;
+            Counter* Signal = nullptr; // Finished when the job is done
+        };
+
+        struct WorkerQueue
+        {
+            std::mutex Mutex;
+            std::deque<Job> Jobs;
+        };
+
+        void Push(Job job);
+        bool TryPop(Job& outJob, bool allowBackground);
+        bool RunMainThreadJob();
+        void Execute(Job& job);
+        void Finish(Counter* counter);
+        void WakeWorkers(bool all);
+        void WorkerLoop(uint32_t index);
+
+    private:
+        std::vector<std::thread> m_Workers;
+        std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+        std::thread::id m_MainThread;
+
+        std::mutex m_SharedMutex;
+        std::deque<Job> m_SharedJobs;
+        std::deque<Job> m_BackgroundJobs;
+
+        std::mutex m_MainThreadMutex;
+        std::deque<Job> m_MainThreadJobs;
+
+        // Jobs in any queue except the main thread one, workers sleep while it's zero
+        std::atomic<uint32_t> m_QueuedJobs = 0;
+        std::mutex m_SleepMutex;
+        std::condition_variable m_WakeCondition;
+        bool m_Stop = false;
+    };
+}
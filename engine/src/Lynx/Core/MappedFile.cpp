@@ -0,0 +1,78 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Lynx
+{
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+#if defined(_WIN32)
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!data)
+        {
+            if (mapping)
+                CloseHandle(mapping);
+            CloseHandle(file);
+            return;
+        }
+
+        m_File = file;
+        m_Mapping = mapping;
+        m_Data = (const uint8_t*)data;
+        m_Size = (size_t)size.QuadPart;
+#else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            return;
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || info.st_size == 0)
+        {
+            close(file);
+            return;
+        }
+
+        // The mapping keeps the file alive on its own
+        void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (data == MAP_FAILED)
+            return;
+
+        m_Data = (const uint8_t*)data;
+        m_Size = (size_t)info.st_size;
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (!m_Data)
+            return;
+#if defined(_WIN32)
+        UnmapViewOfFile(m_Data);
+        CloseHandle((HANDLE)m_Mapping);
+        CloseHandle((HANDLE)m_File);
+#else
+        munmap((void*)m_Data, m_Size);
+#endif
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <filesystem>
+
+namespace Lynx
+{
+    // Read only view of a whole file, the OS pages it in as it gets touched
+    class LX_API MappedFile
+    {
+    public:
+        MappedFile() = default;
+        MappedFile(const std::filesystem::path& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool IsValid() const { return m_Data != nullptr; }
+        const uint8_t* GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+
+    private:
+        const uint8_t* m_Data = nullptr;
+        size_t m_Size = 0;
+#if defined(_WIN32)
+        void* m_File = nullptr;
+        void* m_Mapping = nullptr;
+#endif
+    };
+}
@@ -23,11 +23,13 @@
 #include "Event/SceneEvents.h"
 #include "ImGui/LXUI.h"
 #include "Renderer/DebugRenderer.h"
+#include "Scene/BinaryScene.h"
 #include "Scene/Components/IDComponent.h"
 #include "Scene/Components/LuaScriptComponent.h"
 #include "Scene/Components/NativeScriptComponent.h"
 #include "Scene/Components/UIComponents.h"
 #include "Scene/Components/ParticleComponents.h"
+#include "Scene/Components/AnimationComponents.h"
 
 
 namespace Lynx
@@ -41,6 +43,9 @@ namespace Lynx
         Log::Init();
         LX_CORE_INFO("Initializing...");
 
+        m_JobSystem = std::make_unique<JobSystem>();
+        LX_CORE_INFO("Job system running with {} workers", m_JobSystem->GetWorkerCount());
+
         RegisterCoreScripts();
         RegisterCoreComponents();
 
@@ -156,6 +161,7 @@ namespace Lynx
                 continue;
 
             m_AssetManager->Update();
+            m_JobSystem->ProcessMainThreadJobs();
 
             ImGui_ImplGlfw_NewFrame();
             ImGui::NewFrame();
@@ -201,6 +207,23 @@ namespace Lynx
         }
     }
 
+    void Engine::InitializeHeadless()
+    {
+        s_Instance = this;
+        m_IsEditor = true;
+        m_SceneState = SceneState::Edit;
+        Log::Init();
+
+        m_JobSystem = std::make_unique<JobSystem>();
+
+        RegisterCoreScripts();
+        RegisterCoreComponents();
+
+        m_AssetRegistry = std::make_unique<AssetRegistry>();
+        m_AssetManager = std::make_unique<AssetManager>(m_AssetRegistry.get());
+        m_Scene = std::make_shared<Scene>();
+    }
+
     void Engine::PreGameShutdown()
     {
         ClearActiveScene();
@@ -218,8 +241,13 @@ namespace Lynx
         m_ScriptEngine.reset();
         m_Scene.reset();
         
-        ImGui_ImplGlfw_Shutdown();
-        ImGui::DestroyContext();
+        if (m_Window)
+        {
+            ImGui_ImplGlfw_Shutdown();
+            ImGui::DestroyContext();
+        }
+        // Finishes the loads that are still running, they need the asset manager
+        m_JobSystem.reset();
         m_AssetManager.reset();
         m_Renderer.reset();
         Log::Shutdown();
@@ -403,25 +431,27 @@ namespace Lynx
             {
                 auto& transform = reg.get_or_emplace<TransformComponent>(entity);
                 auto trans = json["Translation"];
-                transform.Translation = glm::vec3(trans[0], trans[1], trans[2]);
+                transform.SetTranslation(glm::vec3(trans[0], trans[1], trans[2]));
                 auto rot = json["Rotation"];
-                transform.Rotation = glm::quat(rot[0], rot[1], rot[2], rot[3]);
+                transform.SetRotation(glm::quat(rot[0], rot[1], rot[2], rot[3]));
                 auto scale = json["Scale"];
-                transform.Scale = glm::vec3(scale[0], scale[1], scale[2]);
+                transform.SetScale(glm::vec3(scale[0], scale[1], scale[2]));
             },
             [](entt::registry& reg, entt::entity entity)
             {
                 auto& transform = reg.get<TransformComponent>(entity);
                 
-                LXUI::DrawVec3Control("Position", transform.Translation);
+                if (LXUI::DrawVec3Control("Position", transform.Translation))
+                    transform.MarkDirty();
 
                 glm::vec3 rotationDegrees = glm::degrees(glm::eulerAngles(transform.Rotation));
                 if (LXUI::DrawVec3Control("Rotation", rotationDegrees))
                 {
-                    transform.Rotation = glm::quat(glm::radians(rotationDegrees));
+                    transform.SetRotation(glm::quat(glm::radians(rotationDegrees)));
                 }
 
-                LXUI::DrawVec3Control("Scale", transform.Scale, 0.0f, 0.0f, 1.0f);
+                if (LXUI::DrawVec3Control("Scale", transform.Scale, 0.0f, 0.0f, 1.0f))
+                    transform.MarkDirty();
             });
 
         m_ComponentRegistry.RegisterCoreInternalOnlyComponent<RelationshipComponent>("Relationship",
@@ -450,9 +480,8 @@ namespace Lynx
             },
             [](entt::registry& reg, entt::entity entity, const nlohmann::json& json)
             {
-                auto& tagComponent = reg.get_or_emplace<TagComponent>(entity);
-                auto tag = json["Tag"];
-                tagComponent.Tag = tag;
+                std::string tag = json["Tag"];
+                reg.emplace_or_replace<TagComponent>(entity, tag);
             },
             [](entt::registry& reg, entt::entity entity)
             {
@@ -462,7 +491,7 @@ namespace Lynx
                 strcpy_s(buffer, sizeof(buffer), tag.c_str());
                 if (ImGui::InputText("Tag", buffer, sizeof(buffer)))
                 {
-                    tag = std::string(buffer);
+                    reg.patch<TagComponent>(entity, [&](TagComponent& t) { t.Tag = buffer; });
                 }
             });
 
@@ -482,12 +511,14 @@ namespace Lynx
                 json["SceneCamera"] = sceneCamObj;
                 json["Primary"] = camComp.Primary;
                 json["FixedAspectRatio"] = camComp.FixedAspectRatio;
+                json["CullingMask"] = camComp.CullingMask;
             },
             [](entt::registry& reg, entt::entity entity, const nlohmann::json& json)
             {
                 auto& camComp = reg.get_or_emplace<CameraComponent>(entity);
                 camComp.Primary = json["Primary"];
                 camComp.FixedAspectRatio = json["FixedAspectRatio"];
+                if (json.contains("CullingMask")) camComp.CullingMask = json["CullingMask"];
                 const auto& sceneCamObj = json["SceneCamera"];
                 const auto& projectionType = sceneCamObj["ProjectionType"];
                 if (projectionType == SceneCamera::ProjectionType::Perspective)
@@ -512,6 +543,7 @@ namespace Lynx
                 auto& cameraComp = reg.get<CameraComponent>(entity);
                 LXUI::DrawCheckBox("Primary", cameraComp.Primary);
                 LXUI::DrawCheckBox("FixedAspectRatio", cameraComp.FixedAspectRatio);
+                LXUI::DrawLayerMask("Culling Mask", cameraComp.CullingMask);
                 
                 std::vector<std::string> projectionTypeStrings = {"Perspective", "Orthographic"};
                 int currentProjectionType = (int)cameraComp.Camera.GetProjectionType();
@@ -564,17 +596,25 @@ namespace Lynx
             {
                 auto& meshComp = reg.get<MeshComponent>(entity);
                 json["Mesh"] = meshComp.Mesh;
+                json["Static"] = meshComp.IsStatic;
+                json["Layers"] = meshComp.Layers;
             },
             [](entt::registry& reg, entt::entity entity, const nlohmann::json& json)
             {
                 auto& meshComp = reg.get_or_emplace<MeshComponent>(entity);
                 meshComp.Mesh = json["Mesh"].get<AssetRef<StaticMesh>>();
+                if (json.contains("Static")) meshComp.IsStatic = json["Static"];
+                if (json.contains("Layers")) meshComp.Layers = json["Layers"];
             },
             [](entt::registry& reg, entt::entity entity)
             {
                 auto& meshComp = reg.get<MeshComponent>(entity);
                
-                LXUI::DrawAssetReference("Static Mesh", meshComp.Mesh, {AssetType::StaticMesh});
+                bool changed = LXUI::DrawAssetReference("Static Mesh", meshComp.Mesh, {AssetType::StaticMesh});
+                changed |= LXUI::DrawCheckBox("Static", meshComp.IsStatic);
+                changed |= LXUI::DrawLayerMask("Layers", meshComp.Layers);
+                if (changed)
+                    reg.patch<MeshComponent>(entity);
                 if (meshComp.Mesh.Get())
                 {
                     auto& submeshes = meshComp.Mesh->GetSubmeshes();
@@ -970,6 +1010,8 @@ namespace Lynx
                 }
                 
             });
+        // Self tables live in the Lua state, every scene needs its own instances
+        m_ComponentRegistry.SetCopyBySerialization("LuaScript");
 
         m_ComponentRegistry.RegisterCoreComponent<DirectionalLightComponent>("DirectionalLight",
             [](entt::registry& reg, entt::entity entity, nlohmann::json& json)
@@ -978,6 +1020,7 @@ namespace Lynx
                 json["Color"] = { light.Color.r, light.Color.g, light.Color.b };
                 json["Intensity"] = light.Intensity;
                 json["CastShadows"] = light.CastShadows;
+                json["ShadowCullingMask"] = light.ShadowCullingMask;
             },
             [](entt::registry& reg, entt::entity entity, const nlohmann::json& json)
             {
@@ -986,6 +1029,7 @@ namespace Lynx
                 light.Color = glm::vec3(color[0], color[1], color[2]);
                 light.Intensity = json["Intensity"];
                 light.CastShadows = json["CastShadows"];
+                if (json.contains("ShadowCullingMask")) light.ShadowCullingMask = json["ShadowCullingMask"];
             },
             [](entt::registry& reg, entt::entity entity)
             {
@@ -993,6 +1037,7 @@ namespace Lynx
                 LXUI::DrawColor3Control("Color", light.Color);
                 LXUI::DrawDragFloat("Intensity", light.Intensity, 0.1f, 0, 10000);
                 LXUI::DrawCheckBox("CastShadows", light.CastShadows);
+                LXUI::DrawLayerMask("Shadow Culling Mask", light.ShadowCullingMask);
             });
 
         m_ComponentRegistry.RegisterCoreComponent<ParticleEmitterComponent>("ParticleEmitter",
@@ -1004,6 +1049,7 @@ namespace Lynx
                 json["EmissionRate"] = comp.EmissionRate;
                 json["IsLooping"] = comp.IsLooping;
                 json["DepthSorting"] = comp.DepthSorting;
+                json["Layers"] = comp.Layers;
 
                 auto props = nlohmann::json::object();
                 props["Position"] = { comp.Properties.Position.x, comp.Properties.Position.y, comp.Properties.Position.z };
@@ -1029,6 +1075,7 @@ namespace Lynx
                 if (json.contains("EmissionRate")) comp.EmissionRate = json["EmissionRate"];
                 if (json.contains("IsLooping")) comp.IsLooping = json["IsLooping"];
                 if (json.contains("DepthSorting")) comp.DepthSorting = json["DepthSorting"];
+                if (json.contains("Layers")) comp.Layers = json["Layers"];
 
                 if (json.contains("Properties"))
                 {
@@ -1075,6 +1122,7 @@ namespace Lynx
                 }
 
                 LXUI::DrawCheckBox("Depth Sorting", comp.DepthSorting);
+                LXUI::DrawLayerMask("Layers", comp.Layers);
                 
                 ImGui::TableNextRow();
                 ImGui::TableNextColumn();
@@ -1098,6 +1146,56 @@ namespace Lynx
                     ImGui::TreePop();
                 }
             });
+        m_ComponentRegistry.RegisterCoreComponent<AnimatorComponent>("Animator",
+            [](entt::registry& reg, entt::entity entity, nlohmann::json& json)
+            {
+                auto& comp = reg.get<AnimatorComponent>(entity);
+                json["Mesh"] = comp.Mesh;
+                json["Clip"] = comp.Clip;
+                json["Speed"] = comp.Speed;
+                json["Loop"] = comp.Loop;
+                json["Playing"] = comp.Playing;
+                json["Layers"] = comp.Layers;
+            },
+            [](entt::registry& reg, entt::entity entity, const nlohmann::json& json)
+            {
+                auto& comp = reg.get_or_emplace<AnimatorComponent>(entity);
+                if (json.contains("Mesh")) comp.Mesh = json["Mesh"].get<AssetRef<SkeletalMesh>>();
+                if (json.contains("Clip")) comp.Clip = json["Clip"];
+                if (json.contains("Speed")) comp.Speed = json["Speed"];
+                if (json.contains("Loop")) comp.Loop = json["Loop"];
+                if (json.contains("Playing")) comp.Playing = json["Playing"];
+                if (json.contains("Layers")) comp.Layers = json["Layers"];
+            },
+            [](entt::registry& reg, entt::entity entity)
+            {
+                auto& comp = reg.get<AnimatorComponent>(entity);
+                if (LXUI::DrawAssetReference("Skeletal Mesh", comp.Mesh, {AssetType::SkeletalMesh}))
+                {
+                    comp.Clip.clear();
+                    comp.Palette.clear();
+                }
+
+                if (auto mesh = comp.Mesh.Get())
+                {
+                    std::vector<std::string> clips;
+                    int current = 0;
+                    for (const auto& animation : mesh->GetAnimations())
+                    {
+                        if (animation.GetName() == comp.Clip)
+                            current = (int)clips.size();
+                        clips.push_back(animation.GetName());
+                    }
+
+                    if (!clips.empty() && LXUI::DrawComboControl("Clip", current, clips))
+                        comp.Play(clips[current]);
+                }
+
+                LXUI::DrawDragFloat("Speed", comp.Speed, 0.05f, -10.0f, 10.0f);
+                LXUI::DrawCheckBox("Loop", comp.Loop);
+                LXUI::DrawCheckBox("Playing", comp.Playing);
+                LXUI::DrawLayerMask("Layers", comp.Layers);
+            });
         m_ComponentRegistry.RegisterCoreComponent<UICanvasComponent>("UICanvas",
             [](entt::registry& reg, entt::entity entity, nlohmann::json& json)
             {
@@ -1130,6 +1228,8 @@ namespace Lynx
                 LXUI::DrawDragInt("Sorting Order", comp.SortingOrder, 1, 0, 1000);
             }
         );
+        // The copy constructor shares the canvas
+        m_ComponentRegistry.SetCopyBySerialization("UICanvas");
         m_ComponentRegistry.RegisterCoreInternalOnlyComponent<PrefabComponent>("Prefab",
             [](entt::registry& reg, entt::entity entity, nlohmann::json& json)
             {
@@ -1187,5 +1287,230 @@ namespace Lynx
                 // TODO: Layer
             }
         );
+
+        // Tags, nothing to save besides being there
+        m_ComponentRegistry.RegisterCoreComponent<StreamedComponent>("Streamed",
+            [](entt::registry& reg, entt::entity entity, nlohmann::json& json) { json = nlohmann::json::object(); },
+            [](entt::registry& reg, entt::entity entity, const nlohmann::json& json) {});
+        m_ComponentRegistry.RegisterCoreComponent<StreamingSourceComponent>("StreamingSource",
+            [](entt::registry& reg, entt::entity entity, nlohmann::json& json) { json = nlohmann::json::object(); },
+            [](entt::registry& reg, entt::entity entity, const nlohmann::json& json) {});
+
+        // Pooled entities hold on to these, they own bodies and script instances that are expensive to rebuild
+        for (const char* name : { "RigidBody", "BoxCollider", "SphereCollider", "CapsuleCollider", "CharacterController", "NativeScript" })
+            m_ComponentRegistry.SetKeepWhenPooled(name);
+
+        // What nearly every entity has, these skip the json in binary scenes
+        m_ComponentRegistry.SetColumnCodec<TransformComponent>("Transform",
+            [](const TransformComponent& transform, BinaryScene::ColumnWriter& writer)
+            {
+                writer.Write(transform.Translation);
+                writer.Write(transform.Rotation);
+                writer.Write(transform.Scale);
+            },
+            [](BinaryScene::ColumnReader& reader, TransformComponent& transform)
+            {
+                return reader.Read(transform.Translation) && reader.Read(transform.Rotation) && reader.Read(transform.Scale);
+            });
+        m_ComponentRegistry.SetColumnCodec<TagComponent>("Tag",
+            [](const TagComponent& tag, BinaryScene::ColumnWriter& writer) { writer.WriteString(tag.Tag); },
+            [](BinaryScene::ColumnReader& reader, TagComponent& tag) { return reader.ReadString(tag.Tag); });
+        m_ComponentRegistry.SetColumnCodec<MeshComponent>("Mesh",
+            [](const MeshComponent& mesh, BinaryScene::ColumnWriter& writer)
+            {
+                writer.WriteAsset(mesh.Mesh.Handle);
+                writer.Write(mesh.IsStatic);
+                writer.Write(mesh.Layers);
+            },
+            [](BinaryScene::ColumnReader& reader, MeshComponent& mesh)
+            {
+                return reader.ReadAsset(mesh.Mesh.Handle) && reader.Read(mesh.IsStatic) && reader.Read(mesh.Layers);
+            });
+
+        // Plain data, same fields as their json. LuaScript and UICanvas have no codec and stay json values.
+        m_ComponentRegistry.SetColumnCodec<CameraComponent>("Camera",
+            [](const CameraComponent& comp, BinaryScene::ColumnWriter& writer)
+            {
+                writer.Write(comp.Camera.GetProjectionType());
+                writer.Write(comp.Camera.GetPerspectiveVerticalFOV());
+                writer.Write(comp.Camera.GetPerspectiveNearClip());
+                writer.Write(comp.Camera.GetPerspectiveFarClip());
+                writer.Write(comp.Camera.GetOrthographicSize());
+                writer.Write(comp.Camera.GetOrthographicNearClip());
+                writer.Write(comp.Camera.GetOrthographicFarClip());
+                writer.Write(comp.Primary);
+                writer.Write(comp.FixedAspectRatio);
+                writer.Write(comp.CullingMask);
+            },
+            [](BinaryScene::ColumnReader& reader, CameraComponent& comp)
+            {
+                SceneCamera::ProjectionType type;
+                float perspective[3], orthographic[3];
+                if (!reader.Read(type) || !reader.Read(perspective) || !reader.Read(orthographic)
+                    || !reader.Read(comp.Primary) || !reader.Read(comp.FixedAspectRatio) || !reader.Read(comp.CullingMask))
+                    return false;
+                // Both sets, the one that isn't active comes back when switching in the editor
+                comp.Camera.SetOrthographic(orthographic[0], orthographic[1], orthographic[2]);
+                comp.Camera.SetPerspective(perspective[0], perspective[1], perspective[2]);
+                comp.Camera.SetProjectionType(type);
+                return true;
+            });
+        m_ComponentRegistry.SetColumnCodec<DirectionalLightComponent>("DirectionalLight",
+            [](const DirectionalLightComponent& light, BinaryScene::ColumnWriter& writer)
+            {
+                writer.Write(light.Color);
+                writer.Write(light.Intensity);
+                writer.Write(light.CastShadows);
+                writer.Write(light.ShadowCullingMask);
+            },
+            [](BinaryScene::ColumnReader& reader, DirectionalLightComponent& light)
+            {
+                return reader.Read(light.Color) && reader.Read(light.Intensity) && reader.Read(light.CastShadows)
+                    && reader.Read(light.ShadowCullingMask);
+            });
+        // Bodies and characters get created at runtime start, the ids aren't saved
+        m_ComponentRegistry.SetColumnCodec<RigidBodyComponent>("RigidBody",
+            [](const RigidBodyComponent& comp, BinaryScene::ColumnWriter& writer)
+            {
+                writer.Write(comp.Type);
+                writer.Write(comp.Mass);
+                writer.Write(comp.Friction);
+                writer.Write(comp.Restitution);
+                writer.Write(comp.LinearDamping);
+                writer.Write(comp.AngularDamping);
+                writer.Write(comp.GravityFactor);
+                writer.Write(comp.MotionQuality);
+                writer.Write(comp.Layer);
+                writer.Write(comp.LockRotationX);
+                writer.Write(comp.LockRotationY);
+                writer.Write(comp.LockRotationZ);
+            },
+            [](BinaryScene::ColumnReader& reader, RigidBodyComponent& comp)
+            {
+                return reader.Read(comp.Type) && reader.Read(comp.Mass) && reader.Read(comp.Friction) && reader.Read(comp.Restitution)
+                    && reader.Read(comp.LinearDamping) && reader.Read(comp.AngularDamping) && reader.Read(comp.GravityFactor)
+                    && reader.Read(comp.MotionQuality) && reader.Read(comp.Layer) && reader.Read(comp.LockRotationX)
+                    && reader.Read(comp.LockRotationY) && reader.Read(comp.LockRotationZ);
+            });
+        m_ComponentRegistry.SetColumnCodec<BoxColliderComponent>("BoxCollider",
+            [](const BoxColliderComponent& comp, BinaryScene::ColumnWriter& writer)
+            {
+                writer.Write(comp.HalfSize);
+                writer.Write(comp.Offset);
+                writer.Write(comp.IsTrigger);
+            },
+            [](BinaryScene::ColumnReader& reader, BoxColliderComponent& comp)
+            {
+                return reader.Read(comp.HalfSize) && reader.Read(comp.Offset) && reader.Read(comp.IsTrigger);
+            });
+        m_ComponentRegistry.SetColumnCodec<SphereColliderComponent>("SphereCollider",
+            [](const SphereColliderComponent& comp, BinaryScene::ColumnWriter& writer)
+            {
+                writer.Write(comp.Radius);
+                writer.Write(comp.Offset);
+                writer.Write(comp.IsTrigger);
+            },
+            [](BinaryScene::ColumnReader& reader, SphereColliderComponent& comp)
+            {
+                return reader.Read(comp.Radius) && reader.Read(comp.Offset) && reader.Read(comp.IsTrigger);
+            });
+        m_ComponentRegistry.SetColumnCodec<CapsuleColliderComponent>("CapsuleCollider",
+            [](const CapsuleColliderComponent& comp, BinaryScene::ColumnWriter& writer)
+            {
+                writer.Write(comp.Radius);
+                writer.Write(comp.HalfHeight);
+                writer.Write(comp.Offset);
+                writer.Write(comp.IsTrigger);
+            },
+            [](BinaryScene::ColumnReader& reader, CapsuleColliderComponent& comp)
+            {
+                return reader.Read(comp.Radius) && reader.Read(comp.HalfHeight) && reader.Read(comp.Offset) && reader.Read(comp.IsTrigger);
+            });
+        m_ComponentRegistry.SetColumnCodec<CharacterControllerComponent>("CharacterController",
+            [](const CharacterControllerComponent& comp, BinaryScene::ColumnWriter& writer)
+            {
+                writer.Write(comp.CapsuleRadius);
+                writer.Write(comp.CapsuleHalfHeight);
+                writer.Write(comp.MaxSlopeAngle);
+                writer.Write(comp.Mass);
+                writer.Write(comp.MaxStrength);
+                writer.Write(comp.CharacterPadding);
+                writer.Write(comp.StepHeight);
+                writer.Write(comp.Gravity);
+                writer.Write(comp.Layer);
+            },
+            [](BinaryScene::ColumnReader& reader, CharacterControllerComponent& comp)
+            {
+                return reader.Read(comp.CapsuleRadius) && reader.Read(comp.CapsuleHalfHeight) && reader.Read(comp.MaxSlopeAngle)
+                    && reader.Read(comp.Mass) && reader.Read(comp.MaxStrength) && reader.Read(comp.CharacterPadding)
+                    && reader.Read(comp.StepHeight) && reader.Read(comp.Gravity) && reader.Read(comp.Layer);
+            });
+        m_ComponentRegistry.SetColumnCodec<NativeScriptComponent>("NativeScript",
+            [](const NativeScriptComponent& comp, BinaryScene::ColumnWriter& writer) { writer.WriteString(comp.ScriptName); },
+            [](BinaryScene::ColumnReader& reader, NativeScriptComponent& comp)
+            {
+                std::string scriptName;
+                if (!reader.ReadString(scriptName))
+                    return false;
+                if (!scriptName.empty())
+                    Engine::Get().GetComponentRegistry().BindScript(scriptName, comp);
+                return true;
+            });
+        m_ComponentRegistry.SetColumnCodec<ParticleEmitterComponent>("ParticleEmitter",
+            [](const ParticleEmitterComponent& comp, BinaryScene::ColumnWriter& writer)
+            {
+                writer.WriteAsset(comp.Material.Handle);
+                writer.Write(comp.MaxParticles);
+                writer.Write(comp.EmissionRate);
+                writer.Write(comp.IsLooping);
+                writer.Write(comp.DepthSorting);
+                writer.Write(comp.Layers);
+                writer.Write(comp.Properties);
+            },
+            [](BinaryScene::ColumnReader& reader, ParticleEmitterComponent& comp)
+            {
+                uint32_t maxParticles;
+                if (!reader.ReadAsset(comp.Material.Handle) || !reader.Read(maxParticles) || !reader.Read(comp.EmissionRate)
+                    || !reader.Read(comp.IsLooping) || !reader.Read(comp.DepthSorting) || !reader.Read(comp.Layers)
+                    || !reader.Read(comp.Properties))
+                    return false;
+                comp.SetMaxParticles(maxParticles);
+                return true;
+            });
+        m_ComponentRegistry.SetColumnCodec<AnimatorComponent>("Animator",
+            [](const AnimatorComponent& comp, BinaryScene::ColumnWriter& writer)
+            {
+                writer.WriteAsset(comp.Mesh.Handle);
+                writer.WriteString(comp.Clip);
+                writer.Write(comp.Speed);
+                writer.Write(comp.Loop);
+                writer.Write(comp.Playing);
+                writer.Write(comp.Layers);
+            },
+            [](BinaryScene::ColumnReader& reader, AnimatorComponent& comp)
+            {
+                return reader.ReadAsset(comp.Mesh.Handle) && reader.ReadString(comp.Clip) && reader.Read(comp.Speed)
+                    && reader.Read(comp.Loop) && reader.Read(comp.Playing) && reader.Read(comp.Layers);
+            });
+        m_ComponentRegistry.SetColumnCodec<PrefabComponent>("Prefab",
+            [](const PrefabComponent& comp, BinaryScene::ColumnWriter& writer)
+            {
+                writer.WriteAsset(comp.Prefab.Handle);
+                writer.Write((uint64_t)comp.SubEntityID);
+            },
+            [](BinaryScene::ColumnReader& reader, PrefabComponent& comp)
+            {
+                uint64_t subEntityID;
+                if (!reader.ReadAsset(comp.Prefab.Handle) || !reader.Read(subEntityID))
+                    return false;
+                comp.SubEntityID = UUID(subEntityID);
+                return true;
+            });
+        m_ComponentRegistry.SetColumnCodec<StreamedComponent>("Streamed",
+            [](const StreamedComponent&, BinaryScene::ColumnWriter&) {},
+            [](BinaryScene::ColumnReader&, StreamedComponent&) { return true; });
+        m_ComponentRegistry.SetColumnCodec<StreamingSourceComponent>("StreamingSource",
+            [](const StreamingSourceComponent&, BinaryScene::ColumnWriter&) {},
+            [](BinaryScene::ColumnReader&, StreamingSourceComponent&) { return true; });
     }
 }
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "TypeRegistry.h"
 #include "Window.h"
+#include "Core/JobSystem.h"
 #include "Asset/AssetManager.h"
 #include "Renderer/Renderer.h"
 #include "Event/Event.h"
@@ -28,11 +29,14 @@ namespace Lynx
         static Engine& Get() { return *s_Instance; }
         
         void Initialize(bool editorMode = false);
+        // Jobs, components and an empty asset registry, no window or renderer. For tests and benchmarks.
+        void InitializeHeadless();
         void Run(IGameModule* gameModule);
         void PreGameShutdown();
         void Shutdown();
 
         inline Window& GetWindow() { return *m_Window; }
+        JobSystem& GetJobSystem() { return *m_JobSystem; }
         AssetManager& GetAssetManager() { return *m_AssetManager; }
         AssetRegistry& GetAssetRegistry() { return *m_AssetRegistry; }
         Renderer& GetRenderer() { return *m_Renderer; }
@@ -83,6 +87,7 @@ namespace Lynx
     private:
         static Engine* s_Instance;
         
+        std::unique_ptr<JobSystem> m_JobSystem;
         std::unique_ptr<Window> m_Window;
         std::unique_ptr<Renderer> m_Renderer;
         std::unique_ptr<AssetManager> m_AssetManager;
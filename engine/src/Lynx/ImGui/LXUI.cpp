@@ -2,8 +2,10 @@
 
 #include <imgui.h>
 #include <imgui_internal.h>
+#include <bit>
 
 #include "Lynx/Engine.h"
+#include "Lynx/Renderer/RenderLayers.h"
 
 namespace Lynx
 {
@@ -364,6 +366,40 @@ namespace Lynx
         return changed;
     }
 
+    bool LXUI::DrawLayerMask(const std::string& label, uint32_t& mask)
+    {
+        DrawLabel(label);
+        std::string id = "##" + label;
+
+        std::string preview;
+        if (mask == RenderLayer::All)
+            preview = "Everything";
+        else if (mask == RenderLayer::None)
+            preview = "Nothing";
+        else if (std::popcount(mask) == 1)
+            preview = RenderLayer::GetName((uint32_t)std::countr_zero(mask));
+        else
+            preview = "Mixed";
+
+        bool changed = false;
+        if (ImGui::BeginCombo(id.c_str(), preview.c_str()))
+        {
+            for (uint32_t i = 0; i < RenderLayer::Count; i++)
+            {
+                uint32_t bit = 1u << i;
+                bool enabled = (mask & bit) != 0;
+                std::string name = RenderLayer::GetName(i);
+                if (ImGui::Checkbox(name.c_str(), &enabled))
+                {
+                    mask = enabled ? mask | bit : mask & ~bit;
+                    changed = true;
+                }
+            }
+            ImGui::EndCombo();
+        }
+        return changed;
+    }
+
     bool LXUI::DrawAssetReference(const std::string& label, AssetHandle& currentHandle, std::initializer_list<AssetType> allowedTypes)
     {
         DrawLabel(label);
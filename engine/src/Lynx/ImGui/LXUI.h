@@ -34,6 +34,7 @@ namespace Lynx
         static bool DrawVec4Control(const std::string& label, glm::vec4& value, float min = 0, float max = 0, float resetValue = 0.0f);
         
         static bool DrawComboControl(const std::string& label, int& currentItem, const std::vector<std::string>& items);
+        static bool DrawLayerMask(const std::string& label, uint32_t& mask);
         static bool DrawAssetReference(const std::string& label, AssetHandle& currentHandle, std::initializer_list<AssetType> allowedTypes);
         static void DrawLuaScriptSection(ScriptInstance& instance, Scene* context);
         
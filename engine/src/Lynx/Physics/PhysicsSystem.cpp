@@ -22,6 +22,9 @@ namespace Lynx
         registry.on_construct<SphereColliderComponent>().connect<&PhysicsSystem::OnSphereColliderAdded>(this);
         registry.on_construct<CapsuleColliderComponent>().connect<&PhysicsSystem::OnCapsuleColliderAdded>(this);
         registry.on_construct<MeshColliderComponent>().connect<&PhysicsSystem::OnMeshColliderAdded>(this);
+        
+        registry.on_construct<DisabledComponent>().connect<&PhysicsSystem::OnEntityDisabled>(this);
+        registry.on_destroy<DisabledComponent>().connect<&PhysicsSystem::OnEntityEnabled>(this);
     }
 
     void PhysicsSystem::OnSceneStart(Scene& scene)
@@ -53,6 +56,8 @@ namespace Lynx
         registry.on_construct<SphereColliderComponent>().disconnect(this);
         registry.on_construct<CapsuleColliderComponent>().disconnect(this);
         registry.on_construct<MeshColliderComponent>().disconnect(this);
+        registry.on_construct<DisabledComponent>().disconnect(this);
+        registry.on_destroy<DisabledComponent>().disconnect(this);
 
         m_Scene = nullptr;
     }
@@ -73,6 +78,8 @@ namespace Lynx
         }
         m_CharactersToDestroy.clear();
         
+        EnablePendingEntities(scene);
+        
         // Sync kinematic bodies TO physics
         SyncTransformsToPhysics(scene, fixedDeltaTime);
         
@@ -143,6 +150,56 @@ namespace Lynx
         //TryCreateRigidBody(*m_Scene, entity);
     }
 
+    void PhysicsSystem::OnEntityDisabled(entt::registry& registry, entt::entity entity)
+    {
+        std::erase(m_EntitiesToEnable, entity);
+        
+        if (auto* rb = registry.try_get<RigidBodyComponent>(entity); rb && rb->BodyId != INVALID_BODY)
+            m_Scene->GetPhysicsWorldChecked().RemoveBody(rb->BodyId);
+        if (auto* cc = registry.try_get<CharacterControllerComponent>(entity); cc && cc->CharacterId != INVALID_CHARACTER)
+            m_Scene->GetPhysicsWorldChecked().RemoveCharacter(cc->CharacterId);
+    }
+
+    void PhysicsSystem::OnEntityEnabled(entt::registry& registry, entt::entity entity)
+    {
+        if (registry.any_of<RigidBodyComponent, CharacterControllerComponent>(entity))
+            m_EntitiesToEnable.push_back(entity);
+    }
+
+    void PhysicsSystem::EnablePendingEntities(Scene& scene)
+    {
+        auto& registry = scene.Reg();
+        auto& physics = scene.GetPhysicsWorldChecked();
+        
+        // Deferred to here so a spawn can still place the entity after enabling it
+        for (entt::entity entity : m_EntitiesToEnable)
+        {
+            if (!registry.valid(entity) || registry.all_of<DisabledComponent>(entity))
+                continue;
+            
+            auto& transform = registry.get<TransformComponent>(entity);
+            if (auto* rb = registry.try_get<RigidBodyComponent>(entity); rb && rb->BodyId != INVALID_BODY)
+            {
+                physics.SetPositionAndRotation(rb->BodyId, transform.Translation, transform.Rotation, false);
+                if (rb->Type != BodyType::Static)
+                {
+                    physics.SetLinearVelocity(rb->BodyId, glm::vec3(0.0f));
+                    physics.SetAngularVelocity(rb->BodyId, glm::vec3(0.0f));
+                }
+                physics.AddBody(rb->BodyId);
+            }
+            
+            if (auto* cc = registry.try_get<CharacterControllerComponent>(entity); cc && cc->CharacterId != INVALID_CHARACTER)
+            {
+                physics.SetCharacterPosition(cc->CharacterId, transform.Translation);
+                physics.SetCharacterRotation(cc->CharacterId, transform.Rotation);
+                physics.SetCharacterLinearVelocity(cc->CharacterId, glm::vec3(0.0f));
+                physics.AddCharacter(cc->CharacterId);
+            }
+        }
+        m_EntitiesToEnable.clear();
+    }
+
     void PhysicsSystem::TryCreateRigidBody(Scene& scene, entt::entity entity)
     {
         auto& registry = scene.Reg();
@@ -217,6 +274,10 @@ namespace Lynx
         
         rb.BodyId = scene.GetPhysicsWorldChecked().CreateBody(desc);
         m_PendingRigidBodies.erase(entity);
+        
+        // Created while disabled (e.g. a pooled instance), it joins the simulation once it gets enabled
+        if (registry.all_of<DisabledComponent>(entity))
+            scene.GetPhysicsWorldChecked().RemoveBody(rb.BodyId);
     }
 
     void PhysicsSystem::CreateCharacterController(Scene& scene, entt::entity entity)
@@ -246,6 +307,8 @@ namespace Lynx
         //desc.PenetrationRecoverySpeed = 
         
         cc.CharacterId = scene.GetPhysicsWorldChecked().CreateCharacter(desc);
+        if (registry.all_of<DisabledComponent>(entity))
+            scene.GetPhysicsWorldChecked().RemoveCharacter(cc.CharacterId);
     }
 
     void PhysicsSystem::UpdateCharacters(Scene& scene, float fixedDt)
@@ -254,7 +317,7 @@ namespace Lynx
         auto& physics = scene.GetPhysicsWorldChecked();
         glm::vec3 gravity = physics.GetGravity();
         
-        auto view = registry.view<TransformComponent, CharacterControllerComponent>();
+        auto view = registry.view<TransformComponent, CharacterControllerComponent>(entt::exclude<DisabledComponent>);
         for (auto [entity, transform, cc] : view.each())
         {
             if (cc.CharacterId == INVALID_CHARACTER)
@@ -290,8 +353,8 @@ namespace Lynx
             cc.GroundNormal = physics.GetCharacterGroundNormal(cc.CharacterId);
             cc.GroundVelocity = physics.GetCharacterGroundVelocity(cc.CharacterId);
             
-            transform.Translation = physics.GetCharacterPosition(cc.CharacterId);
-            transform.Rotation = physics.GetCharacterRotation(cc.CharacterId);
+            transform.SetTranslation(physics.GetCharacterPosition(cc.CharacterId));
+            transform.SetRotation(physics.GetCharacterRotation(cc.CharacterId));
         }
     }
 
@@ -300,7 +363,7 @@ namespace Lynx
         auto& registry = scene.Reg();
         auto& physics = scene.GetPhysicsWorldChecked();
         
-        auto view = registry.view<TransformComponent, RigidBodyComponent>();
+        auto view = registry.view<TransformComponent, RigidBodyComponent>(entt::exclude<DisabledComponent>);
         for (auto [entity, transform, rb] : view.each())
         {
             if (rb.BodyId == INVALID_BODY)
@@ -327,7 +390,7 @@ namespace Lynx
         auto& registry = scene.Reg();
         auto& physics = scene.GetPhysicsWorldChecked();
         
-        auto view = registry.view<TransformComponent, RigidBodyComponent>();
+        auto view = registry.view<TransformComponent, RigidBodyComponent>(entt::exclude<DisabledComponent>);
         for (auto [entity, transform, rb] : view.each())
         {
             if (rb.BodyId == INVALID_BODY)
@@ -335,12 +398,12 @@ namespace Lynx
             
             if (rb.Type == BodyType::Dynamic)
             {
-                transform.Translation = physics.GetPosition(rb.BodyId);
-                transform.Rotation = physics.GetRotation(rb.BodyId);
+                transform.SetTranslation(physics.GetPosition(rb.BodyId));
+                transform.SetRotation(physics.GetRotation(rb.BodyId));
             }
         }
         
-        auto charView = registry.view<TransformComponent, CharacterControllerComponent>();
+        auto charView = registry.view<TransformComponent, CharacterControllerComponent>(entt::exclude<DisabledComponent>);
         for (auto [entity, transform, cc] : charView.each())
         {
             if (cc.CharacterId == INVALID_CHARACTER)
@@ -348,8 +411,8 @@ namespace Lynx
             
             // Note: Previous transform is saved in SavePhysicsState before the update
             
-            transform.Translation = physics.GetCharacterPosition(cc.CharacterId);
-            transform.Rotation = physics.GetCharacterRotation(cc.CharacterId);
+            transform.SetTranslation(physics.GetCharacterPosition(cc.CharacterId));
+            transform.SetRotation(physics.GetCharacterRotation(cc.CharacterId));
         }
     }
 
@@ -357,33 +420,41 @@ namespace Lynx
     {
         auto& physics = scene.GetPhysicsWorldChecked();
         
+        // Appended to the scene's event streams, readers pick them up in bulk instead of getting called per contact
+        auto& collisionEnter = scene.GetEventStream<CollisionEnterEvent>();
+        auto& triggerEnter = scene.GetEventStream<TriggerEnterEvent>();
         for (const CollisionEvent& event : physics.GetCollisionEnterEvents())
         {
             if (event.IsTrigger)
-                scene.Emit<TriggerEnterEvent>(event.EntityA, event.EntityB, event.ContactPoint, event.ContactNormal);
+                triggerEnter.Emplace(event.EntityA, event.EntityB, event.ContactPoint, event.ContactNormal);
             else
-                scene.Emit<CollisionEnterEvent>(event.EntityA, event.EntityB, event.ContactPoint, event.ContactNormal, event.PenetrationDepth);
+                collisionEnter.Emplace(event.EntityA, event.EntityB, event.ContactPoint, event.ContactNormal, event.PenetrationDepth);
         }
         
+        auto& collisionStay = scene.GetEventStream<CollisionStayEvent>();
+        auto& triggerStay = scene.GetEventStream<TriggerStayEvent>();
         for (const CollisionEvent& event : physics.GetCollisionStayEvents())
         {
             if (event.IsTrigger)
-                scene.Emit<TriggerStayEvent>(event.EntityA, event.EntityB);
+                triggerStay.Emplace(event.EntityA, event.EntityB);
             else
-                scene.Emit<CollisionStayEvent>(event.EntityA, event.EntityB, event.ContactPoint, event.ContactNormal, event.PenetrationDepth);
+                collisionStay.Emplace(event.EntityA, event.EntityB, event.ContactPoint, event.ContactNormal, event.PenetrationDepth);
         }
         
+        auto& collisionExit = scene.GetEventStream<CollisionExitEvent>();
+        auto& triggerExit = scene.GetEventStream<TriggerExitEvent>();
         for (const CollisionEvent& event : physics.GetCollisionExitEvents())
         {
             if (event.IsTrigger)
-                scene.Emit<TriggerExitEvent>(event.EntityA, event.EntityB);
+                triggerExit.Emplace(event.EntityA, event.EntityB);
             else
-                scene.Emit<CollisionExitEvent>(event.EntityA, event.EntityB);
+                collisionExit.Emplace(event.EntityA, event.EntityB);
         }
         
+        auto& characterCollisions = scene.GetEventStream<CharacterCollisionEvent>();
         for (const CharacterCollision& event : physics.GetCharacterCollisions()) 
         {
-            scene.Emit<CharacterCollisionEvent>(
+            characterCollisions.Emplace(
                 event.CharacterEntity,
                 event.OtherEntity,
                 event.ContactPoint,
@@ -31,10 +31,15 @@ namespace Lynx
         void OnCapsuleColliderAdded(entt::registry& registry, entt::entity entity);
         void OnMeshColliderAdded(entt::registry& registry, entt::entity entity);
         
+        // Disabled entities leave the simulation but keep their bodies
+        void OnEntityDisabled(entt::registry& registry, entt::entity entity);
+        void OnEntityEnabled(entt::registry& registry, entt::entity entity);
+        
         // Internal Helpers
         void TryCreateRigidBody(Scene& scene, entt::entity entity);
         void CreateCharacterController(Scene& scene, entt::entity entity);
         
+        void EnablePendingEntities(Scene& scene);
         void UpdateCharacters(Scene& scene, float fixedDt);
         void SyncTransformsToPhysics(Scene& scene, float fixedDeltaTime);
         void SyncTransformsFromPhysics(Scene& scene);
@@ -48,6 +53,9 @@ namespace Lynx
         std::vector<BodyId> m_BodiesToDestroy;
         std::vector<CharacterId> m_CharactersToDestroy;
         
+        // Re-enabled entities, their bodies get moved to the current transform and added back before the next step
+        std::vector<entt::entity> m_EntitiesToEnable;
+        
         Scene* m_Scene = nullptr;
     };
 
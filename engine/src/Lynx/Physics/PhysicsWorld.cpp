@@ -4,7 +4,8 @@
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
@@ -22,6 +23,8 @@
 #include <mutex>
 #include <Jolt/Physics/Character/CharacterBase.h>
 
+#include "Lynx/Engine.h"
+
 namespace
 {
     inline JPH::Vec3 ToJolt(const glm::vec3& v) { return {v.x, v.y, v.z}; }
@@ -252,13 +255,73 @@ namespace Lynx
         }
     };
     
+    // Runs Jolt's jobs on the engine workers instead of a second thread pool. Job bookkeeping is the same as
+    // Jolt's JobSystemThreadPool, barriers come from JobSystemWithBarrier.
+    class JoltJobSystemAdapter final : public JPH::JobSystemWithBarrier
+    {
+    public:
+        JoltJobSystemAdapter(Lynx::JobSystem& jobs, JPH::uint maxJobs, JPH::uint maxBarriers)
+            : JobSystemWithBarrier(maxBarriers), m_Jobs(jobs)
+        {
+            m_JobList.Init(maxJobs, maxJobs);
+        }
+
+        int GetMaxConcurrency() const override { return (int)m_Jobs.GetWorkerCount() + 1; }
+
+        JobHandle CreateJob(const char* name, JPH::ColorArg color, const JobFunction& function, JPH::uint32 numDependencies = 0) override
+        {
+            JPH::uint32 index;
+            while (true)
+            {
+                index = m_JobList.ConstructObject(name, color, this, function, numDependencies);
+                if (index != AvailableJobs::cInvalidObjectIndex)
+                    break;
+                // Out of jobs, wait for some to finish
+                std::this_thread::yield();
+            }
+
+            Job* job = &m_JobList.Get(index);
+            // Keep a reference, the job might be done before we return
+            JobHandle handle(job);
+            if (numDependencies == 0)
+                QueueJob(job);
+            return handle;
+        }
+
+        void QueueJob(Job* job) override
+        {
+            job->AddRef();
+            m_Jobs.Run([job]()
+            {
+                // Might already have run through a barrier wait, Execute only runs once
+                job->Execute();
+                job->Release();
+            });
+        }
+
+        void QueueJobs(Job** jobs, JPH::uint numJobs) override
+        {
+            for (JPH::uint i = 0; i < numJobs; i++)
+                QueueJob(jobs[i]);
+        }
+
+    protected:
+        void FreeJob(Job* job) override { m_JobList.DestructObject(job); }
+
+    private:
+        using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+
+        Lynx::JobSystem& m_Jobs;
+        AvailableJobs m_JobList;
+    };
+
     // --- Pimpl Implementation ---
     class JoltPhysicsImpl
     {
     public:
         // Jolt Systems
         std::unique_ptr<JPH::TempAllocatorImpl> TempAllocator;
-        std::unique_ptr<JPH::JobSystemThreadPool> JobSystem;
+        std::unique_ptr<JoltJobSystemAdapter> JobSystem;
         std::unique_ptr<JPH::PhysicsSystem> PhysicsSystem;
         
         // Layer Interfaces
@@ -275,6 +338,7 @@ namespace Lynx
         {
             std::unique_ptr<JPH::CharacterVirtual> Character;
             entt::entity Entity = entt::null;
+            bool Added = true;
         };
         
         std::unordered_map<CharacterId, CharacterData> Characters;
@@ -298,10 +362,10 @@ namespace Lynx
 
             // Allocators
             TempAllocator = std::make_unique<JPH::TempAllocatorImpl>(10 * 1024 * 1024);
-            JobSystem = std::make_unique<JPH::JobSystemThreadPool>(
+            JobSystem = std::make_unique<JoltJobSystemAdapter>(
+                Engine::Get().GetJobSystem(),
                 JPH::cMaxPhysicsJobs, 
-                JPH::cMaxPhysicsBarriers, 
-                static_cast<int>(std::thread::hardware_concurrency()) - 1
+                JPH::cMaxPhysicsBarriers
             );
             
             const uint32_t maxBodies = 65536;
@@ -441,10 +505,27 @@ namespace Lynx
     {
         auto& bodyInterface = m_Impl->PhysicsSystem->GetBodyInterface();
         JPH::BodyID joltId(id);
-        bodyInterface.RemoveBody(joltId);
+        if (bodyInterface.IsAdded(joltId))
+            bodyInterface.RemoveBody(joltId);
         bodyInterface.DestroyBody(joltId); // TODO: Is the way we handle ids correct??
     }
 
+    void PhysicsWorld::AddBody(BodyId id, bool activate)
+    {
+        auto& bodyInterface = m_Impl->PhysicsSystem->GetBodyInterface();
+        JPH::BodyID joltId(id);
+        if (!bodyInterface.IsAdded(joltId))
+            bodyInterface.AddBody(joltId, activate ? JPH::EActivation::Activate : JPH::EActivation::DontActivate);
+    }
+
+    void PhysicsWorld::RemoveBody(BodyId id)
+    {
+        auto& bodyInterface = m_Impl->PhysicsSystem->GetBodyInterface();
+        JPH::BodyID joltId(id);
+        if (bodyInterface.IsAdded(joltId))
+            bodyInterface.RemoveBody(joltId);
+    }
+
     bool PhysicsWorld::IsValidBody(BodyId id) const
     {
         auto& bodyInterface = m_Impl->PhysicsSystem->GetBodyInterface();
@@ -630,6 +711,29 @@ namespace Lynx
         return m_Impl->Characters.contains(id);
     }
 
+    void PhysicsWorld::AddCharacter(CharacterId id)
+    {
+        auto it = m_Impl->Characters.find(id);
+        if (it == m_Impl->Characters.end() || it->second.Added)
+            return;
+        
+        it->second.Added = true;
+        
+        // Contacts are from wherever it was removed, get them for the current position
+        JPH::BroadPhaseLayerFilter broadPhaseLayerFilter;
+        JPH::ObjectLayerFilter objectLayerFilter;
+        JPH::BodyFilter bodyFilter;
+        JPH::ShapeFilter shapeFilter;
+        it->second.Character->RefreshContacts(broadPhaseLayerFilter, objectLayerFilter, bodyFilter, shapeFilter, *m_Impl->TempAllocator);
+    }
+
+    void PhysicsWorld::RemoveCharacter(CharacterId id)
+    {
+        auto it = m_Impl->Characters.find(id);
+        if (it != m_Impl->Characters.end())
+            it->second.Added = false;
+    }
+
     glm::vec3 PhysicsWorld::GetCharacterPosition(CharacterId id) const
     {
         auto it = m_Impl->Characters.find(id);
@@ -726,7 +830,7 @@ namespace Lynx
     void PhysicsWorld::UpdateCharacter(CharacterId id, float deltaTime, const glm::vec3& desiredVelocity)
     {
         auto it = m_Impl->Characters.find(id);
-        if (it == m_Impl->Characters.end()) 
+        if (it == m_Impl->Characters.end() || !it->second.Added) 
             return;
         
         auto* character = it->second.Character.get();
@@ -21,6 +21,9 @@ namespace Lynx
         BodyId CreateBody(const BodyDescriptor& desc);
         void DestroyBody(BodyId id);
         bool IsValidBody(BodyId id) const;
+        // Takes the body out of the simulation without destroying it, AddBody puts it back (used for pooled entities)
+        void AddBody(BodyId id, bool activate = true);
+        void RemoveBody(BodyId id);
         
         // --- Getters ---
         glm::vec3 GetPosition(BodyId id) const;
@@ -57,6 +60,9 @@ namespace Lynx
         CharacterId CreateCharacter(const CharacterDescriptor& desc);
         void DestroyCharacter(CharacterId id);
         bool IsValidCharacter(CharacterId id) const;
+        // Same as for bodies, a removed character keeps its state but doesn't move or collide until it's added back
+        void AddCharacter(CharacterId id);
+        void RemoveCharacter(CharacterId id);
         
         // --- Character Getters ---
         glm::vec3 GetCharacterPosition(CharacterId id) const;
@@ -3,173 +3,152 @@
 #include <algorithm>
 #include <glm/gtc/constants.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
 namespace Lynx
 {
-    std::vector<DebugLine> DebugRenderer::s_Lines;
-    
+    std::vector<DebugShape> DebugRenderer::s_Shapes;
+    std::vector<std::shared_ptr<DebugRenderer::ThreadBuffer>> DebugRenderer::s_ThreadBuffers;
+    std::mutex DebugRenderer::s_ThreadBuffersMutex;
+
+    namespace Helpers
+    {
+        // Any basis with z along dir, primitives are symmetric around z so the rest doesn't matter
+        static glm::mat3 BasisFromDirection(const glm::vec3& dir)
+        {
+            glm::vec3 z = glm::normalize(dir);
+            glm::vec3 up = std::abs(z.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+            glm::vec3 x = glm::normalize(glm::cross(up, z));
+            glm::vec3 y = glm::cross(z, x);
+            return glm::mat3(x, y, z);
+        }
+    }
+
+    void DebugRenderer::DrawPrimitive(DebugPrimitive primitive, const glm::mat4& transform, const glm::vec4& color, float duration)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.Mutex);
+        buffer.Shapes.push_back({ transform, color, primitive, duration });
+    }
+
     void DebugRenderer::DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color, float duration)
     {
-        s_Lines.push_back(DebugLine(start, end, color, duration));
+        // Unit line only has z, so x/y columns don't matter
+        glm::mat4 transform(1.0f);
+        transform[2] = glm::vec4(end - start, 0.0f);
+        transform[3] = glm::vec4(start, 1.0f);
+        DrawPrimitive(DebugPrimitive::Line, transform, color, duration);
+    }
+
+    void DebugRenderer::DrawArrow(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color, float headSize, float duration)
+    {
+        glm::vec3 dir = end - start;
+        float length = glm::length(dir);
+        if (length <= 0.0f)
+            return;
+
+        float headLength = std::min(headSize, length * 0.5f);
+        glm::vec3 headStart = end - dir / length * headLength;
+        DrawLine(start, headStart, color, duration);
+
+        glm::mat3 basis = Helpers::BasisFromDirection(dir);
+        glm::mat4 transform = glm::mat4(basis);
+        transform[0] *= headLength * 0.4f;
+        transform[1] *= headLength * 0.4f;
+        transform[2] *= headLength;
+        transform[3] = glm::vec4(headStart, 1.0f);
+        DrawPrimitive(DebugPrimitive::Cone, transform, color, duration);
     }
 
     void DebugRenderer::DrawBox(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color, float duration)
     {
-        // 12 Lines for an AABB
-        glm::vec3 p0 = { min.x, min.y, min.z };
-        glm::vec3 p1 = { max.x, min.y, min.z };
-        glm::vec3 p2 = { max.x, min.y, max.z };
-        glm::vec3 p3 = { min.x, min.y, max.z };
-
-        glm::vec3 p4 = { min.x, max.y, min.z };
-        glm::vec3 p5 = { max.x, max.y, min.z };
-        glm::vec3 p6 = { max.x, max.y, max.z };
-        glm::vec3 p7 = { min.x, max.y, max.z };
-
-        // Bottom
-        DrawLine(p0, p1, color); DrawLine(p1, p2, color, duration);
-        DrawLine(p2, p3, color); DrawLine(p3, p0, color, duration);
-
-        // Top
-        DrawLine(p4, p5, color); DrawLine(p5, p6, color, duration);
-        DrawLine(p6, p7, color); DrawLine(p7, p4, color, duration);
-
-        // Pillars
-        DrawLine(p0, p4, color); DrawLine(p1, p5, color, duration);
-        DrawLine(p2, p6, color); DrawLine(p3, p7, color, duration);
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), (min + max) * 0.5f) * glm::scale(glm::mat4(1.0f), max - min);
+        DrawPrimitive(DebugPrimitive::Box, transform, color, duration);
     }
 
     void DebugRenderer::DrawBox(const glm::mat4& transform, const glm::vec4& color, float duration)
     {
-        // Unit Cube corners (-0.5 to 0.5) transformed
-        glm::vec3 corners[8] = {
-            { -0.5f, -0.5f, -0.5f }, {  0.5f, -0.5f, -0.5f },
-            {  0.5f, -0.5f,  0.5f }, { -0.5f, -0.5f,  0.5f },
-            { -0.5f,  0.5f, -0.5f }, {  0.5f,  0.5f, -0.5f },
-            {  0.5f,  0.5f,  0.5f }, { -0.5f,  0.5f,  0.5f }
-        };
-
-        for (int i = 0; i < 8; i++)
-            corners[i] = glm::vec3(transform * glm::vec4(corners[i], 1.0f));
-
-        // Bottom
-        DrawLine(corners[0], corners[1], color); DrawLine(corners[1], corners[2], color, duration);
-        DrawLine(corners[2], corners[3], color); DrawLine(corners[3], corners[0], color, duration);
-        // Top
-        DrawLine(corners[4], corners[5], color); DrawLine(corners[5], corners[6], color, duration);
-        DrawLine(corners[6], corners[7], color); DrawLine(corners[7], corners[4], color, duration);
-        // Vertical
-        DrawLine(corners[0], corners[4], color); DrawLine(corners[1], corners[5], color, duration);
-        DrawLine(corners[2], corners[6], color); DrawLine(corners[3], corners[7], color, duration);
+        DrawPrimitive(DebugPrimitive::Box, transform, color, duration);
     }
 
     void DebugRenderer::DrawSphere(const glm::vec3& center, float radius, const glm::vec4& color, float duration)
     {
-        // Draw 3 circles (XY, XZ, YZ planes)
-        const int segments = 24;
-        const float step = glm::two_pi<float>() / segments;
-
-        for (int i = 0; i < segments; i++)
-        {
-            float theta1 = i * step;
-            float theta2 = (i + 1) * step;
-
-            float s1 = sin(theta1) * radius;
-            float c1 = cos(theta1) * radius;
-            float s2 = sin(theta2) * radius;
-            float c2 = cos(theta2) * radius;
-
-            // XY Plane
-            DrawLine(center + glm::vec3(c1, s1, 0), center + glm::vec3(c2, s2, 0), color, duration);
-            // XZ Plane
-            DrawLine(center + glm::vec3(c1, 0, s1), center + glm::vec3(c2, 0, s2), color, duration);
-            // YZ Plane
-            DrawLine(center + glm::vec3(0, c1, s1), center + glm::vec3(0, c2, s2), color, duration);
-        }
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), center) * glm::scale(glm::mat4(1.0f), glm::vec3(radius));
+        DrawPrimitive(DebugPrimitive::Sphere, transform, color, duration);
     }
 
     void DebugRenderer::DrawCapsule(const glm::vec3& center, float radius, float halfHeight, const glm::quat& rotation, const glm::vec4& color, float duration)
     {
-        const int segments = 16;
-        const float step = glm::pi<float>() / segments;
-        
-       // float realHalfHeight = std::max(halfHeight - radius, 0.0f);
-        float realHalfHeight = halfHeight;
-
+        // Hemispheres can't be scaled along with the body, so a capsule is three instances
+        glm::mat4 rotationMat = glm::mat4_cast(rotation);
         glm::vec3 up = rotation * glm::vec3(0, 1, 0);
-        glm::vec3 right = rotation * glm::vec3(1, 0, 0);
-        glm::vec3 forward = rotation * glm::vec3(0, 0, 1);
-
-        glm::vec3 topCenter = center + up * realHalfHeight;
-        glm::vec3 bottomCenter = center - up * realHalfHeight;
-
-        // Draw 4 vertical lines (The Cylinder part)
-        DrawLine(topCenter + right * radius, bottomCenter + right * radius, color, duration);
-        DrawLine(topCenter - right * radius, bottomCenter - right * radius, color, duration);
-        DrawLine(topCenter + forward * radius, bottomCenter + forward * radius, color, duration);
-        DrawLine(topCenter - forward * radius, bottomCenter - forward * radius, color, duration);
 
-        // Draw Top and Bottom Circles
-        const float circleStep = glm::two_pi<float>() / segments;
-        for (int i = 0; i < segments; i++)
-        {
-            float t1 = i * circleStep;
-            float t2 = (i + 1) * circleStep;
+        glm::mat4 body = glm::translate(glm::mat4(1.0f), center) * rotationMat * glm::scale(glm::mat4(1.0f), glm::vec3(radius, halfHeight, radius));
+        DrawPrimitive(DebugPrimitive::Cylinder, body, color, duration);
 
-            glm::vec3 p1 = right * cos(t1) * radius + forward * sin(t1) * radius;
-            glm::vec3 p2 = right * cos(t2) * radius + forward * sin(t2) * radius;
+        glm::mat4 capScale = glm::scale(glm::mat4(1.0f), glm::vec3(radius));
+        glm::mat4 top = glm::translate(glm::mat4(1.0f), center + up * halfHeight) * rotationMat * capScale;
+        DrawPrimitive(DebugPrimitive::Hemisphere, top, color, duration);
 
-            DrawLine(topCenter + p1, topCenter + p2, color, duration);
-            DrawLine(bottomCenter + p1, bottomCenter + p2, color, duration);
-        }
+        glm::mat4 flip = glm::rotate(glm::mat4(1.0f), glm::pi<float>(), glm::vec3(1, 0, 0));
+        glm::mat4 bottom = glm::translate(glm::mat4(1.0f), center - up * halfHeight) * rotationMat * flip * capScale;
+        DrawPrimitive(DebugPrimitive::Hemisphere, bottom, color, duration);
+    }
 
-        // Draw Arcs (The Hemispheres)
-        for (int i = 0; i < segments; i++)
+    DebugRenderer::ThreadBuffer& DebugRenderer::GetThreadBuffer()
+    {
+        thread_local std::shared_ptr<ThreadBuffer> buffer;
+        if (!buffer)
         {
-            float t1 = i * step;
-            float t2 = (i + 1) * step;
-
-            // XY arc
-            DrawLine(topCenter + (right * cos(t1) + up * sin(t1)) * radius,
-                     topCenter + (right * cos(t2) + up * sin(t2)) * radius, color, duration);
-            DrawLine(bottomCenter + (right * cos(t1) - up * sin(t1)) * radius,
-                     bottomCenter + (right * cos(t2) - up * sin(t2)) * radius, color, duration);
-
-            // ZY arc
-            DrawLine(topCenter + (forward * cos(t1) + up * sin(t1)) * radius,
-                     topCenter + (forward * cos(t2) + up * sin(t2)) * radius, color, duration);
-            DrawLine(bottomCenter + (forward * cos(t1) - up * sin(t1)) * radius,
-                     bottomCenter + (forward * cos(t2) - up * sin(t2)) * radius, color, duration);
+            buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(s_ThreadBuffersMutex);
+            s_ThreadBuffers.push_back(buffer);
         }
+        return *buffer;
     }
 
-    void DebugRenderer::EndFrame(float deltaTime)
+    const std::vector<DebugShape>& DebugRenderer::Collect(float deltaTime)
     {
-        if (s_Lines.empty())
-            return;
-        
-        auto it = std::remove_if(s_Lines.begin(), s_Lines.end(), [deltaTime](DebugLine& line)
+        // Everything in here was drawn last frame, keep only what still has time left
+        auto it = std::remove_if(s_Shapes.begin(), s_Shapes.end(), [deltaTime](DebugShape& shape)
         {
-            if (line.LifeTime <= 0.0f)
-            {
+            if (shape.LifeTime <= 0.0f)
                 return true;
-            }
-            else
+
+            shape.LifeTime -= deltaTime;
+            return shape.LifeTime <= 0.0f;
+        });
+        s_Shapes.erase(it, s_Shapes.end());
+
+        std::lock_guard<std::mutex> lock(s_ThreadBuffersMutex);
+        for (auto bufferIt = s_ThreadBuffers.begin(); bufferIt != s_ThreadBuffers.end();)
+        {
+            auto& buffer = *bufferIt;
             {
-                line.LifeTime -= deltaTime;
-                return line.LifeTime <= 0.0f;
+                std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+                s_Shapes.insert(s_Shapes.end(), buffer->Shapes.begin(), buffer->Shapes.end());
+                buffer->Shapes.clear();
             }
-        });
-        
-        s_Lines.erase(it, s_Lines.end());
-    }
 
-    const std::vector<DebugLine>& DebugRenderer::GetLines()
-    {
-        return s_Lines;
+            // Owning thread is gone
+            if (buffer.use_count() == 1)
+                bufferIt = s_ThreadBuffers.erase(bufferIt);
+            else
+                ++bufferIt;
+        }
+
+        return s_Shapes;
     }
 
     void DebugRenderer::Clear()
     {
-        s_Lines.clear();
+        s_Shapes.clear();
+
+        std::lock_guard<std::mutex> lock(s_ThreadBuffersMutex);
+        for (auto& buffer : s_ThreadBuffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+            buffer->Shapes.clear();
+        }
     }
 }
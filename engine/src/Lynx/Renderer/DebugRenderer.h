@@ -1,36 +1,63 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <mutex>
 
 namespace Lynx
 {
-    struct DebugLine
+    // Unit primitives the DebugPass has geometry for. Every shape is drawn as an instance of one of these.
+    enum class DebugPrimitive : uint8_t
     {
-        glm::vec3 Start;
-        glm::vec3 End;
+        Line = 0,   // (0,0,0) -> (0,0,1)
+        Box,        // -0.5..0.5
+        Sphere,     // Radius 1, three great circles
+        Cylinder,   // Radius 1, y from -1 to 1
+        Hemisphere, // Radius 1, y >= 0
+        Cone,       // Base radius 1 at z=0, tip at z=1
+        Count
+    };
+
+    struct DebugShape
+    {
+        glm::mat4 Transform;
         glm::vec4 Color;
+        DebugPrimitive Primitive = DebugPrimitive::Line;
         float LifeTime = 0.0f;
     };
-    
+
+    // Can be called from any thread, each thread submits into its own buffer.
     class LX_API DebugRenderer
     {
     public:
         static void DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), float duration = 0.0f);
+        static void DrawArrow(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), float headSize = 0.25f, float duration = 0.0f);
         static void DrawBox(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), float duration = 0.0f);
         static void DrawBox(const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), float duration = 0.0f);
         static void DrawSphere(const glm::vec3& center, float radius, const glm::vec4& color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), float duration = 0.0f);
         static void DrawCapsule(const glm::vec3& center, float radius, float halfHeight, const glm::quat& rotation, const glm::vec4& color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), float duration = 0.0f);
 
+        static void DrawPrimitive(DebugPrimitive primitive, const glm::mat4& transform, const glm::vec4& color, float duration = 0.0f);
+
     private:
-        static void EndFrame(float deltaTime);
-        static const std::vector<DebugLine>& GetLines();
+        struct ThreadBuffer
+        {
+            std::mutex Mutex;
+            std::vector<DebugShape> Shapes;
+        };
+
+        static ThreadBuffer& GetThreadBuffer();
+
+        // Ages shapes from the last frame and gathers everything submitted since. Main thread only.
+        static const std::vector<DebugShape>& Collect(float deltaTime);
         static void Clear();
 
     private:
-        static std::vector<DebugLine> s_Lines;
+        static std::vector<DebugShape> s_Shapes;
+        static std::vector<std::shared_ptr<ThreadBuffer>> s_ThreadBuffers;
+        static std::mutex s_ThreadBuffersMutex;
         friend class DebugPass;
         friend class Engine;
     };
-    
-}
 
+}
 
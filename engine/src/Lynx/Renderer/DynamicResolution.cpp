@@ -0,0 +1,65 @@
+#include "DynamicResolution.h"
+
+#include <glm/glm.hpp>
+
+namespace Lynx
+{
+    bool DynamicResolution::Update(float gpuFrameTime)
+    {
+        float minScale = std::clamp(m_Settings.MinScale, 0.1f, 1.0f);
+        float maxScale = std::clamp(m_Settings.MaxScale, minScale, 1.0f);
+
+        if (!m_Settings.Enabled)
+        {
+            if (m_Scale == 1.0f)
+                return false;
+
+            Reset();
+            return true;
+        }
+
+        if (gpuFrameTime <= 0.0f)
+            return false;
+
+        // Smooth out spikes, single slow frames shouldn't drop the resolution
+        if (m_SmoothedFrameTime <= 0.0f)
+            m_SmoothedFrameTime = gpuFrameTime;
+        else
+            m_SmoothedFrameTime = glm::mix(m_SmoothedFrameTime, gpuFrameTime, 0.1f);
+
+        m_FramesSinceChange++;
+        if (m_FramesSinceChange < m_Settings.CooldownFrames)
+            return false;
+
+        float target = std::max(m_Settings.TargetFrameTime, 0.1f);
+        float upper = target * (1.0f + m_Settings.Hysteresis);
+        float lower = target * (1.0f - m_Settings.Hysteresis);
+
+        float desired = std::clamp(m_Scale, minScale, maxScale);
+        if (m_SmoothedFrameTime > upper || m_SmoothedFrameTime < lower)
+        {
+            // Cost scales roughly with pixel count, so with scale squared
+            desired = m_Scale * std::sqrt(target / m_SmoothedFrameTime);
+        }
+
+        if (m_Settings.ScaleStep > 0.0f)
+            desired = std::round(desired / m_Settings.ScaleStep) * m_Settings.ScaleStep;
+        desired = std::clamp(desired, minScale, maxScale);
+
+        if (std::abs(desired - m_Scale) < 0.001f)
+            return false;
+
+        m_Scale = desired;
+        m_FramesSinceChange = 0;
+        // Old measurements were taken at the previous scale
+        m_SmoothedFrameTime = 0.0f;
+        return true;
+    }
+
+    void DynamicResolution::Reset()
+    {
+        m_Scale = 1.0f;
+        m_SmoothedFrameTime = 0.0f;
+        m_FramesSinceChange = 0;
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Lynx/Core.h"
+
+namespace Lynx
+{
+    struct DynamicResolutionSettings
+    {
+        bool Enabled = false;
+        float MinScale = 0.5f;
+        float MaxScale = 1.0f;
+        float TargetFrameTime = 16.6f; // ms
+        float Hysteresis = 0.1f; // Fraction of the target we tolerate before changing scale
+        float ScaleStep = 0.05f; // Scale gets quantized to this, keeps target reallocations rare
+        uint32_t CooldownFrames = 30;
+    };
+
+    class LX_API DynamicResolution
+    {
+    public:
+        // Feed the last measured GPU frame time. Returns true if the scale changed.
+        bool Update(float gpuFrameTime);
+        void Reset();
+
+        float GetScale() const { return m_Scale; }
+        float GetSmoothedFrameTime() const { return m_SmoothedFrameTime; }
+
+        DynamicResolutionSettings& GetSettings() { return m_Settings; }
+        const DynamicResolutionSettings& GetSettings() const { return m_Settings; }
+
+    private:
+        DynamicResolutionSettings m_Settings;
+        float m_Scale = 1.0f;
+        float m_SmoothedFrameTime = 0.0f;
+        uint32_t m_FramesSinceChange = 0;
+    };
+}
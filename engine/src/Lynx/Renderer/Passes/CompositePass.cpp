@@ -59,9 +59,10 @@ namespace Lynx
 
             nvrhi::TextureHandle bloom = renderData.BloomTexture ? renderData.BloomTexture : ctx.BlackTexture;
             
+            // Scene color can be smaller than the target (dynamic resolution), bilinear does the upscale
             auto bsDesc = nvrhi::BindingSetDesc()
                 .addItem(nvrhi::BindingSetItem::Texture_SRV(0, renderData.SceneColorInput))
-                .addItem(nvrhi::BindingSetItem::Sampler(1, SamplerCache::Get()->GetSampler(SamplerSettings())))
+                .addItem(nvrhi::BindingSetItem::Sampler(1, SamplerCache::Get()->GetSampler(SamplerSettings{TextureWrap::Clamp, TextureFilter::Bilinear})))
                 .addItem(nvrhi::BindingSetItem::Texture_SRV(2, bloom))
                 .addItem(nvrhi::BindingSetItem::PushConstants(0, sizeof(CompositePushData)));
             m_BindingSet = ctx.Device->createBindingSet(bsDesc, m_BindingLayout);
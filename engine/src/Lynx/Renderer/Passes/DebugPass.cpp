@@ -1,34 +1,39 @@
 #include "DebugPass.h"
 
-#include "Lynx/Renderer/DebugRenderer.h"
+#include <glm/gtc/constants.hpp>
+
 #include "Lynx/Engine.h"
 #include "Lynx/Asset/Shader.h"
 
 namespace Lynx
 {
+    namespace Helpers
+    {
+        static void AddCircle(std::vector<glm::vec3>& out, const glm::vec3& center, const glm::vec3& axisA, const glm::vec3& axisB, float arc, int segments)
+        {
+            const float step = arc / segments;
+            for (int i = 0; i < segments; i++)
+            {
+                float t1 = i * step;
+                float t2 = (i + 1) * step;
+                out.push_back(center + axisA * cos(t1) + axisB * sin(t1));
+                out.push_back(center + axisA * cos(t2) + axisB * sin(t2));
+            }
+        }
+    }
+
     void DebugPass::Init(RenderContext& ctx)
     {
         // 1. Create Layout
         auto layoutDesc = nvrhi::BindingLayoutDesc()
             .setVisibility(nvrhi::ShaderType::All)
             .addItem(nvrhi::BindingLayoutItem::ConstantBuffer(0))
+            .addItem(nvrhi::BindingLayoutItem::StructuredBuffer_SRV(1))
             .setBindingOffsets({0, 0, 0, 0});
         m_BindingLayout = ctx.Device->createBindingLayout(layoutDesc);
 
-        // 2. Create Binding Set (Scene UBO)
-        auto bsDesc = nvrhi::BindingSetDesc()
-            .addItem(nvrhi::BindingSetItem::ConstantBuffer(0, ctx.GlobalConstantBuffer));
-        m_BindingSet = ctx.Device->createBindingSet(bsDesc, m_BindingLayout);
-
-        // 5. Create Dynamic Vertex Buffer (Start small, resize if needed)
-        nvrhi::BufferDesc vbDesc;
-        vbDesc.byteSize = 10000 * sizeof(LineVertex); // ~10k lines capacity
-        vbDesc.isVertexBuffer = true;
-        vbDesc.debugName = "DebugLineVB";
-        vbDesc.canHaveUAVs = false;
-        vbDesc.setInitialState(nvrhi::ResourceStates::VertexBuffer);
-        vbDesc.keepInitialState = true;
-        m_VertexBuffer = ctx.Device->createBuffer(vbDesc);
+        // 2. Unit primitive geometry, every debug shape is an instance of one of these
+        CreateGeometry(ctx);
 
         m_PipelineState.SetPath("engine/resources/Shaders/DebugLine.glsl");
         m_PipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
@@ -36,7 +41,90 @@ namespace Lynx
             this->CreatePipeline(ctx, shader);
         });
     }
-    
+
+    void DebugPass::CreateGeometry(RenderContext& ctx)
+    {
+        const glm::vec3 x(1, 0, 0);
+        const glm::vec3 y(0, 1, 0);
+        const glm::vec3 z(0, 0, 1);
+        const float pi = glm::pi<float>();
+        const float twoPi = glm::two_pi<float>();
+
+        std::vector<glm::vec3> vertices;
+        auto begin = [&](DebugPrimitive primitive) { m_Primitives[(size_t)primitive].StartVertex = (uint32_t)vertices.size(); };
+        auto end = [&](DebugPrimitive primitive)
+        {
+            auto& range = m_Primitives[(size_t)primitive];
+            range.VertexCount = (uint32_t)vertices.size() - range.StartVertex;
+        };
+
+        begin(DebugPrimitive::Line);
+        vertices.push_back(glm::vec3(0.0f));
+        vertices.push_back(z);
+        end(DebugPrimitive::Line);
+
+        begin(DebugPrimitive::Box);
+        {
+            glm::vec3 c[8] = {
+                { -0.5f, -0.5f, -0.5f }, {  0.5f, -0.5f, -0.5f },
+                {  0.5f, -0.5f,  0.5f }, { -0.5f, -0.5f,  0.5f },
+                { -0.5f,  0.5f, -0.5f }, {  0.5f,  0.5f, -0.5f },
+                {  0.5f,  0.5f,  0.5f }, { -0.5f,  0.5f,  0.5f }
+            };
+            int edges[12][2] = { {0,1},{1,2},{2,3},{3,0}, {4,5},{5,6},{6,7},{7,4}, {0,4},{1,5},{2,6},{3,7} };
+            for (auto& edge : edges)
+            {
+                vertices.push_back(c[edge[0]]);
+                vertices.push_back(c[edge[1]]);
+            }
+        }
+        end(DebugPrimitive::Box);
+
+        begin(DebugPrimitive::Sphere);
+        Helpers::AddCircle(vertices, glm::vec3(0.0f), x, y, twoPi, 24);
+        Helpers::AddCircle(vertices, glm::vec3(0.0f), x, z, twoPi, 24);
+        Helpers::AddCircle(vertices, glm::vec3(0.0f), y, z, twoPi, 24);
+        end(DebugPrimitive::Sphere);
+
+        begin(DebugPrimitive::Cylinder);
+        Helpers::AddCircle(vertices, y, x, z, twoPi, 16);
+        Helpers::AddCircle(vertices, -y, x, z, twoPi, 16);
+        for (const glm::vec3& side : { x, -x, z, -z })
+        {
+            vertices.push_back(side + y);
+            vertices.push_back(side - y);
+        }
+        end(DebugPrimitive::Cylinder);
+
+        begin(DebugPrimitive::Hemisphere);
+        Helpers::AddCircle(vertices, glm::vec3(0.0f), x, y, pi, 16);
+        Helpers::AddCircle(vertices, glm::vec3(0.0f), z, y, pi, 16);
+        end(DebugPrimitive::Hemisphere);
+
+        begin(DebugPrimitive::Cone);
+        Helpers::AddCircle(vertices, glm::vec3(0.0f), x, y, twoPi, 12);
+        for (const glm::vec3& side : { x, -x, y, -y })
+        {
+            vertices.push_back(side);
+            vertices.push_back(z);
+        }
+        end(DebugPrimitive::Cone);
+
+        auto vbDesc = nvrhi::BufferDesc()
+            .setByteSize(vertices.size() * sizeof(glm::vec3))
+            .setIsVertexBuffer(true)
+            .setDebugName("DebugPrimitiveVB")
+            .setInitialState(nvrhi::ResourceStates::VertexBuffer)
+            .setKeepInitialState(true);
+        m_VertexBuffer = ctx.Device->createBuffer(vbDesc);
+
+        auto cmd = ctx.Device->createCommandList();
+        cmd->open();
+        cmd->writeBuffer(m_VertexBuffer, vertices.data(), vbDesc.byteSize);
+        cmd->close();
+        ctx.Device->executeCommandList(cmd);
+    }
+
     void DebugPass::CreatePipeline(RenderContext& ctx, std::shared_ptr<Shader> shader)
     {
         // 4. Create Pipeline
@@ -48,14 +136,12 @@ namespace Lynx
         // CRITICAL: Topology is LineList!
         pipeDesc.primType = nvrhi::PrimitiveType::LineList;
 
-        // Input Layout
+        // Input Layout, per instance data comes from the structured buffer
         nvrhi::VertexAttributeDesc attributes[] = {
             nvrhi::VertexAttributeDesc().setName("POSITION").setFormat(nvrhi::Format::RGB32_FLOAT).setBufferIndex(0).setOffset(0).setElementStride(
-                sizeof(LineVertex)),
-            nvrhi::VertexAttributeDesc().setName("COLOR").setFormat(nvrhi::Format::RGBA32_FLOAT).setBufferIndex(0).setOffset(sizeof(glm::vec3)).
-                                         setElementStride(sizeof(LineVertex)),
+                sizeof(glm::vec3)),
         };
-        pipeDesc.inputLayout = ctx.Device->createInputLayout(attributes, 2, shader->GetVertexShader());
+        pipeDesc.inputLayout = ctx.Device->createInputLayout(attributes, 1, shader->GetVertexShader());
 
         pipeDesc.renderState.depthStencilState
                 .setDepthTestEnable(true)
@@ -63,11 +149,12 @@ namespace Lynx
 
         m_Pipeline = ctx.Device->createGraphicsPipeline(pipeDesc, ctx.PresentationFramebufferInfo);
     }
-    
+
     void DebugPass::Execute(RenderContext& ctx, RenderData& renderData)
     {
-        const auto& lines = DebugRenderer::GetLines();
-        if (lines.empty()) return;
+        // Collect every frame, so durations tick even if nothing new gets drawn
+        const auto& shapes = DebugRenderer::Collect(Engine::Get().GetDeltaTime());
+        if (shapes.empty()) return;
 
         m_PipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
         {
@@ -76,28 +163,39 @@ namespace Lynx
 
         ctx.CommandList->beginMarker("DebugPass");
 
-        // 1. Convert Lines to Vertices
-        std::vector<LineVertex> vertices;
-        vertices.reserve(lines.size() * 2);
-        for (const auto& line : lines)
-        {
-            vertices.push_back({line.Start, line.Color});
-            vertices.push_back({line.End, line.Color});
-        }
+        // 1. Bucket instances by primitive, one instanced draw per primitive
+        std::array<uint32_t, (size_t)DebugPrimitive::Count> counts = {};
+        for (const auto& shape : shapes)
+            counts[(size_t)shape.Primitive]++;
+
+        std::array<uint32_t, (size_t)DebugPrimitive::Count> offsets = {};
+        for (size_t i = 1; i < offsets.size(); i++)
+            offsets[i] = offsets[i - 1] + counts[i - 1];
+
+        m_Instances.resize(shapes.size());
+        auto cursor = offsets;
+        for (const auto& shape : shapes)
+            m_Instances[cursor[(size_t)shape.Primitive]++] = { shape.Transform, shape.Color };
 
-        // 2. Upload to Buffer
-        // Check if we need to resize
-        size_t dataSize = vertices.size() * sizeof(LineVertex);
-        if (dataSize > m_VertexBuffer->getDesc().byteSize)
+        // 2. Upload
+        size_t dataSize = m_Instances.size() * sizeof(DebugInstance);
+        if (!m_InstanceBuffer || m_InstanceBuffer->getDesc().byteSize < dataSize)
         {
-            // TODO: add resizing if we need it!
+            nvrhi::BufferDesc desc;
+            desc.byteSize = (uint64_t)(dataSize * 1.5);
+            desc.structStride = sizeof(DebugInstance);
+            desc.debugName = "DebugInstanceBuffer";
+            desc.initialState = nvrhi::ResourceStates::ShaderResource;
+            desc.keepInitialState = true;
+            m_InstanceBuffer = ctx.Device->createBuffer(desc);
+
+            auto bsDesc = nvrhi::BindingSetDesc()
+                .addItem(nvrhi::BindingSetItem::ConstantBuffer(0, ctx.GlobalConstantBuffer))
+                .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(1, m_InstanceBuffer));
+            m_BindingSet = ctx.Device->createBindingSet(bsDesc, m_BindingLayout);
         }
 
-        // Write data
-        ctx.CommandList->writeBuffer(m_VertexBuffer, vertices.data(), dataSize);
-
-        // BARRIER! We just wrote to VB, now we read from it.
-        ctx.CommandList->setBufferState(m_VertexBuffer, nvrhi::ResourceStates::VertexBuffer);
+        ctx.CommandList->writeBuffer(m_InstanceBuffer, m_Instances.data(), dataSize);
 
         // 3. Draw
         auto state = nvrhi::GraphicsState()
@@ -112,16 +210,24 @@ namespace Lynx
         state.viewport.addScissorRect(nvrhi::Rect(0, fbInfo.width, 0, fbInfo.height));
 
         ctx.CommandList->setGraphicsState(state);
-        ctx.CommandList->draw(nvrhi::DrawArguments().setVertexCount(vertices.size()));
 
-        ctx.CommandList->endMarker();
-
-        renderData.DrawCalls++;
-        renderData.IndexCount += vertices.size();
+        for (size_t i = 0; i < counts.size(); i++)
+        {
+            if (counts[i] == 0)
+                continue;
+
+            const auto& primitive = m_Primitives[i];
+            ctx.CommandList->draw(nvrhi::DrawArguments()
+                .setVertexCount(primitive.VertexCount)
+                .setStartVertexLocation(primitive.StartVertex)
+                .setInstanceCount(counts[i])
+                .setStartInstanceLocation(offsets[i]));
+
+            renderData.DrawCalls++;
+            renderData.IndexCount += primitive.VertexCount * counts[i];
+        }
 
-        // Clear lines for next frame
-        float dt = Engine::Get().GetDeltaTime();
-        DebugRenderer::EndFrame(dt);
+        ctx.CommandList->endMarker();
     }
 
 }
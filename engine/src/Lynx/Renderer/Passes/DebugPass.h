@@ -1,5 +1,6 @@
 #pragma once
 #include "Lynx/Renderer/RenderPass.h"
+#include "Lynx/Renderer/DebugRenderer.h"
 
 namespace Lynx
 {
@@ -13,20 +14,30 @@ namespace Lynx
         void Execute(RenderContext& ctx, RenderData& renderData) override;
     private:
         void CreatePipeline(RenderContext& ctx, std::shared_ptr<Shader> shader);
+        void CreateGeometry(RenderContext& ctx);
 
     private:
         nvrhi::GraphicsPipelineHandle m_Pipeline;
         nvrhi::BindingLayoutHandle m_BindingLayout;
         nvrhi::BindingSetHandle m_BindingSet;
 
+        // All unit primitives (DebugPrimitive) as line lists in one buffer
         nvrhi::BufferHandle m_VertexBuffer;
+        nvrhi::BufferHandle m_InstanceBuffer;
         PipelineState m_PipelineState;
 
-        struct LineVertex
+        struct PrimitiveRange
         {
-            glm::vec3 Position;
+            uint32_t StartVertex = 0;
+            uint32_t VertexCount = 0;
+        };
+        std::array<PrimitiveRange, (size_t)DebugPrimitive::Count> m_Primitives;
+
+        struct DebugInstance
+        {
+            glm::mat4 Transform;
             glm::vec4 Color;
         };
+        std::vector<DebugInstance> m_Instances;
     };
 }
-
@@ -19,6 +19,7 @@ namespace Lynx
             .addItem(nvrhi::BindingLayoutItem::ConstantBuffer(0))
             .addItem(nvrhi::BindingLayoutItem::PushConstants(0, sizeof(DepthPushData)))
             .addItem(nvrhi::BindingLayoutItem::StructuredBuffer_SRV(10))
+            .addItem(nvrhi::BindingLayoutItem::StructuredBuffer_SRV(11)) // Bones
             .setBindingOffsets({0, 0, 0, 0});
         m_GlobalBindingLayout = ctx.Device->createBindingLayout(globalLayoutDesc);
 
@@ -46,6 +47,7 @@ namespace Lynx
         auto pipeDesc = nvrhi::GraphicsPipelineDesc()
             .addBindingLayout(m_GlobalBindingLayout)
             .addBindingLayout(m_MaterialBindingLayout)
+            .addBindingLayout(ctx.SkinBindingLayout)
             .setVertexShader(shader->GetVertexShader())
             .setFragmentShader(shader->GetPixelShader()) // Needed for Alpha Test
             .setPrimType(nvrhi::PrimitiveType::TriangleList);
@@ -81,6 +83,11 @@ namespace Lynx
     }
 
     void DepthPass::Execute(RenderContext& ctx, RenderData& renderData)
+    {
+        RecordSerial(ctx, renderData);
+    }
+
+    uint32_t DepthPass::Prepare(RenderContext& ctx, RenderData& renderData)
     {
         m_PipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
         {
@@ -89,7 +96,34 @@ namespace Lynx
         
         CreateGlobalBindingSet(ctx, renderData);
 
-        ctx.CommandList->beginMarker("DepthPrePass");
+        m_Draws.clear();
+        for (const auto& batch : renderData.OpaqueDrawCalls)
+        {
+            if (!(batch.Key.RenderFlags & RenderFlags::MainPass))
+                continue;
+
+            const auto& submesh = batch.Key.Mesh->GetSubmeshes()[batch.Key.SubmeshIndex];
+            auto material = submesh.Material.get();
+            bool isMasked = (material->Mode == AlphaMode::Mask);
+
+            PreparedDraw& draw = m_Draws.emplace_back();
+            draw.Mesh = &submesh;
+            draw.Pipeline = m_Pipeline;
+            draw.MaterialBindingSet = isMasked ? GetMaterialBindingSet(ctx, material) : m_OpaqueBindingSet;
+            draw.SkinBindingSet = GetSkinBindingSet(ctx, submesh);
+            draw.InstanceCount = batch.InstanceCount;
+            draw.FirstInstance = batch.FirstInstance;
+            draw.Push.AlphaCutoff = isMasked ? material->AlphaCutoff : -1.0f;
+        }
+
+        return GetRangeCount(m_Draws.size());
+    }
+
+    void DepthPass::Record(const RenderContext& ctx, const RenderData& renderData, nvrhi::ICommandList* commandList, uint32_t rangeIndex, uint32_t rangeCount, RecordStats& stats)
+    {
+        auto [begin, end] = GetRange(m_Draws.size(), rangeIndex, rangeCount);
+
+        commandList->beginMarker("DepthPrePass");
 
         auto state = nvrhi::GraphicsState()
             .setPipeline(m_Pipeline)
@@ -100,50 +134,42 @@ namespace Lynx
         state.viewport.addViewport(nvrhi::Viewport(fbInfo.width, fbInfo.height));
         state.viewport.addScissorRect(nvrhi::Rect(0, fbInfo.width, 0, fbInfo.height));
 
-        state.bindings = { m_GlobalBindingSet };
-        ctx.CommandList->setGraphicsState(state);
-
-        for (const auto& batch : renderData.OpaqueDrawCalls)
+        for (size_t i = begin; i < end; i++)
         {
-            if (!(batch.Key.RenderFlags & RenderFlags::MainPass))
-                continue;
-
-            const auto& submesh = batch.Key.Mesh->GetSubmeshes()[batch.Key.SubmeshIndex];
-            auto material = submesh.Material.get();
-            bool isMasked = (material->Mode == AlphaMode::Mask);
-
-            state.bindings = { m_GlobalBindingSet, isMasked ? GetMaterialBindingSet(ctx, material) : m_OpaqueBindingSet };
-
-            state.vertexBuffers = { nvrhi::VertexBufferBinding(submesh.VertexBuffer, 0, 0) };
-            state.indexBuffer = nvrhi::IndexBufferBinding(submesh.IndexBuffer, nvrhi::Format::R32_UINT);
-            ctx.CommandList->setGraphicsState(state);
+            const PreparedDraw& draw = m_Draws[i];
+            state.bindings = { m_GlobalBindingSet, draw.MaterialBindingSet, draw.SkinBindingSet };
+            state.vertexBuffers = { nvrhi::VertexBufferBinding(draw.Mesh->VertexBuffer, 0, 0) };
+            state.indexBuffer = nvrhi::IndexBufferBinding(draw.Mesh->IndexBuffer, nvrhi::Format::R32_UINT);
+            commandList->setGraphicsState(state);
 
             DepthPushData push;
-            push.AlphaCutoff = isMasked ? material->AlphaCutoff : -1.0f;
-            ctx.CommandList->setPushConstants(&push, sizeof(DepthPushData));
+            push.AlphaCutoff = draw.Push.AlphaCutoff;
+            commandList->setPushConstants(&push, sizeof(DepthPushData));
 
-            ctx.CommandList->drawIndexed(nvrhi::DrawArguments()
-                .setVertexCount(submesh.IndexCount)
-                .setInstanceCount(batch.InstanceCount)
-                .setStartInstanceLocation(batch.FirstInstance));
+            commandList->drawIndexed(nvrhi::DrawArguments()
+                .setVertexCount(draw.Mesh->IndexCount)
+                .setInstanceCount(draw.InstanceCount)
+                .setStartInstanceLocation(draw.FirstInstance));
 
             // Note: Don't double count stats here!
             // Or count them as "DepthDrawCalls" if you want separate metrics.
         }
 
-        ctx.CommandList->endMarker();
+        commandList->endMarker();
     }
 
 
     void DepthPass::CreateGlobalBindingSet(RenderContext& ctx, RenderData& renderData)
     {
-        if (m_GlobalBindingSet && m_CachedInstanceBuffer == renderData.InstanceBuffer)
+        if (m_GlobalBindingSet && m_CachedInstanceBuffer == renderData.InstanceBuffer && m_CachedBoneBuffer == renderData.BoneBuffer)
             return;
 
         m_CachedInstanceBuffer = renderData.InstanceBuffer;
+        m_CachedBoneBuffer = renderData.BoneBuffer;
         auto desc = nvrhi::BindingSetDesc()
             .addItem(nvrhi::BindingSetItem::ConstantBuffer(0, ctx.GlobalConstantBuffer))
-            .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(10, renderData.InstanceBuffer));
+            .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(10, renderData.InstanceBuffer))
+            .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(11, renderData.BoneBuffer));
 
         m_GlobalBindingSet = ctx.Device->createBindingSet(desc, m_GlobalBindingLayout);
     }
@@ -12,6 +12,10 @@ namespace Lynx
         void Init(RenderContext& ctx) override;
         void Execute(RenderContext& ctx, RenderData& renderData) override;
 
+        bool SupportsParallelRecording() const override { return true; }
+        uint32_t Prepare(RenderContext& ctx, RenderData& renderData) override;
+        void Record(const RenderContext& ctx, const RenderData& renderData, nvrhi::ICommandList* commandList, uint32_t rangeIndex, uint32_t rangeCount, RecordStats& stats) override;
+
     private:
         void CreatePipelines(RenderContext& ctx, std::shared_ptr<Shader> shader);
         void CreateGlobalBindingSet(RenderContext& ctx, RenderData& renderData);
@@ -26,10 +30,14 @@ namespace Lynx
         nvrhi::BindingSetHandle m_GlobalBindingSet;
         nvrhi::BindingSetHandle m_OpaqueBindingSet;
         nvrhi::BufferHandle m_CachedInstanceBuffer;
+        nvrhi::BufferHandle m_CachedBoneBuffer;
         BindingSetCache<Material*> m_MaterialBindingSetCache;
 
         PipelineState m_PipelineState;
 
+        // Only Push.AlphaCutoff is used
+        std::vector<PreparedDraw> m_Draws;
+
         
     };
 }
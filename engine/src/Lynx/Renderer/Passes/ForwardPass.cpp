@@ -6,6 +6,46 @@
 
 namespace Lynx
 {
+    namespace Helpers
+    {
+        static nvrhi::InputLayoutHandle CreateInputLayout(RenderContext& ctx, const std::shared_ptr<Shader>& shader)
+        {
+            nvrhi::VertexAttributeDesc attributes[] = {
+                nvrhi::VertexAttributeDesc()
+                    .setName("POSITION")
+                    .setFormat(nvrhi::Format::RGB32_FLOAT)
+                    .setBufferIndex(0)
+                    .setOffset(offsetof(Vertex, Position))
+                    .setElementStride(sizeof(Vertex)),
+                nvrhi::VertexAttributeDesc()
+                    .setName("NORMAL")
+                    .setFormat(nvrhi::Format::RGB32_FLOAT)
+                    .setBufferIndex(0)
+                    .setOffset(offsetof(Vertex, Normal))
+                    .setElementStride(sizeof(Vertex)),
+                nvrhi::VertexAttributeDesc()
+                    .setName("TANGENT")
+                    .setFormat(nvrhi::Format::RGBA32_FLOAT)
+                    .setBufferIndex(0)
+                    .setOffset(offsetof(Vertex, Tangent))
+                    .setElementStride(sizeof(Vertex)),
+                nvrhi::VertexAttributeDesc()
+                    .setName("TEXCOORD")
+                    .setFormat(nvrhi::Format::RG32_FLOAT)
+                    .setBufferIndex(0)
+                    .setOffset(offsetof(Vertex, TexCoord))
+                    .setElementStride(sizeof(Vertex)),
+                nvrhi::VertexAttributeDesc()
+                    .setName("COLOR")
+                    .setFormat(nvrhi::Format::RGBA32_FLOAT)
+                    .setBufferIndex(0)
+                    .setOffset(offsetof(Vertex, Color))
+                    .setElementStride(sizeof(Vertex))
+            };
+            return ctx.Device->createInputLayout(attributes, 5, shader->GetVertexShader());
+        }
+    }
+
     void ForwardPass::Init(RenderContext& ctx)
     {
         // Global Layout (Set 0)
@@ -16,6 +56,7 @@ namespace Lynx
             .addItem(nvrhi::BindingLayoutItem::Texture_SRV(1)) // Shadow Map
             .addItem(nvrhi::BindingLayoutItem::Sampler(2))
             .addItem(nvrhi::BindingLayoutItem::StructuredBuffer_SRV(10))
+            .addItem(nvrhi::BindingLayoutItem::StructuredBuffer_SRV(11)) // Bones
             .setBindingOffsets({0, 0, 0, 0});
         m_GlobalBindingLayout = ctx.Device->createBindingLayout(globalLayoutDesc);
 
@@ -36,6 +77,13 @@ namespace Lynx
         {
             this->CreatePipelines(ctx, shader);
         });
+
+        // No entity ID output, weighted blended surfaces can't be picked
+        m_OITPipelineState.SetPath("engine/resources/Shaders/StandardOIT.glsl");
+        m_OITPipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
+        {
+            this->CreateOITPipeline(ctx, shader);
+        });
     }
 
     void ForwardPass::CreatePipelines(RenderContext& ctx, std::shared_ptr<Shader> shader)
@@ -43,45 +91,14 @@ namespace Lynx
         auto pipeDesc = nvrhi::GraphicsPipelineDesc()
             .addBindingLayout(m_GlobalBindingLayout)
             .addBindingLayout(m_MaterialBindingLayout)
+            .addBindingLayout(ctx.SkinBindingLayout)
             .setVertexShader(shader->GetVertexShader())
             .setFragmentShader(shader->GetPixelShader())
             .setPrimType(nvrhi::PrimitiveType::TriangleList);
         pipeDesc.renderState.rasterState.frontCounterClockwise = true;
         pipeDesc.renderState.rasterState.cullMode = nvrhi::RasterCullMode::Back;
 
-        nvrhi::VertexAttributeDesc attributes[] = {
-            nvrhi::VertexAttributeDesc()
-                .setName("POSITION")
-                .setFormat(nvrhi::Format::RGB32_FLOAT)
-                .setBufferIndex(0)
-                .setOffset(offsetof(Vertex, Position))
-                .setElementStride(sizeof(Vertex)),
-            nvrhi::VertexAttributeDesc()
-                .setName("NORMAL")
-                .setFormat(nvrhi::Format::RGB32_FLOAT)
-                .setBufferIndex(0)
-                .setOffset(offsetof(Vertex, Normal))
-                .setElementStride(sizeof(Vertex)),
-            nvrhi::VertexAttributeDesc()
-                .setName("TANGENT")
-                .setFormat(nvrhi::Format::RGBA32_FLOAT)
-                .setBufferIndex(0)
-                .setOffset(offsetof(Vertex, Tangent))
-                .setElementStride(sizeof(Vertex)),
-            nvrhi::VertexAttributeDesc()
-                .setName("TEXCOORD")
-                .setFormat(nvrhi::Format::RG32_FLOAT)
-                .setBufferIndex(0)
-                .setOffset(offsetof(Vertex, TexCoord))
-                .setElementStride(sizeof(Vertex)),
-            nvrhi::VertexAttributeDesc()
-                .setName("COLOR")
-                .setFormat(nvrhi::Format::RGBA32_FLOAT)
-                .setBufferIndex(0)
-                .setOffset(offsetof(Vertex, Color))
-                .setElementStride(sizeof(Vertex))
-        };
-        pipeDesc.inputLayout = ctx.Device->createInputLayout(attributes, 5, shader->GetVertexShader());
+        pipeDesc.inputLayout = Helpers::CreateInputLayout(ctx, shader);
 
         // Opaque
         pipeDesc.renderState.depthStencilState.depthTestEnable = true;
@@ -107,17 +124,158 @@ namespace Lynx
         m_PipelineTransparent = ctx.Device->createGraphicsPipeline(pipeDesc, ctx.PresentationFramebufferInfo);
     }
 
+    void ForwardPass::CreateOITPipeline(RenderContext& ctx, std::shared_ptr<Shader> shader)
+    {
+        auto pipeDesc = nvrhi::GraphicsPipelineDesc()
+            .addBindingLayout(m_GlobalBindingLayout)
+            .addBindingLayout(m_MaterialBindingLayout)
+            .addBindingLayout(ctx.SkinBindingLayout)
+            .setVertexShader(shader->GetVertexShader())
+            .setFragmentShader(shader->GetPixelShader())
+            .setPrimType(nvrhi::PrimitiveType::TriangleList);
+        pipeDesc.renderState.rasterState.frontCounterClockwise = true;
+        pipeDesc.renderState.rasterState.cullMode = nvrhi::RasterCullMode::Back;
+        pipeDesc.inputLayout = Helpers::CreateInputLayout(ctx, shader);
+
+        pipeDesc.renderState.depthStencilState.depthTestEnable = true;
+        pipeDesc.renderState.depthStencilState.depthWriteEnable = false;
+        pipeDesc.renderState.depthStencilState.depthFunc = nvrhi::ComparisonFunc::Less;
+
+        // Accumulation is a plain sum, revealage gets multiplied by (1 - alpha)
+        pipeDesc.renderState.blendState.targets[0]
+            .setBlendEnable(true)
+            .setSrcBlend(nvrhi::BlendFactor::One)
+            .setDestBlend(nvrhi::BlendFactor::One)
+            .setSrcBlendAlpha(nvrhi::BlendFactor::One)
+            .setDestBlendAlpha(nvrhi::BlendFactor::One);
+        pipeDesc.renderState.blendState.targets[1]
+            .setBlendEnable(true)
+            .setSrcBlend(nvrhi::BlendFactor::Zero)
+            .setDestBlend(nvrhi::BlendFactor::InvSrcColor)
+            .setSrcBlendAlpha(nvrhi::BlendFactor::Zero)
+            .setDestBlendAlpha(nvrhi::BlendFactor::InvSrcAlpha);
+
+        m_PipelineOIT = ctx.Device->createGraphicsPipeline(pipeDesc, ctx.OITFramebufferInfo);
+    }
+
     void ForwardPass::Execute(RenderContext& ctx, RenderData& renderData)
+    {
+        RecordSerial(ctx, renderData);
+    }
+
+    uint32_t ForwardPass::Prepare(RenderContext& ctx, RenderData& renderData)
     {
         m_PipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
         {
             this->CreatePipelines(ctx, shader);
         });
+        m_OITPipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
+        {
+            this->CreateOITPipeline(ctx, shader);
+        });
         
         CreateGlobalBindingSet(ctx, renderData);
-        
-        DrawBatches(ctx, renderData, renderData.OpaqueDrawCalls, m_PipelineOpaque);
-        DrawQueue(ctx, renderData, renderData.TransparentQueue, m_PipelineTransparent);
+
+        m_Draws.clear();
+        for (const auto& batch : renderData.OpaqueDrawCalls)
+        {
+            if (batch.InstanceCount <= 0)
+                continue;
+
+            if (!(batch.Key.RenderFlags & RenderFlags::MainPass))
+                continue;
+
+            const auto& submesh = batch.Key.Mesh->GetSubmeshes()[batch.Key.SubmeshIndex];
+            PreparedDraw& draw = m_Draws.emplace_back();
+            draw.Mesh = &submesh;
+            draw.Pipeline = m_PipelineOpaque;
+            draw.MaterialBindingSet = GetMaterialBindingSet(ctx, submesh.Material.get());
+            draw.SkinBindingSet = GetSkinBindingSet(ctx, submesh);
+            draw.InstanceCount = batch.InstanceCount;
+            draw.FirstInstance = batch.FirstInstance;
+            draw.Push = GetPushData(submesh.Material.get());
+        }
+
+        for (const auto& cmd : renderData.TransparentQueue)
+        {
+            if (!(cmd.Flags & RenderFlags::MainPass))
+                continue;
+
+            const auto& submesh = cmd.Mesh->GetSubmeshes()[cmd.SubmeshIndex];
+            PreparedDraw& draw = m_Draws.emplace_back();
+            draw.Mesh = &submesh;
+            draw.Pipeline = m_PipelineTransparent;
+            draw.MaterialBindingSet = GetMaterialBindingSet(ctx, submesh.Material.get());
+            draw.SkinBindingSet = GetSkinBindingSet(ctx, submesh);
+            draw.InstanceCount = 1;
+            draw.FirstInstance = cmd.InstanceOffset;
+            draw.Push = GetPushData(submesh.Material.get());
+        }
+
+        for (const auto& cmd : renderData.WeightedBlendedQueue)
+        {
+            if (!(cmd.Flags & RenderFlags::MainPass))
+                continue;
+
+            const auto& submesh = cmd.Mesh->GetSubmeshes()[cmd.SubmeshIndex];
+            PreparedDraw& draw = m_Draws.emplace_back();
+            draw.Mesh = &submesh;
+            draw.Pipeline = m_PipelineOIT;
+            draw.MaterialBindingSet = GetMaterialBindingSet(ctx, submesh.Material.get());
+            draw.SkinBindingSet = GetSkinBindingSet(ctx, submesh);
+            draw.Framebuffer = renderData.OITFramebuffer;
+            draw.InstanceCount = 1;
+            draw.FirstInstance = cmd.InstanceOffset;
+            draw.Push = GetPushData(submesh.Material.get());
+        }
+
+        return GetRangeCount(m_Draws.size());
+    }
+
+    void ForwardPass::Record(const RenderContext& ctx, const RenderData& renderData, nvrhi::ICommandList* commandList, uint32_t rangeIndex, uint32_t rangeCount, RecordStats& stats)
+    {
+        auto [begin, end] = GetRange(m_Draws.size(), rangeIndex, rangeCount);
+
+        commandList->beginMarker("ForwardPass");
+
+        // OIT targets have the same size as the scene color, so the viewport works for both
+        auto state = nvrhi::GraphicsState();
+        const auto& fbInfo = renderData.TargetFramebuffer->getFramebufferInfo();
+        state.viewport.addViewport(nvrhi::Viewport(fbInfo.width, fbInfo.height));
+        state.viewport.addScissorRect(nvrhi::Rect(0, fbInfo.width, 0, fbInfo.height));
+
+        for (size_t i = begin; i < end; i++)
+        {
+            const PreparedDraw& draw = m_Draws[i];
+            state.setFramebuffer(draw.Framebuffer ? draw.Framebuffer : renderData.TargetFramebuffer.Get());
+            state.setPipeline(draw.Pipeline);
+            state.bindings = { m_GlobalBindingSet, draw.MaterialBindingSet, draw.SkinBindingSet };
+            state.vertexBuffers = { nvrhi::VertexBufferBinding(draw.Mesh->VertexBuffer, 0, 0) };
+            state.indexBuffer = nvrhi::IndexBufferBinding(draw.Mesh->IndexBuffer, nvrhi::Format::R32_UINT);
+            commandList->setGraphicsState(state);
+
+            commandList->setPushConstants(&draw.Push, sizeof(PushData));
+            commandList->drawIndexed(nvrhi::DrawArguments()
+                .setVertexCount(draw.Mesh->IndexCount)
+                .setInstanceCount(draw.InstanceCount)
+                .setStartInstanceLocation(draw.FirstInstance));
+
+            stats.DrawCalls++;
+            stats.IndexCount += draw.Mesh->IndexCount * draw.InstanceCount;
+        }
+
+        commandList->endMarker();
+    }
+
+    PushData ForwardPass::GetPushData(Material* material) const
+    {
+        PushData push;
+        push.AlphaCutoff = material->Mode == AlphaMode::Mask ? material->AlphaCutoff : -1.0f;
+        push.AlbedoColor = material->AlbedoColor;
+        push.EmissiveColorStrength = glm::vec4(material->EmissiveColor, material->EmissiveStrength);
+        push.MetallicStrength = material->Metallic;
+        push.RoughnessStrength = material->Roughness;
+        return push;
     }
 
     nvrhi::BindingSetHandle ForwardPass::GetMaterialBindingSet(RenderContext& ctx, Material* material)
@@ -185,104 +343,19 @@ namespace Lynx
 
     void ForwardPass::CreateGlobalBindingSet(RenderContext& ctx, RenderData& renderData)
     {
-        if (m_GlobalBindingSet && m_CachedInstanceBuffer == renderData.InstanceBuffer)
+        if (m_GlobalBindingSet && m_CachedInstanceBuffer == renderData.InstanceBuffer && m_CachedBoneBuffer == renderData.BoneBuffer)
             return;
 
         m_CachedInstanceBuffer = renderData.InstanceBuffer;
+        m_CachedBoneBuffer = renderData.BoneBuffer;
         auto desc = nvrhi::BindingSetDesc()
             .addItem(nvrhi::BindingSetItem::ConstantBuffer(0, ctx.GlobalConstantBuffer))
             .addItem(nvrhi::BindingSetItem::PushConstants(0, sizeof(PushData)))
             .addItem(nvrhi::BindingSetItem::Texture_SRV(1, renderData.ShadowMap)) // Shadow Map
             .addItem(nvrhi::BindingSetItem::Sampler(2, renderData.ShadowSampler))
-            .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(10, renderData.InstanceBuffer));
+            .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(10, renderData.InstanceBuffer))
+            .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(11, renderData.BoneBuffer));
 
         m_GlobalBindingSet = ctx.Device->createBindingSet(desc, m_GlobalBindingLayout);
     }
-
-    void ForwardPass::DrawQueue(RenderContext& ctx, RenderData& renderData, std::vector<RenderCommand>& queue, nvrhi::GraphicsPipelineHandle pipeline)
-    {
-        if (queue.empty())
-            return;
-
-        for (const auto& cmd : queue)
-        {
-            if (!(cmd.Flags & RenderFlags::MainPass))
-                continue;
-            
-            const auto& submesh = cmd.Mesh->GetSubmeshes()[cmd.SubmeshIndex];
-            auto state = nvrhi::GraphicsState()
-                .setPipeline(pipeline)
-                .setFramebuffer(renderData.TargetFramebuffer)
-                .addVertexBuffer(nvrhi::VertexBufferBinding(submesh.VertexBuffer, 0, 0))
-                .setIndexBuffer(nvrhi::IndexBufferBinding(submesh.IndexBuffer, nvrhi::Format::R32_UINT));
-
-            const auto& fbInfo = renderData.TargetFramebuffer->getFramebufferInfo();
-            state.viewport.addViewport(nvrhi::Viewport(fbInfo.width, fbInfo.height));
-            state.viewport.addScissorRect(nvrhi::Rect(0, fbInfo.width, 0, fbInfo.height));
-            state.addBindingSet(m_GlobalBindingSet);
-            state.addBindingSet(GetMaterialBindingSet(ctx, submesh.Material.get()));
-
-            ctx.CommandList->setGraphicsState(state);
-
-            PushData push;
-            push.AlphaCutoff = submesh.Material->Mode == AlphaMode::Mask ? submesh.Material->AlphaCutoff : -1.0f;
-            push.AlbedoColor = submesh.Material->AlbedoColor;
-            push.EmissiveColorStrength = glm::vec4(submesh.Material->EmissiveColor, submesh.Material->EmissiveStrength);
-            push.MetallicStrength = submesh.Material->Metallic;
-            push.RoughnessStrength = submesh.Material->Roughness;
-            ctx.CommandList->setPushConstants(&push, sizeof(PushData));
-            ctx.CommandList->drawIndexed(nvrhi::DrawArguments()
-                .setVertexCount(submesh.IndexCount)
-                .setInstanceCount(1)
-                .setStartInstanceLocation(cmd.InstanceOffset));
-
-            renderData.DrawCalls++;
-            renderData.IndexCount += submesh.IndexCount;
-        }
-    }
-
-    void ForwardPass::DrawBatches(RenderContext& ctx, RenderData& renderData, std::vector<BatchDrawCall>& batches, nvrhi::GraphicsPipelineHandle pipeline)
-    {
-        for (const auto& batch : batches)
-        {
-            if (batch.InstanceCount <= 0)
-                continue;
-
-            if (!(batch.Key.RenderFlags & RenderFlags::MainPass))
-                continue;
-
-            const auto& submesh = batch.Key.Mesh->GetSubmeshes()[batch.Key.SubmeshIndex];
-            auto state = nvrhi::GraphicsState()
-                .setPipeline(pipeline)
-                .setFramebuffer(renderData.TargetFramebuffer)
-                .addVertexBuffer(nvrhi::VertexBufferBinding(submesh.VertexBuffer, 0, 0))
-                .setIndexBuffer(nvrhi::IndexBufferBinding(submesh.IndexBuffer, nvrhi::Format::R32_UINT));
-
-            const auto& fbInfo = renderData.TargetFramebuffer->getFramebufferInfo();
-            state.viewport.addViewport(nvrhi::Viewport(fbInfo.width, fbInfo.height));
-            state.viewport.addScissorRect(nvrhi::Rect(0, fbInfo.width, 0, fbInfo.height));
-            state.addBindingSet(m_GlobalBindingSet);
-            state.addBindingSet(GetMaterialBindingSet(ctx, submesh.Material.get()));
-
-            ctx.CommandList->setGraphicsState(state);
-
-            PushData push;
-            push.AlphaCutoff = submesh.Material->Mode == AlphaMode::Mask ? submesh.Material->AlphaCutoff : -1.0f;
-            push.AlbedoColor = submesh.Material->AlbedoColor;
-            push.EmissiveColorStrength = glm::vec4(submesh.Material->EmissiveColor, submesh.Material->EmissiveStrength);
-            push.MetallicStrength = submesh.Material->Metallic;
-            push.RoughnessStrength = submesh.Material->Roughness;
-            ctx.CommandList->setPushConstants(&push, sizeof(PushData));
-
-            ctx.CommandList->drawIndexed(nvrhi::DrawArguments()
-                .setVertexCount(submesh.IndexCount)
-                .setInstanceCount(batch.InstanceCount)
-                .setStartInstanceLocation(batch.FirstInstance));
-            
-            renderData.DrawCalls++;
-            renderData.IndexCount += submesh.IndexCount * batch.InstanceCount;
-        }
-    }
-
-    
 }
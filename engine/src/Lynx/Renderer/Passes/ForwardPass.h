@@ -12,13 +12,17 @@ namespace Lynx
         void Init(RenderContext& ctx) override;
         void Execute(RenderContext& ctx, RenderData& renderData) override;
 
+        bool SupportsParallelRecording() const override { return true; }
+        uint32_t Prepare(RenderContext& ctx, RenderData& renderData) override;
+        void Record(const RenderContext& ctx, const RenderData& renderData, nvrhi::ICommandList* commandList, uint32_t rangeIndex, uint32_t rangeCount, RecordStats& stats) override;
+
     private:
         void CreatePipelines(RenderContext& ctx, std::shared_ptr<Shader> shader);
+        void CreateOITPipeline(RenderContext& ctx, std::shared_ptr<Shader> shader);
         nvrhi::BindingSetHandle GetMaterialBindingSet(RenderContext& ctx, Material* material);
         void CreateGlobalBindingSet(RenderContext& ctx, RenderData& renderData);
         
-        void DrawQueue(RenderContext& ctx, RenderData& renderData, std::vector<RenderCommand>& queue, nvrhi::GraphicsPipelineHandle pipeline);
-        void DrawBatches(RenderContext& ctx, RenderData& renderData, std::vector<BatchDrawCall>& batches, nvrhi::GraphicsPipelineHandle pipeline);
+        PushData GetPushData(Material* material) const;
 
     private:
         nvrhi::BindingLayoutHandle m_GlobalBindingLayout;
@@ -30,9 +34,15 @@ namespace Lynx
         
         nvrhi::GraphicsPipelineHandle m_PipelineOpaque;
         nvrhi::GraphicsPipelineHandle m_PipelineTransparent;
+        nvrhi::GraphicsPipelineHandle m_PipelineOIT;
         nvrhi::BufferHandle m_CachedInstanceBuffer;
+        nvrhi::BufferHandle m_CachedBoneBuffer;
 
         PipelineState m_PipelineState;
+        PipelineState m_OITPipelineState;
+
+        // Opaque batches first, then transparent back to front, then weighted blended into the OIT targets
+        std::vector<PreparedDraw> m_Draws;
     };
 }
 
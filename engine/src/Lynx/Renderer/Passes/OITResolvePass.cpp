@@ -0,0 +1,88 @@
+#include "OITResolvePass.h"
+
+#include "Lynx/Engine.h"
+#include "Lynx/Asset/Shader.h"
+
+namespace Lynx
+{
+    void OITResolvePass::Init(RenderContext& ctx)
+    {
+        auto layoutDesc = nvrhi::BindingLayoutDesc()
+            .setVisibility(nvrhi::ShaderType::Pixel)
+            .addItem(nvrhi::BindingLayoutItem::Texture_SRV(0))
+            .addItem(nvrhi::BindingLayoutItem::Texture_SRV(1))
+            .setBindingOffsets({0, 0, 0, 0});
+        m_BindingLayout = ctx.Device->createBindingLayout(layoutDesc);
+
+        m_PipelineState.SetPath("engine/resources/Shaders/OITResolve.glsl");
+        m_PipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
+        {
+            this->CreatePipeline(ctx, shader);
+        });
+    }
+
+    void OITResolvePass::CreatePipeline(RenderContext& ctx, std::shared_ptr<Shader> shader)
+    {
+        auto pipeDesc = nvrhi::GraphicsPipelineDesc()
+            .addBindingLayout(m_BindingLayout)
+            .setVertexShader(shader->GetVertexShader())
+            .setPixelShader(shader->GetPixelShader())
+            .setPrimType(nvrhi::PrimitiveType::TriangleList);
+        pipeDesc.renderState.rasterState.cullMode = nvrhi::RasterCullMode::None;
+        pipeDesc.renderState.depthStencilState
+            .setDepthTestEnable(false)
+            .setDepthWriteEnable(false);
+        pipeDesc.renderState.blendState.targets[0]
+            .setBlendEnable(true)
+            .setSrcBlend(nvrhi::BlendFactor::SrcAlpha)
+            .setDestBlend(nvrhi::BlendFactor::InvSrcAlpha)
+            .setSrcBlendAlpha(nvrhi::BlendFactor::Zero)
+            .setDestBlendAlpha(nvrhi::BlendFactor::One);
+
+        // Leave the entity IDs alone
+        if (ctx.PresentationFramebufferInfo.colorFormats.size() > 1)
+            pipeDesc.renderState.blendState.targets[1].setColorWriteMask(nvrhi::ColorMask(0));
+
+        m_Pipeline = ctx.Device->createGraphicsPipeline(pipeDesc, ctx.PresentationFramebufferInfo);
+    }
+
+    void OITResolvePass::Execute(RenderContext& ctx, RenderData& renderData)
+    {
+        if (!renderData.HasOITDraws)
+            return;
+
+        m_PipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
+        {
+            this->CreatePipeline(ctx, shader);
+        });
+
+        if (!m_BindingSet || m_CachedAccumulation != renderData.OITAccumulation || m_CachedRevealage != renderData.OITRevealage)
+        {
+            m_CachedAccumulation = renderData.OITAccumulation;
+            m_CachedRevealage = renderData.OITRevealage;
+
+            auto bsDesc = nvrhi::BindingSetDesc()
+                .addItem(nvrhi::BindingSetItem::Texture_SRV(0, renderData.OITAccumulation))
+                .addItem(nvrhi::BindingSetItem::Texture_SRV(1, renderData.OITRevealage));
+            m_BindingSet = ctx.Device->createBindingSet(bsDesc, m_BindingLayout);
+        }
+
+        ctx.CommandList->beginMarker("OITResolvePass");
+
+        auto state = nvrhi::GraphicsState()
+            .setPipeline(m_Pipeline)
+            .setFramebuffer(renderData.TargetFramebuffer)
+            .addBindingSet(m_BindingSet);
+
+        const auto& fbInfo = renderData.TargetFramebuffer->getFramebufferInfo();
+        state.viewport.addViewport(nvrhi::Viewport(fbInfo.width, fbInfo.height));
+        state.viewport.addScissorRect(nvrhi::Rect(0, fbInfo.width, 0, fbInfo.height));
+
+        ctx.CommandList->setGraphicsState(state);
+        ctx.CommandList->draw(nvrhi::DrawArguments().setVertexCount(3));
+
+        ctx.CommandList->endMarker();
+
+        renderData.DrawCalls++;
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "Lynx/Renderer/RenderPass.h"
+
+namespace Lynx
+{
+    // Composites the weighted blended OIT targets onto the scene color, before bloom so transparent emissive still glows
+    class OITResolvePass : public RenderPass
+    {
+    public:
+        OITResolvePass() = default;
+        virtual ~OITResolvePass() = default;
+
+        void Init(RenderContext& ctx) override;
+        void Execute(RenderContext& ctx, RenderData& renderData) override;
+
+    private:
+        void CreatePipeline(RenderContext& ctx, std::shared_ptr<Shader> shader);
+
+    private:
+        nvrhi::BindingLayoutHandle m_BindingLayout;
+        nvrhi::BindingSetHandle m_BindingSet;
+        nvrhi::GraphicsPipelineHandle m_Pipeline;
+        nvrhi::TextureHandle m_CachedAccumulation;
+        nvrhi::TextureHandle m_CachedRevealage;
+        PipelineState m_PipelineState;
+    };
+}
@@ -19,6 +19,28 @@ namespace Lynx
         float EmissiveStrength;
         float Padding;
     };
+
+    namespace Helpers
+    {
+        static nvrhi::InputLayoutHandle CreateInputLayout(RenderContext& ctx, const std::shared_ptr<Shader>& shader)
+        {
+            nvrhi::VertexAttributeDesc attributes[] = {
+                nvrhi::VertexAttributeDesc()
+                    .setName("POS")
+                    .setFormat(nvrhi::Format::RG32_FLOAT)
+                    .setBufferIndex(0)
+                    .setOffset(0)
+                    .setElementStride(sizeof(ParticleVertex)),
+                nvrhi::VertexAttributeDesc()
+                    .setName("UV")
+                    .setFormat(nvrhi::Format::RG32_FLOAT)
+                    .setBufferIndex(0)
+                    .setOffset(sizeof(glm::vec2))
+                    .setElementStride(sizeof(ParticleVertex))
+            };
+            return ctx.Device->createInputLayout(attributes, 2, shader->GetVertexShader());
+        }
+    }
     
     void ParticlePass::Init(RenderContext& ctx)
     {
@@ -73,6 +95,12 @@ namespace Lynx
         {
             CreatePipelines(ctx, shader);
         });
+
+        m_OITPipelineState.SetPath("engine/resources/Shaders/ParticleOIT.glsl");
+        m_OITPipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
+        {
+            CreateOITPipeline(ctx, shader);
+        });
     }
 
     void ParticlePass::CreatePipelines(RenderContext& ctx, std::shared_ptr<Shader> shader)
@@ -84,21 +112,7 @@ namespace Lynx
             .setPixelShader(shader->GetPixelShader())
             .setPrimType(nvrhi::PrimitiveType::TriangleList);
 
-        nvrhi::VertexAttributeDesc attributes[] = {
-            nvrhi::VertexAttributeDesc()
-                .setName("POS")
-                .setFormat(nvrhi::Format::RG32_FLOAT)
-                .setBufferIndex(0)
-                .setOffset(0)
-                .setElementStride(sizeof(ParticleVertex)),
-            nvrhi::VertexAttributeDesc()
-                .setName("UV")
-                .setFormat(nvrhi::Format::RG32_FLOAT)
-                .setBufferIndex(0)
-                .setOffset(sizeof(glm::vec2))
-                .setElementStride(sizeof(ParticleVertex))
-        };
-        pipeDesc.inputLayout = ctx.Device->createInputLayout(attributes, 2, shader->GetVertexShader());
+        pipeDesc.inputLayout = Helpers::CreateInputLayout(ctx, shader);
 
         // Common State
         pipeDesc.renderState.rasterState.cullMode = nvrhi::RasterCullMode::None; // Particles represent 2D sprites, usually seen from any side, but mostly front.
@@ -120,6 +134,36 @@ namespace Lynx
         m_PipelineAdditive = ctx.Device->createGraphicsPipeline(pipeDesc, ctx.PresentationFramebufferInfo);
     }
 
+    void ParticlePass::CreateOITPipeline(RenderContext& ctx, std::shared_ptr<Shader> shader)
+    {
+        auto pipeDesc = nvrhi::GraphicsPipelineDesc()
+            .addBindingLayout(m_GlobalBindingLayout)
+            .addBindingLayout(m_MaterialBindingLayout)
+            .setVertexShader(shader->GetVertexShader())
+            .setPixelShader(shader->GetPixelShader())
+            .setPrimType(nvrhi::PrimitiveType::TriangleList);
+        pipeDesc.inputLayout = Helpers::CreateInputLayout(ctx, shader);
+
+        pipeDesc.renderState.rasterState.cullMode = nvrhi::RasterCullMode::None;
+        pipeDesc.renderState.depthStencilState.depthWriteEnable = false;
+        pipeDesc.renderState.depthStencilState.depthTestEnable = true;
+
+        // Same blending as the forward OIT pipeline
+        pipeDesc.renderState.blendState.targets[0]
+            .setBlendEnable(true)
+            .setSrcBlend(nvrhi::BlendFactor::One)
+            .setDestBlend(nvrhi::BlendFactor::One)
+            .setSrcBlendAlpha(nvrhi::BlendFactor::One)
+            .setDestBlendAlpha(nvrhi::BlendFactor::One);
+        pipeDesc.renderState.blendState.targets[1]
+            .setBlendEnable(true)
+            .setSrcBlend(nvrhi::BlendFactor::Zero)
+            .setDestBlend(nvrhi::BlendFactor::InvSrcColor)
+            .setSrcBlendAlpha(nvrhi::BlendFactor::Zero)
+            .setDestBlendAlpha(nvrhi::BlendFactor::InvSrcAlpha);
+        m_PipelineOIT = ctx.Device->createGraphicsPipeline(pipeDesc, ctx.OITFramebufferInfo);
+    }
+
     void ParticlePass::CreateGlobalBindingSet(RenderContext& ctx, RenderData& renderData)
     {
         if (m_GlobalBindingSet && m_CachedInstanceBuffer == renderData.ParticleInstanceBuffer)
@@ -135,47 +179,73 @@ namespace Lynx
     }
 
     void ParticlePass::Execute(RenderContext& ctx, RenderData& renderData)
+    {
+        RecordSerial(ctx, renderData);
+    }
+
+    uint32_t ParticlePass::Prepare(RenderContext& ctx, RenderData& renderData)
     {
         if (renderData.ParticleQueue.empty())
-            return;
+            return 0;
 
         m_PipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
         {
             CreatePipelines(ctx, shader);
         });
+        m_OITPipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
+        {
+            CreateOITPipeline(ctx, shader);
+        });
 
         CreateGlobalBindingSet(ctx, renderData);
 
+        m_MaterialBindingSets.clear();
         for (const auto& batch : renderData.ParticleQueue)
+            m_MaterialBindingSets.push_back(GetMaterialBindingSet(ctx, batch.Material));
+
+        // Usually only a handful of batches, one range is plenty
+        return 1;
+    }
+
+    void ParticlePass::Record(const RenderContext& ctx, const RenderData& renderData, nvrhi::ICommandList* commandList, uint32_t rangeIndex, uint32_t rangeCount, RecordStats& stats)
+    {
+        for (size_t i = 0; i < renderData.ParticleQueue.size(); i++)
         {
+            const auto& batch = renderData.ParticleQueue[i];
             auto pipeline = (batch.Material->Mode == AlphaMode::Additive) ? m_PipelineAdditive : m_PipelineAlpha;
+            nvrhi::IFramebuffer* framebuffer = renderData.TargetFramebuffer;
+            if (batch.Material->IsWeightedBlended())
+            {
+                pipeline = m_PipelineOIT;
+                framebuffer = renderData.OITFramebuffer;
+            }
 
             auto state = nvrhi::GraphicsState()
                 .setPipeline(pipeline)
-                .setFramebuffer(renderData.TargetFramebuffer)
+                .setFramebuffer(framebuffer)
                 .addVertexBuffer(nvrhi::VertexBufferBinding(m_QuadVertexBuffer, 0, 0))
                 .setIndexBuffer(nvrhi::IndexBufferBinding(m_QuadIndexBuffer, nvrhi::Format::R32_UINT))
                 .addBindingSet(m_GlobalBindingSet)
-                .addBindingSet(GetMaterialBindingSet(ctx, batch.Material));
+                .addBindingSet(m_MaterialBindingSets[i]);
 
-            const auto& fbInfo = renderData.TargetFramebuffer->getFramebufferInfo();
+            const auto& fbInfo = framebuffer->getFramebufferInfo();
             state.viewport.addViewport(nvrhi::Viewport(fbInfo.width, fbInfo.height));
             state.viewport.addScissorRect(nvrhi::Rect(0, fbInfo.width, 0, fbInfo.height));
 
-            ctx.CommandList->setGraphicsState(state);
+            commandList->setGraphicsState(state);
 
             ParticlePushData push;
             push.AlbedoColor = batch.Material->AlbedoColor;
             push.Tiling = batch.Material->Tiling;
             push.EmissiveStrength = batch.Material->EmissiveStrength;
-            ctx.CommandList->setPushConstants(&push, sizeof(ParticlePushData));
+            commandList->setPushConstants(&push, sizeof(ParticlePushData));
             
-            ctx.CommandList->drawIndexed(nvrhi::DrawArguments()
+            commandList->drawIndexed(nvrhi::DrawArguments()
                 .setVertexCount(6)
                 .setInstanceCount(batch.Count)
                 .setStartInstanceLocation(batch.StartOffset));
 
-            renderData.DrawCalls++;
+            stats.DrawCalls++;
         }
     }
 
@@ -12,8 +12,13 @@ namespace Lynx
         void Init(RenderContext& ctx) override;
         void Execute(RenderContext& ctx, RenderData& renderData) override;
 
+        bool SupportsParallelRecording() const override { return true; }
+        uint32_t Prepare(RenderContext& ctx, RenderData& renderData) override;
+        void Record(const RenderContext& ctx, const RenderData& renderData, nvrhi::ICommandList* commandList, uint32_t rangeIndex, uint32_t rangeCount, RecordStats& stats) override;
+
     private:
         void CreatePipelines(RenderContext& ctx, std::shared_ptr<Shader> shader);
+        void CreateOITPipeline(RenderContext& ctx, std::shared_ptr<Shader> shader);
         void CreateGlobalBindingSet(RenderContext& ctx, RenderData& renderData);
         nvrhi::BindingSetHandle GetMaterialBindingSet(RenderContext& ctx, Material* material);
 
@@ -26,12 +31,17 @@ namespace Lynx
 
         nvrhi::GraphicsPipelineHandle m_PipelineAlpha;
         nvrhi::GraphicsPipelineHandle m_PipelineAdditive;
+        nvrhi::GraphicsPipelineHandle m_PipelineOIT;
 
         nvrhi::BufferHandle m_QuadVertexBuffer;
         nvrhi::BufferHandle m_QuadIndexBuffer;
         nvrhi::BufferHandle m_CachedInstanceBuffer;
 
         PipelineState m_PipelineState;
+        PipelineState m_OITPipelineState;
+
+        // Parallel to renderData.ParticleQueue
+        std::vector<nvrhi::BindingSetHandle> m_MaterialBindingSets;
     };
 }
 
@@ -56,6 +56,7 @@ namespace Lynx
             .addItem(nvrhi::BindingLayoutItem::ConstantBuffer(0)) // UBO
             .addItem(nvrhi::BindingLayoutItem::PushConstants(0, sizeof(ShadowPushData)))
             .addItem(nvrhi::BindingLayoutItem::StructuredBuffer_SRV(10))
+            .addItem(nvrhi::BindingLayoutItem::StructuredBuffer_SRV(11)) // Bones
             .setBindingOffsets({0, 0, 0, 0});
         m_GlobalBindingLayout = ctx.Device->createBindingLayout(globalDesc);
 
@@ -81,7 +82,7 @@ namespace Lynx
     void ShadowPass::CreatePipeline(RenderContext& ctx, std::shared_ptr<Shader> shader)
     {
         auto pipeDesc = nvrhi::GraphicsPipelineDesc();
-        pipeDesc.bindingLayouts = { m_GlobalBindingLayout, m_MaterialBindingLayout };
+        pipeDesc.bindingLayouts = { m_GlobalBindingLayout, m_MaterialBindingLayout, ctx.SkinBindingLayout };
         pipeDesc.VS = shader->GetVertexShader();
         pipeDesc.PS = shader->GetPixelShader();
         pipeDesc.primType = nvrhi::PrimitiveType::TriangleList;
@@ -131,6 +132,11 @@ namespace Lynx
     }
 
     void ShadowPass::Execute(RenderContext& ctx, RenderData& renderData)
+    {
+        RecordSerial(ctx, renderData);
+    }
+
+    uint32_t ShadowPass::Prepare(RenderContext& ctx, RenderData& renderData)
     {
         m_PipelineState.Update([this, &ctx](std::shared_ptr<Shader> shader)
         {
@@ -142,22 +148,7 @@ namespace Lynx
         renderData.ShadowMap = m_ShadowMap;
         renderData.ShadowSampler = m_ShadowSampler;
 
-        ctx.CommandList->beginMarker("ShadowPass");
-        nvrhi::utils::ClearDepthStencilAttachment(ctx.CommandList, m_Framebuffer, 1.0f, 0);
-
-        ShadowSceneData shadowData;
-        shadowData.ViewProjectionMatrix = renderData.LightViewProj;
-        ctx.CommandList->writeBuffer(m_ShadowConstantBuffer, &shadowData, sizeof(ShadowSceneData));
-
-        auto state = nvrhi::GraphicsState()
-            .setPipeline(m_Pipeline)
-            .setFramebuffer(m_Framebuffer);
-        state.viewport.addViewport(nvrhi::Viewport(m_Resolution, m_Resolution));
-        state.viewport.addScissorRect(nvrhi::Rect(0, m_Resolution, 0, m_Resolution));
-
-        state.bindings = { m_GlobalBindingSet };
-        ctx.CommandList->setGraphicsState(state);
-
+        m_Draws.clear();
         for (const auto& batch : renderData.OpaqueDrawCalls)
         {
             if (batch.InstanceCount <= 0)
@@ -171,38 +162,65 @@ namespace Lynx
             auto material = submesh.Material.get();
             bool isMasked = (material->Mode == AlphaMode::Mask);
 
-            if (isMasked)
-            {
-                auto specificState = state;
-                specificState.bindings = { m_GlobalBindingSet, GetMaskedBindingSet(ctx, renderData, material) };
-                specificState.vertexBuffers = { nvrhi::VertexBufferBinding(submesh.VertexBuffer, 0, 0) };
-                specificState.indexBuffer = nvrhi::IndexBufferBinding(submesh.IndexBuffer, nvrhi::Format::R32_UINT);
-                ctx.CommandList->setGraphicsState(specificState);
-            }
-            else
-            {
-                // TODO: We could optimize this by sorting Opaque vs Masked.
-                state.bindings = { m_GlobalBindingSet, m_OpaqueBindingSet };
-                state.vertexBuffers = { nvrhi::VertexBufferBinding(submesh.VertexBuffer, 0, 0) };
-                state.indexBuffer = nvrhi::IndexBufferBinding(submesh.IndexBuffer, nvrhi::Format::R32_UINT);
-                ctx.CommandList->setGraphicsState(state);
-            }
+            // TODO: We could optimize this by sorting Opaque vs Masked.
+            PreparedDraw& draw = m_Draws.emplace_back();
+            draw.Mesh = &submesh;
+            draw.Pipeline = m_Pipeline;
+            draw.MaterialBindingSet = isMasked ? GetMaskedBindingSet(ctx, renderData, material) : m_OpaqueBindingSet;
+            draw.SkinBindingSet = GetSkinBindingSet(ctx, submesh);
+            draw.InstanceCount = batch.InstanceCount;
+            draw.FirstInstance = batch.FirstInstance;
+            draw.Push.AlphaCutoff = isMasked ? material->AlphaCutoff : -1.0f;
+        }
 
-            ShadowPushData push;
-            push.AlphaCutoff = isMasked ? material->AlphaCutoff : -1.0f;
+        // Always record at least one range, the shadow map needs clearing even without casters
+        return std::max(GetRangeCount(m_Draws.size()), 1u);
+    }
+
+    void ShadowPass::Record(const RenderContext& ctx, const RenderData& renderData, nvrhi::ICommandList* commandList, uint32_t rangeIndex, uint32_t rangeCount, RecordStats& stats)
+    {
+        auto [begin, end] = GetRange(m_Draws.size(), rangeIndex, rangeCount);
 
-            ctx.CommandList->setPushConstants(&push, sizeof(ShadowPushData));
+        commandList->beginMarker("ShadowPass");
+
+        // Ranges are submitted in order, so the first one clears for everyone
+        if (rangeIndex == 0)
+        {
+            nvrhi::utils::ClearDepthStencilAttachment(commandList, m_Framebuffer, 1.0f, 0);
+
+            ShadowSceneData shadowData;
+            shadowData.ViewProjectionMatrix = renderData.LightViewProj;
+            commandList->writeBuffer(m_ShadowConstantBuffer, &shadowData, sizeof(ShadowSceneData));
+        }
+
+        auto state = nvrhi::GraphicsState()
+            .setPipeline(m_Pipeline)
+            .setFramebuffer(m_Framebuffer);
+        state.viewport.addViewport(nvrhi::Viewport(m_Resolution, m_Resolution));
+        state.viewport.addScissorRect(nvrhi::Rect(0, m_Resolution, 0, m_Resolution));
+
+        for (size_t i = begin; i < end; i++)
+        {
+            const PreparedDraw& draw = m_Draws[i];
+            state.bindings = { m_GlobalBindingSet, draw.MaterialBindingSet, draw.SkinBindingSet };
+            state.vertexBuffers = { nvrhi::VertexBufferBinding(draw.Mesh->VertexBuffer, 0, 0) };
+            state.indexBuffer = nvrhi::IndexBufferBinding(draw.Mesh->IndexBuffer, nvrhi::Format::R32_UINT);
+            commandList->setGraphicsState(state);
+
+            ShadowPushData push;
+            push.AlphaCutoff = draw.Push.AlphaCutoff;
+            commandList->setPushConstants(&push, sizeof(ShadowPushData));
 
-            ctx.CommandList->drawIndexed(nvrhi::DrawArguments()
-                .setVertexCount(submesh.IndexCount)
-                .setInstanceCount(batch.InstanceCount)
-                .setStartInstanceLocation(batch.FirstInstance));
+            commandList->drawIndexed(nvrhi::DrawArguments()
+                .setVertexCount(draw.Mesh->IndexCount)
+                .setInstanceCount(draw.InstanceCount)
+                .setStartInstanceLocation(draw.FirstInstance));
 
-            //renderData.DrawCalls++;
-            //renderData.IndexCount += submesh.IndexCount * batch.InstanceCount;
+            //stats.DrawCalls++;
+            //stats.IndexCount += draw.Mesh->IndexCount * draw.InstanceCount;
         }
 
-        ctx.CommandList->endMarker();
+        commandList->endMarker();
     }
 
     
@@ -238,14 +256,16 @@ namespace Lynx
 
     void ShadowPass::CreateGlobalBindingSet(RenderContext& ctx, RenderData& renderData)
     {
-        if (m_GlobalBindingSet && m_CachedInstanceBuffer == renderData.InstanceBuffer)
+        if (m_GlobalBindingSet && m_CachedInstanceBuffer == renderData.InstanceBuffer && m_CachedBoneBuffer == renderData.BoneBuffer)
             return;
         
         m_CachedInstanceBuffer = renderData.InstanceBuffer;
+        m_CachedBoneBuffer = renderData.BoneBuffer;
         auto desc = nvrhi::BindingSetDesc()
             .addItem(nvrhi::BindingSetItem::ConstantBuffer(0, m_ShadowConstantBuffer))
             .addItem(nvrhi::BindingSetItem::PushConstants(0, sizeof(ShadowPushData)))
-            .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(10, renderData.InstanceBuffer));
+            .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(10, renderData.InstanceBuffer))
+            .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(11, renderData.BoneBuffer));
 
         m_GlobalBindingSet = ctx.Device->createBindingSet(desc, m_GlobalBindingLayout);
     }
@@ -13,6 +13,10 @@ namespace Lynx
         void Init(RenderContext& ctx) override;
         void Execute(RenderContext& ctx, RenderData& renderData) override;
 
+        bool SupportsParallelRecording() const override { return true; }
+        uint32_t Prepare(RenderContext& ctx, RenderData& renderData) override;
+        void Record(const RenderContext& ctx, const RenderData& renderData, nvrhi::ICommandList* commandList, uint32_t rangeIndex, uint32_t rangeCount, RecordStats& stats) override;
+
         nvrhi::TextureHandle GetShadowMap() const { return m_ShadowMap; }
         nvrhi::SamplerHandle GetShadowSampler() const { return m_ShadowSampler; }
 
@@ -30,6 +34,7 @@ namespace Lynx
 
         nvrhi::BufferHandle m_ShadowConstantBuffer;
         nvrhi::BufferHandle m_CachedInstanceBuffer;
+        nvrhi::BufferHandle m_CachedBoneBuffer;
 
         nvrhi::BindingLayoutHandle m_GlobalBindingLayout;
         nvrhi::BindingLayoutHandle m_MaterialBindingLayout;
@@ -40,6 +45,9 @@ namespace Lynx
         BindingSetCache<Material*> m_MaskedBindingSets;
 
         PipelineState m_PipelineState;
+
+        // Only Push.AlphaCutoff is used
+        std::vector<PreparedDraw> m_Draws;
     };
 }
 
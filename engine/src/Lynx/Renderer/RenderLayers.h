@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace Lynx
+{
+    // One bit per layer. Renderables sit on one or more layers, cameras and lights have a culling mask.
+    // SubmitScene rejects anything with (layers & mask) == 0 before it looks at bounds.
+    namespace RenderLayer
+    {
+        constexpr uint32_t Count = 32;
+
+        constexpr uint32_t None = 0;
+        constexpr uint32_t Default = 1u << 0;
+        constexpr uint32_t VFX = 1u << 1;
+        constexpr uint32_t EditorOnly = 1u << 2; // Helpers and gizmo geometry, only the editor viewport draws these
+        constexpr uint32_t NoShadow = 1u << 3; // Default lights leave this out of their shadow mask
+        constexpr uint32_t All = 0xFFFFFFFFu;
+
+        // What game cameras and lights see unless told otherwise
+        constexpr uint32_t Game = All & ~EditorOnly;
+        constexpr uint32_t Shadow = Game & ~NoShadow;
+
+        inline std::string GetName(uint32_t index)
+        {
+            switch (index)
+            {
+                case 0: return "Default";
+                case 1: return "VFX";
+                case 2: return "EditorOnly";
+                case 3: return "NoShadow";
+                default: return "Layer " + std::to_string(index);
+            }
+        }
+    }
+}
@@ -16,4 +16,40 @@ namespace Lynx
         }
         return false;
     }
+
+    void RenderPass::RecordSerial(RenderContext& ctx, RenderData& renderData)
+    {
+        uint32_t rangeCount = Prepare(ctx, renderData);
+        if (rangeCount == 0)
+            return;
+
+        RecordStats stats;
+        Record(ctx, renderData, ctx.CommandList, 0, 1, stats);
+        renderData.DrawCalls += stats.DrawCalls;
+        renderData.IndexCount += stats.IndexCount;
+    }
+
+    uint32_t RenderPass::GetRangeCount(size_t drawCount, size_t minDrawsPerRange, uint32_t maxRanges)
+    {
+        if (drawCount == 0)
+            return 0;
+
+        // Small passes aren't worth the extra command list
+        size_t ranges = (drawCount + minDrawsPerRange - 1) / minDrawsPerRange;
+        // No more ranges than there are threads to record them, workers plus the waiting main thread
+        uint32_t threads = Engine::Get().GetJobSystem().GetWorkerCount() + 1;
+        return (uint32_t)std::clamp<size_t>(ranges, 1, std::min(maxRanges, threads));
+    }
+
+    std::pair<size_t, size_t> RenderPass::GetRange(size_t drawCount, uint32_t rangeIndex, uint32_t rangeCount)
+    {
+        size_t begin = drawCount * rangeIndex / rangeCount;
+        size_t end = drawCount * (rangeIndex + 1) / rangeCount;
+        return { begin, end };
+    }
+
+    nvrhi::BindingSetHandle RenderPass::GetSkinBindingSet(const RenderContext& ctx, const Submesh& submesh)
+    {
+        return submesh.SkinBindingSet ? submesh.SkinBindingSet : ctx.EmptySkinBindingSet;
+    }
 }
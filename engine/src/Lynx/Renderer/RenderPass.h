@@ -8,6 +8,7 @@
 namespace Lynx
 {
     class Shader;
+    class TextureStreamer;
 
     enum class RenderFlags : uint8_t
     {
@@ -23,7 +24,8 @@ namespace Lynx
     {
         glm::mat4 Model;
         int EntityID;
-        float Padding[3];
+        int BoneOffset = -1; // First matrix in the bone buffer, -1 if not skinned
+        float Padding[2];
     };
 
     struct BatchKey
@@ -86,6 +88,20 @@ namespace Lynx
         RenderFlags Flags = RenderFlags::All;
     };
 
+    // Cached render state of one mesh entity, kept up to date by the scene's RenderProxyCache
+    struct RenderProxy
+    {
+        std::shared_ptr<StaticMesh> Mesh;
+        uint32_t MeshVersion = 0;
+        std::vector<Material*> Materials; // Per submesh
+        uint32_t Layers = 0;
+        GPUInstanceData InstanceData;
+        AABB WorldBounds;
+        // World space bounding sphere, for the screen size
+        glm::vec3 Center = glm::vec3(0.0f);
+        float Radius = 0.0f;
+    };
+
     struct ParticleInstanceData
     {
         glm::vec3 Position;
@@ -106,8 +122,12 @@ namespace Lynx
     struct RenderData
     {
         std::vector<RenderCommand> TransparentQueue;
+        // Translucent submeshes of WeightedBlended materials, unsorted
+        std::vector<RenderCommand> WeightedBlendedQueue;
         std::vector<BatchDrawCall> OpaqueDrawCalls;
         nvrhi::BufferHandle InstanceBuffer;
+        // Skinning palettes of all skinned instances this frame
+        nvrhi::BufferHandle BoneBuffer;
 
         std::vector<ParticleBatch> ParticleQueue;
         nvrhi::BufferHandle ParticleInstanceBuffer;
@@ -126,6 +146,11 @@ namespace Lynx
         nvrhi::SamplerHandle ShadowSampler;
 
         nvrhi::FramebufferHandle TargetFramebuffer;
+        // Weighted blended OIT, accumulation + revealage with the scene depth. Resolved onto the scene color by OITResolvePass
+        nvrhi::FramebufferHandle OITFramebuffer;
+        nvrhi::TextureHandle OITAccumulation;
+        nvrhi::TextureHandle OITRevealage;
+        bool HasOITDraws = false;
         nvrhi::TextureHandle SceneColorInput;
         nvrhi::TextureHandle BloomTexture;
 
@@ -144,12 +169,19 @@ namespace Lynx
 
         nvrhi::FramebufferInfo PresentationFramebufferInfo;
         nvrhi::FramebufferInfo FinalFramebufferInfo;
+        nvrhi::FramebufferInfo OITFramebufferInfo;
 
         nvrhi::BufferHandle GlobalConstantBuffer;
         nvrhi::TextureHandle WhiteTexture;
         nvrhi::TextureHandle BlackTexture;
         nvrhi::TextureHandle NormalTexture;
         nvrhi::TextureHandle MetallicRoughnessTexture;
+
+        // Set 2, the submesh's skin buffer. Unskinned meshes bind the empty set
+        nvrhi::BindingLayoutHandle SkinBindingLayout;
+        nvrhi::BindingSetHandle EmptySkinBindingSet;
+
+        TextureStreamer* Streamer = nullptr;
     };
 
     struct MaterialCacheEntry
@@ -159,12 +191,50 @@ namespace Lynx
     };
     
 
+    // Stats collected while recording on a worker, merged into RenderData in submission order
+    struct RecordStats
+    {
+        uint32_t DrawCalls = 0;
+        uint32_t IndexCount = 0;
+    };
+
+    // Everything needed to record one draw, resolved on the main thread in RenderPass::Prepare
+    struct PreparedDraw
+    {
+        const Submesh* Mesh = nullptr;
+        nvrhi::GraphicsPipelineHandle Pipeline;
+        nvrhi::BindingSetHandle MaterialBindingSet;
+        nvrhi::BindingSetHandle SkinBindingSet;
+        // nullptr draws into renderData.TargetFramebuffer
+        nvrhi::IFramebuffer* Framebuffer = nullptr;
+        uint32_t InstanceCount = 0;
+        uint32_t FirstInstance = 0;
+        PushData Push;
+    };
+
     class RenderPass
     {
     public:
         virtual ~RenderPass() = default;
         virtual void Init(RenderContext& ctx) = 0;
         virtual void Execute(RenderContext& ctx, RenderData& renderData) = 0;
+
+        // Parallel recording, see RenderPipeline.
+        // Prepare runs on the main thread and does everything touching shared state (shaders, binding set caches, assets).
+        // It returns how many ranges the pass wants to be split into, 0 if there is nothing to record.
+        // Record then only writes into its own command list, so ranges can be recorded on worker threads.
+        virtual bool SupportsParallelRecording() const { return false; }
+        virtual uint32_t Prepare(RenderContext& ctx, RenderData& renderData) { return 0; }
+        virtual void Record(const RenderContext& ctx, const RenderData& renderData, nvrhi::ICommandList* commandList, uint32_t rangeIndex, uint32_t rangeCount, RecordStats& stats) {}
+
+    protected:
+        // Execute for passes that implement Prepare/Record, records everything into ctx.CommandList
+        void RecordSerial(RenderContext& ctx, RenderData& renderData);
+
+        static uint32_t GetRangeCount(size_t drawCount, size_t minDrawsPerRange = 128, uint32_t maxRanges = 8);
+        static std::pair<size_t, size_t> GetRange(size_t drawCount, uint32_t rangeIndex, uint32_t rangeCount);
+
+        static nvrhi::BindingSetHandle GetSkinBindingSet(const RenderContext& ctx, const Submesh& submesh);
     };
 
     class PipelineState
@@ -0,0 +1,92 @@
+#include "RenderPipeline.h"
+
+#include "Lynx/Engine.h"
+
+namespace Lynx
+{
+    const std::vector<nvrhi::CommandListHandle>& RenderPipeline::Execute(RenderContext& ctx, RenderData& renderData)
+    {
+        m_UsedCommandLists = 0;
+        m_SubmitLists.clear();
+        m_Jobs.clear();
+
+        nvrhi::CommandListHandle mainCommandList = ctx.CommandList;
+        for (auto& pass : m_Passes)
+        {
+            if (m_ParallelRecording && pass->SupportsParallelRecording())
+            {
+                uint32_t rangeCount = pass->Prepare(ctx, renderData);
+                for (uint32_t i = 0; i < rangeCount; i++)
+                {
+                    RecordJob& job = m_Jobs.emplace_back();
+                    job.Pass = pass.get();
+                    job.RangeIndex = i;
+                    job.RangeCount = rangeCount;
+                    job.CommandList = AcquireCommandList(ctx);
+                    m_SubmitLists.push_back(job.CommandList);
+                }
+            }
+            else
+            {
+                // Serial passes record right away on the main thread, still into their own list to keep the order
+                auto commandList = AcquireCommandList(ctx);
+                commandList->open();
+                ctx.CommandList = commandList;
+                pass->Execute(ctx, renderData);
+                ctx.CommandList = mainCommandList;
+                commandList->close();
+                m_SubmitLists.push_back(commandList);
+            }
+        }
+
+        RunJobs(ctx, renderData);
+
+        for (const auto& job : m_Jobs)
+        {
+            renderData.DrawCalls += job.Stats.DrawCalls;
+            renderData.IndexCount += job.Stats.IndexCount;
+        }
+
+        return m_SubmitLists;
+    }
+
+    void RenderPipeline::Clear()
+    {
+        m_Passes.clear();
+        m_CommandListPool.clear();
+        m_SubmitLists.clear();
+        m_Jobs.clear();
+    }
+
+    nvrhi::CommandListHandle RenderPipeline::AcquireCommandList(RenderContext& ctx)
+    {
+        if (m_UsedCommandLists == m_CommandListPool.size())
+        {
+            // Not immediate, several of these are open at the same time
+            auto params = nvrhi::CommandListParameters().setEnableImmediateExecution(false);
+            m_CommandListPool.push_back(ctx.Device->createCommandList(params));
+        }
+
+        return m_CommandListPool[m_UsedCommandLists++];
+    }
+
+    void RenderPipeline::RunJobs(const RenderContext& ctx, const RenderData& renderData)
+    {
+        if (m_Jobs.empty())
+            return;
+
+        // Wait has the main thread record ranges too instead of just blocking
+        auto& jobSystem = Engine::Get().GetJobSystem();
+        JobSystem::Counter counter;
+        for (RecordJob& job : m_Jobs)
+        {
+            jobSystem.Run([&job, &ctx, &renderData]()
+            {
+                job.CommandList->open();
+                job.Pass->Record(ctx, renderData, job.CommandList, job.RangeIndex, job.RangeCount, job.Stats);
+                job.CommandList->close();
+            }, &counter);
+        }
+        jobSystem.Wait(counter);
+    }
+}
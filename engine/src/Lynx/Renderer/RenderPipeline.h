@@ -3,9 +3,14 @@
 
 namespace Lynx
 {
+    // Records the scene passes into their own command lists.
+    // Passes that support it get split into ranges which are recorded on the engine's JobSystem, everything else records on the main thread.
+    // The returned lists are always in pass/range order, so submission stays deterministic.
     class RenderPipeline
     {
     public:
+        RenderPipeline() = default;
+
         void AddPass(std::unique_ptr<RenderPass> pass)
         {
             m_Passes.push_back(std::move(pass));
@@ -17,18 +22,37 @@ namespace Lynx
                 pass->Init(ctx);
         }
 
-        void Execute(RenderContext& ctx, RenderData& renderData)
-        {
-            for (auto& pass : m_Passes)
-                pass->Execute(ctx, renderData);
-        }
+        // Returned command lists are closed and have to be executed after everything recorded before this call
+        const std::vector<nvrhi::CommandListHandle>& Execute(RenderContext& ctx, RenderData& renderData);
+
+        void Clear();
+
+        void SetParallelRecording(bool enabled) { m_ParallelRecording = enabled; }
+        bool GetParallelRecording() const { return m_ParallelRecording; }
 
-        void Clear()
+    private:
+        struct RecordJob
         {
-            m_Passes.clear();
-        }
+            RenderPass* Pass = nullptr;
+            uint32_t RangeIndex = 0;
+            uint32_t RangeCount = 0;
+            nvrhi::CommandListHandle CommandList;
+            RecordStats Stats;
+        };
+
+        nvrhi::CommandListHandle AcquireCommandList(RenderContext& ctx);
+        void RunJobs(const RenderContext& ctx, const RenderData& renderData);
 
     private:
         std::vector<std::unique_ptr<RenderPass>> m_Passes;
+
+        std::vector<nvrhi::CommandListHandle> m_CommandListPool;
+        uint32_t m_UsedCommandLists = 0;
+        std::vector<nvrhi::CommandListHandle> m_SubmitLists;
+
+        // Built on the main thread, every job only touches its own entry
+        std::vector<RecordJob> m_Jobs;
+
+        bool m_ParallelRecording = true;
     };
-}
\ No newline at end of file
+}
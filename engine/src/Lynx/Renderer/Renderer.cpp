@@ -16,6 +16,7 @@
 #include "Lynx/Asset/Shader.h"
 #include "nvrhi/validation.h"
 #include "Passes/DepthPass.h"
+#include "Passes/OITResolvePass.h"
 #include "Passes/ParticlePass.h"
 
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
@@ -77,6 +78,14 @@ namespace Lynx
                     return nvrhi::Format::D32;
                 case TextureFormat::Depth24Stencil8:
                     return nvrhi::Format::D24S8;
+                case TextureFormat::BC1:
+                    return sRGB ? nvrhi::Format::BC1_UNORM_SRGB : nvrhi::Format::BC1_UNORM;
+                case TextureFormat::BC3:
+                    return sRGB ? nvrhi::Format::BC3_UNORM_SRGB : nvrhi::Format::BC3_UNORM;
+                case TextureFormat::BC5:
+                    return nvrhi::Format::BC5_UNORM;
+                case TextureFormat::BC7:
+                    return sRGB ? nvrhi::Format::BC7_UNORM_SRGB : nvrhi::Format::BC7_UNORM;
             }
 
             return nvrhi::Format::UNKNOWN;
@@ -93,6 +102,11 @@ namespace Lynx
                 case TextureFormat::Depth32:        return 4;
                 case TextureFormat::Depth24Stencil8:return 4;
                 case TextureFormat::R8:             return 1;
+                // Block formats, bytes per 4x4 block
+                case TextureFormat::BC1:            return 8;
+                case TextureFormat::BC3:
+                case TextureFormat::BC5:
+                case TextureFormat::BC7:            return 16;
             }
             LX_CORE_WARN("Unknown Texture Format byte size, defaulting to 4");
             return 4;
@@ -143,6 +157,7 @@ namespace Lynx
         if (m_NvrhiDevice)
             m_NvrhiDevice->runGarbageCollection();
 
+        m_TextureStreamer.reset();
         m_Pipeline.Clear();
         m_BloomPass.reset();
         m_CompositePass.reset();
@@ -153,6 +168,8 @@ namespace Lynx
         m_OpaqueBatches.clear();
         m_StageBuffer = nullptr;
         m_ParticleInstanceBuffer = nullptr;
+        for (auto& timer : m_GPUTimers)
+            timer = nullptr;
 
         SamplerCache::Shutdown();
         m_WhiteTex = nullptr;
@@ -161,7 +178,13 @@ namespace Lynx
         m_MetallicRoughnessTex = nullptr;
         m_GlobalCB = nullptr;
         m_InstanceBuffer = nullptr;
+        m_BoneBuffer = nullptr;
+        m_EmptySkinBindingSet = nullptr;
+        m_EmptySkinBuffer = nullptr;
+        m_SkinBindingLayout = nullptr;
         m_CommandList = nullptr;
+        m_PostCommandList = nullptr;
+        m_SubmitLists.clear();
         m_SwapchainFramebuffers.clear();
         m_SceneTarget.reset();
         m_NvrhiDevice = nullptr;
@@ -197,6 +220,11 @@ namespace Lynx
         m_RenderContext.BlackTexture = m_BlackTex;
         m_RenderContext.NormalTexture = m_NormalTex;
         m_RenderContext.MetallicRoughnessTexture = m_MetallicRoughnessTex;
+        m_RenderContext.SkinBindingLayout = m_SkinBindingLayout;
+        m_RenderContext.EmptySkinBindingSet = m_EmptySkinBindingSet;
+
+        m_TextureStreamer = std::make_unique<TextureStreamer>();
+        m_RenderContext.Streamer = m_TextureStreamer.get();
 
         // TODO: Make sure this is up-to-date...
         nvrhi::FramebufferInfo fbInfo;
@@ -207,6 +235,11 @@ namespace Lynx
         nvrhi::FramebufferInfo finalfbInfo;
         finalfbInfo.addColorFormat(nvrhi::Format::BGRA8_UNORM);
         m_RenderContext.FinalFramebufferInfo = finalfbInfo;
+        nvrhi::FramebufferInfo oitfbInfo;
+        oitfbInfo.addColorFormat(nvrhi::Format::RGBA16_FLOAT);
+        oitfbInfo.addColorFormat(nvrhi::Format::R16_FLOAT);
+        oitfbInfo.setDepthFormat(nvrhi::Format::D32);
+        m_RenderContext.OITFramebufferInfo = oitfbInfo;
 
         SamplerCache::Init(m_NvrhiDevice, m_MaxAnisotropy);
 
@@ -214,6 +247,7 @@ namespace Lynx
         m_Pipeline.AddPass(std::make_unique<DepthPass>());
         m_Pipeline.AddPass(std::make_unique<ForwardPass>());
         m_Pipeline.AddPass(std::make_unique<ParticlePass>());
+        m_Pipeline.AddPass(std::make_unique<OITResolvePass>());
         if (m_ShouldCreateIDTarget)
         {
             m_Pipeline.AddPass(std::make_unique<GridPass>());
@@ -236,6 +270,9 @@ namespace Lynx
 
         m_UIPass = std::make_unique<UIPass>();
         m_UIPass->Init(m_RenderContext);
+
+        for (auto& timer : m_GPUTimers)
+            timer = m_NvrhiDevice->createTimerQuery();
         
         LX_CORE_INFO("Renderer initialized successfully (Pipeline loaded).");
     }
@@ -290,6 +327,92 @@ namespace Lynx
         return result;
     }
 
+    nvrhi::TextureHandle Renderer::CreateTexture(const TextureSpecification& specification, const TextureData& data)
+    {
+        if (!data.IsValid())
+            return nullptr;
+
+        // Mips come prebuilt (see TextureCompiler), so no render target / blit pass needed here
+        auto desc = nvrhi::TextureDesc()
+            .setDimension(nvrhi::TextureDimension::Texture2D)
+            .setWidth(data.Mips[0].Width)
+            .setHeight(data.Mips[0].Height)
+            .setFormat(Helpers::TextureFormatToNvrhi(data.Format, specification.IsSRGB))
+            .setDebugName(specification.DebugName)
+            .enableAutomaticStateTracking(nvrhi::ResourceStates::ShaderResource)
+            .setMipLevels((uint32_t)data.Mips.size());
+
+        auto result = m_NvrhiDevice->createTexture(desc);
+        if (!result)
+        {
+            LX_CORE_ERROR("Failed to create compressed NVRHI texture '{0}'", specification.DebugName);
+            return nullptr;
+        }
+
+        // TODO: Batch this!
+        auto cmdList = m_NvrhiDevice->createCommandList();
+        cmdList->open();
+        for (uint32_t mip = 0; mip < (uint32_t)data.Mips.size(); mip++)
+        {
+            const auto& mipData = data.Mips[mip];
+            cmdList->writeTexture(result, 0, mip, mipData.Data.data(), mipData.RowPitch, 0);
+        }
+        cmdList->close();
+        m_NvrhiDevice->executeCommandList(cmdList);
+
+        return result;
+    }
+
+    nvrhi::TextureHandle Renderer::CreateStreamedTexture(const TextureSpecification& specification, nvrhi::ITexture* resident, uint32_t residentMip,
+        uint32_t firstMip, const TextureData& newMips)
+    {
+        if (!resident)
+            return nullptr;
+
+        const nvrhi::TextureDesc& residentDesc = resident->getDesc();
+        uint32_t mipCount = residentMip + residentDesc.mipLevels;
+        if (firstMip >= mipCount || (firstMip < residentMip && (newMips.FirstMip != firstMip || newMips.Mips.size() < residentMip - firstMip)))
+            return nullptr;
+
+        auto desc = nvrhi::TextureDesc()
+            .setDimension(nvrhi::TextureDimension::Texture2D)
+            .setWidth(std::max(1u, specification.Width >> firstMip))
+            .setHeight(std::max(1u, specification.Height >> firstMip))
+            .setFormat(residentDesc.format)
+            .setDebugName(specification.DebugName)
+            .enableAutomaticStateTracking(nvrhi::ResourceStates::ShaderResource)
+            .setMipLevels(mipCount - firstMip);
+
+        auto result = m_NvrhiDevice->createTexture(desc);
+        if (!result)
+        {
+            LX_CORE_ERROR("Failed to create streamed NVRHI texture '{0}'", specification.DebugName);
+            return nullptr;
+        }
+
+        auto cmdList = m_NvrhiDevice->createCommandList();
+        cmdList->open();
+        for (uint32_t mip = firstMip; mip < residentMip; mip++)
+        {
+            const auto& mipData = newMips.Mips[mip - firstMip];
+            cmdList->writeTexture(result, 0, mip - firstMip, mipData.Data.data(), mipData.RowPitch, 0);
+        }
+
+        // Everything that's already on the GPU stays there, evicting is nothing but these copies
+        for (uint32_t mip = std::max(firstMip, residentMip); mip < mipCount; mip++)
+        {
+            nvrhi::TextureSlice dstSlice;
+            dstSlice.mipLevel = mip - firstMip;
+            nvrhi::TextureSlice srcSlice;
+            srcSlice.mipLevel = mip - residentMip;
+            cmdList->copyTexture(result, dstSlice, resident, srcSlice);
+        }
+        cmdList->close();
+        m_NvrhiDevice->executeCommandList(cmdList);
+
+        return result;
+    }
+
     int Renderer::ReadIdFromBuffer(uint32_t x, uint32_t y)
     {
         if (!m_SceneTarget || !m_SceneTarget->IdBuffer)
@@ -312,6 +435,13 @@ namespace Lynx
         m_CommandList->open();
 
         // Define the source region (the pixel under mouse)
+        // Mouse coords are in output space, the ID buffer might be rendered at a lower resolution
+        if (m_SceneTarget->RenderWidth != m_SceneTarget->Width || m_SceneTarget->RenderHeight != m_SceneTarget->Height)
+        {
+            x = std::min(m_SceneTarget->RenderWidth - 1, (uint32_t)((uint64_t)x * m_SceneTarget->RenderWidth / m_SceneTarget->Width));
+            y = std::min(m_SceneTarget->RenderHeight - 1, (uint32_t)((uint64_t)y * m_SceneTarget->RenderHeight / m_SceneTarget->Height));
+        }
+
         nvrhi::TextureSlice srcSlice;
         srcSlice.x = x;
         srcSlice.y = y;
@@ -546,6 +676,7 @@ namespace Lynx
 
         // 3. Create Command List
         m_CommandList = m_NvrhiDevice->createCommandList();
+        m_PostCommandList = m_NvrhiDevice->createCommandList(nvrhi::CommandListParameters().setEnableImmediateExecution(false));
 
         // 4. Create Default White Texture
         nvrhi::TextureDesc defaultTexDesc;
@@ -610,6 +741,33 @@ namespace Lynx
         {
             LX_CORE_ERROR("Failed to create Constant Buffer!");
         }
+
+        // Never null, so the passes can always bind it. Grows in PrepareDrawCalls
+        nvrhi::BufferDesc boneDesc;
+        boneDesc.byteSize = sizeof(glm::mat4) * 256;
+        boneDesc.structStride = sizeof(glm::mat4);
+        boneDesc.debugName = "BoneBuffer";
+        boneDesc.initialState = nvrhi::ResourceStates::ShaderResource;
+        boneDesc.keepInitialState = true;
+        m_BoneBuffer = m_NvrhiDevice->createBuffer(boneDesc);
+
+        // Skin stream (Set 2)
+        auto skinLayoutDesc = nvrhi::BindingLayoutDesc()
+            .setVisibility(nvrhi::ShaderType::Vertex)
+            .addItem(nvrhi::BindingLayoutItem::StructuredBuffer_SRV(0))
+            .setBindingOffsets({0, 0, 0, 0});
+        m_SkinBindingLayout = m_NvrhiDevice->createBindingLayout(skinLayoutDesc);
+
+        // Bound for unskinned meshes, the shader never reads it since their BoneOffset is -1
+        nvrhi::BufferDesc emptySkinDesc;
+        emptySkinDesc.byteSize = sizeof(SkinVertex);
+        emptySkinDesc.structStride = sizeof(SkinVertex);
+        emptySkinDesc.debugName = "EmptySkinBuffer";
+        emptySkinDesc.initialState = nvrhi::ResourceStates::ShaderResource;
+        emptySkinDesc.keepInitialState = true;
+        m_EmptySkinBuffer = m_NvrhiDevice->createBuffer(emptySkinDesc);
+        m_EmptySkinBindingSet = m_NvrhiDevice->createBindingSet(nvrhi::BindingSetDesc()
+            .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(0, m_EmptySkinBuffer)), m_SkinBindingLayout);
     }
     
     void Renderer::CreateRenderTarget(RenderTarget& target, uint32_t width, uint32_t height)
@@ -617,6 +775,30 @@ namespace Lynx
         target.Width = width;
         target.Height = height;
 
+        auto outputDesc = nvrhi::TextureDesc()
+            .setWidth(width)
+            .setHeight(height)
+            .setFormat(nvrhi::Format::BGRA8_UNORM)
+            .setIsRenderTarget(true)
+            .setDebugName("SceneLDR")
+            .setInitialState(nvrhi::ResourceStates::ShaderResource)
+            .setKeepInitialState(true);
+        target.Output = m_NvrhiDevice->createTexture(outputDesc);
+
+        auto ldrFBDesc = nvrhi::FramebufferDesc()
+            .addColorAttachment(target.Output);
+        target.LDRFramebuffer = m_NvrhiDevice->createFramebuffer(ldrFBDesc);
+
+        float scale = m_DynamicResolution.GetScale();
+        CreateSceneBuffers(target, std::max(1u, (uint32_t)(width * scale)), std::max(1u, (uint32_t)(height * scale)));
+    }
+
+    void Renderer::CreateSceneBuffers(RenderTarget& target, uint32_t width, uint32_t height)
+    {
+        // No waitIdle here, NVRHI keeps the old textures alive until the frames using them are done
+        target.RenderWidth = width;
+        target.RenderHeight = height;
+
         auto colorDesc = nvrhi::TextureDesc()
             .setWidth(width)
             .setHeight(height)
@@ -637,16 +819,6 @@ namespace Lynx
             .setKeepInitialState(true);
         target.Depth = m_NvrhiDevice->createTexture(depthDesc);
 
-        auto outputDesc = nvrhi::TextureDesc()
-            .setWidth(width)
-            .setHeight(height)
-            .setFormat(nvrhi::Format::BGRA8_UNORM)
-            .setIsRenderTarget(true)
-            .setDebugName("SceneLDR")
-            .setInitialState(nvrhi::ResourceStates::ShaderResource)
-            .setKeepInitialState(true);
-        target.Output = m_NvrhiDevice->createTexture(outputDesc);
-
         if (m_ShouldCreateIDTarget)
         {
             auto idDesc = nvrhi::TextureDesc()
@@ -668,9 +840,60 @@ namespace Lynx
             hdrFBDesc.addColorAttachment(target.IdBuffer);
         target.HDRFramebuffer = m_NvrhiDevice->createFramebuffer(hdrFBDesc);
 
-        auto ldrFBDesc = nvrhi::FramebufferDesc()
-            .addColorAttachment(target.Output);
-        target.LDRFramebuffer = m_NvrhiDevice->createFramebuffer(ldrFBDesc);
+        auto accumDesc = nvrhi::TextureDesc()
+            .setWidth(width)
+            .setHeight(height)
+            .setFormat(nvrhi::Format::RGBA16_FLOAT)
+            .setIsRenderTarget(true)
+            .setDebugName("OITAccumulation")
+            .setInitialState(nvrhi::ResourceStates::ShaderResource)
+            .setKeepInitialState(true)
+            .setClearValue(nvrhi::Color(0.0f));
+        target.OITAccumulation = m_NvrhiDevice->createTexture(accumDesc);
+
+        auto revealageDesc = nvrhi::TextureDesc()
+            .setWidth(width)
+            .setHeight(height)
+            .setFormat(nvrhi::Format::R16_FLOAT)
+            .setIsRenderTarget(true)
+            .setDebugName("OITRevealage")
+            .setInitialState(nvrhi::ResourceStates::ShaderResource)
+            .setKeepInitialState(true)
+            .setClearValue(nvrhi::Color(1.0f));
+        target.OITRevealage = m_NvrhiDevice->createTexture(revealageDesc);
+
+        auto oitFBDesc = nvrhi::FramebufferDesc()
+            .addColorAttachment(target.OITAccumulation)
+            .addColorAttachment(target.OITRevealage)
+            .setDepthAttachment(target.Depth);
+        target.OITFramebuffer = m_NvrhiDevice->createFramebuffer(oitFBDesc);
+    }
+
+    void Renderer::UpdateDynamicResolution()
+    {
+        // The fence for this frame slot was just waited on, so its timer is done (or never started)
+        auto& timer = m_GPUTimers[m_CurrentFrame];
+        if (timer && m_GPUTimerPending[m_CurrentFrame] && m_NvrhiDevice->pollTimerQuery(timer))
+        {
+            m_LastGPUFrameTime = m_NvrhiDevice->getTimerQueryTime(timer) * 1000.0f;
+            m_NvrhiDevice->resetTimerQuery(timer);
+            m_GPUTimerPending[m_CurrentFrame] = false;
+
+            m_DynamicResolution.Update(m_LastGPUFrameTime);
+        }
+        else if (!m_DynamicResolution.GetSettings().Enabled)
+        {
+            m_DynamicResolution.Update(0.0f);
+        }
+
+        if (!m_SceneTarget)
+            return;
+
+        float scale = m_DynamicResolution.GetScale();
+        uint32_t renderWidth = std::max(1u, (uint32_t)(m_SceneTarget->Width * scale));
+        uint32_t renderHeight = std::max(1u, (uint32_t)(m_SceneTarget->Height * scale));
+        if (renderWidth != m_SceneTarget->RenderWidth || renderHeight != m_SceneTarget->RenderHeight)
+            CreateSceneBuffers(*m_SceneTarget, renderWidth, renderHeight);
     }
 
     void Renderer::PrepareDrawCalls()
@@ -698,8 +921,16 @@ namespace Lynx
         for (auto& cmd : m_CurrentFrameData.TransparentQueue)
         {
             cmd.InstanceOffset = (int)allInstanceData.size();
-            allInstanceData.push_back({ cmd.InstanceData.Model, cmd.InstanceData.EntityID });
+            allInstanceData.push_back(cmd.InstanceData);
+        }
+
+        // Order doesn't matter for these, so no sort
+        for (auto& cmd : m_CurrentFrameData.WeightedBlendedQueue)
+        {
+            cmd.InstanceOffset = (int)allInstanceData.size();
+            allInstanceData.push_back(cmd.InstanceData);
         }
+        m_CurrentFrameData.HasOITDraws = !m_CurrentFrameData.WeightedBlendedQueue.empty();
 
         // Create or resize GPU Buffer
         size_t requiredSize = allInstanceData.size() * sizeof(GPUInstanceData);
@@ -721,6 +952,20 @@ namespace Lynx
         
         m_CurrentFrameData.InstanceBuffer = m_InstanceBuffer;
 
+        size_t requiredBoneSize = m_BoneData.size() * sizeof(glm::mat4);
+        if (requiredBoneSize > 0)
+        {
+            if (m_BoneBuffer->getDesc().byteSize < requiredBoneSize)
+            {
+                nvrhi::BufferDesc desc = m_BoneBuffer->getDesc();
+                desc.byteSize = (uint64_t)(requiredBoneSize * 1.5);
+                m_BoneBuffer = m_NvrhiDevice->createBuffer(desc);
+            }
+
+            m_CommandList->writeBuffer(m_BoneBuffer, m_BoneData.data(), requiredBoneSize);
+        }
+        m_CurrentFrameData.BoneBuffer = m_BoneBuffer;
+
         std::vector<ParticleInstanceData> allParticleData;
         m_CurrentFrameData.ParticleQueue.clear();
 
@@ -736,6 +981,9 @@ namespace Lynx
 
             m_CurrentFrameData.ParticleQueue.push_back(batch);
             allParticleData.insert(allParticleData.end(), particles.begin(), particles.end());
+
+            if (material->IsWeightedBlended())
+                m_CurrentFrameData.HasOITDraws = true;
         }
 
         size_t requiredParticleSize = allParticleData.size() * sizeof(ParticleInstanceData);
@@ -755,6 +1003,12 @@ namespace Lynx
             m_CommandList->writeBuffer(m_ParticleInstanceBuffer, allParticleData.data(), requiredParticleSize);
         }
         m_CurrentFrameData.ParticleInstanceBuffer = m_ParticleInstanceBuffer;
+
+        if (m_CurrentFrameData.HasOITDraws)
+        {
+            m_CommandList->clearTextureFloat(m_SceneTarget->OITAccumulation, nvrhi::AllSubresources, nvrhi::Color(0.0f));
+            m_CommandList->clearTextureFloat(m_SceneTarget->OITRevealage, nvrhi::AllSubresources, nvrhi::Color(1.0f));
+        }
     }
 
     void Renderer::BeginScene(const glm::mat4& view, const glm::mat4 projection, const glm::vec3& cameraPosition, const glm::vec3& lightDir, const glm::vec3& lightColor, float lightIntensity, float deltaTime, bool editMode)
@@ -769,6 +1023,18 @@ namespace Lynx
         }
         m_VulkanState->Device.resetFences(1, &m_VulkanState->InFlightFences[m_CurrentFrame]);
 
+        if (!m_SceneTarget)
+        {
+            auto [w, h] = GetViewportSize();
+            m_SceneTarget = std::make_unique<RenderTarget>();
+            CreateRenderTarget(*m_SceneTarget, w, h);
+        }
+        UpdateDynamicResolution();
+        m_Stats.GPUFrameTime = m_LastGPUFrameTime;
+        m_Stats.RenderScale = m_DynamicResolution.GetScale();
+        m_Stats.RenderWidth = m_SceneTarget->RenderWidth;
+        m_Stats.RenderHeight = m_SceneTarget->RenderHeight;
+
         // 1. Acquire Image from Vulkan
         // TODO: handle resizing (VK_ERROR_OUT_OF_DATE_KHR)
         auto result = m_VulkanState->Device.acquireNextImageKHR(
@@ -782,11 +1048,15 @@ namespace Lynx
 
         // 2. Start recording
         m_CommandList->open();
+        if (m_GPUTimers[m_CurrentFrame])
+            m_CommandList->beginTimerQuery(m_GPUTimers[m_CurrentFrame]);
 
         m_OpaqueBatches.clear();
         m_ParticleBatches.clear();
+        m_BoneData.clear();
         m_CurrentFrameData.OpaqueDrawCalls.clear();
         m_CurrentFrameData.TransparentQueue.clear();
+        m_CurrentFrameData.WeightedBlendedQueue.clear();
         m_CurrentFrameData.ParticleQueue.clear();
         
         glm::vec3 center = cameraPosition;
@@ -844,15 +1114,12 @@ namespace Lynx
         m_CurrentFrameData.LightIntensity = lightIntensity;
         m_CurrentFrameData.LightViewProj = lightViewProj;
         m_CurrentFrameData.ShowGrid = editMode && m_ShowGrid;
-        if (!m_SceneTarget)
-        {
-            auto [w, h] = GetViewportSize();
-            m_SceneTarget = std::make_unique<RenderTarget>();
-            CreateRenderTarget(*m_SceneTarget, w, h);
-        }
 
         m_CurrentFrameData.TargetFramebuffer = m_SceneTarget->HDRFramebuffer;
         m_CurrentFrameData.SceneColorInput = m_SceneTarget->Color;
+        m_CurrentFrameData.OITFramebuffer = m_SceneTarget->OITFramebuffer;
+        m_CurrentFrameData.OITAccumulation = m_SceneTarget->OITAccumulation;
+        m_CurrentFrameData.OITRevealage = m_SceneTarget->OITRevealage;
         if (m_SceneTarget->IdBuffer)
             m_CommandList->clearTextureUInt(m_SceneTarget->IdBuffer, nvrhi::AllSubresources, (uint32_t)-1);
         
@@ -874,43 +1141,63 @@ namespace Lynx
         if (!mesh)
             return;
 
-        float dist = glm::distance(m_CurrentFrameData.CameraPosition, glm::vec3(transform[3]));
+        GPUInstanceData instance = { transform, entityID };
+        SubmitMeshInstance(mesh, instance, mesh->GetBounds(), Flags);
+    }
 
-        for (int i = 0; i < mesh->GetSubmeshes().size(); ++i)
-        {
-            const auto& submesh = mesh->GetSubmeshes()[i];
+    void Renderer::SubmitSkinnedMesh(std::shared_ptr<StaticMesh> mesh, const glm::mat4& transform, const std::vector<glm::mat4>& palette, const AABB& bounds, RenderFlags flags, int entityID)
+    {
+        if (!mesh)
+            return;
 
-            GPUInstanceData instance = { transform, entityID };
-            BatchKey key = { mesh.get(), (uint32_t)i, submesh.Material.get(), Flags };
+        GPUInstanceData instance = { transform, entityID };
+        instance.BoneOffset = (int)m_BoneData.size();
+        m_BoneData.insert(m_BoneData.end(), palette.begin(), palette.end());
+        SubmitMeshInstance(mesh, instance, bounds, flags);
+    }
 
-            if (submesh.Material->Mode == AlphaMode::Translucent)
-            {
-                RenderCommand cmd;
-                cmd.Mesh = mesh;
-                cmd.SubmeshIndex = i;
-                cmd.InstanceData = instance;
-                cmd.DistanceToCamera = dist;
-                cmd.Flags = Flags;
-                m_CurrentFrameData.TransparentQueue.push_back(cmd);
-            }
+    void Renderer::SubmitMeshInstance(const std::shared_ptr<StaticMesh>& mesh, const GPUInstanceData& instance, const AABB& bounds, RenderFlags flags)
+    {
+        float dist = glm::distance(m_CurrentFrameData.CameraPosition, glm::vec3(instance.Model[3]));
+        float screenSize = GetScreenSize(bounds, instance.Model);
+
+        const auto& submeshes = mesh->GetSubmeshes();
+        for (uint32_t i = 0; i < submeshes.size(); ++i)
+            QueueSubmesh(mesh, i, submeshes[i].Material.get(), instance, flags, dist, screenSize);
+    }
+
+    void Renderer::SubmitProxy(const RenderProxy& proxy, RenderFlags flags)
+    {
+        float dist = glm::distance(m_CurrentFrameData.CameraPosition, glm::vec3(proxy.InstanceData.Model[3]));
+        float screenSize = GetScreenSize(proxy.Center, proxy.Radius);
+
+        for (uint32_t i = 0; i < proxy.Materials.size(); ++i)
+            QueueSubmesh(proxy.Mesh, i, proxy.Materials[i], proxy.InstanceData, flags, dist, screenSize);
+    }
+
+    void Renderer::QueueSubmesh(const std::shared_ptr<StaticMesh>& mesh, uint32_t submeshIndex, Material* material, const GPUInstanceData& instance, RenderFlags flags, float distance, float screenSize)
+    {
+        if (m_TextureStreamer)
+            m_TextureStreamer->RequestMaterial(material, screenSize);
+
+        if (material->Mode == AlphaMode::Translucent)
+        {
+            RenderCommand cmd;
+            cmd.Mesh = mesh;
+            cmd.SubmeshIndex = (int)submeshIndex;
+            cmd.InstanceData = instance;
+            cmd.DistanceToCamera = distance;
+            cmd.Flags = flags;
+            if (material->IsWeightedBlended())
+                m_CurrentFrameData.WeightedBlendedQueue.push_back(cmd);
             else
-            {
-                m_OpaqueBatches[key].push_back(instance);
-            }
+                m_CurrentFrameData.TransparentQueue.push_back(cmd);
+        }
+        else
+        {
+            BatchKey key = { mesh.get(), submeshIndex, material, flags };
+            m_OpaqueBatches[key].push_back(instance);
         }
-        // 1. Bind Texture
-        // Check if mesh has a texture. If so, bind it. If not, use white texture.
-        // NOTE: This is expensive to do per-draw-call (creating BindingSet).
-        // Optimization for later: Cache BindingSets in the Mesh or a Material.
-
-        // For now, let's reuse SetTexture logic or just call it here.
-        // We need to access the AssetManager to get the texture by UUID,
-        // OR just assume Mesh holds the Texture pointer directly?
-        // You implemented Mesh. Does it hold UUID or shared_ptr?
-        // If UUID, we need AssetManager. If ptr, easy.
-
-        // Let's assume for V1 we just use the currently bound texture (from SetTexture)
-        // OR we implement a simple lookup.
     }
 
     void Renderer::SubmitParticles(Material* material, const std::vector<ParticleInstanceData>& particles)
@@ -918,6 +1205,15 @@ namespace Lynx
         if (!material || particles.empty())
             return;
 
+        // The biggest particle on screen decides
+        if (m_TextureStreamer)
+        {
+            float screenSize = 0.0f;
+            for (const auto& particle : particles)
+                screenSize = std::max(screenSize, GetScreenSize(particle.Position, particle.Size * 0.5f));
+            m_TextureStreamer->RequestMaterial(material, screenSize);
+        }
+
         auto& batch = m_ParticleBatches[material];
         batch.insert(batch.end(), particles.begin(), particles.end());
     }
@@ -925,8 +1221,13 @@ namespace Lynx
     void Renderer::EndScene()
     {
         PrepareDrawCalls();
-        
-        m_Pipeline.Execute(m_RenderContext, m_CurrentFrameData);
+
+        // Clears and uploads go first, the pipeline records its passes into separate lists (partly on worker threads)
+        m_CommandList->close();
+        const auto& passCommandLists = m_Pipeline.Execute(m_RenderContext, m_CurrentFrameData);
+
+        m_PostCommandList->open();
+        m_RenderContext.CommandList = m_PostCommandList;
 
         m_Stats.DrawCalls = m_CurrentFrameData.DrawCalls;
         m_Stats.IndexCount = m_CurrentFrameData.IndexCount;
@@ -948,9 +1249,22 @@ namespace Lynx
 
         if (m_ShowUI)
             m_UIPass->Execute(m_RenderContext, m_CurrentFrameData);
+
+        if (m_GPUTimers[m_CurrentFrame])
+        {
+            m_PostCommandList->endTimerQuery(m_GPUTimers[m_CurrentFrame]);
+            m_GPUTimerPending[m_CurrentFrame] = true;
+        }
         
         // 1. Close recording
-        m_CommandList->close();
+        m_PostCommandList->close();
+        m_RenderContext.CommandList = m_CommandList;
+
+        m_SubmitLists.clear();
+        m_SubmitLists.push_back(m_CommandList);
+        for (const auto& commandList : passCommandLists)
+            m_SubmitLists.push_back(commandList);
+        m_SubmitLists.push_back(m_PostCommandList);
 
         // 2. Execute
         nvrhi::vulkan::IDevice* vkDevice = static_cast<nvrhi::vulkan::IDevice*>(m_NvrhiDevice.Get());
@@ -961,7 +1275,8 @@ namespace Lynx
         // SYNC: Signal RenderFinished after executing
         vkDevice->queueSignalSemaphore(nvrhi::CommandQueue::Graphics, (VkSemaphore)m_VulkanState->RenderFinishedSemaphores[m_CurrentImageIndex], 0);
 
-        m_NvrhiDevice->executeCommandList(m_CommandList);
+        // One submission, in recording order
+        m_NvrhiDevice->executeCommandLists(m_SubmitLists.data(), m_SubmitLists.size());
 
         m_ImGuiBackend->render(m_SwapchainFramebuffers[m_CurrentImageIndex]);
 
@@ -983,6 +1298,34 @@ namespace Lynx
         m_VulkanState->GraphicsQueue.presentKHR(&presentInfo);
         
         m_CurrentFrame = (m_CurrentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+
+        if (m_TextureStreamer)
+            m_TextureStreamer->Update();
+    }
+
+    float Renderer::GetScreenSize(const AABB& bounds, const glm::mat4& transform) const
+    {
+        glm::vec3 center = glm::vec3(transform * glm::vec4((bounds.Min + bounds.Max) * 0.5f, 1.0f));
+        float maxScale = std::max({ glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2])) });
+        float radius = glm::length(bounds.Max - bounds.Min) * 0.5f * maxScale;
+        return GetScreenSize(center, radius);
+    }
+
+    float Renderer::GetScreenSize(const glm::vec3& center, float radius) const
+    {
+        // Projected diameter of the bounding sphere in pixels
+        float height = m_SceneTarget ? (float)m_SceneTarget->RenderHeight : 0.0f;
+        const glm::mat4& proj = m_CurrentFrameData.Projection;
+
+        // Orthographic, size doesn't depend on distance
+        if (proj[3][3] == 1.0f)
+            return radius * proj[1][1] * height;
+
+        float dist = glm::distance(m_CurrentFrameData.CameraPosition, center);
+        if (dist <= radius)
+            return FLT_MAX;
+
+        return radius / dist * proj[1][1] * height;
     }
 
     std::pair<nvrhi::BufferHandle, nvrhi::BufferHandle> Renderer::CreateMeshBuffers(std::vector<Vertex> vertices, std::vector<uint32_t> indices)
@@ -1013,6 +1356,31 @@ namespace Lynx
         return { vb, ib };
     }
 
+    std::pair<nvrhi::BufferHandle, nvrhi::BindingSetHandle> Renderer::CreateSkinBuffer(const std::vector<SkinVertex>& skinVertices)
+    {
+        if (skinVertices.empty())
+            return { nullptr, nullptr };
+
+        auto desc = nvrhi::BufferDesc()
+            .setByteSize(skinVertices.size() * sizeof(SkinVertex))
+            .setStructStride(sizeof(SkinVertex))
+            .setDebugName("MeshSkinBuffer")
+            .setInitialState(nvrhi::ResourceStates::ShaderResource)
+            .setKeepInitialState(true);
+        nvrhi::BufferHandle buffer = m_NvrhiDevice->createBuffer(desc);
+
+        nvrhi::CommandListHandle commandList = m_NvrhiDevice->createCommandList();
+        commandList->open();
+        commandList->writeBuffer(buffer, skinVertices.data(), desc.byteSize);
+        commandList->close();
+        m_NvrhiDevice->executeCommandList(commandList);
+
+        auto bindingSet = m_NvrhiDevice->createBindingSet(nvrhi::BindingSetDesc()
+            .addItem(nvrhi::BindingSetItem::StructuredBuffer_SRV(0, buffer)), m_SkinBindingLayout);
+
+        return { buffer, bindingSet };
+    }
+
     void Renderer::OnResize(uint32_t width, uint32_t height)
     {
         if (width == 0 || height == 0) return;
@@ -1081,6 +1449,10 @@ namespace Lynx
             m_SwapchainFramebuffers.push_back(m_NvrhiDevice->createFramebuffer(fbDesc));
         }
 
+        // Game renders straight to the swapchain, so the scene target follows the window
+        if (!m_ShouldCreateIDTarget)
+            m_SceneTarget.reset();
+
         //EnsureEditorViewport(width, height);
     }
 
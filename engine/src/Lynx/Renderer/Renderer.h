@@ -10,10 +10,13 @@
 
 #include "RenderPipeline.h"
 #include "RenderPass.h"
+#include "RenderLayers.h"
 #include "Lynx/UI/Rendering/UIPass.h"
 #include "Passes/BloomPass.h"
 #include "Passes/CompositePass.h"
 #include "Passes/MipMapBlitPass.h"
+#include "DynamicResolution.h"
+#include "TextureStreamer.h"
 
 struct GLFWwindow;
 
@@ -32,14 +35,22 @@ namespace Lynx
             nvrhi::TextureHandle Depth;
             // LDR Final Color (BGRA8_UNORM)
             nvrhi::TextureHandle Output;
-            // Framebuffer for ForwardPass (Color + Depth)
+            // Framebuffer for ForwardPass (Color + Depth), sized to RenderWidth/RenderHeight
             nvrhi::FramebufferHandle HDRFramebuffer;
             // Framebuffer for CompositePass (Output)
             nvrhi::FramebufferHandle LDRFramebuffer;
             // ID buffer for picking
             nvrhi::TextureHandle IdBuffer;
+            // Weighted blended OIT targets (RGBA16_FLOAT accumulation, R16_FLOAT revealage), share Depth
+            nvrhi::TextureHandle OITAccumulation;
+            nvrhi::TextureHandle OITRevealage;
+            nvrhi::FramebufferHandle OITFramebuffer;
+            // Output size
             uint32_t Width = 0;
             uint32_t Height = 0;
+            // Scene passes render at this size (dynamic resolution), composite upscales to Width/Height
+            uint32_t RenderWidth = 0;
+            uint32_t RenderHeight = 0;
         };
 
         struct RenderStats
@@ -47,6 +58,10 @@ namespace Lynx
             uint32_t DrawCalls = 0;
             uint32_t IndexCount = 0;
             float FrameTime = 0.0f;
+            float GPUFrameTime = 0.0f; // ms, from the last completed frame
+            float RenderScale = 1.0f;
+            uint32_t RenderWidth = 0;
+            uint32_t RenderHeight = 0;
         };
         
         Renderer(GLFWwindow* window, bool initIDTarget = false);
@@ -65,11 +80,22 @@ namespace Lynx
 
         std::pair<nvrhi::BufferHandle, nvrhi::BufferHandle> CreateMeshBuffers(std::vector<Vertex> vertices, std::vector<uint32_t> indices);
         void SubmitMesh(std::shared_ptr<StaticMesh> mesh, const glm::mat4& transform, RenderFlags flags, int entityID = -1);
+        // Same as SubmitMesh, but everything derived from the transform is already cached
+        void SubmitProxy(const RenderProxy& proxy, RenderFlags flags);
+        // Palette is in mesh space (joint model matrix * inverse bind), batches with every other instance of the mesh.
+        // Bounds are the mesh space bounds of the pose, see SkeletalMesh::GetPoseBounds
+        void SubmitSkinnedMesh(std::shared_ptr<StaticMesh> mesh, const glm::mat4& transform, const std::vector<glm::mat4>& palette, const AABB& bounds, RenderFlags flags, int entityID = -1);
+        std::pair<nvrhi::BufferHandle, nvrhi::BindingSetHandle> CreateSkinBuffer(const std::vector<SkinVertex>& skinVertices);
         void SubmitParticles(Material* material, const std::vector<ParticleInstanceData>& particles);
 
         nvrhi::DeviceHandle GetDeviceHandle() const { return m_NvrhiDevice; }
 
         nvrhi::TextureHandle CreateTexture(const TextureSpecification& specification, unsigned char* data);
+        nvrhi::TextureHandle CreateTexture(const TextureSpecification& specification, const TextureData& data);
+        // Streaming: a texture with mips firstMip.. of the full chain. Whatever resident (starting at residentMip) already has
+        // is copied over on the GPU, newMips only has to hold the mips above that.
+        nvrhi::TextureHandle CreateStreamedTexture(const TextureSpecification& specification, nvrhi::ITexture* resident, uint32_t residentMip,
+            uint32_t firstMip, const TextureData& newMips);
 
         int ReadIdFromBuffer(uint32_t x, uint32_t y);
 
@@ -82,6 +108,10 @@ namespace Lynx
         void SetShowUI(bool show) { m_ShowUI = show; }
         bool GetShowUI() const { return m_ShowUI; }
 
+        // Layers the editor viewport draws, game cameras use CameraComponent::CullingMask
+        void SetEditorCullingMask(uint32_t mask) { m_EditorCullingMask = mask; }
+        uint32_t GetEditorCullingMask() const { return m_EditorCullingMask; }
+
         const RenderStats& GetRenderStats() const { return m_Stats; }
         void ResetStats();
 
@@ -94,6 +124,18 @@ namespace Lynx
         void SetFXAAEnabled(bool enabled) { m_FXAAEnabled = enabled; }
         bool GetFXAAEnabled() const { return m_FXAAEnabled; }
 
+        DynamicResolutionSettings& GetDynamicResolutionSettings() { return m_DynamicResolution.GetSettings(); }
+        const DynamicResolutionSettings& GetDynamicResolutionSettings() const { return m_DynamicResolution.GetSettings(); }
+        float GetRenderScale() const { return m_DynamicResolution.GetScale(); }
+
+        TextureStreamer* GetTextureStreamer() const { return m_TextureStreamer.get(); }
+
+        void SetParallelRecording(bool enabled) { m_Pipeline.SetParallelRecording(enabled); }
+        bool GetParallelRecording() const { return m_Pipeline.GetParallelRecording(); }
+
+        void SetStaticBatching(bool enabled) { m_StaticBatching = enabled; }
+        bool GetStaticBatching() const { return m_StaticBatching; }
+
         void SetMaxAnisotropy(float maxAnisotropy) { m_MaxAnisotropy = maxAnisotropy; }
         float GetMaxAnisotropy() const { return m_MaxAnisotropy; }
 
@@ -102,6 +144,12 @@ namespace Lynx
         void InitNVRHI();
         void InitBuffers();
         void CreateRenderTarget(RenderTarget& target, uint32_t width, uint32_t height);
+        void CreateSceneBuffers(RenderTarget& target, uint32_t width, uint32_t height);
+        void UpdateDynamicResolution();
+        float GetScreenSize(const AABB& bounds, const glm::mat4& transform) const;
+        float GetScreenSize(const glm::vec3& center, float radius) const;
+        void SubmitMeshInstance(const std::shared_ptr<StaticMesh>& mesh, const GPUInstanceData& instance, const AABB& bounds, RenderFlags flags);
+        void QueueSubmesh(const std::shared_ptr<StaticMesh>& mesh, uint32_t submeshIndex, Material* material, const GPUInstanceData& instance, RenderFlags flags, float distance, float screenSize);
         void PrepareDrawCalls();
 
     private:
@@ -110,11 +158,19 @@ namespace Lynx
         std::unique_ptr<VulkanState> m_VulkanState;
         
         nvrhi::DeviceHandle m_NvrhiDevice;
+        // Frame is split into: m_CommandList (clears, uploads), the pipeline's pass lists, m_PostCommandList (bloom, composite, UI)
         nvrhi::CommandListHandle m_CommandList;
+        nvrhi::CommandListHandle m_PostCommandList;
+        std::vector<nvrhi::ICommandList*> m_SubmitLists;
         nvrhi::StagingTextureHandle m_StageBuffer;
 
         nvrhi::BufferHandle m_GlobalCB;
         nvrhi::BufferHandle m_InstanceBuffer;
+        nvrhi::BufferHandle m_BoneBuffer;
+        std::vector<glm::mat4> m_BoneData;
+        nvrhi::BindingLayoutHandle m_SkinBindingLayout;
+        nvrhi::BufferHandle m_EmptySkinBuffer;
+        nvrhi::BindingSetHandle m_EmptySkinBindingSet;
         nvrhi::TextureHandle m_WhiteTex;
         nvrhi::TextureHandle m_NormalTex;
         nvrhi::TextureHandle m_BlackTex;
@@ -149,10 +205,19 @@ namespace Lynx
         bool m_ShowGrid = true;
         bool m_ShowColliders = false;
         bool m_ShowUI = true;
+        uint32_t m_EditorCullingMask = RenderLayer::All;
         bool m_FXAAEnabled = true;
+        bool m_StaticBatching = true;
         float m_MaxAnisotropy = 16.0f;
 
         RenderStats m_Stats;
+
+        DynamicResolution m_DynamicResolution;
+        std::array<nvrhi::TimerQueryHandle, MAX_FRAMES_IN_FLIGHT> m_GPUTimers;
+        std::array<bool, MAX_FRAMES_IN_FLIGHT> m_GPUTimerPending = {};
+        float m_LastGPUFrameTime = 0.0f;
+
+        std::unique_ptr<TextureStreamer> m_TextureStreamer;
     };
 }
 
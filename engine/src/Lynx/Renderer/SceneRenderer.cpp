@@ -2,11 +2,37 @@
 
 #include "DebugRenderer.h"
 #include "Lynx/Engine.h"
+#include "Lynx/Scene/Components/AnimationComponents.h"
 #include "Lynx/Scene/Components/Components.h"
 #include "Lynx/Scene/Components/PhysicsComponents.h"
 
 namespace Lynx
 {
+    namespace Helpers
+    {
+        // Layer masks go first, they reject whole categories without any bounds math
+        static RenderFlags CullLayers(uint32_t layers, uint32_t cullingMask, uint32_t shadowMask)
+        {
+            RenderFlags flags = RenderFlags::None;
+            if (layers & cullingMask)
+                flags = flags | RenderFlags::MainPass;
+            if (layers & shadowMask)
+                flags = flags | RenderFlags::ShadowPass;
+            return flags;
+        }
+
+        // TODO: Check if this is worth it. Using these flags splits the batches up, so more draw calls, but less geometry drawn...
+        static RenderFlags CullBounds(const AABB& bounds, RenderFlags candidates, const Frustum& camFrustum, const Frustum& lightFrustum)
+        {
+            RenderFlags flags = RenderFlags::None;
+            if ((candidates & RenderFlags::MainPass) && camFrustum.IsOnFrustum(bounds))
+                flags = flags | RenderFlags::MainPass;
+            if ((candidates & RenderFlags::ShadowPass) && lightFrustum.IsOnFrustum(bounds))
+                flags = flags | RenderFlags::ShadowPass;
+            return flags;
+        }
+    }
+
     SceneRenderer::SceneRenderer(std::shared_ptr<Scene> scene)
         : m_Scene(scene)
     {
@@ -36,7 +62,7 @@ namespace Lynx
         
         if (m_ViewportDirty)
             camera.SetViewportSize(m_ViewportWidth, m_ViewportHeight);
-        SubmitScene(camera.GetView(), camera.GetProjection(), camera.GetPosition(), deltaTime, true);
+        SubmitScene(camera.GetView(), camera.GetProjection(), camera.GetPosition(), Engine::Get().GetRenderer().GetEditorCullingMask(), deltaTime, true);
         m_ViewportDirty = false;
     }
 
@@ -79,7 +105,7 @@ namespace Lynx
                         }
                     }
 
-                    SubmitScene(glm::inverse(interpolatedWorldMatrix), camera.Camera.GetProjection(), transform.Translation, deltaTime, false, physicsAlpha);
+                    SubmitScene(glm::inverse(interpolatedWorldMatrix), camera.Camera.GetProjection(), transform.Translation, camera.CullingMask, deltaTime, false, physicsAlpha);
                     m_ViewportDirty = false;
                     break;
                 }
@@ -87,7 +113,7 @@ namespace Lynx
         }
     }
 
-    void SceneRenderer::SubmitScene(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos, float deltaTime, bool isEditor, float physicsAlpha)
+    void SceneRenderer::SubmitScene(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos, uint32_t cullingMask, float deltaTime, bool isEditor, float physicsAlpha)
     {
         auto& renderer = Engine::Get().GetRenderer();
         auto& assetManager = Engine::Get().GetAssetManager();
@@ -95,6 +121,7 @@ namespace Lynx
         glm::vec3 lightDir = { -0.5f, -0.7f, 1.0f };
         glm::vec3 lightColor = { 1.0f, 1.0f, 1.0f };
         float lightIntensity = 1.0f;
+        uint32_t shadowMask = RenderLayer::Shadow;
 
         auto sunView = m_Scene->Reg().view<TransformComponent, DirectionalLightComponent>(entt::exclude<DisabledComponent>);
         for (auto entity : sunView)
@@ -103,6 +130,7 @@ namespace Lynx
             lightDir = glm::rotate(transform.Rotation, glm::vec3(0.0f, 0.0f, -1.0f));
             lightColor = light.Color;
             lightIntensity = light.Intensity;
+            shadowMask = light.CastShadows ? light.ShadowCullingMask : RenderLayer::None;
             break;
         }
         
@@ -112,77 +140,88 @@ namespace Lynx
         camFrustum.FromViewProjection(projection * view);
         Frustum lightFrustum;
         lightFrustum.FromViewProjection(renderer.GetLightViewProjMatrix());
-        
-        if (!isEditor)
+
+        // Static entities are drawn through their cluster, which isn't pickable (select them in the hierarchy or turn batching off)
+        auto* staticBatcher = m_Scene->GetStaticBatcher();
+        if (renderer.GetStaticBatching())
         {
-            auto physicsView = m_Scene->Reg().view<TransformComponent, MeshComponent, CharacterControllerComponent>(entt::exclude<DisabledComponent>);
-            for (auto entity : physicsView)
-            {
-                auto [transform, mesh] = physicsView.get<TransformComponent, MeshComponent>(entity);
-                if (mesh.Mesh)
-                {
-                    auto finalTransform = transform.GetPhysicsInterpolatedTransform(physicsAlpha);
-                    AABB worldBounds = TransformAABB(mesh.Mesh->GetBounds(), finalTransform);
-                    // TODO: Check if this is worth it. Using these flags splits the batches up, so more draw calls, but less geometry drawn...
-                    RenderFlags flags = RenderFlags::None;
-                    if (camFrustum.IsOnFrustum(worldBounds))
-                        flags = flags | RenderFlags::MainPass;
-                    if (lightFrustum.IsOnFrustum(worldBounds))
-                        flags = flags | RenderFlags::ShadowPass;
-                    if (flags != RenderFlags::None)
-                    {
-                        renderer.SubmitMesh(mesh.Mesh.Get(), finalTransform, flags, (int)entity);
-                    }
-                }
-            }
-            
-            auto meshView = m_Scene->Reg().view<TransformComponent, MeshComponent>(entt::exclude<DisabledComponent, CharacterControllerComponent>);
-            for (auto entity : meshView)
+            staticBatcher->Update(m_Scene.get(), isEditor);
+            // Clusters only hold default layer meshes
+            RenderFlags clusterCandidates = Helpers::CullLayers(RenderLayer::Default, cullingMask, shadowMask);
+            for (const auto& [cell, cluster] : staticBatcher->GetClusters())
             {
-                auto [transform, meshComp] = meshView.get<TransformComponent, MeshComponent>(entity);
-            
-                if (meshComp.Mesh)
-                {
-                    AABB worldBounds = TransformAABB(meshComp.Mesh->GetBounds(), transform.WorldMatrix);
-                    // TODO: Check if this is worth it. Using these flags splits the batches up, so more draw calls, but less geometry drawn...
-                    RenderFlags flags = RenderFlags::None;
-                    if (camFrustum.IsOnFrustum(worldBounds))
-                        flags = flags | RenderFlags::MainPass;
-                    if (lightFrustum.IsOnFrustum(worldBounds))
-                        flags = flags | RenderFlags::ShadowPass;
-                    if (flags != RenderFlags::None)
-                    {
-                        renderer.SubmitMesh(meshComp.Mesh.Get(), transform.WorldMatrix, flags, (int)entity);
-                    }
-                }
+                if (!cluster.Mesh || clusterCandidates == RenderFlags::None)
+                    continue;
+
+                RenderFlags flags = Helpers::CullBounds(cluster.Bounds, clusterCandidates, camFrustum, lightFrustum);
+                if (flags != RenderFlags::None)
+                    renderer.SubmitMesh(cluster.Mesh, glm::mat4(1.0f), flags, -1);
             }
         }
         else
         {
-            auto meshView = m_Scene->Reg().view<TransformComponent, MeshComponent>(entt::exclude<DisabledComponent>);
-            for (auto entity : meshView)
+            staticBatcher->Clear(m_Scene.get());
+        }
+        
+        // Character controllers are interpolated at runtime, so they can't use a cached transform
+        auto physicsView = m_Scene->Reg().view<TransformComponent, MeshComponent, CharacterControllerComponent>(entt::exclude<DisabledComponent>);
+        for (auto entity : physicsView)
+        {
+            auto [transform, mesh] = physicsView.get<TransformComponent, MeshComponent>(entity);
+            RenderFlags candidates = Helpers::CullLayers(mesh.Layers, cullingMask, shadowMask);
+            if (mesh.Mesh && candidates != RenderFlags::None)
             {
-                auto [transform, meshComp] = meshView.get<TransformComponent, MeshComponent>(entity);
-            
-                if (meshComp.Mesh)
+                auto finalTransform = isEditor ? transform.WorldMatrix : transform.GetPhysicsInterpolatedTransform(physicsAlpha);
+                AABB worldBounds = TransformAABB(mesh.Mesh->GetBounds(), finalTransform);
+                RenderFlags flags = Helpers::CullBounds(worldBounds, candidates, camFrustum, lightFrustum);
+                if (flags != RenderFlags::None)
                 {
-                    AABB worldBounds = TransformAABB(meshComp.Mesh->GetBounds(), transform.WorldMatrix);
-                    // TODO: Check if this is worth it. Using these flags splits the batches up, so more draw calls, but less geometry drawn...
-                    RenderFlags flags = RenderFlags::None;
-                    if (camFrustum.IsOnFrustum(worldBounds))
-                        flags = flags | RenderFlags::MainPass;
-                    if (lightFrustum.IsOnFrustum(worldBounds))
-                        flags = flags | RenderFlags::ShadowPass;
-                    if (flags != RenderFlags::None)
-                    {
-                        renderer.SubmitMesh(meshComp.Mesh.Get(), transform.WorldMatrix, flags, (int)entity);
-                    }
+                    renderer.SubmitMesh(mesh.Mesh.Get(), finalTransform, flags, (int)entity);
                 }
             }
         }
-        
-        
-        
+
+        // Everything else comes from the proxy cache, rebuilt only for entities that changed
+        auto* renderProxies = m_Scene->GetRenderProxies();
+        renderProxies->Flush(m_Scene->Reg());
+        for (const auto& proxy : renderProxies->GetProxies())
+        {
+            RenderFlags candidates = Helpers::CullLayers(proxy.Layers, cullingMask, shadowMask);
+            if (candidates == RenderFlags::None)
+                continue;
+
+            RenderFlags flags = Helpers::CullBounds(proxy.WorldBounds, candidates, camFrustum, lightFrustum);
+            if (flags != RenderFlags::None)
+                renderer.SubmitProxy(proxy, flags);
+        }
+
+        // Skinned meshes, batched per mesh like static ones. No palette yet (editor) means bind pose
+        auto animatorView = m_Scene->Reg().view<TransformComponent, AnimatorComponent>(entt::exclude<DisabledComponent>);
+        for (auto entity : animatorView)
+        {
+            auto [transform, animator] = animatorView.get<TransformComponent, AnimatorComponent>(entity);
+            RenderFlags candidates = Helpers::CullLayers(animator.Layers, cullingMask, shadowMask);
+            if (candidates == RenderFlags::None)
+                continue;
+
+            auto mesh = animator.Mesh.Get();
+            if (!mesh || !mesh->IsLoaded())
+                continue;
+
+            glm::mat4 finalTransform = transform.WorldMatrix;
+            if (!isEditor && m_Scene->Reg().all_of<CharacterControllerComponent>(entity))
+                finalTransform = transform.GetPhysicsInterpolatedTransform(physicsAlpha);
+
+            AABB worldBounds = TransformAABB(animator.Palette.empty() ? mesh->GetBounds() : animator.Bounds, finalTransform);
+            RenderFlags flags = Helpers::CullBounds(worldBounds, candidates, camFrustum, lightFrustum);
+            if (flags == RenderFlags::None)
+                continue;
+
+            if (animator.Palette.empty())
+                renderer.SubmitMesh(mesh, finalTransform, flags, (int)entity);
+            else
+                renderer.SubmitSkinnedMesh(mesh, finalTransform, animator.Palette, animator.Bounds, flags, (int)entity);
+        }
         
         if (renderer.GetShowColliders()) // Render collider meshes
         {
@@ -228,7 +267,7 @@ namespace Lynx
             }
         }
         
-        m_Scene->GetParticleSystem()->OnUpdate(deltaTime, m_Scene.get(), cameraPos);
+        m_Scene->GetParticleSystem()->OnUpdate(deltaTime, m_Scene.get(), cameraPos, cullingMask);
 
         renderer.EndScene();
     }
@@ -20,7 +20,7 @@ namespace Lynx
         bool GetShowColliders() const { return m_ShowColliders; }
         
     private:
-        void SubmitScene(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos, float deltaTime, bool isEditor, float physicsAlpha = 0.0f);
+        void SubmitScene(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos, uint32_t cullingMask, float deltaTime, bool isEditor, float physicsAlpha = 0.0f);
         void SetViewportDirty(bool dirty) { m_ViewportDirty = true; }
         
     private:
@@ -0,0 +1,263 @@
+#include "TextureStreamer.h"
+
+#include "Lynx/Engine.h"
+#include "Lynx/Asset/Material.h"
+#include "Lynx/Asset/Texture.h"
+
+namespace Lynx
+{
+    TextureStreamer::TextureStreamer()
+        : m_Results(std::make_shared<ResultQueue>())
+    {
+    }
+
+    void TextureStreamer::Register(const std::shared_ptr<Texture>& texture)
+    {
+        if (!texture || !texture->IsStreamable())
+            return;
+
+        // Re-registering (e.g. after a reload) starts from the tail again
+        Entry entry;
+        entry.WeakTexture = texture;
+        m_Entries[texture.get()] = entry;
+    }
+
+    void TextureStreamer::RequestMaterial(Material* material, float screenSize)
+    {
+        if (!material)
+            return;
+
+        auto it = m_MaterialRequests.find(material);
+        if (it == m_MaterialRequests.end())
+            m_MaterialRequests[material] = screenSize;
+        else
+            it->second = std::max(it->second, screenSize);
+    }
+
+    void TextureStreamer::RequestTexture(Texture* texture, uint32_t mip)
+    {
+        auto it = m_Entries.find(texture);
+        if (it == m_Entries.end())
+            return;
+
+        Entry& entry = it->second;
+        if (!entry.HasRequest || entry.LastRequestFrame != m_FrameIndex)
+            entry.RequestedMip = mip;
+        else
+            entry.RequestedMip = std::min(entry.RequestedMip, mip);
+
+        entry.LastRequestFrame = m_FrameIndex;
+        entry.HasRequest = true;
+    }
+
+    void TextureStreamer::Update()
+    {
+        ProcessResults();
+        ResolveMaterialRequests();
+
+        struct Candidate
+        {
+            Texture* Tex;
+            Entry* Info;
+            uint32_t Wanted;
+            uint32_t Target;
+        };
+
+        std::vector<Candidate> candidates;
+        candidates.reserve(m_Entries.size());
+
+        uint64_t requestedBytes = 0;
+        uint64_t residentBytes = 0;
+        for (auto it = m_Entries.begin(); it != m_Entries.end();)
+        {
+            auto texture = it->second.WeakTexture.lock();
+            if (!texture)
+            {
+                it = m_Entries.erase(it);
+                continue;
+            }
+
+            Entry& entry = it->second;
+            uint32_t tail = texture->GetTailMip();
+            uint32_t wanted = tail;
+            if (!m_Settings.Enabled)
+                wanted = 0;
+            else if (entry.HasRequest && m_FrameIndex - entry.LastRequestFrame <= m_Settings.EvictionDelayFrames)
+                wanted = std::min(entry.RequestedMip, tail);
+
+            requestedBytes += texture->GetMipChainSize(wanted);
+            residentBytes += texture->GetMipChainSize(texture->GetResidentMip());
+            candidates.push_back({ it->first, &entry, wanted, wanted });
+            ++it;
+        }
+
+        // Drop the same amount of mips from every texture until we fit. Tails are always resident, so this can still be over budget.
+        uint32_t bias = 0;
+        if (m_Settings.Enabled)
+        {
+            uint64_t budget = (uint64_t)m_Settings.BudgetMB * 1024 * 1024;
+            for (; bias < 16; bias++)
+            {
+                uint64_t total = 0;
+                for (auto& candidate : candidates)
+                    total += candidate.Tex->GetMipChainSize(std::min(candidate.Wanted + bias, candidate.Tex->GetTailMip()));
+
+                if (total <= budget)
+                    break;
+            }
+        }
+
+        for (auto& candidate : candidates)
+            candidate.Target = std::min(candidate.Wanted + bias, candidate.Tex->GetTailMip());
+
+        // Evictions first to free memory, then the biggest quality gains
+        std::vector<Candidate*> toLoad;
+        for (auto& candidate : candidates)
+        {
+            if (!candidate.Info->Pending && candidate.Target != candidate.Tex->GetResidentMip())
+                toLoad.push_back(&candidate);
+        }
+
+        std::sort(toLoad.begin(), toLoad.end(), [](const Candidate* a, const Candidate* b)
+        {
+            bool aEvict = a->Target > a->Tex->GetResidentMip();
+            bool bEvict = b->Target > b->Tex->GetResidentMip();
+            if (aEvict != bEvict)
+                return aEvict;
+
+            int64_t aDelta = std::abs((int64_t)a->Tex->GetMipChainSize(a->Target) - (int64_t)a->Tex->GetMipChainSize(a->Tex->GetResidentMip()));
+            int64_t bDelta = std::abs((int64_t)b->Tex->GetMipChainSize(b->Target) - (int64_t)b->Tex->GetMipChainSize(b->Tex->GetResidentMip()));
+            return aDelta > bDelta;
+        });
+
+        std::vector<LoadJob> jobs;
+        uint32_t uploads = 0;
+        for (Candidate* candidate : toLoad)
+        {
+            if (uploads >= m_Settings.MaxUploadsPerFrame)
+                break;
+            uploads++;
+
+            // Nothing to read, the smaller texture is a copy of what's there
+            Texture& texture = *candidate->Tex;
+            if (candidate->Target > texture.GetResidentMip())
+            {
+                SwapResidentMips(texture, candidate->Target, TextureData());
+                continue;
+            }
+
+            LoadJob job;
+            job.WeakTexture = candidate->Info->WeakTexture;
+            job.Path = texture.GetStreamSource();
+            job.FirstMip = candidate->Target;
+            job.ResidentMip = texture.GetResidentMip();
+            job.Generation = texture.GetStreamGeneration();
+            jobs.push_back(std::move(job));
+
+            candidate->Info->Pending = true;
+        }
+
+        // Disk bound, so they go to the background queue where they never hold up a wait. Capped per frame anyway.
+        auto& jobSystem = Engine::Get().GetJobSystem();
+        for (auto& job : jobs)
+        {
+            jobSystem.RunBackground([job = std::move(job), results = m_Results]() mutable
+            {
+                Load(std::move(job), *results);
+            });
+        }
+
+        m_Stats.ResidentBytes = residentBytes;
+        m_Stats.RequestedBytes = requestedBytes;
+        m_Stats.StreamingTextures = (uint32_t)m_Entries.size();
+        m_Stats.PendingLoads = 0;
+        for (auto& [texture, entry] : m_Entries)
+        {
+            if (entry.Pending)
+                m_Stats.PendingLoads++;
+        }
+        m_Stats.MipBias = bias;
+
+        m_FrameIndex++;
+    }
+
+    void TextureStreamer::ResolveMaterialRequests()
+    {
+        auto& assetManager = Engine::Get().GetAssetManager();
+        for (auto& [material, screenSize] : m_MaterialRequests)
+        {
+            float tiling = std::max(std::max(material->Tiling.x, material->Tiling.y), 1.0f);
+            AssetHandle handles[] = { material->AlbedoTexture, material->NormalMap, material->MetallicRoughnessTexture, material->EmissiveTexture, material->OcclusionTexture };
+            for (AssetHandle handle : handles)
+            {
+                if (!handle)
+                    continue;
+
+                auto texture = assetManager.GetAsset<Texture>(handle);
+                if (!texture || !texture->IsStreamable())
+                    continue;
+
+                // Mip where one texel covers roughly one pixel
+                uint32_t mip = 0;
+                float texSize = (float)std::max(texture->GetWidth(), texture->GetHeight()) * tiling;
+                if (screenSize <= 0.0f)
+                    mip = texture->GetTailMip();
+                else if (texSize > screenSize)
+                    mip = (uint32_t)std::floor(std::log2(texSize / screenSize));
+
+                RequestTexture(texture.get(), std::min(mip, texture->GetMipCount() - 1));
+            }
+        }
+        m_MaterialRequests.clear();
+    }
+
+    void TextureStreamer::ProcessResults()
+    {
+        std::vector<LoadResult> results;
+        {
+            std::lock_guard<std::mutex> lock(m_Results->Mutex);
+            results.swap(m_Results->Results);
+        }
+
+        for (auto& result : results)
+        {
+            auto texture = result.Job.WeakTexture.lock();
+            if (!texture)
+                continue;
+
+            auto it = m_Entries.find(texture.get());
+            if (it != m_Entries.end())
+                it->second.Pending = false;
+
+            // Texture got reloaded while we were loading, the data is stale
+            if (!result.Success || result.Job.Generation != texture->GetStreamGeneration() || result.Job.ResidentMip != texture->GetResidentMip())
+                continue;
+
+            SwapResidentMips(*texture, result.Data.FirstMip, result.Data);
+        }
+    }
+
+    bool TextureStreamer::SwapResidentMips(Texture& texture, uint32_t firstMip, const TextureData& newMips)
+    {
+        auto handle = Engine::Get().GetRenderer().CreateStreamedTexture(texture.GetSpecification(), texture.GetTextureHandle(),
+            texture.GetResidentMip(), firstMip, newMips);
+        if (!handle)
+            return false;
+
+        texture.SetResidentMips(handle, firstMip);
+        Engine::Get().GetAssetManager().InvalidateDependents(texture.GetHandle());
+        return true;
+    }
+
+    void TextureStreamer::Load(LoadJob job, ResultQueue& queue)
+    {
+        LoadResult result;
+        result.Success = TextureCompiler::LoadDDS(job.Path, result.Data, nullptr, job.FirstMip, 0, job.ResidentMip - job.FirstMip);
+        if (!result.Success)
+            LX_CORE_WARN("TextureStreamer: Failed to stream mips from {0}", job.Path.string());
+        result.Job = std::move(job);
+
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        queue.Results.push_back(std::move(result));
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "Lynx/Core.h"
+#include <filesystem>
+#include <mutex>
+
+#include "Lynx/Asset/TextureCompiler.h"
+
+namespace Lynx
+{
+    class Texture;
+    class Material;
+
+    struct TextureStreamingSettings
+    {
+        bool Enabled = true;
+        uint32_t BudgetMB = 512;
+        uint32_t MaxUploadsPerFrame = 4; // Loads started plus evictions
+        uint32_t EvictionDelayFrames = 120; // Frames without a request before a texture falls back to its tail
+    };
+
+    struct TextureStreamingStats
+    {
+        uint64_t ResidentBytes = 0;
+        uint64_t RequestedBytes = 0;
+        uint32_t StreamingTextures = 0;
+        uint32_t PendingLoads = 0;
+        uint32_t MipBias = 0; // Mips dropped from every request to stay in budget
+    };
+
+    // Keeps the resident mips of block compressed textures in line with what is actually on screen.
+    // Textures load only their tail (mips <= TailSize) first, higher mips get loaded from the DDS cache on request.
+    // Only the mips that aren't resident yet are read, the rest gets copied over on the GPU. Evicting is just that copy.
+    class LX_API TextureStreamer
+    {
+    public:
+        static constexpr uint32_t TailSize = 128;
+
+        TextureStreamer();
+
+        void Register(const std::shared_ptr<Texture>& texture);
+
+        // screenSize is the projected size of the object in pixels
+        void RequestMaterial(Material* material, float screenSize);
+        void RequestTexture(Texture* texture, uint32_t mip);
+
+        // Called once per frame after submission. Resolves requests, schedules loads and swaps in finished ones.
+        void Update();
+
+        TextureStreamingSettings& GetSettings() { return m_Settings; }
+        const TextureStreamingSettings& GetSettings() const { return m_Settings; }
+        const TextureStreamingStats& GetStats() const { return m_Stats; }
+
+    private:
+        struct Entry
+        {
+            std::weak_ptr<Texture> WeakTexture;
+            uint32_t RequestedMip = 0;
+            uint64_t LastRequestFrame = 0;
+            bool HasRequest = false;
+            bool Pending = false;
+        };
+
+        struct LoadJob
+        {
+            std::weak_ptr<Texture> WeakTexture;
+            std::filesystem::path Path;
+            uint32_t FirstMip = 0;
+            uint32_t ResidentMip = 0; // Mips FirstMip..ResidentMip-1 get read
+            uint32_t Generation = 0;
+        };
+
+        struct LoadResult
+        {
+            LoadJob Job;
+            TextureData Data;
+            bool Success = false;
+        };
+
+        // Shared with the background loads, so one that finishes late has somewhere to put its result
+        struct ResultQueue
+        {
+            std::mutex Mutex;
+            std::vector<LoadResult> Results;
+        };
+
+        void ResolveMaterialRequests();
+        void ProcessResults();
+        // Swaps in a texture with firstMip.., newMips holds what wasn't resident before
+        bool SwapResidentMips(Texture& texture, uint32_t firstMip, const TextureData& newMips);
+        static void Load(LoadJob job, ResultQueue& queue);
+
+    private:
+        TextureStreamingSettings m_Settings;
+        TextureStreamingStats m_Stats;
+
+        std::unordered_map<Texture*, Entry> m_Entries;
+        std::unordered_map<Material*, float> m_MaterialRequests;
+        uint64_t m_FrameIndex = 1;
+
+        std::shared_ptr<ResultQueue> m_Results;
+    };
+}
@@ -0,0 +1,573 @@
+#include "BinaryScene.h"
+
+#include <nlohmann/json.hpp>
+
+#include "Scene.h"
+#include "Components/Components.h"
+#include "Components/IDComponent.h"
+#include "Lynx/Engine.h"
+#include "Lynx/Asset/AssetRegistry.h"
+
+namespace Lynx::BinaryScene
+{
+    enum class ValueTag : uint8_t
+    {
+        Null, False, True, Int, UInt, Float, Double, String, Array, Object
+    };
+
+    // Corrupt files shouldn't be able to blow the stack
+    static constexpr uint32_t MaxDepth = 128;
+
+    template<typename T>
+    static void Append(std::vector<uint8_t>& out, const T& value)
+    {
+        size_t at = out.size();
+        out.resize(at + sizeof(T));
+        std::memcpy(out.data() + at, &value, sizeof(T));
+    }
+
+    template<typename T>
+    static void AppendRange(std::vector<uint8_t>& out, const std::vector<T>& values)
+    {
+        size_t at = out.size();
+        out.resize(at + values.size() * sizeof(T));
+        if (!values.empty())
+            std::memcpy(out.data() + at, values.data(), values.size() * sizeof(T));
+    }
+
+    static uint64_t Align(std::vector<uint8_t>& out)
+    {
+        out.resize((out.size() + 7) & ~(size_t)7);
+        return out.size();
+    }
+
+    class Encoder
+    {
+    public:
+        uint32_t AddString(const std::string& string)
+        {
+            auto [it, inserted] = m_StringLookup.try_emplace(string, (uint32_t)m_Strings.size());
+            if (inserted)
+                m_Strings.push_back(&it->first);
+            return it->second;
+        }
+
+        uint32_t AddAsset(uint64_t handle)
+        {
+            auto [it, inserted] = m_AssetLookup.try_emplace(handle, (uint32_t)m_Assets.size());
+            if (inserted)
+                m_Assets.push_back(handle);
+            return it->second;
+        }
+
+        void Encode(const nlohmann::json& value, std::vector<uint8_t>& out)
+        {
+            switch (value.type())
+            {
+                case nlohmann::json::value_t::boolean:
+                    Append(out, value.get<bool>() ? ValueTag::True : ValueTag::False);
+                    break;
+                case nlohmann::json::value_t::number_integer:
+                    Append(out, ValueTag::Int);
+                    Append(out, value.get<int64_t>());
+                    break;
+                case nlohmann::json::value_t::number_unsigned:
+                {
+                    uint64_t number = value.get<uint64_t>();
+                    Append(out, ValueTag::UInt);
+                    Append(out, number);
+                    // Handles are written as plain numbers, the registry tells which ones are assets
+                    if (number != 0 && !m_AssetLookup.contains(number) && m_AssetRegistry.Contains(AssetHandle(number)))
+                        AddAsset(number);
+                    break;
+                }
+                case nlohmann::json::value_t::number_float:
+                {
+                    // Pretty much everything comes from floats, those take half the space
+                    double number = value.get<double>();
+                    float narrow = (float)number;
+                    if ((double)narrow == number)
+                    {
+                        Append(out, ValueTag::Float);
+                        Append(out, narrow);
+                    }
+                    else
+                    {
+                        Append(out, ValueTag::Double);
+                        Append(out, number);
+                    }
+                    break;
+                }
+                case nlohmann::json::value_t::string:
+                    Append(out, ValueTag::String);
+                    Append(out, AddString(value.get_ref<const std::string&>()));
+                    break;
+                case nlohmann::json::value_t::array:
+                    Append(out, ValueTag::Array);
+                    Append(out, (uint32_t)value.size());
+                    for (const auto& element : value)
+                        Encode(element, out);
+                    break;
+                case nlohmann::json::value_t::object:
+                    Append(out, ValueTag::Object);
+                    Append(out, (uint32_t)value.size());
+                    for (const auto& [key, element] : value.items())
+                    {
+                        Append(out, AddString(key));
+                        Encode(element, out);
+                    }
+                    break;
+                default:
+                    // Null, and the binary/discarded types no serializer writes
+                    Append(out, ValueTag::Null);
+                    break;
+            }
+        }
+
+        void WriteStrings(std::vector<uint8_t>& out) const
+        {
+            uint32_t offset = 0;
+            for (const std::string* string : m_Strings)
+            {
+                Append(out, offset);
+                offset += (uint32_t)string->size();
+            }
+            Append(out, offset);
+
+            for (const std::string* string : m_Strings)
+                out.insert(out.end(), string->begin(), string->end());
+        }
+
+        uint32_t GetStringCount() const { return (uint32_t)m_Strings.size(); }
+        const std::vector<uint64_t>& GetAssets() const { return m_Assets; }
+
+    private:
+        AssetRegistry& m_AssetRegistry = Engine::Get().GetAssetRegistry();
+        // Node based, so the pointers stay valid
+        std::unordered_map<std::string, uint32_t> m_StringLookup;
+        std::vector<const std::string*> m_Strings;
+        std::unordered_map<uint64_t, uint32_t> m_AssetLookup;
+        std::vector<uint64_t> m_Assets;
+    };
+
+    void ColumnWriter::WriteString(const std::string& string)
+    {
+        Write(m_Encoder.AddString(string));
+    }
+
+    void ColumnWriter::WriteAsset(AssetHandle handle)
+    {
+        Write(handle.IsValid() ? m_Encoder.AddAsset((uint64_t)handle) : NoIndex);
+    }
+
+    bool ColumnReader::ReadString(std::string& outString)
+    {
+        uint32_t index;
+        if (!Read(index))
+            return false;
+        if (index >= m_Reader.GetStringCount())
+        {
+            m_Failed = true;
+            return false;
+        }
+        outString = m_Reader.GetString(index);
+        return true;
+    }
+
+    bool ColumnReader::ReadAsset(AssetHandle& outHandle)
+    {
+        uint32_t index;
+        if (!Read(index))
+            return false;
+
+        auto assets = m_Reader.GetAssetHandles();
+        if (index == NoIndex)
+        {
+            outHandle = AssetHandle::Null();
+            return true;
+        }
+        if (index >= assets.size())
+        {
+            m_Failed = true;
+            return false;
+        }
+        outHandle = AssetHandle(assets[index]);
+        return true;
+    }
+
+    bool IsBinary(const uint8_t* data, size_t size)
+    {
+        return size >= sizeof(FileHeader) && std::memcmp(data, Magic, sizeof(Magic)) == 0;
+    }
+
+    std::vector<uint8_t> Write(Scene& scene, std::span<const entt::entity> entities, const nlohmann::json& sceneSettings)
+    {
+        struct Chunk
+        {
+            const ComponentInfo* Info = nullptr;
+            std::vector<uint32_t> Entities;
+            std::vector<entt::entity> Handles;
+            std::vector<uint32_t> Offsets;
+            std::vector<uint8_t> Values;
+        };
+
+        Encoder encoder;
+        auto& registry = scene.Reg();
+        uint32_t entityCount = (uint32_t)entities.size();
+
+        std::vector<uint64_t> ids(entityCount);
+        std::vector<uint32_t> parents(entityCount, NoParent);
+        std::unordered_map<entt::entity, uint32_t> indices;
+        indices.reserve(entityCount);
+        for (uint32_t i = 0; i < entityCount; i++)
+        {
+            ids[i] = (uint64_t)registry.get<IDComponent>(entities[i]).ID;
+            indices[entities[i]] = i;
+        }
+
+        // Relationships are the parent column, parents that aren't saved with us (other cells) make roots
+        for (uint32_t i = 0; i < entityCount; i++)
+        {
+            entt::entity parent = registry.get<RelationshipComponent>(entities[i]).Parent;
+            if (parent == entt::null)
+                continue;
+            auto it = indices.find(parent);
+            if (it != indices.end() && it->second < i)
+                parents[i] = it->second;
+        }
+
+        std::unordered_map<entt::id_type, const ComponentInfo*> infos;
+        for (const auto& [name, info] : Engine::Get().GetComponentRegistry().GetRegisteredComponents())
+        {
+            if (name != "Relationship" && info.serialize)
+                infos[info.TypeId] = &info;
+        }
+
+        // Straight from the pools, in name order so the same scene gives the same file
+        std::map<std::string, Chunk> chunks;
+        for (auto [id, storage] : registry.storage())
+        {
+            auto infoIt = infos.find(id);
+            if (infoIt == infos.end())
+                continue;
+
+            std::vector<uint32_t> rows;
+            for (entt::entity entity : storage)
+            {
+                auto it = indices.find(entity);
+                if (it != indices.end())
+                    rows.push_back(it->second);
+            }
+            if (rows.empty())
+                continue;
+
+            // Pool order is up to the registry, the file goes by entity index
+            std::sort(rows.begin(), rows.end());
+            Chunk& chunk = chunks[infoIt->second->name];
+            chunk.Info = infoIt->second;
+            chunk.Handles.reserve(rows.size());
+            for (uint32_t row : rows)
+                chunk.Handles.push_back(entities[row]);
+            chunk.Entities = std::move(rows);
+        }
+
+        for (auto& [name, chunk] : chunks)
+        {
+            if (chunk.Info->writeColumn && chunk.Info->insertColumn)
+            {
+                ColumnWriter writer(encoder, chunk.Values);
+                chunk.Info->writeColumn(registry, chunk.Handles.data(), chunk.Handles.data() + chunk.Handles.size(), writer);
+                continue;
+            }
+
+            // No codec (Lua scripts, UI canvases), these keep the json their serializer writes
+            nlohmann::json value;
+            for (entt::entity entity : chunk.Handles)
+            {
+                chunk.Offsets.push_back((uint32_t)chunk.Values.size());
+                value = nlohmann::json();
+                chunk.Info->serialize(registry, entity, value);
+                encoder.Encode(value, chunk.Values);
+            }
+            chunk.Offsets.push_back((uint32_t)chunk.Values.size());
+        }
+
+        // Scene level stuff (name, world partition), small enough to go through the same encoding
+        std::vector<uint8_t> sceneValue;
+        encoder.Encode(sceneSettings, sceneValue);
+
+        std::vector<uint32_t> chunkNames;
+        for (const auto& [name, chunk] : chunks)
+            chunkNames.push_back(encoder.AddString(name));
+
+        FileHeader header = {};
+        std::memcpy(header.Magic, Magic, sizeof(Magic));
+        header.Version = Version;
+        header.EntityCount = entityCount;
+        header.ChunkCount = (uint32_t)chunks.size();
+        header.StringCount = encoder.GetStringCount();
+        header.AssetCount = (uint32_t)encoder.GetAssets().size();
+
+        std::vector<uint8_t> out;
+        Append(out, header);
+
+        header.StringsOffset = Align(out);
+        encoder.WriteStrings(out);
+
+        header.AssetsOffset = Align(out);
+        AppendRange(out, encoder.GetAssets());
+
+        header.EntitiesOffset = Align(out);
+        AppendRange(out, ids);
+        AppendRange(out, parents);
+
+        // Headers first, patched once the columns have their offsets
+        header.ChunksOffset = Align(out);
+        out.resize(out.size() + chunks.size() * sizeof(ChunkHeader));
+
+        uint32_t chunkIndex = 0;
+        for (const auto& [name, chunk] : chunks)
+        {
+            ChunkHeader chunkHeader = {};
+            chunkHeader.Name = chunkNames[chunkIndex];
+            chunkHeader.Count = (uint32_t)chunk.Entities.size();
+            chunkHeader.Layout = chunk.Offsets.empty() ? ChunkLayout::Column : ChunkLayout::Values;
+            chunkHeader.EntitiesOffset = Align(out);
+            AppendRange(out, chunk.Entities);
+            chunkHeader.ValuesOffset = Align(out);
+            AppendRange(out, chunk.Offsets);
+            chunkHeader.DataOffset = Align(out);
+            chunkHeader.DataSize = chunk.Values.size();
+            AppendRange(out, chunk.Values);
+
+            std::memcpy(out.data() + header.ChunksOffset + chunkIndex * sizeof(ChunkHeader), &chunkHeader, sizeof(ChunkHeader));
+            chunkIndex++;
+        }
+
+        header.SceneOffset = Align(out);
+        header.SceneSize = sceneValue.size();
+        AppendRange(out, sceneValue);
+
+        std::memcpy(out.data(), &header, sizeof(FileHeader));
+        return out;
+    }
+
+    Reader::Reader(const uint8_t* data, size_t size)
+        : m_Data(data), m_Size(size)
+    {
+        if (!IsBinary(data, size))
+            return;
+
+        const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+        if (header->Version < MinVersion || header->Version > Version)
+        {
+            LX_CORE_ERROR("Binary scene has version {}, expected {} to {}", header->Version, MinVersion, Version);
+            return;
+        }
+
+        auto fits = [size](uint64_t offset, uint64_t bytes)
+        {
+            return offset <= size && bytes <= size - offset;
+        };
+
+        uint64_t stringOffsetsSize = ((uint64_t)header->StringCount + 1) * sizeof(uint32_t);
+        if (!fits(header->StringsOffset, stringOffsetsSize)
+            || !fits(header->AssetsOffset, (uint64_t)header->AssetCount * sizeof(uint64_t))
+            || !fits(header->EntitiesOffset, (uint64_t)header->EntityCount * (sizeof(uint64_t) + sizeof(uint32_t)))
+            || !fits(header->ChunksOffset, (uint64_t)header->ChunkCount * sizeof(ChunkHeader))
+            || !fits(header->SceneOffset, header->SceneSize))
+        {
+            LX_CORE_ERROR("Binary scene is truncated");
+            return;
+        }
+
+        // Offsets have to go up, then every string is inside the file
+        auto stringOffsets = GetSpan<uint32_t>(header->StringsOffset, header->StringCount + 1);
+        for (uint32_t i = 0; i < header->StringCount; i++)
+        {
+            if (stringOffsets[i] > stringOffsets[i + 1])
+            {
+                LX_CORE_ERROR("Binary scene has a broken string table");
+                return;
+            }
+        }
+        if (!fits(header->StringsOffset + stringOffsetsSize, stringOffsets[header->StringCount]))
+        {
+            LX_CORE_ERROR("Binary scene is truncated");
+            return;
+        }
+
+        for (const ChunkHeader& chunk : GetSpan<ChunkHeader>(header->ChunksOffset, header->ChunkCount))
+        {
+            bool valid = chunk.Name < header->StringCount
+                && fits(chunk.EntitiesOffset, (uint64_t)chunk.Count * sizeof(uint32_t))
+                && fits(chunk.DataOffset, chunk.DataSize);
+            if (valid && chunk.Layout == ChunkLayout::Values)
+            {
+                uint64_t valueOffsetsSize = ((uint64_t)chunk.Count + 1) * sizeof(uint32_t);
+                valid = fits(chunk.ValuesOffset, valueOffsetsSize)
+                    && GetSpan<uint32_t>(chunk.ValuesOffset, chunk.Count + 1)[chunk.Count] <= chunk.DataSize;
+            }
+            else if (chunk.Layout != ChunkLayout::Column)
+            {
+                valid = false;
+            }
+
+            if (!valid)
+            {
+                LX_CORE_ERROR("Binary scene has a broken chunk");
+                return;
+            }
+        }
+
+        m_StringOffsets = stringOffsets;
+        m_Characters = reinterpret_cast<const char*>(data + header->StringsOffset + stringOffsetsSize);
+        m_Header = header;
+    }
+
+    std::span<const uint64_t> Reader::GetEntityIDs() const
+    {
+        return GetSpan<uint64_t>(m_Header->EntitiesOffset, m_Header->EntityCount);
+    }
+
+    std::span<const uint32_t> Reader::GetParents() const
+    {
+        return GetSpan<uint32_t>(m_Header->EntitiesOffset + m_Header->EntityCount * sizeof(uint64_t), m_Header->EntityCount);
+    }
+
+    std::span<const uint64_t> Reader::GetAssetHandles() const
+    {
+        return GetSpan<uint64_t>(m_Header->AssetsOffset, m_Header->AssetCount);
+    }
+
+    std::span<const ChunkHeader> Reader::GetChunks() const
+    {
+        return GetSpan<ChunkHeader>(m_Header->ChunksOffset, m_Header->ChunkCount);
+    }
+
+    std::span<const uint32_t> Reader::GetChunkEntities(const ChunkHeader& chunk) const
+    {
+        return GetSpan<uint32_t>(chunk.EntitiesOffset, chunk.Count);
+    }
+
+    std::string_view Reader::GetString(uint32_t index) const
+    {
+        if (index >= m_Header->StringCount)
+            return {};
+        return std::string_view(m_Characters + m_StringOffsets[index], m_StringOffsets[index + 1] - m_StringOffsets[index]);
+    }
+
+    bool Reader::ReadValue(const ChunkHeader& chunk, uint32_t index, nlohmann::json& outJson) const
+    {
+        if (chunk.Layout != ChunkLayout::Values || index >= chunk.Count)
+            return false;
+
+        auto offsets = GetSpan<uint32_t>(chunk.ValuesOffset, chunk.Count + 1);
+        if (offsets[index] > offsets[index + 1] || offsets[index + 1] > offsets[chunk.Count])
+            return false;
+        return Decode(m_Data + chunk.DataOffset + offsets[index], offsets[index + 1] - offsets[index], outJson);
+    }
+
+    ColumnReader Reader::ReadColumn(const ChunkHeader& chunk) const
+    {
+        return ColumnReader(*this, m_Data + chunk.DataOffset, (size_t)chunk.DataSize);
+    }
+
+    bool Reader::ReadScene(nlohmann::json& outJson) const
+    {
+        return Decode(m_Data + m_Header->SceneOffset, (size_t)m_Header->SceneSize, outJson);
+    }
+
+    bool Reader::Decode(const uint8_t* data, size_t size, nlohmann::json& outJson) const
+    {
+        const uint8_t* end = data + size;
+        bool failed = false;
+
+        auto read = [&]<typename T>(T& value)
+        {
+            if ((size_t)(end - data) < sizeof(T))
+            {
+                failed = true;
+                value = T{};
+                return;
+            }
+            std::memcpy(&value, data, sizeof(T));
+            data += sizeof(T);
+        };
+
+        auto readString = [&](std::string& outString)
+        {
+            uint32_t index;
+            read(index);
+            if (!failed && index >= m_Header->StringCount)
+                failed = true;
+            if (!failed)
+                outString = GetString(index);
+        };
+
+        std::function<void(nlohmann::json&, uint32_t)> decode = [&](nlohmann::json& out, uint32_t depth)
+        {
+            ValueTag tag;
+            read(tag);
+            if (failed || depth > MaxDepth)
+            {
+                failed = true;
+                return;
+            }
+
+            switch (tag)
+            {
+                case ValueTag::Null: out = nullptr; break;
+                case ValueTag::False: out = false; break;
+                case ValueTag::True: out = true; break;
+                case ValueTag::Int: { int64_t value; read(value); out = value; break; }
+                case ValueTag::UInt: { uint64_t value; read(value); out = value; break; }
+                case ValueTag::Float: { float value; read(value); out = value; break; }
+                case ValueTag::Double: { double value; read(value); out = value; break; }
+                case ValueTag::String:
+                {
+                    std::string value;
+                    readString(value);
+                    out = std::move(value);
+                    break;
+                }
+                case ValueTag::Array:
+                {
+                    uint32_t count;
+                    read(count);
+                    // Every element takes at least a byte
+                    if (failed || count > (size_t)(end - data))
+                    {
+                        failed = true;
+                        return;
+                    }
+                    out = nlohmann::json::array();
+                    out.get_ref<nlohmann::json::array_t&>().resize(count);
+                    for (uint32_t i = 0; i < count && !failed; i++)
+                        decode(out[i], depth + 1);
+                    break;
+                }
+                case ValueTag::Object:
+                {
+                    uint32_t count;
+                    read(count);
+                    out = nlohmann::json::object();
+                    std::string key;
+                    for (uint32_t i = 0; i < count && !failed; i++)
+                    {
+                        readString(key);
+                        if (!failed)
+                            decode(out[key], depth + 1);
+                    }
+                    break;
+                }
+                default:
+                    failed = true;
+                    break;
+            }
+        };
+
+        decode(outJson, 0);
+        return !failed;
+    }
+}
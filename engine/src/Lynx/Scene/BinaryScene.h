@@ -0,0 +1,174 @@
+#pragma once
+
+#include "Lynx/Core.h"
+#include "Lynx/UUID.h"
+#include <nlohmann/json_fwd.hpp>
+#include <entt/entt.hpp>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace Lynx
+{
+    // Binary .lxscene layout. Everything is native endian and sections are 8 byte aligned, so a mapped file is read in place.
+    //   FileHeader
+    //   String table: uint32 offsets[StringCount + 1] into the characters right after. Component names, keys and string values.
+    //   Asset table: uint64 handles[AssetCount], every registered asset the components point at
+    //   Entity table: uint64 UUIDs[EntityCount], then uint32 parent indices[EntityCount], parents come before their children
+    //     The parent indices are the relationship column, the loader links the hierarchy from them in one pass
+    //   ChunkHeader[ChunkCount], one per component type, with its columns somewhere behind:
+    //     uint32 entity indices[Count], then depending on the layout
+    //     Values: uint32 value offsets[Count + 1], values
+    //     Column: Count components back to back, written by the codec the component registered (TypeRegistry::SetColumnCodec)
+    //   Scene value: everything of the scene json besides the entities
+    // Values are the json the component serializers write, with keys and strings as indices into the string table.
+    // Columns skip the json and get inserted in one go, strings and asset handles in there are table indices too.
+    class Scene;
+
+    namespace BinaryScene
+    {
+        static constexpr char Magic[4] = { 'L', 'X', 'S', 'B' };
+        static constexpr uint32_t Version = 3;
+        // Same layout, fewer components had a codec back then. Their values still load through json.
+        static constexpr uint32_t MinVersion = 2;
+        static constexpr uint32_t NoParent = 0xFFFFFFFF;
+        static constexpr uint32_t NoIndex = 0xFFFFFFFF;
+
+        enum class ChunkLayout : uint32_t
+        {
+            Values = 0,
+            Column
+        };
+
+        struct FileHeader
+        {
+            char Magic[4];
+            uint32_t Version;
+            uint32_t EntityCount;
+            uint32_t ChunkCount;
+            uint32_t StringCount;
+            uint32_t AssetCount;
+            uint64_t StringsOffset;
+            uint64_t AssetsOffset;
+            uint64_t EntitiesOffset;
+            uint64_t ChunksOffset;
+            uint64_t SceneOffset;
+            uint64_t SceneSize;
+        };
+
+        struct ChunkHeader
+        {
+            uint32_t Name; // String index, the registered component name
+            uint32_t Count;
+            ChunkLayout Layout;
+            uint32_t Reserved;
+            uint64_t EntitiesOffset;
+            uint64_t ValuesOffset; // Values layout only
+            uint64_t DataOffset; // Value offsets are relative to this
+            uint64_t DataSize;
+        };
+
+        class Encoder;
+        class Reader;
+
+        // What a column codec writes into. Plain values get copied as they are.
+        class LX_API ColumnWriter
+        {
+        public:
+            ColumnWriter(Encoder& encoder, std::vector<uint8_t>& data) : m_Encoder(encoder), m_Data(data) {}
+
+            template<typename T>
+            void Write(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                size_t at = m_Data.size();
+                m_Data.resize(at + sizeof(T));
+                std::memcpy(m_Data.data() + at, &value, sizeof(T));
+            }
+
+            void WriteString(const std::string& string);
+            void WriteAsset(AssetHandle handle);
+
+        private:
+            Encoder& m_Encoder;
+            std::vector<uint8_t>& m_Data;
+        };
+
+        // Reads a column back, every read fails once the data runs out or an index is out of range
+        class LX_API ColumnReader
+        {
+        public:
+            ColumnReader(const Reader& reader, const uint8_t* data, size_t size) : m_Reader(reader), m_Data(data), m_End(data + size) {}
+
+            template<typename T>
+            bool Read(T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                if (m_Failed || (size_t)(m_End - m_Data) < sizeof(T))
+                {
+                    m_Failed = true;
+                    return false;
+                }
+                std::memcpy(&value, m_Data, sizeof(T));
+                m_Data += sizeof(T);
+                return true;
+            }
+
+            bool ReadString(std::string& outString);
+            bool ReadAsset(AssetHandle& outHandle);
+
+            bool HasFailed() const { return m_Failed; }
+
+        private:
+            const Reader& m_Reader;
+            const uint8_t* m_Data;
+            const uint8_t* m_End;
+            bool m_Failed = false;
+        };
+
+        bool IsBinary(const uint8_t* data, size_t size);
+
+        // entities in hierarchy order, parents before their children. Components come straight from the pools,
+        // as columns where there's a codec and as json values otherwise. sceneSettings is the scene json minus the entities.
+        std::vector<uint8_t> Write(Scene& scene, std::span<const entt::entity> entities, const nlohmann::json& sceneSettings);
+
+        // View over a binary scene in memory, nothing gets copied until a value is read.
+        // Checks the section bounds up front, values while they're decoded.
+        class Reader
+        {
+        public:
+            Reader(const uint8_t* data, size_t size);
+
+            bool IsValid() const { return m_Header != nullptr; }
+
+            std::span<const uint64_t> GetEntityIDs() const;
+            std::span<const uint32_t> GetParents() const;
+            std::span<const uint64_t> GetAssetHandles() const;
+            std::span<const ChunkHeader> GetChunks() const;
+            std::span<const uint32_t> GetChunkEntities(const ChunkHeader& chunk) const;
+            std::string_view GetString(uint32_t index) const;
+            uint32_t GetStringCount() const { return m_Header->StringCount; }
+
+            // False if the value is broken
+            bool ReadValue(const ChunkHeader& chunk, uint32_t index, nlohmann::json& outJson) const;
+            ColumnReader ReadColumn(const ChunkHeader& chunk) const;
+            bool ReadScene(nlohmann::json& outJson) const;
+
+        private:
+            bool Decode(const uint8_t* data, size_t size, nlohmann::json& outJson) const;
+
+            template<typename T>
+            std::span<const T> GetSpan(uint64_t offset, size_t count) const
+            {
+                return std::span<const T>(reinterpret_cast<const T*>(m_Data + offset), count);
+            }
+
+        private:
+            const uint8_t* m_Data = nullptr;
+            size_t m_Size = 0;
+            const FileHeader* m_Header = nullptr;
+            std::span<const uint32_t> m_StringOffsets;
+            const char* m_Characters = nullptr;
+        };
+    }
+}
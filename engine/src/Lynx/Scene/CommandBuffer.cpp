@@ -0,0 +1,167 @@
+#include "CommandBuffer.h"
+
+#include "Entity.h"
+#include "Scene.h"
+
+namespace Lynx
+{
+    static constexpr uint32_t s_NoCreate = std::numeric_limits<uint32_t>::max();
+    static std::atomic<uint64_t> s_NextQueueSerial = 1;
+
+    CommandBuffer::Target::Target(const Entity& entity)
+        : Handle(entity.GetHandle())
+    {
+    }
+
+    PendingEntity CommandBuffer::Create(const std::string& name)
+    {
+        uint32_t index = (uint32_t)m_CreateNames.size();
+        m_CreateNames.push_back(name);
+        m_Commands.push_back({ m_SortKey, m_Sequence.fetch_add(1, std::memory_order_relaxed), entt::entity(entt::null), index, nullptr });
+        return { index };
+    }
+
+    void CommandBuffer::Destroy(Target target, bool excludeChildren)
+    {
+        Record(target, [excludeChildren](Scene& scene, entt::entity entity)
+        {
+            scene.DestroyEntity(entity, excludeChildren);
+        });
+    }
+
+    void CommandBuffer::ReleaseToPool(Target target)
+    {
+        Record(target, [](Scene& scene, entt::entity entity)
+        {
+            scene.GetEntityPool()->Release(scene, entity);
+        });
+    }
+
+    void CommandBuffer::Record(Target target, ApplyFunc func)
+    {
+        m_Commands.push_back({ m_SortKey, m_Sequence.fetch_add(1, std::memory_order_relaxed), target, s_NoCreate, std::move(func) });
+    }
+
+    entt::registry& CommandBuffer::GetRegistry(Scene& scene)
+    {
+        return scene.Reg();
+    }
+
+    CommandQueue::CommandQueue()
+        : m_Serial(s_NextQueueSerial++)
+    {
+    }
+
+    CommandBuffer& CommandQueue::GetBuffer()
+    {
+        // Most calls come from the same thread for the same scene over and over
+        thread_local uint64_t t_Serial = 0;
+        thread_local CommandBuffer* t_Buffer = nullptr;
+        if (t_Serial == m_Serial)
+            return *t_Buffer;
+
+        std::lock_guard lock(m_Mutex);
+        std::thread::id thread = std::this_thread::get_id();
+        auto it = std::find_if(m_Buffers.begin(), m_Buffers.end(), [thread](const auto& entry) { return entry.first == thread; });
+        if (it == m_Buffers.end())
+        {
+            m_Buffers.emplace_back(thread, std::make_unique<CommandBuffer>(m_Sequence));
+            it = m_Buffers.end() - 1;
+            m_Stats.Buffers = (uint32_t)m_Buffers.size();
+        }
+
+        t_Serial = m_Serial;
+        t_Buffer = it->second.get();
+        return *t_Buffer;
+    }
+
+    void CommandQueue::Playback(Scene& scene)
+    {
+        struct Batch
+        {
+            std::vector<CommandBuffer::Command> Commands;
+            std::vector<std::string> CreateNames;
+            std::vector<entt::entity> Created;
+        };
+
+        auto& registry = scene.Reg();
+
+        // Playing back can record more (on_destroy handlers destroying other entities etc.), keep going until it settles.
+        // Bounded so handlers that queue each other forever don't hang the frame.
+        for (uint32_t pass = 0; pass < 16; pass++)
+        {
+            // Nobody records while we play back, the sync points are between systems. The lock is just for the buffer list.
+            std::vector<Batch> batches;
+            {
+                std::lock_guard lock(m_Mutex);
+                for (auto& [thread, buffer] : m_Buffers)
+                {
+                    if (buffer->m_Commands.empty())
+                        continue;
+
+                    Batch& batch = batches.emplace_back();
+                    batch.Commands.swap(buffer->m_Commands);
+                    batch.CreateNames.swap(buffer->m_CreateNames);
+                    batch.Created.resize(batch.CreateNames.size(), entt::null);
+                }
+            }
+            if (batches.empty())
+                return;
+
+            // Key then recording order. Never by buffer, which buffer comes first is up to which thread asked first.
+            // A single buffer with a single key already is in order.
+            std::vector<std::pair<uint32_t, uint32_t>> order;
+            bool sortNeeded = batches.size() > 1;
+            for (uint32_t b = 0; b < batches.size(); b++)
+            {
+                for (uint32_t c = 0; c < batches[b].Commands.size(); c++)
+                {
+                    order.emplace_back(b, c);
+                    sortNeeded |= batches[b].Commands[c].SortKey != batches[0].Commands[0].SortKey;
+                }
+            }
+            if (sortNeeded)
+            {
+                std::sort(order.begin(), order.end(), [&batches](const auto& lhs, const auto& rhs)
+                {
+                    const auto& a = batches[lhs.first].Commands[lhs.second];
+                    const auto& b = batches[rhs.first].Commands[rhs.second];
+                    return a.SortKey != b.SortKey ? a.SortKey < b.SortKey : a.Sequence < b.Sequence;
+                });
+            }
+
+            for (auto [b, c] : order)
+            {
+                Batch& batch = batches[b];
+                auto& command = batch.Commands[c];
+                if (command.Create != s_NoCreate)
+                {
+                    batch.Created[command.Create] = scene.CreateEntity(batch.CreateNames[command.Create]).GetHandle();
+                    continue;
+                }
+
+                entt::entity entity = command.Subject.Pending != s_NoCreate ? batch.Created[command.Subject.Pending] : command.Subject.Handle;
+                // Destroyed by an earlier command, or created with a higher sort key
+                if (entity == entt::null || !registry.valid(entity))
+                    continue;
+
+                command.Apply(scene, entity);
+            }
+
+            m_Stats.Commands += (uint32_t)order.size();
+        }
+
+        LX_CORE_WARN("CommandQueue: Commands still queued after 16 playback passes, leaving the rest for the next sync point");
+    }
+
+    void CommandQueue::Clear()
+    {
+        std::lock_guard lock(m_Mutex);
+        for (auto& [thread, buffer] : m_Buffers)
+        {
+            buffer->m_Commands.clear();
+            buffer->m_CreateNames.clear();
+            buffer->SetSortKey(0);
+        }
+    }
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Lynx/Core.h"
+#include <entt/entt.hpp>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Lynx
+{
+    class Scene;
+    class Entity;
+
+    // An entity created through a command buffer. Only usable with the same buffer until the next playback.
+    struct PendingEntity
+    {
+        uint32_t Index = std::numeric_limits<uint32_t>::max();
+    };
+
+    // Records structural changes (create/destroy/add/remove/set) instead of applying them, so systems can keep
+    // iterating their views and worker threads can queue changes without touching the registry.
+    // Get one through Scene::GetCommandBuffer(), the scene plays them back at its sync points.
+    class LX_API CommandBuffer
+    {
+    public:
+        // Commands get their recording order from sequence, the queue hands out one counter to all its buffers
+        explicit CommandBuffer(std::atomic<uint64_t>& sequence) : m_Sequence(sequence) {}
+
+        // Either an existing entity or one created earlier in this buffer
+        struct Target
+        {
+            entt::entity Handle = entt::null;
+            uint32_t Pending = std::numeric_limits<uint32_t>::max();
+
+            Target(entt::entity entity) : Handle(entity) {}
+            Target(const class Entity& entity);
+            Target(PendingEntity pending) : Pending(pending.Index) {}
+        };
+
+        using ApplyFunc = std::function<void(Scene&, entt::entity)>;
+
+        PendingEntity Create(const std::string& name = std::string());
+        void Destroy(Target target, bool excludeChildren = true);
+        // Root of a prefab instance, see Scene::ReleaseToPool
+        void ReleaseToPool(Target target);
+
+        template<typename T, typename... Args>
+        void Add(Target target, Args&&... args)
+        {
+            Record(target, [value = T(std::forward<Args>(args)...)](Scene& scene, entt::entity entity) mutable
+            {
+                auto& registry = GetRegistry(scene);
+                if (!registry.all_of<T>(entity))
+                    registry.emplace<T>(entity, std::move(value));
+            });
+        }
+
+        // Adds or replaces
+        template<typename T>
+        void Set(Target target, T value)
+        {
+            Record(target, [value = std::move(value)](Scene& scene, entt::entity entity) mutable
+            {
+                GetRegistry(scene).emplace_or_replace<T>(entity, std::move(value));
+            });
+        }
+
+        template<typename T>
+        void Remove(Target target)
+        {
+            Record(target, [](Scene& scene, entt::entity entity)
+            {
+                GetRegistry(scene).remove<T>(entity);
+            });
+        }
+
+        // Anything else, runs at playback with the resolved entity. Skipped if it's gone by then.
+        void Call(Target target, ApplyFunc func) { Record(target, std::move(func)); }
+
+        // Commands are played back ordered by this key, then by when they were recorded. SystemManager::RunSystem sets
+        // SystemSortKey while a system runs, so systems play back in schedule order no matter which thread ran what.
+        // Jobs that split a system's work over threads record under ChunkSortKey (take the system's key with GetSortKey()
+        // before handing out the jobs), one chunk per job, so their order doesn't depend on scheduling either.
+        static uint64_t SystemSortKey(uint32_t system) { return (uint64_t)(system + 1) << 32; }
+        // Chunks go after the system's own commands
+        static uint64_t ChunkSortKey(uint64_t systemKey, uint32_t chunk) { return (systemKey & ~0xFFFFFFFFull) | ((uint64_t)chunk + 1); }
+
+        void SetSortKey(uint64_t key) { m_SortKey = key; }
+        uint64_t GetSortKey() const { return m_SortKey; }
+
+        bool IsEmpty() const { return m_Commands.empty(); }
+
+    private:
+        struct Command
+        {
+            uint64_t SortKey;
+            uint64_t Sequence;
+            Target Subject;
+            uint32_t Create; // Index into m_CreateNames for Create commands, otherwise max
+            ApplyFunc Apply;
+        };
+
+        void Record(Target target, ApplyFunc func);
+        static entt::registry& GetRegistry(Scene& scene);
+
+    private:
+        std::vector<Command> m_Commands;
+        std::vector<std::string> m_CreateNames;
+        uint64_t m_SortKey = 0;
+        std::atomic<uint64_t>& m_Sequence;
+
+        friend class CommandQueue;
+    };
+
+    // Sets the sort key of a buffer until the end of the scope
+    class SortKeyScope
+    {
+    public:
+        SortKeyScope(CommandBuffer& buffer, uint64_t key)
+            : m_Buffer(buffer), m_PreviousKey(buffer.GetSortKey())
+        {
+            buffer.SetSortKey(key);
+        }
+        ~SortKeyScope() { m_Buffer.SetSortKey(m_PreviousKey); }
+
+        SortKeyScope(const SortKeyScope&) = delete;
+        SortKeyScope& operator=(const SortKeyScope&) = delete;
+
+    private:
+        CommandBuffer& m_Buffer;
+        uint64_t m_PreviousKey;
+    };
+
+    // All command buffers of a scene, one per thread that recorded into it
+    class CommandQueue
+    {
+    public:
+        struct Stats
+        {
+            uint32_t Buffers = 0;
+            uint32_t Commands = 0; // Played back this frame
+        };
+
+        CommandQueue();
+
+        // The calling thread's buffer, created on first use
+        CommandBuffer& GetBuffer();
+
+        // Runs every recorded command in SortKey, then recording order. Commands recorded during playback
+        // (destroy callbacks etc.) run in the same call.
+        void Playback(Scene& scene);
+        void Clear();
+
+        void ResetStats() { m_Stats.Commands = 0; }
+        const Stats& GetStats() const { return m_Stats; }
+
+    private:
+        // Tells the thread local cache apart from queues of deleted scenes at the same address
+        uint64_t m_Serial;
+        std::atomic<uint64_t> m_Sequence = 0;
+        std::mutex m_Mutex;
+        std::vector<std::pair<std::thread::id, std::unique_ptr<CommandBuffer>>> m_Buffers;
+        Stats m_Stats;
+    };
+}
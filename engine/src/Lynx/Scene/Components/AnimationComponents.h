@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Lynx/Asset/AssetRef.h"
+#include "Lynx/Asset/SkeletalMesh.h"
+#include "Lynx/Renderer/RenderLayers.h"
+#include <glm/glm.hpp>
+
+namespace Lynx
+{
+    // Plays clips of a skeletal mesh, the pose gets evaluated by the AnimationSystem
+    struct AnimatorComponent
+    {
+        AssetRef<SkeletalMesh> Mesh;
+        std::string Clip;
+        float Speed = 1.0f;
+        bool Loop = true;
+        bool Playing = true;
+        uint32_t Layers = RenderLayer::Default;
+
+        // Runtime
+        float Time = 0.0f;
+
+        // Crossfade from the previous clip, frozen at PreviousTime
+        std::string PreviousClip;
+        float PreviousTime = 0.0f;
+        float FadeDuration = 0.0f;
+        float FadeTime = 0.0f;
+
+        // Skinning palette of the current pose, empty until the first update (renders the bind pose)
+        std::vector<glm::mat4> Palette;
+        // Mesh space bounds of that pose
+        AABB Bounds;
+
+        void Play(const std::string& clip, float fadeDuration = 0.2f)
+        {
+            if (clip == Clip)
+                return;
+
+            PreviousClip = Clip;
+            PreviousTime = Time;
+            FadeDuration = PreviousClip.empty() ? 0.0f : fadeDuration;
+            FadeTime = 0.0f;
+
+            Clip = clip;
+            Time = 0.0f;
+            Playing = true;
+        }
+    };
+}
@@ -15,11 +15,13 @@
 #include <string>
 #include <glm/gtx/matrix_decompose.hpp>
 
+#include "Lynx/Renderer/RenderLayers.h"
 #include "Lynx/Renderer/SceneCamera.h"
 
 
 namespace Lynx
 {
+    // Renames have to go through registry.patch/replace, the scene keeps a name index
     struct TagComponent
     {
         std::string Tag;
@@ -36,6 +38,13 @@ namespace Lynx
         glm::vec3 Scale = { 1.0f, 1.0f, 1.0f };
 
         glm::mat4 WorldMatrix = glm::mat4(1.0f);
+        // Translation/Rotation/Scale composed, refreshed when LocalDirty
+        glm::mat4 LocalMatrix = glm::mat4(1.0f);
+
+        // Scene::UpdateGlobalTransforms only recomputes the subtrees below dirty transforms.
+        // LocalDirty: TRS changed, WorldDirty: the parent changed. Use the setters, if you write the fields directly call MarkDirty()!
+        bool LocalDirty = true;
+        bool WorldDirty = true;
         
         // For physics interpolation
         glm::vec3 PreviousTranslation{0.0f};
@@ -44,6 +53,32 @@ namespace Lynx
         TransformComponent() = default;
         TransformComponent(const TransformComponent&) = default;
         TransformComponent(const glm::vec3& translation) : Translation(translation) {}
+
+        void MarkDirty() { LocalDirty = true; }
+
+        void SetTranslation(const glm::vec3& translation)
+        {
+            if (Translation == translation)
+                return;
+            Translation = translation;
+            LocalDirty = true;
+        }
+
+        void SetRotation(const glm::quat& rotation)
+        {
+            if (Rotation == rotation)
+                return;
+            Rotation = rotation;
+            LocalDirty = true;
+        }
+
+        void SetScale(const glm::vec3& scale)
+        {
+            if (Scale == scale)
+                return;
+            Scale = scale;
+            LocalDirty = true;
+        }
         
         glm::vec3 GetWorldTranslation() const
         {
@@ -119,7 +154,7 @@ namespace Lynx
         void SetRotionDegrees(const glm::vec3& rotDegrees)
         {
             glm::vec3 rotRadians = glm::radians(rotDegrees);
-            Rotation = glm::quat(rotRadians);
+            SetRotation(glm::quat(rotRadians));
         }
 
         glm::vec3 GetRotationEuler() const
@@ -129,7 +164,7 @@ namespace Lynx
 
         void SetRotationEuler(const glm::vec3& rotation)
         {
-            Rotation = glm::quat(rotation);
+            SetRotation(glm::quat(rotation));
         }
         
         glm::vec3 GetPhysicsInterpolatedTranslation(float alpha) const
@@ -156,10 +191,13 @@ namespace Lynx
     {
         entt::entity Parent = entt::null;
         entt::entity FirstChild = entt::null;
+        entt::entity LastChild = entt::null; // So attaching doesn't have to walk the siblings
         entt::entity NextSibling = entt::null;
         entt::entity PrevSibling = entt::null;
 
         size_t ChildrenCount = 0;
+        // Distance to the root, maintained by the TransformHierarchy (only valid after its rebuild)
+        uint32_t Depth = 0;
         
         RelationshipComponent() = default;
         RelationshipComponent(const RelationshipComponent&) = default;
@@ -167,9 +205,19 @@ namespace Lynx
     
     struct DisabledComponent {}; // TODO: We need to check where to actually exclude entities with this component. Should this be visibility only? Or fully disabled?
 
+    // Root of a subtree that gets saved into a world partition cell and streamed in at runtime (see WorldPartition).
+    // Ignored on children and in scenes without world partition.
+    struct StreamedComponent {};
+
+    // World partition cells get loaded around these, without any the primary camera is used
+    struct StreamingSourceComponent {};
+
     struct MeshComponent
     {
         AssetRef<StaticMesh> Mesh;
+        // Never moves, gets merged into a combined mesh with its neighbours (see StaticBatcher)
+        bool IsStatic = false;
+        uint32_t Layers = RenderLayer::Default;
 
         MeshComponent() = default;
         MeshComponent(const MeshComponent&) = default;
@@ -180,6 +228,7 @@ namespace Lynx
         SceneCamera Camera;
         bool Primary = true;
         bool FixedAspectRatio = false;
+        uint32_t CullingMask = RenderLayer::Game;
 
         CameraComponent() = default;
         CameraComponent(const CameraComponent&) = default;
@@ -191,6 +240,8 @@ namespace Lynx
         float Intensity = 1.0f;
 
         bool CastShadows = true;
+        // Layers that end up in the shadow map
+        uint32_t ShadowCullingMask = RenderLayer::Shadow;
 
         DirectionalLightComponent() = default;
         DirectionalLightComponent(const DirectionalLightComponent&) = default;
@@ -200,6 +251,7 @@ namespace Lynx
     {
         AssetRef<Prefab> Prefab;
         UUID SubEntityID = UUID::Null();
+        uint32_t Version = 0; // Prefab version the instance was built from, not saved
         
         //std::unordered_set<std::string> Overrides;
         
@@ -3,6 +3,7 @@
 #include "Lynx/UUID.h"
 #include "Lynx/Asset/AssetRef.h"
 #include "Lynx/Asset/Material.h"
+#include "Lynx/Renderer/RenderLayers.h"
 #include <glm/glm.hpp>
 
 namespace Lynx
@@ -49,6 +50,7 @@ namespace Lynx
         float EmissionRate = 5.0f;
         bool IsLooping = true;
         bool DepthSorting = false;
+        uint32_t Layers = RenderLayer::VFX;
         bool BurstDone = false;
 
         std::vector<Particle> ParticlePool;
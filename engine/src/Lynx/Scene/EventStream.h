@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Lynx/Core.h"
+#include <entt/entt.hpp>
+#include <span>
+
+namespace Lynx
+{
+    // Position of a reader in a stream. Every reader keeps its own, so any number of systems can go over the same
+    // events without copying them or stealing them from each other.
+    struct EventCursor
+    {
+        uint64_t Next = 0;
+    };
+
+    class IEventStream
+    {
+    public:
+        virtual ~IEventStream() = default;
+
+        virtual void Update() = 0;
+        virtual void Clear() = 0;
+    };
+
+    // Events of one type in one contiguous buffer. Producers append during the frame, consumers read everything they
+    // haven't seen yet as a single span whenever it suits them. Events live for two Updates (one frame), so a reader
+    // that runs once per frame sees every event exactly once, no matter if it runs before or after the producer.
+    // Not thread safe, systems that push or read from workers declare Write<T>/Read<T> so they don't share a wave.
+    template<typename T>
+    class EventStream : public IEventStream
+    {
+    public:
+        void Push(const T& event)
+        {
+            m_Events.push_back(event);
+        }
+
+        template<typename... Args>
+        T& Emplace(Args&&... args)
+        {
+            return m_Events.emplace_back(T{ std::forward<Args>(args)... });
+        }
+
+        // Everything since the last read with this cursor, moves the cursor to the end.
+        // Events that got dropped before the reader got to them are skipped.
+        std::span<const T> Read(EventCursor& cursor) const
+        {
+            uint64_t first = std::max(cursor.Next, m_FirstIndex);
+            cursor.Next = GetEnd();
+            return std::span<const T>(m_Events).subspan((size_t)(first - m_FirstIndex));
+        }
+
+        // Cursor that only sees events pushed from now on
+        EventCursor GetCursor() const { return { GetEnd() }; }
+
+        // All events that are still alive, for one-off looks that don't need a cursor
+        std::span<const T> GetEvents() const { return m_Events; }
+        size_t GetSize() const { return m_Events.size(); }
+
+        // Drops the events that were already there at the previous Update
+        void Update() override
+        {
+            size_t expired = (size_t)(m_FrameStart - m_FirstIndex);
+            m_Events.erase(m_Events.begin(), m_Events.begin() + expired);
+            m_FirstIndex = m_FrameStart;
+            m_FrameStart = GetEnd();
+        }
+
+        // Cursors stay valid, they just skip whatever was dropped
+        void Clear() override
+        {
+            m_FirstIndex = m_FrameStart = GetEnd();
+            m_Events.clear();
+        }
+
+    private:
+        uint64_t GetEnd() const { return m_FirstIndex + m_Events.size(); }
+
+    private:
+        std::vector<T> m_Events;
+        // Index of m_Events[0] counted over the lifetime of the stream, cursors are in the same space
+        uint64_t m_FirstIndex = 0;
+        // First event pushed after the last Update
+        uint64_t m_FrameStart = 0;
+    };
+
+    // One stream per event type, owned by the scene
+    class EventStreams
+    {
+    public:
+        template<typename T>
+        EventStream<T>& Get()
+        {
+            auto& stream = m_Streams[entt::type_hash<T>::value()];
+            if (!stream)
+                stream = std::make_unique<EventStream<T>>();
+            return static_cast<EventStream<T>&>(*stream);
+        }
+
+        void Update()
+        {
+            for (auto& [id, stream] : m_Streams)
+                stream->Update();
+        }
+
+        void Clear()
+        {
+            for (auto& [id, stream] : m_Streams)
+                stream->Clear();
+        }
+
+    private:
+        std::unordered_map<entt::id_type, std::unique_ptr<IEventStream>> m_Streams;
+    };
+}
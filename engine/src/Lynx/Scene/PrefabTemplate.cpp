@@ -0,0 +1,77 @@
+#include "PrefabTemplate.h"
+
+#include "Lynx/Engine.h"
+#include "Lynx/Scene/Components/Components.h"
+
+namespace Lynx
+{
+    PrefabTemplate::PrefabTemplate()
+    {
+        // Some deserializers look the scene up, there is none for the template
+        m_Registry.ctx().emplace<Scene*>(nullptr);
+    }
+
+    void PrefabTemplate::Compile(const nlohmann::json& data)
+    {
+        m_Registry.clear();
+        m_Nodes.clear();
+
+        if (!data.contains("Entities") || !data["Entities"].is_array())
+            return;
+
+        const auto& registeredComponents = Engine::Get().GetComponentRegistry().GetRegisteredComponents();
+        const ComponentInfo* transformInfo = &registeredComponents.at("Transform");
+        const ComponentInfo* tagInfo = &registeredComponents.at("Tag");
+
+        // Entities are stored depth first, parents always come before their children
+        std::unordered_map<uint64_t, uint32_t> indexMap;
+        for (const auto& entityJson : data["Entities"])
+        {
+            Node node;
+            node.Entity = m_Registry.create();
+            node.Parent = InvalidIndex;
+            node.SubEntityID = entityJson["ID"].get<UUID>();
+
+            // Same defaults as Scene::CreateEntity
+            m_Registry.emplace<TransformComponent>(node.Entity);
+            m_Registry.emplace<RelationshipComponent>(node.Entity);
+            m_Registry.emplace<TagComponent>(node.Entity).Tag = "Entity";
+
+            for (auto& [key, value] : entityJson.items())
+            {
+                // The hierarchy gets rebuilt per instance, the prefab link is set to this prefab
+                if (key == "ID" || key == "Relationship" || key == "Prefab")
+                    continue;
+
+                auto it = registeredComponents.find(key);
+                if (it == registeredComponents.end() || !it->second.deserialize)
+                    continue;
+
+                const ComponentInfo& info = it->second;
+                if (info.CopyBySerialization)
+                {
+                    node.Serialized.emplace_back(&info, value);
+                    continue;
+                }
+
+                info.add(m_Registry, node.Entity);
+                info.deserialize(m_Registry, node.Entity, value);
+                if (&info != transformInfo && &info != tagInfo)
+                    node.Components.push_back(&info);
+            }
+
+            // Transform and tag go first, like in CreateEntity. Signal handlers of the other components expect them.
+            node.Components.insert(node.Components.begin(), { transformInfo, tagInfo });
+
+            if (entityJson.contains("Relationship") && entityJson["Relationship"].contains("Parent"))
+            {
+                auto parentIt = indexMap.find(entityJson["Relationship"]["Parent"].get<uint64_t>());
+                if (parentIt != indexMap.end())
+                    node.Parent = parentIt->second;
+            }
+
+            indexMap[(uint64_t)node.SubEntityID] = (uint32_t)m_Nodes.size();
+            m_Nodes.push_back(std::move(node));
+        }
+    }
+}
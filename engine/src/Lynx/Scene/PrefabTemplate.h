@@ -0,0 +1,43 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <nlohmann/json.hpp>
+
+#include "Lynx/UUID.h"
+
+namespace Lynx
+{
+    struct ComponentInfo;
+
+    // The entities of a prefab deserialized once into a private registry. Instances get their components
+    // stamped from here instead of walking the prefab json again on every spawn.
+    // Owned by the Prefab asset and thrown away when it reloads.
+    class PrefabTemplate
+    {
+    public:
+        static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        struct Node
+        {
+            entt::entity Entity; // In the template registry
+            uint32_t Parent; // Index into the nodes (always lower than our own), InvalidIndex for the root
+            UUID SubEntityID; // ID inside the prefab file
+            // Points into the component registry, templates don't outlive the game types (game assets get unloaded first)
+            std::vector<const ComponentInfo*> Components;
+            // CopyBySerialization components, deserialized again for every instance
+            std::vector<std::pair<const ComponentInfo*, nlohmann::json>> Serialized;
+        };
+
+        PrefabTemplate();
+
+        void Compile(const nlohmann::json& data);
+
+        bool IsEmpty() const { return m_Nodes.empty(); }
+        const std::vector<Node>& GetNodes() const { return m_Nodes; }
+        entt::registry& GetRegistry() { return m_Registry; }
+
+    private:
+        entt::registry m_Registry;
+        std::vector<Node> m_Nodes;
+    };
+}
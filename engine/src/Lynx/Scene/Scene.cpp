@@ -8,11 +8,13 @@
 #include "Components/NativeScriptComponent.h"
 #include "Lynx/Scripting/ScriptEngine.h"
 #include <glm/gtx/matrix_decompose.hpp>
+#include <nlohmann/json.hpp>
 
 #include "SceneSerializer.h"
 #include "Components/IDComponent.h"
 #include "Components/UIComponents.h"
 #include "Lynx/Asset/Prefab.h"
+#include "PrefabTemplate.h"
 #include "Lynx/Event/AssetEvents.h"
 #include "Lynx/Physics/PhysicsWorld.h"
 
@@ -27,9 +29,35 @@ namespace Lynx
         glm::vec4 perspective;
 
         glm::decompose(matrix, scale, rotation, translation, skew, perspective);
-        transform.Translation = translation;
-        transform.Rotation = rotation;
-        transform.Scale = scale;
+        transform.SetTranslation(translation);
+        transform.SetRotation(rotation);
+        transform.SetScale(scale);
+    }
+
+    // Recomputes the world matrices of one subtree right away (the TransformHierarchy does the regular per frame update).
+    // Entities whose world matrix changed end up in outChanged.
+    static void PropagateTransforms(entt::storage_for_t<TransformComponent>& transforms, const entt::storage_for_t<RelationshipComponent>& relationships,
+        entt::entity entity, const glm::mat4& parentWorld, std::vector<entt::entity>& outChanged)
+    {
+        auto& transform = transforms.get(entity);
+        if (transform.LocalDirty)
+            transform.LocalMatrix = transform.GetTransform();
+        transform.LocalDirty = false;
+        transform.WorldDirty = false;
+
+        glm::mat4 worldMatrix = parentWorld * transform.LocalMatrix;
+        if (worldMatrix != transform.WorldMatrix)
+        {
+            transform.WorldMatrix = worldMatrix;
+            outChanged.push_back(entity);
+        }
+
+        entt::entity child = relationships.get(entity).FirstChild;
+        while (child != entt::null)
+        {
+            PropagateTransforms(transforms, relationships, child, transform.WorldMatrix, outChanged);
+            child = relationships.get(child).NextSibling;
+        }
     }
 
     static void OnNativeScriptComponentDestroyed(entt::registry& registry, entt::entity entity)
@@ -76,24 +104,91 @@ namespace Lynx
         
         m_Registry.on_destroy<NativeScriptComponent>().connect<&OnNativeScriptComponentDestroyed>();
         m_Registry.on_destroy<LuaScriptComponent>().connect<&OnLuaScriptComponentDestroyed>();
-        
+        m_StaticBatcher.Init(m_Registry);
+        m_RenderProxies.Init(m_Registry);
+        m_TransformHierarchy.Init(m_Registry);
+        m_EntityIndex.Init(m_Registry);
+        m_SpatialIndex.Init(m_Registry);
     }
 
     Scene::~Scene()
     {
+        m_StaticBatcher.Shutdown(m_Registry);
+        m_RenderProxies.Shutdown(m_Registry);
+        m_TransformHierarchy.Shutdown(m_Registry);
+        m_EntityIndex.Shutdown(m_Registry);
+        m_SpatialIndex.Shutdown(m_Registry);
         m_PhysicsWorld.reset();
     }
 
+    std::shared_ptr<Scene> Scene::Copy(Scene& source)
+    {
+        auto scene = std::make_shared<Scene>();
+        auto& srcRegistry = source.m_Registry;
+        auto& dstRegistry = scene->m_Registry;
+
+        // Same entity ids on both sides, so the hierarchy and any entt::entity stored in components stay valid as is
+        for (auto entity : srcRegistry.view<entt::entity>())
+        {
+            entt::entity created = dstRegistry.create(entity);
+            LX_ASSERT(created == entity, "Scene copy couldn't reuse the entity id!");
+        }
+
+        for (auto [entity, idComp] : srcRegistry.view<IDComponent>().each())
+            dstRegistry.emplace<IDComponent>(entity, idComp);
+
+        // Same order as CreateEntity, the signal handlers of the other components expect these to be there
+        const auto& registeredComponents = Engine::Get().GetComponentRegistry().GetRegisteredComponents();
+        for (const char* name : { "Transform", "Relationship", "Tag" })
+        {
+            auto it = registeredComponents.find(name);
+            if (it != registeredComponents.end())
+                it->second.copy(srcRegistry, dstRegistry);
+        }
+
+        for (const auto& [name, info] : registeredComponents)
+        {
+            if (name == "Transform" || name == "Relationship" || name == "Tag")
+                continue;
+
+            if (!info.CopyBySerialization)
+            {
+                if (info.copy)
+                    info.copy(srcRegistry, dstRegistry);
+                continue;
+            }
+
+            // Only the entities in the pool, not every entity asked if it has one
+            auto* storage = srcRegistry.storage(info.TypeId);
+            if (!storage || !info.serialize || !info.deserialize)
+                continue;
+            for (auto entity : *storage)
+            {
+                nlohmann::json json;
+                info.serialize(srcRegistry, entity, json);
+                info.add(dstRegistry, entity);
+                info.deserialize(dstRegistry, entity, json);
+            }
+        }
+
+        for (auto entity : dstRegistry.view<entt::entity>())
+            scene->Emit<EntityCreatedEvent>(Entity{ entity, scene.get() });
+
+        // Cells unloaded while playing come back from the saved cell files
+        scene->m_WorldPartition.CopyFrom(source.m_WorldPartition);
+
+        return scene;
+    }
+
     Entity Scene::CreateEntity(const std::string& name)
     {
         Entity entity = { m_Registry.create(), this };
-        auto& idComp = entity.AddComponent<IDComponent>();
+        entity.AddComponent<IDComponent>();
         entity.AddComponent<TransformComponent>();
         entity.AddComponent<RelationshipComponent>();
-        auto& tag = entity.AddComponent<TagComponent>();
-        tag.Tag = name.empty() ? "Entity" : name;
+        // Named on construct, so the entity index sees the name
+        entity.AddComponent<TagComponent>(name.empty() ? "Entity" : name);
         
-        m_EntityMap[idComp.ID] = entity;
         Emit<EntityCreatedEvent>(entity);
         
         return entity;
@@ -124,8 +219,6 @@ namespace Lynx
         
         Entity e(entity, this);
         Emit<EntityDestroyedEvent>(e);
-        auto& idComp = m_Registry.get<IDComponent>(entity);
-        m_EntityMap.erase(idComp.ID);
         m_Registry.destroy(entity);
     }
     
@@ -139,19 +232,8 @@ namespace Lynx
         if (!m_Registry.valid(entity))
             return;
         
-        if (!excludeChildren)
-        {
-            auto& rel = m_Registry.get<RelationshipComponent>(entity);
-            entt::entity child = rel.FirstChild;
-            while (child != entt::null)
-            {
-                entt::entity nextChild = m_Registry.get<RelationshipComponent>(child).NextSibling;
-                DestroyEntityDeferred(entity, excludeChildren);
-                child = nextChild;
-            }
-        }
-        
-        m_DestroyQueue.push_back(entity);
+        // DestroyEntity takes care of the children at playback
+        GetCommandBuffer().Destroy(entity, excludeChildren);
     }
 
     void Scene::DestroyEntityDeferred(Entity entity, bool excludeChildren)
@@ -171,42 +253,102 @@ namespace Lynx
 
     Entity Scene::InstantiatePrefab(std::shared_ptr<Prefab> prefab, Entity parent)
     {
-        if (!prefab)
-            return {};
-        
-        auto data = prefab->GetData();
-        Entity rootInstance = SceneSerializer::DeserializePrefab(this, data, parent);
-        if (rootInstance)
+        std::vector<Entity> instances = InstantiatePrefabBatch(prefab, 1, parent);
+        return instances.empty() ? Entity{} : instances[0];
+    }
+
+    std::vector<Entity> Scene::InstantiatePrefabBatch(std::shared_ptr<Prefab> prefab, uint32_t count, Entity parent)
+    {
+        std::vector<Entity> roots;
+        if (!prefab || count == 0)
+            return roots;
+
+        PrefabTemplate& prefabTemplate = prefab->GetTemplate();
+        if (prefabTemplate.IsEmpty())
+            return roots;
+
+        const auto& nodes = prefabTemplate.GetNodes();
+        auto& templateRegistry = prefabTemplate.GetRegistry();
+
+        // Grouped by node, so every component gets stamped onto all instances at once: entities[node * count + instance]
+        std::vector<entt::entity> entities(nodes.size() * count);
+        m_Registry.create(entities.begin(), entities.end());
+
+        for (entt::entity entity : entities)
+            m_Registry.emplace<IDComponent>(entity);
+
+        for (size_t i = 0; i < nodes.size(); i++)
         {
-            auto entitiesJson = data["Entities"];
-            if (entitiesJson.is_array())
+            const auto& node = nodes[i];
+            const entt::entity* first = entities.data() + i * count;
+            const entt::entity* last = first + count;
+
+            // Components[0] is the transform, the relationship goes right behind it like in CreateEntity
+            node.Components[0]->stamp(templateRegistry, node.Entity, m_Registry, first, last);
+            m_Registry.insert<RelationshipComponent>(first, last);
+            for (size_t c = 1; c < node.Components.size(); c++)
+                node.Components[c]->stamp(templateRegistry, node.Entity, m_Registry, first, last);
+
+            PrefabComponent pc;
+            pc.Prefab = prefab;
+            pc.SubEntityID = node.SubEntityID;
+            pc.Version = prefab->GetVersion();
+            m_Registry.insert<PrefabComponent>(first, last, pc);
+
+            for (const auto& [info, json] : node.Serialized)
             {
-                int jsonIndex = 0;
-                std::function<void(Entity)> tagEntity = [&](Entity current)
+                for (const entt::entity* entity = first; entity != last; entity++)
                 {
-                    if (jsonIndex >= entitiesJson.size())
-                        return;
-                    
-                    UUID originalID = entitiesJson[jsonIndex]["ID"].get<UUID>();
-                    jsonIndex++;
-                    
-                    auto& pc = current.AddOrReplaceComponent<PrefabComponent>();
-                    pc.Prefab = prefab;
-                    pc.SubEntityID = originalID;
-                    
-                    auto& rel = current.GetComponent<RelationshipComponent>();
-                    entt::entity child = rel.FirstChild;
-                    while (child != entt::null)
-                    {
-                        tagEntity(Entity(child, this));
-                        child = Reg().get<RelationshipComponent>(child).NextSibling;
-                    }
-                };
-                
-                tagEntity(rootInstance);
+                    info->add(m_Registry, *entity);
+                    info->deserialize(m_Registry, *entity, json);
+                }
             }
         }
-        return rootInstance;
+
+        // Children get appended in node order, which keeps the sibling order of the prefab
+        for (size_t i = 1; i < nodes.size(); i++)
+        {
+            if (nodes[i].Parent == PrefabTemplate::InvalidIndex)
+                continue;
+            for (uint32_t instance = 0; instance < count; instance++)
+                AttachEntity(entities[i * count + instance], entities[nodes[i].Parent * count + instance]);
+        }
+
+        roots.reserve(count);
+        for (uint32_t instance = 0; instance < count; instance++)
+        {
+            if (parent)
+                AttachEntity(entities[instance], parent);
+            roots.emplace_back(entities[instance], this);
+        }
+
+        for (entt::entity entity : entities)
+            Emit<EntityCreatedEvent>(Entity{ entity, this });
+
+        return roots;
+    }
+
+    Entity Scene::SpawnPooled(std::shared_ptr<Prefab> prefab, Entity parent)
+    {
+        std::vector<Entity> instances = SpawnPooledBatch(prefab, 1, parent);
+        return instances.empty() ? Entity{} : instances[0];
+    }
+
+    std::vector<Entity> Scene::SpawnPooledBatch(std::shared_ptr<Prefab> prefab, uint32_t count, Entity parent)
+    {
+        std::vector<entt::entity> roots;
+        m_EntityPool.Spawn(*this, prefab, count, parent.GetHandle(), roots);
+        
+        std::vector<Entity> instances;
+        instances.reserve(roots.size());
+        for (entt::entity root : roots)
+            instances.emplace_back(root, this);
+        return instances;
+    }
+
+    void Scene::ReleaseToPool(Entity entity)
+    {
+        GetCommandBuffer().ReleaseToPool(entity);
     }
 
     Entity Scene::InstantiatePrefab(AssetHandle prefab, Entity parent)
@@ -220,24 +362,29 @@ namespace Lynx
         if (name.empty())
             return {};
         
-        auto view = m_Registry.view<TagComponent>();
-        for (auto entity : view)
-        {
-            if (view.get<TagComponent>(entity).Tag == name)
-            {
-                return { entity, this };
-            }
-        }
+        entt::entity entity = m_EntityIndex.FindByName(name);
+        if (entity == entt::null)
+            return {};
+        
+        return { entity, this };
+    }
+
+    std::vector<Entity> Scene::FindEntitiesByName(const std::string& name)
+    {
+        std::vector<Entity> result;
+        for (entt::entity entity : m_EntityIndex.FindAllByName(name))
+            result.emplace_back(entity, this);
         
-        return {};
+        return result;
     }
 
     Entity Scene::FindEntityByUUID(UUID uuid)
     {
-        if (m_EntityMap.find(uuid) != m_EntityMap.end())
-            return {m_EntityMap.at(uuid), this};
+        entt::entity entity = m_EntityIndex.FindByUUID(uuid);
+        if (entity == entt::null)
+            return {};
         
-        return {};
+        return { entity, this };
     }
 
     /*void Scene::CreateRuntimeBody(entt::entity entity, const TransformComponent& transform, RigidBodyComponent& rigidBody)
@@ -356,17 +503,9 @@ namespace Lynx
         character.RuntimeCreated = true;
     }*/
 
-    void Scene::ProcessDestroyQueue()
+    void Scene::PlaybackCommands()
     {
-        for (auto entity : m_DestroyQueue)
-        {
-            Entity e(entity, this);
-            Emit<EntityDestroyedEvent>(e);
-            auto& idComp = m_Registry.get<IDComponent>(entity);
-            m_EntityMap.erase(idComp.ID);
-            m_Registry.destroy(entity);
-        }
-        m_DestroyQueue.clear();
+        m_Commands.Playback(*this);
     }
 
     void Scene::OnRuntimeStart()
@@ -375,6 +514,7 @@ namespace Lynx
         
         m_GameSystems.Init(*this);
         m_PhysicsSystem.OnInit(*this);
+        m_WorldPartition.Start(*this);
         
         Engine::Get().GetRenderer().SetShowUI(true);
         
@@ -400,15 +540,7 @@ namespace Lynx
 
         auto nscView = m_Registry.view<NativeScriptComponent>();
         for (auto entity : nscView)
-        {
-            auto& nsc = m_Registry.get<NativeScriptComponent>(entity);
-            if (!nsc.Instance && nsc.InstantiateScript)
-            {
-                nsc.Instance = nsc.InstantiateScript();
-                nsc.Instance->m_Entity = Entity{ entity, this };
-                nsc.Instance->OnCreate();
-            }
-        }
+            CreateScriptInstance(entity);
         
         m_GameSystems.SceneStart(*this);
         m_PhysicsSystem.OnSceneStart(*this);
@@ -441,19 +573,27 @@ namespace Lynx
         m_PhysicsSystem.OnShutdown(*this); // TODO: Do the bodies get destroyed correctly??
         m_GameSystems.Shutdown(*this);
         
+        m_EntityPool.Clear();
+        m_Commands.Clear();
+        m_WorldPartition.Stop();
+        m_EventStreams.Clear();
         m_PhysicsWorld.reset();
     }
 
     void Scene::OnUpdateRuntime(float deltaTime)
     {
-        auto luaView = m_Registry.view<LuaScriptComponent>();
+        m_Commands.ResetStats();
+        m_SpatialIndex.ResetStats();
+        m_WorldPartition.Update(*this);
+        
+        auto luaView = m_Registry.view<LuaScriptComponent>(entt::exclude<DisabledComponent>);
         for (auto entity : luaView)
         {
             Entity e = { entity, this };
             Engine::Get().GetScriptEngine()->OnUpdateEntity(e, deltaTime);
         }
         
-        auto nscView = m_Registry.view<NativeScriptComponent>();
+        auto nscView = m_Registry.view<NativeScriptComponent>(entt::exclude<DisabledComponent>);
         for (auto entity : nscView)
         {
             auto& nsc = m_Registry.get<NativeScriptComponent>(entity);
@@ -462,6 +602,7 @@ namespace Lynx
                 nsc.Instance->OnUpdate(deltaTime);
             }
         }
+        PlaybackCommands();
         
         auto& renderer = Engine::Get().GetRenderer();
         if (renderer.GetShowUI())
@@ -499,21 +640,27 @@ namespace Lynx
         }*/
         
         m_GameSystems.Update(*this, deltaTime);
+        PlaybackCommands();
+
+        m_AnimationSystem.OnUpdate(deltaTime, this);
+        m_EntityPool.Update(*this, deltaTime);
     }
 
     void Scene::OnFixedUpdate(float fixedDeltaTime)
     {
         m_GameSystems.FixedUpdate(*this, fixedDeltaTime);
+        PlaybackCommands();
         m_PhysicsSystem.OnFixedUpdate(*this, fixedDeltaTime);
     }
 
     void Scene::OnLateUpdate(float deltaTime)
     {
         m_GameSystems.LateUpdate(*this, deltaTime);
+        PlaybackCommands();
         
         UpdateGlobalTransforms();
-        ProcessDestroyQueue();
         DispatchEvents();
+        m_EventStreams.Update();
     }
 
     void Scene::OnUpdateEditor(float deltaTime, glm::vec3 cameraPos)
@@ -611,21 +758,15 @@ namespace Lynx
         }
         else
         {
-            entt::entity current = parentRel.FirstChild;
-            while (true)
-            {
-                auto& currentRel = m_Registry.get<RelationshipComponent>(current);
-                if (currentRel.NextSibling == entt::null)
-                {
-                    currentRel.NextSibling = child;
-                    childRel.PrevSibling = current;
-                    break;
-                }
-                current = currentRel.NextSibling;
-            }
+            m_Registry.get<RelationshipComponent>(parentRel.LastChild).NextSibling = child;
+            childRel.PrevSibling = parentRel.LastChild;
         }
+        parentRel.LastChild = child;
 
         parentRel.ChildrenCount++;
+        m_TransformHierarchy.MarkDirty();
+        if (auto* transform = m_Registry.try_get<TransformComponent>(child))
+            transform->WorldDirty = true;
     }
 
     void Scene::AttachEntityKeepWorld(entt::entity child, entt::entity parent)
@@ -647,7 +788,7 @@ namespace Lynx
         SetTransformFromMatrix(childTransform, newLocal);
 
         AttachEntity(child, parent);
-        UpdateEntityTransform(child, parentWorld);
+        UpdateTransformSubtree(child);
     }
 
     void Scene::DetachEntity(entt::entity child)
@@ -665,6 +806,11 @@ namespace Lynx
             parentRel.FirstChild = childRel.NextSibling;
         }
 
+        if (parentRel.LastChild == child)
+        {
+            parentRel.LastChild = childRel.PrevSibling;
+        }
+
         if (childRel.PrevSibling != entt::null)
         {
             m_Registry.get<RelationshipComponent>(childRel.PrevSibling).NextSibling = childRel.NextSibling;
@@ -680,6 +826,9 @@ namespace Lynx
         childRel.PrevSibling = entt::null;
 
         parentRel.ChildrenCount--;
+        m_TransformHierarchy.MarkDirty();
+        if (auto* transform = m_Registry.try_get<TransformComponent>(child))
+            transform->WorldDirty = true;
     }
 
     void Scene::DetachEntityKeepWorld(entt::entity child)
@@ -691,7 +840,7 @@ namespace Lynx
         auto& childTransform = m_Registry.get<TransformComponent>(child);
         SetTransformFromMatrix(childTransform, childTransform.WorldMatrix);
         DetachEntity(child);
-        childTransform.WorldMatrix = childTransform.GetTransform();
+        UpdateTransformSubtree(child);
     }
 
     std::shared_ptr<class UIElement> Scene::FindUIElementByID(UUID id)
@@ -712,23 +861,59 @@ namespace Lynx
 
     void Scene::UpdateGlobalTransforms()
     {
-        auto view = m_Registry.view<TransformComponent, RelationshipComponent>();
-        for (auto entity : view)
+        // Signals on this thread, listeners (render proxies) aren't thread safe
+        for (auto entity : m_TransformHierarchy.Update(m_Registry))
+            m_Registry.patch<TransformComponent>(entity);
+    }
+
+    void Scene::OnStreamedIn(entt::entity root)
+    {
+        UpdateTransformSubtree(root);
+
+        std::vector<entt::entity> stack = { root };
+        while (!stack.empty())
         {
-            const auto& rel = view.get<RelationshipComponent>(entity);
-            if (rel.Parent == entt::null)
-            {
-                auto& transform = view.get<TransformComponent>(entity);
-                transform.WorldMatrix = transform.GetTransform();
+            entt::entity entity = stack.back();
+            stack.pop_back();
 
-                if (rel.FirstChild != entt::null)
-                {
-                    UpdateEntityTransform(rel.FirstChild, transform.WorldMatrix);
-                }
-            }
+            // Children first, detaching changes the sibling links
+            for (entt::entity child = m_Registry.get<RelationshipComponent>(entity).FirstChild; child != entt::null;
+                 child = m_Registry.get<RelationshipComponent>(child).NextSibling)
+                stack.push_back(child);
+
+            if (entity != root && m_Registry.all_of<RigidBodyComponent>(entity))
+                DetachEntityKeepWorld(entity);
+
+            if (m_Registry.all_of<NativeScriptComponent>(entity))
+                CreateScriptInstance(entity);
         }
     }
 
+    void Scene::CreateScriptInstance(entt::entity entity)
+    {
+        auto& nsc = m_Registry.get<NativeScriptComponent>(entity);
+        if (!nsc.Instance && nsc.InstantiateScript)
+        {
+            nsc.Instance = nsc.InstantiateScript();
+            nsc.Instance->m_Entity = Entity{ entity, this };
+            nsc.Instance->OnCreate();
+        }
+    }
+
+    void Scene::UpdateTransformSubtree(entt::entity entity)
+    {
+        auto& transforms = m_Registry.storage<TransformComponent>();
+        const auto& relationships = m_Registry.storage<RelationshipComponent>();
+
+        entt::entity parent = relationships.get(entity).Parent;
+        glm::mat4 parentWorld = parent != entt::null ? transforms.get(parent).WorldMatrix : glm::mat4(1.0f);
+
+        std::vector<entt::entity> changed;
+        PropagateTransforms(transforms, relationships, entity, parentWorld, changed);
+        for (auto changedEntity : changed)
+            m_Registry.patch<TransformComponent>(changedEntity);
+    }
+
     bool Scene::LoadSourceData()
     {
         SceneSerializer serializer(shared_from_this());
@@ -739,18 +924,4 @@ namespace Lynx
     {
         m_Registry.on_construct<LuaScriptComponent>().connect<&OnLuaScriptComponentConstructed>();
     }
-
-    void Scene::UpdateEntityTransform(entt::entity entity, const glm::mat4& parentTransform)
-    {
-        auto& transform = m_Registry.get<TransformComponent>(entity);
-        auto& rel = m_Registry.get<RelationshipComponent>(entity);
-
-        transform.WorldMatrix = parentTransform * transform.GetTransform();
-
-        if (rel.NextSibling != entt::null)
-            UpdateEntityTransform(rel.NextSibling, parentTransform);
-
-        if (rel.FirstChild != entt::null)
-            UpdateEntityTransform(rel.FirstChild, transform.WorldMatrix);
-    }
 }
@@ -4,11 +4,21 @@
 #include <entt/entt.hpp>
 #include <glm/fwd.hpp>
 
+#include "CommandBuffer.h"
 #include "Entity.h"
+#include "EventStream.h"
+#include "WorldPartition.h"
 #include "Lynx/Asset/Asset.h"
 #include "Lynx/Event/Event.h"
 #include "Lynx/Physics/PhysicsSystem.h"
+#include "Systems/AnimationSystem.h"
+#include "Systems/EntityIndex.h"
+#include "Systems/EntityPool.h"
 #include "Systems/ParticleSystem.h"
+#include "Systems/RenderProxyCache.h"
+#include "Systems/SpatialIndex.h"
+#include "Systems/TransformHierarchy.h"
+#include "Systems/StaticBatcher.h"
 #include "Systems/SystemManager.h"
 
 namespace Lynx
@@ -27,19 +37,39 @@ namespace Lynx
         Scene(const Scene&) = delete;
         Scene& operator=(const Scene&) = delete;
 
+        // Clones the registry pool by pool through the component registry. Keeps UUIDs, entity ids and the hierarchy,
+        // asset refs are shared instead of reloaded. Components flagged CopyBySerialization take the JSON path.
+        static std::shared_ptr<Scene> Copy(Scene& source);
+
         // --- Entity Management ---
         Entity CreateEntity(const std::string& name = std::string());
         void DestroyEntity(Entity entity, bool excludeChildren = true);
         void DestroyEntity(entt::entity entity, bool excludeChildren = true);
+        // Recorded into this thread's command buffer, happens at the next sync point
         void DestroyEntityDeferred(Entity entity, bool excludeChildren = true);
         void DestroyEntityDeferred(entt::entity entity, bool excludeChildren = true);
         
+        // Structural changes from systems and scripts go here while they iterate. Played back after the scripts,
+        // after the game systems (update and fixed update) and before the late transform update, in SortKey order.
+        CommandBuffer& GetCommandBuffer() { return m_Commands.GetBuffer(); }
+        const CommandQueue::Stats& GetCommandStats() const { return m_Commands.GetStats(); }
+        
         Entity InstantiatePrefab(std::shared_ptr<Prefab> prefab);
         Entity InstantiatePrefab(std::shared_ptr<Prefab> prefab, Entity parent);
         Entity InstantiatePrefab(AssetHandle prefab);
         Entity InstantiatePrefab(AssetHandle prefab, Entity parent);
+        // Spawns count copies of the prefab in one go, returns their roots
+        std::vector<Entity> InstantiatePrefabBatch(std::shared_ptr<Prefab> prefab, uint32_t count, Entity parent = {});
+        
+        // Like InstantiatePrefab, but reuses instances given back through ReleaseToPool
+        Entity SpawnPooled(std::shared_ptr<Prefab> prefab, Entity parent = {});
+        std::vector<Entity> SpawnPooledBatch(std::shared_ptr<Prefab> prefab, uint32_t count, Entity parent = {});
+        // Deferred like DestroyEntityDeferred. The entity has to be the root of a prefab instance, otherwise it just gets destroyed.
+        void ReleaseToPool(Entity entity);
         
+        // Indexed, see EntityIndex. With duplicate names FindEntityByName returns any one of them.
         Entity FindEntityByName(const std::string& name);
+        std::vector<Entity> FindEntitiesByName(const std::string& name);
         Entity FindEntityByUUID(UUID uuid);
         std::shared_ptr<class UIElement> FindUIElementByID(UUID id);
                 
@@ -52,18 +82,21 @@ namespace Lynx
         template <typename... Components>
         auto View()
         {
+            CheckAccess<Components...>();
             return m_Registry.view<Components...>();
         }
         
         template <typename... Components>
         auto Group()
         {
+            CheckAccess<Components...>();
             return m_Registry.group<Components...>();
         }
         
         template <typename... Components, typename Func>
         void ForEach(Func&& func)
         {
+            CheckAccess<Components...>();
             auto view = m_Registry.view<Components...>();
             
             view.each([&](auto entityID, auto&... components)
@@ -106,7 +139,27 @@ namespace Lynx
             m_Dispatcher.update();
         }
         
+        // --- Event streams ---
+        // Batched alternative to Emit: events get appended to a per type buffer and readers go over them as a span
+        // whenever they run. Streams are rotated once per frame in OnLateUpdate.
+        template <typename Event, typename... Args>
+        void Publish(Args&&... args)
+        {
+            m_EventStreams.Get<Event>().Emplace(std::forward<Args>(args)...);
+        }
+        
+        template <typename Event>
+        std::span<const Event> ReadEvents(EventCursor& cursor)
+        {
+            return m_EventStreams.Get<Event>().Read(cursor);
+        }
+        
+        template <typename Event>
+        EventStream<Event>& GetEventStream() { return m_EventStreams.Get<Event>(); }
+        
         // --- Game Systems ---
+        SystemManager* GetSystemManager() { return &m_GameSystems; }
+        
         template <typename T, typename... Args>
         T* AddSystem(Args&&... args)
         {
@@ -128,6 +181,13 @@ namespace Lynx
         PhysicsWorld* GetPhysicsWorld() { return m_PhysicsWorld.get(); }
         PhysicsWorld& GetPhysicsWorldChecked() { LX_ASSERT(m_PhysicsWorld, "PhysicsWorld only available in player mode!"); return *m_PhysicsWorld; }
         ParticleSystem* GetParticleSystem() { return &m_ParticleSystem; }
+        AnimationSystem* GetAnimationSystem() { return &m_AnimationSystem; }
+        StaticBatcher* GetStaticBatcher() { return &m_StaticBatcher; }
+        RenderProxyCache* GetRenderProxies() { return &m_RenderProxies; }
+        TransformHierarchy* GetTransformHierarchy() { return &m_TransformHierarchy; }
+        EntityPool* GetEntityPool() { return &m_EntityPool; }
+        SpatialIndex* GetSpatialIndex() { return &m_SpatialIndex; }
+        WorldPartition* GetWorldPartition() { return &m_WorldPartition; }
 
         static AssetType GetAssetType() { return AssetType::Scene; }
         virtual AssetType GetType() const override { return Scene::GetAssetType(); }
@@ -150,25 +210,46 @@ namespace Lynx
         void UpdateGlobalTransforms();
 
     private:
-        void UpdateEntityTransform(entt::entity entity, const glm::mat4& parentTransform);
-        void ProcessDestroyQueue();
+        // Does nothing unless SystemManager::SetAccessChecks is on and a system is running on this thread
+        template <typename... Components>
+        static void CheckAccess()
+        {
+            (SystemAccess::CheckAccess(entt::type_hash<Components>::value(), entt::type_name<Components>::value()), ...);
+        }
+        
+        // Immediate update of one subtree, for when the world matrix is needed before the next UpdateGlobalTransforms
+        void UpdateTransformSubtree(entt::entity entity);
+        void PlaybackCommands();
+        // Runtime fixups for a subtree a world partition cell brought in, what OnRuntimeStart does for everything else
+        void OnStreamedIn(entt::entity root);
+        // Native script instance for a bound NativeScriptComponent that doesn't have one yet
+        void CreateScriptInstance(entt::entity entity);
         
     private:
         entt::registry m_Registry;
         entt::dispatcher m_Dispatcher;
+        EventStreams m_EventStreams;
         
         ParticleSystem m_ParticleSystem;
+        AnimationSystem m_AnimationSystem;
+        StaticBatcher m_StaticBatcher;
+        RenderProxyCache m_RenderProxies;
+        TransformHierarchy m_TransformHierarchy;
+        EntityPool m_EntityPool;
+        EntityIndex m_EntityIndex;
+        SpatialIndex m_SpatialIndex;
         std::unique_ptr<PhysicsWorld> m_PhysicsWorld;
         PhysicsSystem m_PhysicsSystem;
         
         SystemManager m_GameSystems;
         
-        std::vector<entt::entity> m_DestroyQueue;
-        
-        std::unordered_map<UUID, entt::entity> m_EntityMap;
+        CommandQueue m_Commands;
+        WorldPartition m_WorldPartition;
 
         friend class SceneHierarchyPanel; // For editor later
         friend class SceneSerializer;
+        friend class WorldPartition;
+        friend class EntityPool;
         friend class Engine;
         friend class EditorLayer;
     };
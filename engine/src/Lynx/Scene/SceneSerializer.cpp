@@ -2,10 +2,13 @@
 
 #include <nlohmann/json.hpp>
 
+#include "BinaryScene.h"
 #include "Entity.h"
 #include "Components/Components.h"
 #include "Components/IDComponent.h"
 #include "Lynx/Engine.h"
+#include "Lynx/Core/MappedFile.h"
+#include "Lynx/Asset/AssetRegistry.h"
 
 namespace Lynx
 {
@@ -14,8 +17,50 @@ namespace Lynx
     {
     }
 
+    // Parents before their children, siblings in order. A stack, deep hierarchies would run out of it otherwise.
+    static void CollectHierarchy(entt::registry& registry, entt::entity root, std::vector<entt::entity>& outEntities)
+    {
+        std::vector<entt::entity> stack = { root };
+        while (!stack.empty())
+        {
+            entt::entity entity = stack.back();
+            stack.pop_back();
+            outEntities.push_back(entity);
+
+            // Last child first, so the first one comes off next
+            for (entt::entity child = registry.get<RelationshipComponent>(entity).LastChild; child != entt::null;
+                 child = registry.get<RelationshipComponent>(child).PrevSibling)
+                stack.push_back(child);
+        }
+    }
+
     void SceneSerializer::Serialize(const std::string& filepath)
     {
+        // No scene json, the entities go from the pools into the file. Only cells are still json.
+        nlohmann::json sceneSettings;
+        sceneSettings["Scene"] = "Untitled"; // TODO: Add name?
+
+        bool partitioned = m_Scene->GetWorldPartition()->GetSettings().Enabled;
+        std::vector<entt::entity> roots;
+        CellRoots cellRoots;
+        CollectRoots(partitioned, roots, cellRoots);
+        if (partitioned)
+            WriteCells(filepath, cellRoots, sceneSettings);
+
+        auto& registry = m_Scene->Reg();
+        std::vector<entt::entity> entities;
+        entities.reserve(registry.storage<RelationshipComponent>().size());
+        for (entt::entity root : roots)
+            CollectHierarchy(registry, root, entities);
+
+        std::vector<uint8_t> data = BinaryScene::Write(*m_Scene, entities, sceneSettings);
+        std::ofstream fout(filepath, std::ios::binary);
+        fout.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)data.size());
+    }
+
+    void SceneSerializer::ExportJson(const std::string& filepath)
+    {
+        // The whole world in one file, cells included
         std::ofstream fout(filepath);
         fout << SerializeToJson().dump(4);
     }
@@ -25,97 +70,447 @@ namespace Lynx
         return SerializeToJson().dump();
     }
 
-    bool SceneSerializer::Deserialize(const std::string& filepath)
+    // Creates every entity as soon as its closing brace comes by, so there is never more than one entity worth of
+    // json around. Everything outside "Entities" is small and kept for DeserializeSceneSettings.
+    class SceneJsonReader : public nlohmann::json_sax<nlohmann::json>
     {
-        std::ifstream stream(filepath);
-        if (!stream.is_open())
+    public:
+        SceneJsonReader(Scene* scene) : m_Scene(scene) {}
+
+        nlohmann::json& GetSceneJson() { return m_SceneJson; }
+
+        // Parents come before their children when we wrote the file, anything else gets attached here
+        void Finish()
+        {
+            for (const auto& [child, parentUUID] : m_PendingParents)
+            {
+                auto it = m_Entities.find(parentUUID);
+                if (it != m_Entities.end())
+                    m_Scene->AttachEntity(child, it->second);
+            }
+            m_PendingParents.clear();
+        }
+
+        bool null() override { Add(nullptr); return true; }
+        bool boolean(bool value) override { Add(value); return true; }
+        bool number_integer(number_integer_t value) override { Add(value); return true; }
+        bool number_unsigned(number_unsigned_t value) override { Add(value); return true; }
+        bool number_float(number_float_t value, const string_t&) override { Add(value); return true; }
+        bool string(string_t& value) override { Add(std::move(value)); return true; }
+        bool binary(binary_t& value) override { Add(nlohmann::json::binary(std::move(value))); return true; }
+        bool key(string_t& value) override { m_Key = std::move(value); return true; }
+
+        bool start_object(std::size_t) override
+        {
+            if (m_Depth == 0)
+            {
+                m_SceneJson = nlohmann::json::object();
+                m_Stack.push_back(&m_SceneJson);
+            }
+            else if (m_InEntities && m_Depth == 2)
+            {
+                m_Entity = nlohmann::json::object();
+                m_Stack.push_back(&m_Entity);
+            }
+            else
+            {
+                m_Stack.push_back(Add(nlohmann::json::object()));
+            }
+            m_Depth++;
+            return true;
+        }
+
+        bool end_object() override
+        {
+            m_Depth--;
+            m_Stack.pop_back();
+            if (m_InEntities && m_Depth == 2)
+                CreateEntity();
+            return true;
+        }
+
+        bool start_array(std::size_t) override
+        {
+            if (m_Depth == 1 && m_Key == "Entities")
+            {
+                // Entities don't go into the scene json, the null makes Add skip anything that isn't an entity
+                m_InEntities = true;
+                m_Stack.push_back(nullptr);
+            }
+            else
+            {
+                m_Stack.push_back(Add(nlohmann::json::array()));
+            }
+            m_Depth++;
+            return true;
+        }
+
+        bool end_array() override
         {
-            LX_CORE_ERROR("Could not open file: {}", filepath);
+            m_Depth--;
+            m_Stack.pop_back();
+            if (m_Depth == 1)
+                m_InEntities = false;
+            return true;
+        }
+
+        bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& e) override
+        {
+            LX_CORE_ERROR("JSON Parse Error: {}", e.what());
             return false;
         }
 
-        std::stringstream ss;
-        ss << stream.rdbuf();
-        bool result = DeserializeFromString(ss.str());
+    private:
+        // Puts the value where the parser is, returns it for containers. Null outside of anything we keep.
+        nlohmann::json* Add(nlohmann::json&& value)
+        {
+            if (m_Stack.empty() || !m_Stack.back())
+                return nullptr;
+
+            nlohmann::json& parent = *m_Stack.back();
+            if (parent.is_array())
+            {
+                parent.push_back(std::move(value));
+                return &parent.back();
+            }
+            nlohmann::json& slot = parent[m_Key];
+            slot = std::move(value);
+            return &slot;
+        }
+
+        void CreateEntity()
+        {
+            if (!m_Entity.contains("ID"))
+                return;
+
+            Entity entity = SceneSerializer::DeserializeEntity(m_Scene, m_Entity);
+            m_Entities[m_Entity["ID"].get<uint64_t>()] = entity;
+
+            if (m_Entity.contains("Relationship") && m_Entity["Relationship"].contains("Parent"))
+            {
+                uint64_t parentUUID = m_Entity["Relationship"]["Parent"].get<uint64_t>();
+                auto it = m_Entities.find(parentUUID);
+                if (it != m_Entities.end())
+                    m_Scene->AttachEntity(entity, it->second);
+                else
+                    m_PendingParents.emplace_back(entity, parentUUID);
+            }
+        }
+
+    private:
+        Scene* m_Scene;
+        nlohmann::json m_SceneJson;
+        nlohmann::json m_Entity;
+        std::vector<nlohmann::json*> m_Stack;
+        std::string m_Key;
+        uint32_t m_Depth = 0;
+        bool m_InEntities = false;
+
+        std::unordered_map<uint64_t, entt::entity> m_Entities;
+        std::vector<std::pair<entt::entity, uint64_t>> m_PendingParents;
+    };
+
+    bool SceneSerializer::Deserialize(const std::string& filepath)
+    {
+        // Binary or json, whatever is in the file. Json is still around for older scenes and exports.
+        bool result;
+        MappedFile file(filepath);
+        if (file.IsValid() && BinaryScene::IsBinary(file.GetData(), file.GetSize()))
+        {
+            result = DeserializeBinary(file.GetData(), file.GetSize());
+        }
+        else
+        {
+            std::ifstream stream(filepath);
+            if (!stream.is_open())
+            {
+                LX_CORE_ERROR("Could not open file: {}", filepath);
+                return false;
+            }
+
+            // Parsed straight from the stream, the file never is in memory as a whole
+            SceneJsonReader reader(m_Scene.get());
+            result = nlohmann::json::sax_parse(stream, &reader);
+            reader.Finish();
+            DeserializeSceneSettings(reader.GetSceneJson());
+        }
+        // Cell files are relative to the scene
+        m_Scene->GetWorldPartition()->SetDirectory(std::filesystem::path(filepath).parent_path());
         m_Scene->PostDeserialize();
         return result;
     }
 
     bool SceneSerializer::DeserializeFromString(const std::string& serialized)
     {
+        SceneJsonReader reader(m_Scene.get());
+        bool result = nlohmann::json::sax_parse(serialized, &reader);
+        reader.Finish();
+        DeserializeSceneSettings(reader.GetSceneJson());
+        return result;
+    }
+
+    bool SceneSerializer::DeserializeBinary(const uint8_t* data, size_t size)
+    {
+        BinaryScene::Reader reader(data, size);
+        if (!reader.IsValid())
+            return false;
+
         nlohmann::json sceneJson;
-        try
+        if (!reader.ReadScene(sceneJson))
         {
-            sceneJson = nlohmann::json::parse(serialized);
+            LX_CORE_ERROR("Binary scene has broken scene settings");
+            return false;
         }
-        catch (nlohmann::json::parse_error& e)
+
+        // Start loading everything the components point at, so it's in flight before the first frame asks for it
+        auto& assetRegistry = Engine::Get().GetAssetRegistry();
+        auto& assetManager = Engine::Get().GetAssetManager();
+        for (uint64_t handle : reader.GetAssetHandles())
         {
-            LX_CORE_ERROR("JSON Parse Error: {}", e.what());
-            return false;
+            if (assetRegistry.Contains(AssetHandle(handle)))
+                assetManager.GetAsset(AssetHandle(handle));
         }
 
-        std::string sceneName = sceneJson["Scene"];
-        LX_CORE_INFO("Deserializing scene: {}", sceneName);
+        auto& registry = m_Scene->Reg();
+        auto ids = reader.GetEntityIDs();
+        std::vector<entt::entity> entities(ids.size());
+        registry.create(entities.begin(), entities.end());
+        for (size_t i = 0; i < entities.size(); i++)
+            registry.emplace<IDComponent>(entities[i], UUID(ids[i]));
+
+        const auto& registeredComponents = Engine::Get().GetComponentRegistry().GetRegisteredComponents();
+        std::vector<entt::entity> chunkEntities;
+        auto gatherEntities = [&](const BinaryScene::ChunkHeader& chunk, const std::string& name)
+        {
+            chunkEntities.clear();
+            for (uint32_t index : reader.GetChunkEntities(chunk))
+            {
+                if (index < entities.size())
+                    chunkEntities.push_back(entities[index]);
+            }
+            if (chunkEntities.size() == chunk.Count)
+                return true;
+            LX_CORE_ERROR("Binary scene: Chunk '{}' points at entities that don't exist", name);
+            return false;
+        };
 
-        std::unordered_map<uint64_t, entt::entity> uuidMap;
+        // Whole column in one insert, no json in between
+        auto insertColumn = [&](const BinaryScene::ChunkHeader& chunk, const ComponentInfo& info)
+        {
+            BinaryScene::ColumnReader column = reader.ReadColumn(chunk);
+            if (info.insertColumn(registry, chunkEntities.data(), chunkEntities.data() + chunkEntities.size(), column))
+                return true;
+            LX_CORE_ERROR("Binary scene: Broken '{}' column", info.name);
+            return false;
+        };
 
-        auto entities = sceneJson["Entities"];
-        if (entities.is_array())
+        std::unordered_map<std::string_view, const BinaryScene::ChunkHeader*> chunksByName;
+        for (const auto& chunk : reader.GetChunks())
+            chunksByName[reader.GetString(chunk.Name)] = &chunk;
+
+        // Same order as CreateEntity, the signal handlers of the other components expect these to be there.
+        // Stored columns go in first, whoever isn't in them gets a default one.
+        std::unordered_set<const BinaryScene::ChunkHeader*> doneChunks;
+        std::vector<entt::entity> missing;
+        for (const char* name : { "Transform", "Relationship", "Tag" })
         {
-            for (auto& entityJson : entities)
+            auto it = registeredComponents.find(name);
+            if (it == registeredComponents.end())
+                continue;
+            const auto& info = it->second;
+
+            auto chunkIt = chunksByName.find(name);
+            if (chunkIt != chunksByName.end() && chunkIt->second->Layout == BinaryScene::ChunkLayout::Column && info.insertColumn)
             {
-                uint64_t uuid = entityJson["ID"].get<uint64_t>();
-                Entity newEntity = m_Scene->CreateEntity();
-                auto& idComp = newEntity.GetComponent<IDComponent>();
+                const auto& chunk = *chunkIt->second;
+                doneChunks.insert(&chunk);
+                if (gatherEntities(chunk, info.name))
+                    insertColumn(chunk, info);
+            }
 
-                uuidMap[uuid] = newEntity;
-                
-                idComp.ID = UUID(uuid);
+            missing.clear();
+            for (entt::entity entity : entities)
+            {
+                if (!info.has(registry, entity))
+                    missing.push_back(entity);
+            }
+            info.insert(registry, missing.data(), missing.data() + missing.size());
+        }
 
-                const auto& registeredComponents = Engine::Get().GetComponentRegistry().GetRegisteredComponents();
-                for (auto& [key, value] : entityJson.items())
+        // One component type at a time, like Scene::Copy
+        nlohmann::json componentJson;
+        for (const auto& chunk : reader.GetChunks())
+        {
+            if (doneChunks.contains(&chunk))
+                continue;
+
+            std::string name(reader.GetString(chunk.Name));
+            auto it = registeredComponents.find(name);
+            if (it == registeredComponents.end() || !it->second.deserialize)
+                continue;
+            const auto& info = it->second;
+
+            if (!gatherEntities(chunk, name))
+                continue;
+
+            if (chunk.Layout == BinaryScene::ChunkLayout::Column)
+            {
+                if (info.insertColumn)
+                    insertColumn(chunk, info);
+                else
+                    LX_CORE_ERROR("Binary scene: '{}' was saved as a column, but has no column codec anymore", name);
+                continue;
+            }
+
+            bool isCore = name == "Transform" || name == "Tag";
+            if (!isCore)
+                info.insert(registry, chunkEntities.data(), chunkEntities.data() + chunkEntities.size());
+
+            for (uint32_t i = 0; i < chunk.Count; i++)
+            {
+                if (!reader.ReadValue(chunk, i, componentJson))
                 {
-                    if (registeredComponents.find(key) != registeredComponents.end())
-                    {
-                        const auto& info = registeredComponents.at(key);
-                        if (info.deserialize)
-                        {
-                            info.add(m_Scene->Reg(), newEntity);
-                            info.deserialize(m_Scene->Reg(), newEntity, value);
-                        }
-                    }
+                    LX_CORE_ERROR("Binary scene: Broken '{}' on entity {}", name, (uint64_t)registry.get<IDComponent>(chunkEntities[i]).ID);
+                    continue;
                 }
+                info.deserialize(registry, chunkEntities[i], componentJson);
             }
         }
 
-        for (auto& entityJson : entities)
+        // The parent column, linked in one pass. Children come in sibling order and nothing is linked yet, so they go
+        // to the back without the detaching and checks of AttachEntity. The hierarchy is what got saved, rigid bodies included.
+        // The writer puts parents first, anything else is a broken file (and could be a cycle or an entity parented to itself)
+        auto parents = reader.GetParents();
+        auto& relationships = registry.storage<RelationshipComponent>();
+        bool linked = false;
+        for (size_t i = 0; i < entities.size(); i++)
         {
-            uint64_t childUUID = entityJson["ID"].get<uint64_t>();
+            if (parents[i] == BinaryScene::NoParent)
+                continue;
+            if (parents[i] >= i)
+            {
+                LX_CORE_ERROR("Binary scene: Entity {} has an invalid parent, keeping it as a root", ids[i]);
+                continue;
+            }
 
-            if (entityJson.contains("Relationship"))
+            entt::entity child = entities[i];
+            entt::entity parent = entities[parents[i]];
+            auto& childRel = relationships.get(child);
+            auto& parentRel = relationships.get(parent);
+            childRel.Parent = parent;
+            if (parentRel.FirstChild == entt::null)
             {
-                auto& relJson = entityJson["Relationship"];
-                if (relJson.contains("Parent"))
-                {
-                    uint64_t parentUUID = relJson["Parent"].get<uint64_t>();
-                    if (uuidMap.contains(childUUID) && uuidMap.contains(parentUUID))
-                    {
-                        entt::entity child = uuidMap[childUUID];
-                        entt::entity parent = uuidMap[parentUUID];
+                parentRel.FirstChild = child;
+            }
+            else
+            {
+                relationships.get(parentRel.LastChild).NextSibling = child;
+                childRel.PrevSibling = parentRel.LastChild;
+            }
+            parentRel.LastChild = child;
+            parentRel.ChildrenCount++;
+            linked = true;
+        }
+        // Transforms are new, so already dirty
+        if (linked)
+            m_Scene->m_TransformHierarchy.MarkDirty();
 
-                        m_Scene->AttachEntity(child, parent);
-                    }
+        for (entt::entity entity : entities)
+            m_Scene->Emit<EntityCreatedEvent>(Entity{ entity, m_Scene.get() });
+
+        DeserializeSceneSettings(sceneJson);
+        return true;
+    }
+
+    void SceneSerializer::DeserializeSceneSettings(const nlohmann::json& sceneJson)
+    {
+        if (sceneJson.is_object())
+            LX_CORE_INFO("Deserialized scene: {}", sceneJson.value("Scene", std::string("Untitled")));
+
+        // Only the cell table, the cells themselves get loaded by the editor or streamed in at runtime
+        auto& partition = *m_Scene->GetWorldPartition();
+        partition.ClearCells();
+        if (sceneJson.contains("WorldPartition"))
+        {
+            const auto& partitionJson = sceneJson["WorldPartition"];
+            auto& settings = partition.GetSettings();
+            settings.Enabled = true;
+            settings.CellSize = partitionJson.value("CellSize", settings.CellSize);
+            settings.LoadRadius = partitionJson.value("LoadRadius", settings.LoadRadius);
+            settings.UnloadRadius = partitionJson.value("UnloadRadius", settings.UnloadRadius);
+            settings.EntitiesPerFrame = partitionJson.value("EntitiesPerFrame", settings.EntitiesPerFrame);
+
+            if (partitionJson.contains("Cells"))
+            {
+                for (const auto& cellJson : partitionJson["Cells"])
+                    partition.AddCell({ cellJson["X"].get<int32_t>(), cellJson["Z"].get<int32_t>() }, cellJson["File"].get<std::string>());
+            }
+        }
+    }
+
+    Entity SceneSerializer::DeserializeEntity(Scene* scene, const nlohmann::json& entityJson)
+    {
+        uint64_t uuid = entityJson["ID"].get<uint64_t>();
+        Entity newEntity = scene->CreateEntity();
+
+        // Replace, so the entity index picks up the stored id
+        scene->Reg().replace<IDComponent>(newEntity, UUID(uuid));
+
+        const auto& registeredComponents = Engine::Get().GetComponentRegistry().GetRegisteredComponents();
+        for (auto& [key, value] : entityJson.items())
+        {
+            if (registeredComponents.find(key) != registeredComponents.end())
+            {
+                const auto& info = registeredComponents.at(key);
+                if (info.deserialize)
+                {
+                    info.add(scene->Reg(), newEntity);
+                    info.deserialize(scene->Reg(), newEntity, value);
                 }
             }
         }
+        return newEntity;
+    }
 
-        return true;
+    // Component json of every entity, keyed by component name
+    using EntityComponentsJson = std::unordered_map<entt::entity, nlohmann::json>;
+
+    // Goes over the pools that are actually there instead of asking every registered type about every entity
+    static EntityComponentsJson SerializeComponents(entt::registry& registry)
+    {
+        std::unordered_map<entt::id_type, const ComponentInfo*> infos;
+        for (const auto& [name, info] : Engine::Get().GetComponentRegistry().GetRegisteredComponents())
+        {
+            if (name != "Relationship" && info.serialize)
+                infos[info.TypeId] = &info;
+        }
+
+        EntityComponentsJson components;
+        components.reserve(registry.storage<TransformComponent>().size());
+        for (auto [id, storage] : registry.storage())
+        {
+            auto it = infos.find(id);
+            if (it == infos.end())
+                continue;
+
+            const ComponentInfo& info = *it->second;
+            for (entt::entity entity : storage)
+                info.serialize(registry, entity, components[entity][info.name]);
+        }
+        return components;
     }
 
-    void SerializeEntityInternal(Entity current, nlohmann::json& outArray, bool usePrefabIDs)
+    // components comes from SerializeComponents for whole scenes, small subtrees (prefabs) ask per entity
+    void SerializeEntityInternal(Entity current, nlohmann::json& outArray, bool usePrefabIDs, EntityComponentsJson* components = nullptr)
     {
         auto& registry = current.GetScene()->Reg();
         nlohmann::json entityJson;
+        if (components)
+        {
+            auto it = components->find(current.GetHandle());
+            if (it != components->end())
+                entityJson = std::move(it->second);
+        }
 
         // Determine which ID to save
         uint64_t uuidToSave = (uint64_t)current.GetUUID();
@@ -126,17 +521,20 @@ namespace Lynx
         entityJson["ID"] = uuidToSave;
 
         // Serialize Components
-        for (const auto& [name, info] : Engine::Get().GetComponentRegistry().GetRegisteredComponents())
+        if (!components)
         {
-            if (name == "Relationship")
-                continue;
-            if (info.has(registry, current))
+            for (const auto& [name, info] : Engine::Get().GetComponentRegistry().GetRegisteredComponents())
             {
-                if (info.serialize)
+                if (name == "Relationship")
+                    continue;
+                if (info.has(registry, current))
                 {
-                    nlohmann::json componentData;
-                    info.serialize(registry, current, componentData);
-                    entityJson[name] = componentData;
+                    if (info.serialize)
+                    {
+                        nlohmann::json componentData;
+                        info.serialize(registry, current, componentData);
+                        entityJson[name] = componentData;
+                    }
                 }
             }
         }
@@ -166,31 +564,130 @@ namespace Lynx
         entt::entity childHandle = rel.FirstChild;
         while (childHandle != entt::null)
         {
-            SerializeEntityInternal(Entity(childHandle, current.GetScene()), outArray, usePrefabIDs);
+            SerializeEntityInternal(Entity(childHandle, current.GetScene()), outArray, usePrefabIDs, components);
             childHandle = registry.get<RelationshipComponent>(childHandle).NextSibling;
         }
     }
 
-    nlohmann::json SceneSerializer::SerializeToJson()
+    void SceneSerializer::CollectRoots(bool partitioned, std::vector<entt::entity>& outRoots, CellRoots& outCellRoots)
     {
-        nlohmann::json sceneJson;
-        sceneJson["Scene"] = "Untitled"; // TODO: Add name?
-        sceneJson["Entities"] = nlohmann::json::array();
-        
+        auto& partition = *m_Scene->GetWorldPartition();
         auto& registry = m_Scene->Reg();
         for (auto entityID : registry.view<entt::entity>())
         {
-            Entity entity(entityID, m_Scene.get());
-            auto& rel = entity.GetComponent<RelationshipComponent>();
-            
-            if (rel.Parent == entt::null)
+            if (registry.get<RelationshipComponent>(entityID).Parent != entt::null)
+                continue;
+
+            if (partitioned && registry.all_of<StreamedComponent>(entityID))
             {
-                SerializeEntityInternal(entity, sceneJson["Entities"], false);
+                // Roots only, so the local translation is the world one
+                glm::ivec2 coord = partition.GetCellCoord(registry.get<TransformComponent>(entityID).Translation);
+                auto* cell = partition.FindCell(coord);
+                if (!cell || cell->State == WorldPartition::CellState::Loaded)
+                {
+                    outCellRoots[{ coord.x, coord.y }].push_back(entityID);
+                    continue;
+                }
+                // Writing the cell would drop everything in it that isn't loaded
+                LX_CORE_WARN("Cell {}, {} isn't loaded, saving '{}' into the scene file", coord.x, coord.y,
+                    registry.get<TagComponent>(entityID).Tag);
             }
+            outRoots.push_back(entityID);
         }
+    }
+
+    nlohmann::json SceneSerializer::SerializeToJson(const std::string& filepath)
+    {
+        nlohmann::json sceneJson;
+        sceneJson["Scene"] = "Untitled"; // TODO: Add name?
+        sceneJson["Entities"] = nlohmann::json::array();
+
+        bool partitioned = !filepath.empty() && m_Scene->GetWorldPartition()->GetSettings().Enabled;
+        std::vector<entt::entity> roots;
+        CellRoots cellRoots;
+        CollectRoots(partitioned, roots, cellRoots);
+
+        EntityComponentsJson components = SerializeComponents(m_Scene->Reg());
+        for (entt::entity root : roots)
+            SerializeEntityInternal(Entity(root, m_Scene.get()), sceneJson["Entities"], false, &components);
+
+        if (partitioned)
+            WriteCells(filepath, cellRoots, sceneJson, &components);
 
         return sceneJson;
     }
+
+    void SceneSerializer::WriteCells(const std::string& filepath, const CellRoots& cellRoots, nlohmann::json& sceneJson,
+        EntityComponentsJson* components)
+    {
+        auto& partition = *m_Scene->GetWorldPartition();
+        const auto& settings = partition.GetSettings();
+
+        std::filesystem::path scenePath(filepath);
+        std::string cellFolder = scenePath.stem().string() + ".cells";
+        std::filesystem::path cellDirectory = scenePath.parent_path() / cellFolder;
+        std::filesystem::create_directories(cellDirectory);
+
+        // Cells that aren't loaded keep their file, everything else is what we just collected
+        std::vector<WorldPartition::Cell> keptCells;
+        for (const auto& [key, cell] : partition.GetCells())
+        {
+            if (cell.State != WorldPartition::CellState::Loaded && !cellRoots.contains({ cell.Coord.x, cell.Coord.y }))
+                keptCells.push_back({ cell.Coord, cell.File });
+        }
+
+        partition.ClearCells();
+        partition.SetDirectory(scenePath.parent_path());
+
+        std::unordered_set<std::string> cellFiles;
+        nlohmann::json cellsJson = nlohmann::json::array();
+        for (const auto& cell : keptCells)
+        {
+            partition.AddCell(cell.Coord, cell.File);
+            cellFiles.insert(std::filesystem::path(cell.File).filename().string());
+            cellsJson.push_back({ { "X", cell.Coord.x }, { "Z", cell.Coord.y }, { "File", cell.File } });
+        }
+
+        for (const auto& [coord, roots] : cellRoots)
+        {
+            std::string fileName = std::to_string(coord.first) + "_" + std::to_string(coord.second) + ".lxcell";
+            std::string file = cellFolder + "/" + fileName;
+
+            nlohmann::json cellJson;
+            cellJson["Entities"] = nlohmann::json::array();
+            for (entt::entity root : roots)
+                SerializeEntityInternal(Entity(root, m_Scene.get()), cellJson["Entities"], false, components);
+            std::ofstream fout(cellDirectory / fileName);
+            fout << cellJson.dump(4);
+
+            // Already loaded, as it was written from what's in the scene
+            auto& cell = partition.AddCell({ coord.first, coord.second }, file);
+            cell.State = WorldPartition::CellState::Loaded;
+            for (const auto& entityJson : cellJson["Entities"])
+            {
+                bool isRoot = !entityJson.contains("Relationship") || !entityJson["Relationship"].contains("Parent");
+                if (isRoot)
+                    cell.Roots.push_back(entityJson["ID"].get<UUID>());
+            }
+
+            cellFiles.insert(fileName);
+            cellsJson.push_back({ { "X", coord.first }, { "Z", coord.second }, { "File", file } });
+        }
+
+        // Cells that ended up empty
+        for (const auto& entry : std::filesystem::directory_iterator(cellDirectory))
+        {
+            if (entry.path().extension() == ".lxcell" && !cellFiles.contains(entry.path().filename().string()))
+                std::filesystem::remove(entry.path());
+        }
+
+        nlohmann::json& partitionJson = sceneJson["WorldPartition"];
+        partitionJson["CellSize"] = settings.CellSize;
+        partitionJson["LoadRadius"] = settings.LoadRadius;
+        partitionJson["UnloadRadius"] = settings.UnloadRadius;
+        partitionJson["EntitiesPerFrame"] = settings.EntitiesPerFrame;
+        partitionJson["Cells"] = std::move(cellsJson);
+    }
     
     
     void SceneSerializer::SerializePrefab(Entity entity, nlohmann::json& outJson, bool usePrefabIDs)
@@ -10,17 +10,34 @@ namespace Lynx
     public:
         SceneSerializer(const std::shared_ptr<Scene>& scene);
 
+        // Binary, see BinaryScene.h
         void Serialize(const std::string& filepath);
+        // Readable json of the same scene, for diffing. Deserialize takes both.
+        void ExportJson(const std::string& filepath);
         std::string SerializeToString();
         bool Deserialize(const std::string& filepath);
         bool DeserializeFromString(const std::string& serialized);
+
+        // Creates the entity with its stored id and components, the hierarchy is up to the caller
+        static Entity DeserializeEntity(Scene* scene, const nlohmann::json& entityJson);
         
         static void SerializePrefab(Entity entity, nlohmann::json& outJson, bool usePrefabIDs);
         static Entity DeserializePrefab(Scene* scene, nlohmann::json& json, Entity parent = {});
         static void DeserializePrefabInto(Scene* scene, nlohmann::json& json, Entity root);
 
     private:
-        nlohmann::json SerializeToJson();
+        using CellRoots = std::map<std::pair<int32_t, int32_t>, std::vector<entt::entity>>;
+        using EntityComponentsJson = std::unordered_map<entt::entity, nlohmann::json>;
+
+        // Streamed roots go into cell files next to filepath when the scene is partitioned, empty keeps everything inline
+        nlohmann::json SerializeToJson(const std::string& filepath = {});
+        // Roots in storage order, streamed ones go by cell when partitioned
+        void CollectRoots(bool partitioned, std::vector<entt::entity>& outRoots, CellRoots& outCellRoots);
+        bool DeserializeBinary(const uint8_t* data, size_t size);
+        void DeserializeSceneSettings(const nlohmann::json& sceneJson);
+        // components from SerializeComponents if there is one, asks per entity otherwise
+        void WriteCells(const std::string& filepath, const CellRoots& cellRoots, nlohmann::json& sceneJson,
+            EntityComponentsJson* components = nullptr);
         
         std::shared_ptr<Scene> m_Scene;
     };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Entity.h"
+#include "Scene.h"
 
 namespace Lynx
 {
@@ -15,6 +16,13 @@ namespace Lynx
             return m_Entity.GetComponent<T>();
         }
 
+        Entity FindEntityByName(const std::string& name) { return m_Entity.GetScene()->FindEntityByName(name); }
+        std::vector<Entity> FindEntitiesByName(const std::string& name) { return m_Entity.GetScene()->FindEntitiesByName(name); }
+        Entity FindEntityByUUID(UUID uuid) { return m_Entity.GetScene()->FindEntityByUUID(uuid); }
+
+        // Scripts run while the scene iterates, create/destroy/add/remove through here
+        CommandBuffer& Commands() { return m_Entity.GetScene()->GetCommandBuffer(); }
+
         virtual void OnCreate() {}
         virtual void OnDestroy() {}
         virtual void OnUpdate(float deltaTime) {}
@@ -0,0 +1,114 @@
+#include "AnimationSystem.h"
+
+#include <chrono>
+
+#include "Lynx/Scene/Components/AnimationComponents.h"
+#include "Lynx/Engine.h"
+#include "Lynx/Scene/Scene.h"
+
+namespace Lynx
+{
+    void AnimationSystem::OnUpdate(float ts, Scene* scene)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        // 1. Advance time, touches the registry and assets so it stays on this thread
+        m_Jobs.clear();
+        auto view = scene->Reg().view<AnimatorComponent>();
+        for (auto entity : view)
+        {
+            auto& animator = view.get<AnimatorComponent>(entity);
+            auto mesh = animator.Mesh.Get();
+            if (!mesh || !mesh->IsLoaded())
+                continue;
+
+            const auto& animations = mesh->GetAnimations();
+            if (animator.Clip.empty() && !animations.empty())
+                animator.Clip = animations[0].GetName();
+
+            int clip = mesh->FindAnimation(animator.Clip);
+            if (clip >= 0 && animator.Playing)
+            {
+                float duration = animations[clip].GetDuration();
+                animator.Time += ts * animator.Speed;
+                if (animator.Loop && duration > 0.0f)
+                {
+                    animator.Time = std::fmod(animator.Time, duration);
+                    if (animator.Time < 0.0f)
+                        animator.Time += duration;
+                }
+                else if (animator.Time >= duration || animator.Time <= 0.0f)
+                {
+                    animator.Time = glm::clamp(animator.Time, 0.0f, duration);
+                    animator.Playing = false;
+                }
+            }
+
+            int previousClip = -1;
+            if (animator.FadeDuration > 0.0f)
+            {
+                animator.FadeTime += ts;
+                if (animator.FadeTime >= animator.FadeDuration)
+                {
+                    animator.FadeDuration = 0.0f;
+                    animator.PreviousClip.clear();
+                }
+                else
+                {
+                    previousClip = mesh->FindAnimation(animator.PreviousClip);
+                }
+            }
+
+            m_Jobs.push_back({ &animator, mesh, clip, previousClip });
+        }
+
+        // 2. Evaluate poses, every job only writes its own palette
+        const size_t minJobsPerChunk = 16;
+        Engine::Get().GetJobSystem().ParallelFor(m_Jobs.size(), minJobsPerChunk, [this](size_t begin, size_t end, uint32_t)
+        {
+            EvaluateRange(begin, end);
+        });
+
+        auto end = std::chrono::high_resolution_clock::now();
+        m_Stats.AnimatedEntities = (uint32_t)m_Jobs.size();
+        m_Stats.EvaluationTime = std::chrono::duration<float, std::milli>(end - start).count();
+    }
+
+    void AnimationSystem::EvaluateRange(size_t begin, size_t end) const
+    {
+        for (size_t i = begin; i < end; i++)
+            Evaluate(m_Jobs[i]);
+    }
+
+    void AnimationSystem::Evaluate(const Job& job)
+    {
+        // Scratch buffers, reused between frames
+        thread_local std::vector<JointTransform> s_Pose;
+        thread_local std::vector<JointTransform> s_PreviousPose;
+        thread_local std::vector<glm::mat4> s_ModelPose;
+
+        const Skeleton& skeleton = job.Mesh->GetSkeleton();
+        const auto& animations = job.Mesh->GetAnimations();
+        size_t jointCount = skeleton.GetJointCount();
+        AnimatorComponent& animator = *job.Animator;
+
+        s_Pose.assign(skeleton.BindPose.begin(), skeleton.BindPose.end());
+        if (job.Clip >= 0)
+            animations[job.Clip].Sample(animator.Time, s_Pose.data(), jointCount);
+
+        if (job.PreviousClip >= 0)
+        {
+            s_PreviousPose.assign(skeleton.BindPose.begin(), skeleton.BindPose.end());
+            animations[job.PreviousClip].Sample(animator.PreviousTime, s_PreviousPose.data(), jointCount);
+
+            float weight = animator.FadeTime / animator.FadeDuration;
+            PoseUtils::Blend(s_PreviousPose.data(), s_Pose.data(), weight, s_Pose.data(), jointCount);
+        }
+
+        s_ModelPose.resize(jointCount);
+        animator.Palette.resize(jointCount);
+        PoseUtils::LocalToModel(skeleton, s_Pose.data(), s_ModelPose.data());
+        PoseUtils::BuildSkinningPalette(skeleton, s_ModelPose.data(), animator.Palette.data());
+        animator.Bounds = job.Mesh->GetPoseBounds(animator.Palette);
+    }
+}
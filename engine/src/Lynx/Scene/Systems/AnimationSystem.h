@@ -0,0 +1,41 @@
+#pragma once
+
+namespace Lynx
+{
+    class Scene;
+    class SkeletalMesh;
+    struct AnimatorComponent;
+
+    class AnimationSystem
+    {
+    public:
+        struct Stats
+        {
+            uint32_t AnimatedEntities = 0;
+            float EvaluationTime = 0.0f; // ms
+        };
+
+        AnimationSystem() = default;
+
+        // Advances the animators on the calling thread, then evaluates all poses in parallel
+        void OnUpdate(float ts, Scene* scene);
+
+        const Stats& GetStats() const { return m_Stats; }
+
+    private:
+        struct Job
+        {
+            AnimatorComponent* Animator;
+            std::shared_ptr<SkeletalMesh> Mesh;
+            int Clip;
+            int PreviousClip;
+        };
+
+        void EvaluateRange(size_t begin, size_t end) const;
+        static void Evaluate(const Job& job);
+
+    private:
+        std::vector<Job> m_Jobs;
+        Stats m_Stats;
+    };
+}
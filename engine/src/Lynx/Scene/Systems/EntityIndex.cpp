@@ -0,0 +1,208 @@
+#include "EntityIndex.h"
+
+#include "Lynx/Scene/Components/Components.h"
+#include "Lynx/Scene/Components/IDComponent.h"
+
+namespace Lynx
+{
+    size_t UUIDMap::HomeSlot(uint64_t key) const
+    {
+        // UUIDs are random already, the finalizer just makes sure sequential ids don't cluster
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return (size_t)key & (m_Slots.size() - 1);
+    }
+
+    entt::entity UUIDMap::Find(uint64_t key) const
+    {
+        if (key == 0 || m_Slots.empty())
+            return entt::null;
+
+        size_t mask = m_Slots.size() - 1;
+        for (size_t i = HomeSlot(key);; i = (i + 1) & mask)
+        {
+            const Slot& slot = m_Slots[i];
+            if (slot.Key == key)
+                return slot.Entity;
+            if (slot.Key == 0)
+                return entt::null;
+        }
+    }
+
+    void UUIDMap::Insert(uint64_t key, entt::entity entity)
+    {
+        if (key == 0)
+            return;
+
+        // Max load 3/4
+        if ((m_Count + 1) * 4 > m_Slots.size() * 3)
+            Grow();
+
+        size_t mask = m_Slots.size() - 1;
+        for (size_t i = HomeSlot(key);; i = (i + 1) & mask)
+        {
+            Slot& slot = m_Slots[i];
+            if (slot.Key == key)
+            {
+                slot.Entity = entity;
+                return;
+            }
+            if (slot.Key == 0)
+            {
+                slot = { key, entity };
+                m_Count++;
+                return;
+            }
+        }
+    }
+
+    void UUIDMap::Erase(uint64_t key, entt::entity entity)
+    {
+        if (key == 0 || m_Slots.empty())
+            return;
+
+        size_t mask = m_Slots.size() - 1;
+        size_t hole = HomeSlot(key);
+        while (m_Slots[hole].Key != key)
+        {
+            if (m_Slots[hole].Key == 0)
+                return;
+            hole = (hole + 1) & mask;
+        }
+        if (m_Slots[hole].Entity != entity)
+            return;
+
+        // Move later entries of the cluster into the hole, unless that would put them in front of their home slot
+        for (size_t i = (hole + 1) & mask; m_Slots[i].Key != 0; i = (i + 1) & mask)
+        {
+            size_t home = HomeSlot(m_Slots[i].Key);
+            if (((i - home) & mask) >= ((i - hole) & mask))
+            {
+                m_Slots[hole] = m_Slots[i];
+                hole = i;
+            }
+        }
+        m_Slots[hole] = {};
+        m_Count--;
+    }
+
+    void UUIDMap::Clear()
+    {
+        m_Slots.clear();
+        m_Count = 0;
+    }
+
+    void UUIDMap::Grow()
+    {
+        std::vector<Slot> old = std::move(m_Slots);
+        m_Slots.assign(std::max<size_t>(64, old.size() * 2), {});
+        m_Count = 0;
+
+        for (const Slot& slot : old)
+        {
+            if (slot.Key != 0)
+                Insert(slot.Key, slot.Entity);
+        }
+    }
+
+    void EntityIndex::Init(entt::registry& registry)
+    {
+        registry.on_construct<IDComponent>().connect<&EntityIndex::OnIDConstructed>(this);
+        registry.on_update<IDComponent>().connect<&EntityIndex::OnIDConstructed>(this);
+        registry.on_destroy<IDComponent>().connect<&EntityIndex::OnIDDestroyed>(this);
+        registry.on_construct<TagComponent>().connect<&EntityIndex::OnTagConstructed>(this);
+        registry.on_update<TagComponent>().connect<&EntityIndex::OnTagConstructed>(this);
+        registry.on_destroy<TagComponent>().connect<&EntityIndex::OnTagDestroyed>(this);
+    }
+
+    void EntityIndex::Shutdown(entt::registry& registry)
+    {
+        registry.on_construct<IDComponent>().disconnect(this);
+        registry.on_update<IDComponent>().disconnect(this);
+        registry.on_destroy<IDComponent>().disconnect(this);
+        registry.on_construct<TagComponent>().disconnect(this);
+        registry.on_update<TagComponent>().disconnect(this);
+        registry.on_destroy<TagComponent>().disconnect(this);
+    }
+
+    entt::entity EntityIndex::FindByName(const std::string& name) const
+    {
+        const auto& entities = FindAllByName(name);
+        return entities.empty() ? entt::null : entities.front();
+    }
+
+    const std::vector<entt::entity>& EntityIndex::FindAllByName(const std::string& name) const
+    {
+        static const std::vector<entt::entity> s_Empty;
+
+        auto it = m_NameIds.find(name);
+        if (it == m_NameIds.end())
+            return s_Empty;
+        return m_NameEntities[it->second];
+    }
+
+    EntityIndex::Entry& EntityIndex::GetEntry(entt::entity entity)
+    {
+        size_t index = (size_t)entt::to_entity(entity);
+        if (index >= m_Entries.size())
+            m_Entries.resize(index + 1);
+        return m_Entries[index];
+    }
+
+    void EntityIndex::IndexName(entt::entity entity, const std::string& name)
+    {
+        auto [it, inserted] = m_NameIds.try_emplace(name, (uint32_t)m_NameEntities.size());
+        if (inserted)
+            m_NameEntities.emplace_back();
+
+        auto& entities = m_NameEntities[it->second];
+        Entry& entry = GetEntry(entity);
+        entry.Name = it->second;
+        entry.NameSlot = (uint32_t)entities.size();
+        entities.push_back(entity);
+    }
+
+    void EntityIndex::UnindexName(entt::entity entity)
+    {
+        Entry& entry = GetEntry(entity);
+        if (entry.Name == InvalidIndex)
+            return;
+
+        // Swap with the last one
+        auto& entities = m_NameEntities[entry.Name];
+        entt::entity moved = entities.back();
+        entities[entry.NameSlot] = moved;
+        GetEntry(moved).NameSlot = entry.NameSlot;
+        entities.pop_back();
+
+        entry.Name = InvalidIndex;
+    }
+
+    void EntityIndex::OnIDConstructed(entt::registry& registry, entt::entity entity)
+    {
+        Entry& entry = GetEntry(entity);
+        m_UUIDs.Erase(entry.UUID, entity);
+
+        entry.UUID = (uint64_t)registry.get<IDComponent>(entity).ID;
+        m_UUIDs.Insert(entry.UUID, entity);
+    }
+
+    void EntityIndex::OnIDDestroyed(entt::registry& registry, entt::entity entity)
+    {
+        Entry& entry = GetEntry(entity);
+        m_UUIDs.Erase(entry.UUID, entity);
+        entry.UUID = 0;
+    }
+
+    void EntityIndex::OnTagConstructed(entt::registry& registry, entt::entity entity)
+    {
+        UnindexName(entity);
+        IndexName(entity, registry.get<TagComponent>(entity).Tag);
+    }
+
+    void EntityIndex::OnTagDestroyed(entt::registry& registry, entt::entity entity)
+    {
+        UnindexName(entity);
+    }
+}
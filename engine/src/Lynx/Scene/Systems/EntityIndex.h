@@ -0,0 +1,80 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "Lynx/UUID.h"
+
+namespace Lynx
+{
+    // Open addressing UUID -> entity map with linear probing. Key 0 (UUID::Null) marks an empty slot,
+    // erasing shifts the rest of the cluster back so there are no tombstones.
+    class UUIDMap
+    {
+    public:
+        entt::entity Find(uint64_t key) const;
+        void Insert(uint64_t key, entt::entity entity);
+        // Only if the key still maps to this entity
+        void Erase(uint64_t key, entt::entity entity);
+        void Clear();
+
+        size_t Size() const { return m_Count; }
+
+    private:
+        struct Slot
+        {
+            uint64_t Key = 0;
+            entt::entity Entity = entt::null;
+        };
+
+        size_t HomeSlot(uint64_t key) const;
+        void Grow();
+
+    private:
+        std::vector<Slot> m_Slots; // Always a power of two
+        size_t m_Count = 0;
+    };
+
+    // UUID and name lookups for a scene, kept up to date through the IDComponent and TagComponent signals.
+    // Renames have to go through registry.patch/replace (or emplace with the name), plain writes to Tag aren't seen.
+    class EntityIndex
+    {
+    public:
+        EntityIndex() = default;
+
+        void Init(entt::registry& registry);
+        void Shutdown(entt::registry& registry);
+
+        entt::entity FindByUUID(UUID uuid) const { return m_UUIDs.Find((uint64_t)uuid); }
+        // Any entity with that name, entt::null if there is none
+        entt::entity FindByName(const std::string& name) const;
+        const std::vector<entt::entity>& FindAllByName(const std::string& name) const;
+
+    private:
+        static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        // What an entity is currently indexed under
+        struct Entry
+        {
+            uint64_t UUID = 0;
+            uint32_t Name = InvalidIndex;
+            uint32_t NameSlot = 0; // Position in m_NameEntities[Name], for O(1) removal
+        };
+
+        Entry& GetEntry(entt::entity entity);
+        void IndexName(entt::entity entity, const std::string& name);
+        void UnindexName(entt::entity entity);
+
+        void OnIDConstructed(entt::registry& registry, entt::entity entity);
+        void OnIDDestroyed(entt::registry& registry, entt::entity entity);
+        void OnTagConstructed(entt::registry& registry, entt::entity entity);
+        void OnTagDestroyed(entt::registry& registry, entt::entity entity);
+
+    private:
+        UUIDMap m_UUIDs;
+        // Interned names, the id indexes m_NameEntities. Ids stay around when their last entity goes away.
+        std::unordered_map<std::string, uint32_t> m_NameIds;
+        std::vector<std::vector<entt::entity>> m_NameEntities;
+        // By entity index
+        std::vector<Entry> m_Entries;
+    };
+}
@@ -0,0 +1,299 @@
+#include "EntityPool.h"
+
+#include "Lynx/Engine.h"
+#include "Lynx/Asset/Prefab.h"
+#include "Lynx/Scene/PrefabTemplate.h"
+#include "Lynx/Scene/Scene.h"
+#include "Lynx/Scene/Components/Components.h"
+#include "Lynx/Scene/Components/IDComponent.h"
+#include "Lynx/Scene/Components/NativeScriptComponent.h"
+#include "Lynx/Scene/Components/PhysicsComponents.h"
+
+namespace Lynx
+{
+    static void CollectInstance(entt::registry& registry, entt::entity entity, std::vector<entt::entity>& outEntities)
+    {
+        // Depth first, same order as the prefab file
+        outEntities.push_back(entity);
+        for (entt::entity child = registry.get<RelationshipComponent>(entity).FirstChild; child != entt::null;
+             child = registry.get<RelationshipComponent>(child).NextSibling)
+        {
+            CollectInstance(registry, child, outEntities);
+        }
+    }
+
+    // Kept components go back to the template values, except for what the physics side mirrors. The body, its shape and
+    // the character were built from the component values back when they got created, and there is no way to change
+    // those afterwards short of rebuilding them. So those fields stay as they are and keep describing the body the
+    // instance really has. Gravity factor has a setter and goes to the body with the rest of the reset.
+    static void ResetKeptComponents(Scene& scene, entt::registry& templateRegistry, entt::entity templateEntity, entt::registry& registry, entt::entity entity)
+    {
+        if (auto* rb = registry.try_get<RigidBodyComponent>(entity); rb && templateRegistry.all_of<RigidBodyComponent>(templateEntity))
+        {
+            const auto& source = templateRegistry.get<RigidBodyComponent>(templateEntity);
+            rb->LockRotationX = source.LockRotationX;
+            rb->LockRotationY = source.LockRotationY;
+            rb->LockRotationZ = source.LockRotationZ;
+            if (rb->GravityFactor != source.GravityFactor)
+            {
+                rb->GravityFactor = source.GravityFactor;
+                if (rb->BodyId != INVALID_BODY)
+                    scene.GetPhysicsWorldChecked().SetGravityFactor(rb->BodyId, rb->GravityFactor);
+            }
+        }
+
+        // Capsule, mass, slope, strength and layer are in the character, the rest is read every step or is state
+        if (auto* cc = registry.try_get<CharacterControllerComponent>(entity); cc && templateRegistry.all_of<CharacterControllerComponent>(templateEntity))
+        {
+            const auto& source = templateRegistry.get<CharacterControllerComponent>(templateEntity);
+            cc->CharacterPadding = source.CharacterPadding;
+            cc->StepHeight = source.StepHeight;
+            cc->Gravity = source.Gravity;
+            cc->AirControlFactor = source.AirControlFactor;
+            cc->DesiredVelocity = source.DesiredVelocity;
+            cc->Velocity = source.Velocity;
+            cc->GroundState = source.GroundState;
+            cc->GroundNormal = source.GroundNormal;
+            cc->GroundVelocity = source.GroundVelocity;
+        }
+
+        // Colliders are nothing but the shape, they stay as they are
+
+        // Scripts keep whatever they set up in OnCreate, a fresh instance is the only way to get back to the start
+        if (auto* nsc = registry.try_get<NativeScriptComponent>(entity); nsc && templateRegistry.all_of<NativeScriptComponent>(templateEntity))
+        {
+            bool hadInstance = nsc->Instance != nullptr;
+            if (hadInstance)
+            {
+                nsc->Instance->OnDestroy();
+                nsc->DestroyScript(nsc);
+            }
+
+            *nsc = templateRegistry.get<NativeScriptComponent>(templateEntity);
+            nsc->Instance = nullptr;
+            if (hadInstance)
+                scene.CreateScriptInstance(entity);
+        }
+    }
+
+    void EntityPool::SetPolicy(Scene& scene, const std::shared_ptr<Prefab>& prefab, const Policy& policy)
+    {
+        if (!prefab)
+            return;
+
+        Pool& pool = GetPool(scene, prefab);
+        pool.Settings = policy;
+
+        uint32_t idle = pool.NodeCount > 0 ? (uint32_t)(pool.Idle.size() / pool.NodeCount) : 0;
+        if (idle >= policy.WarmUp)
+            return;
+
+        std::vector<entt::entity> roots;
+        roots.reserve(policy.WarmUp - idle);
+        Spawn(scene, prefab, policy.WarmUp - idle, entt::null, roots);
+        for (entt::entity root : roots)
+            Release(scene, root);
+    }
+
+    void EntityPool::Spawn(Scene& scene, const std::shared_ptr<Prefab>& prefab, uint32_t count, entt::entity parent, std::vector<entt::entity>& outRoots)
+    {
+        if (!prefab || count == 0)
+            return;
+
+        Pool& pool = GetPool(scene, prefab);
+        pool.TimeSinceSpawn = 0.0f;
+
+        PrefabTemplate& prefabTemplate = prefab->GetTemplate();
+        const auto& nodes = prefabTemplate.GetNodes();
+        if (nodes.empty())
+            return;
+
+        auto& registry = scene.Reg();
+        auto& templateRegistry = prefabTemplate.GetRegistry();
+
+        uint32_t reused = std::min(count, (uint32_t)(pool.Idle.size() / pool.NodeCount));
+        for (uint32_t instance = 0; instance < reused; instance++)
+        {
+            const entt::entity* entities = pool.Idle.data() + pool.Idle.size() - pool.NodeCount;
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+                const auto& node = nodes[i];
+                entt::entity entity = entities[i];
+
+                registry.replace<TransformComponent>(entity, templateRegistry.get<TransformComponent>(node.Entity));
+                registry.replace<TagComponent>(entity, templateRegistry.get<TagComponent>(node.Entity));
+                // Components[0] and [1] are transform and tag, the kept ones are still there unless a script removed them
+                for (size_t c = 2; c < node.Components.size(); c++)
+                {
+                    const ComponentInfo* info = node.Components[c];
+                    if (!info->KeepWhenPooled || !info->has(registry, entity))
+                        info->stamp(templateRegistry, node.Entity, registry, &entity, &entity + 1);
+                }
+
+                registry.remove<DisabledComponent>(entity);
+                ResetKeptComponents(scene, templateRegistry, node.Entity, registry, entity);
+            }
+
+            registry.remove<PooledComponent>(entities[0]);
+            if (parent != entt::null)
+                scene.AttachEntity(entities[0], parent);
+
+            outRoots.push_back(entities[0]);
+            pool.Idle.resize(pool.Idle.size() - pool.NodeCount);
+        }
+
+        if (reused < count)
+        {
+            for (Entity root : scene.InstantiatePrefabBatch(prefab, count - reused, Entity(parent, &scene)))
+                outRoots.push_back(root);
+        }
+
+        m_Stats.Reused += reused;
+        m_Stats.Created += count - reused;
+    }
+
+    void EntityPool::Update(Scene& scene, float deltaTime)
+    {
+        uint32_t idle = 0;
+        for (auto& [handle, pool] : m_Pools)
+        {
+            pool.TimeSinceSpawn += deltaTime;
+            if (pool.TimeSinceSpawn >= pool.Settings.ShrinkDelay)
+            {
+                DestroyIdle(scene, pool, pool.Settings.WarmUp);
+                pool.TimeSinceSpawn = 0.0f;
+            }
+
+            if (pool.NodeCount > 0)
+                idle += (uint32_t)(pool.Idle.size() / pool.NodeCount);
+        }
+
+        m_Stats.Pools = (uint32_t)m_Pools.size();
+        m_Stats.Idle = idle;
+    }
+
+    void EntityPool::Clear()
+    {
+        m_Pools.clear();
+        // Game modules can register components in between runs
+        m_KeptStorages.clear();
+        m_KeptComponents.clear();
+        m_Stats = {};
+    }
+
+    EntityPool::Pool& EntityPool::GetPool(Scene& scene, const std::shared_ptr<Prefab>& prefab)
+    {
+        Pool& pool = m_Pools[prefab->GetHandle()];
+        if (!pool.Prefab || pool.Version != prefab->GetVersion())
+        {
+            // New pool or the prefab got reloaded, the old instances don't match the template anymore
+            DestroyIdle(scene, pool, 0);
+            pool.Prefab = prefab;
+            pool.Version = prefab->GetVersion();
+            pool.NodeCount = (uint32_t)prefab->GetTemplate().GetNodes().size();
+        }
+        return pool;
+    }
+
+    void EntityPool::Release(Scene& scene, entt::entity root)
+    {
+        auto& registry = scene.Reg();
+        if (!registry.valid(root) || registry.all_of<PooledComponent>(root))
+            return;
+
+        auto* pc = registry.try_get<PrefabComponent>(root);
+        std::shared_ptr<Prefab> prefab = pc ? pc->Prefab.Get() : nullptr;
+        if (!prefab)
+        {
+            scene.DestroyEntity(root, false);
+            return;
+        }
+
+        if (m_KeptStorages.empty())
+            UpdateKeptStorages();
+
+        Pool& pool = GetPool(scene, prefab);
+        const auto& nodes = prefab->GetTemplate().GetNodes();
+
+        m_Instance.clear();
+        CollectInstance(registry, root, m_Instance);
+
+        // Somebody attached or removed children, the instance is from before a reload, or the pool is full
+        bool matches = m_Instance.size() == nodes.size() && pool.Idle.size() / pool.NodeCount < pool.Settings.MaxIdle;
+        for (size_t i = 0; matches && i < nodes.size(); i++)
+        {
+            auto* nodePc = registry.try_get<PrefabComponent>(m_Instance[i]);
+            matches = nodePc && nodePc->Prefab.Handle == prefab->GetHandle() && nodePc->Version == pool.Version &&
+                nodePc->SubEntityID == nodes[i].SubEntityID;
+        }
+        if (!matches)
+        {
+            scene.DestroyEntity(root, false);
+            return;
+        }
+
+        scene.DetachEntity(root);
+        for (size_t i = 0; i < m_Instance.size(); i++)
+        {
+            entt::entity entity = m_Instance[i];
+
+            // Disable first, physics takes the body out of the world on construct
+            if (!registry.all_of<DisabledComponent>(entity))
+                registry.emplace<DisabledComponent>(entity);
+
+            for (auto [id, storage] : registry.storage())
+            {
+                if (!m_KeptStorages.contains(id) && storage.contains(entity))
+                    storage.remove(entity);
+            }
+
+            // Kept ones a script added don't belong to the template
+            const auto& components = nodes[i].Components;
+            for (const ComponentInfo* info : m_KeptComponents)
+            {
+                if (info->has(registry, entity) && std::find(components.begin(), components.end(), info) == components.end())
+                    info->remove(registry, entity);
+            }
+        }
+        registry.emplace<PooledComponent>(root);
+
+        pool.Idle.insert(pool.Idle.end(), m_Instance.begin(), m_Instance.end());
+    }
+
+    void EntityPool::DestroyIdle(Scene& scene, Pool& pool, uint32_t keepInstances)
+    {
+        if (pool.NodeCount == 0)
+            return;
+
+        size_t keep = (size_t)keepInstances * pool.NodeCount;
+        for (size_t i = keep; i < pool.Idle.size(); i += pool.NodeCount)
+            scene.DestroyEntity(pool.Idle[i], false);
+
+        if (pool.Idle.size() > keep)
+            pool.Idle.resize(keep);
+    }
+
+    void EntityPool::UpdateKeptStorages()
+    {
+        m_KeptStorages.clear();
+        m_KeptStorages.insert({
+            entt::type_hash<entt::entity>::value(),
+            entt::type_hash<IDComponent>::value(),
+            entt::type_hash<TransformComponent>::value(),
+            entt::type_hash<RelationshipComponent>::value(),
+            entt::type_hash<TagComponent>::value(),
+            entt::type_hash<PrefabComponent>::value(),
+            entt::type_hash<DisabledComponent>::value(),
+            entt::type_hash<PooledComponent>::value()
+        });
+
+        m_KeptComponents.clear();
+        for (const auto& [name, info] : Engine::Get().GetComponentRegistry().GetRegisteredComponents())
+        {
+            if (info.KeepWhenPooled || info.CopyBySerialization)
+                m_KeptStorages.insert(info.TypeId);
+            if (info.KeepWhenPooled)
+                m_KeptComponents.push_back(&info);
+        }
+    }
+}
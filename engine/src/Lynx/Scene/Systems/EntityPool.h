@@ -0,0 +1,77 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "Lynx/Asset/Asset.h"
+
+namespace Lynx
+{
+    class Scene;
+    class Prefab;
+    struct ComponentInfo;
+
+    // Marks the root of an idle pooled instance
+    struct PooledComponent {};
+
+    // Per prefab pools of despawned instances. Releasing an instance disables it (no rendering, physics or script updates)
+    // and strips everything except transform, hierarchy and the KeepWhenPooled/CopyBySerialization components, so bodies,
+    // script instances and UI trees survive. Spawning stamps the stripped components back from the prefab template
+    // and resets the kept ones to it, apart from the physics settings their body or character was built with.
+    class EntityPool
+    {
+    public:
+        struct Policy
+        {
+            uint32_t WarmUp = 0; // Instances created up front, shrinking never goes below this
+            uint32_t MaxIdle = 256; // Releases beyond this get destroyed
+            float ShrinkDelay = 10.0f; // Seconds without a spawn before the idle instances get trimmed back to WarmUp
+        };
+
+        struct Stats
+        {
+            uint32_t Pools = 0;
+            uint32_t Idle = 0;
+            uint32_t Reused = 0; // Spawns served from a pool
+            uint32_t Created = 0; // Spawns that had to instantiate
+        };
+
+        EntityPool() = default;
+
+        // Also warms the pool up right away
+        void SetPolicy(Scene& scene, const std::shared_ptr<Prefab>& prefab, const Policy& policy);
+
+        // Reuses idle instances first, instantiates the rest in one batch
+        void Spawn(Scene& scene, const std::shared_ptr<Prefab>& prefab, uint32_t count, entt::entity parent, std::vector<entt::entity>& outRoots);
+        // Immediate, Scene::ReleaseToPool defers it through the command buffer. Instances that don't match their prefab anymore get destroyed instead.
+        void Release(Scene& scene, entt::entity root);
+
+        void Update(Scene& scene, float deltaTime);
+        void Clear();
+
+        const Stats& GetStats() const { return m_Stats; }
+
+    private:
+        struct Pool
+        {
+            std::shared_ptr<Prefab> Prefab;
+            Policy Settings;
+            uint32_t Version = 0; // Prefab version the idle instances were built from
+            uint32_t NodeCount = 0;
+            float TimeSinceSpawn = 0.0f;
+            // Idle instances back to back, NodeCount entities each in template node order
+            std::vector<entt::entity> Idle;
+        };
+
+        Pool& GetPool(Scene& scene, const std::shared_ptr<Prefab>& prefab);
+        void DestroyIdle(Scene& scene, Pool& pool, uint32_t keepInstances);
+        void UpdateKeptStorages();
+
+    private:
+        std::unordered_map<AssetHandle, Pool> m_Pools;
+        std::vector<entt::entity> m_Instance;
+        // Storages that stay on idle instances, everything else gets removed
+        std::unordered_set<entt::id_type> m_KeptStorages;
+        std::vector<const ComponentInfo*> m_KeptComponents;
+        Stats m_Stats;
+    };
+}
@@ -1,26 +1,119 @@
 #pragma once
 
+#include <entt/entt.hpp>
+
 namespace Lynx
 {
     class Scene;
+
+    // What a system touches, declared once in ISystem::DeclareAccess. The SystemManager runs systems that don't
+    // conflict (nobody writes what the other one reads or writes) at the same time.
+    class LX_API SystemAccess
+    {
+    public:
+        template<typename... Components>
+        SystemAccess& Read()
+        {
+            (Add(m_Reads, entt::type_hash<Components>::value(), &CreateStorage<Components>), ...);
+            (AddUpdateHook(&HookUpdates<Components>), ...);
+            return *this;
+        }
+
+        // Includes adding and removing the component
+        template<typename... Components>
+        SystemAccess& Write()
+        {
+            (Add(m_Writes, entt::type_hash<Components>::value(), &CreateStorage<Components>), ...);
+            return *this;
+        }
+
+        // Ordering constraints, by system name
+        SystemAccess& After(const std::string& system) { m_After.push_back(system); m_Declared = true; return *this; }
+        SystemAccess& Before(const std::string& system) { m_Before.push_back(system); m_Declared = true; return *this; }
+
+        // For systems that touch state outside the registry that isn't safe to share (UI, audio, the scene itself, ...).
+        // Systems that don't declare anything are exclusive too.
+        SystemAccess& Exclusive() { m_Exclusive = true; m_Declared = true; return *this; }
+
+        bool IsExclusive() const { return m_Exclusive || !m_Declared; }
+        bool Reads(entt::id_type component) const;
+        bool Writes(entt::id_type component) const;
+        bool ConflictsWith(const SystemAccess& other) const;
+
+        // Access checks (SystemManager::SetAccessChecks), called by Scene::View etc. Warns if the system running on this
+        // thread didn't declare the component.
+        static void CheckAccess(entt::id_type component, std::string_view name);
+        // Same for patch/replace of a component the system only declared as read
+        static void CheckWrite(entt::id_type component, std::string_view name);
+
+        // Views create the storage of a component the first time it's used, which isn't safe while other systems run.
+        // The SystemManager calls this for every system on the main thread when it builds the schedule.
+        void CreateStorages(entt::registry& registry) const;
+
+    private:
+        using CreateStorageFunc = void(*)(entt::registry&);
+        using UpdateHookFunc = void(*)(entt::registry&, bool);
+
+        template<typename Component>
+        static void CreateStorage(entt::registry& registry)
+        {
+            registry.storage<std::remove_const_t<Component>>();
+        }
+
+        // Connected while a checked system runs, on_update only fires for patch/replace, not writes through a reference
+        template<typename Component>
+        static void HookUpdates(entt::registry& registry, bool connect)
+        {
+            using T = std::remove_const_t<Component>;
+            if (connect)
+                registry.on_update<T>().template connect<&OnCheckedUpdate<T>>();
+            else
+                registry.on_update<T>().template disconnect<&OnCheckedUpdate<T>>();
+        }
+
+        template<typename Component>
+        static void OnCheckedUpdate(entt::registry&, entt::entity)
+        {
+            CheckWrite(entt::type_hash<Component>::value(), entt::type_name<Component>::value());
+        }
+
+        void Add(std::vector<entt::id_type>& list, entt::id_type component, CreateStorageFunc createStorage);
+        void AddUpdateHook(UpdateHookFunc hook);
+
+    private:
+        std::vector<entt::id_type> m_Reads;
+        std::vector<entt::id_type> m_Writes;
+        std::vector<CreateStorageFunc> m_Storages;
+        std::vector<UpdateHookFunc> m_UpdateHooks; // Read components
+        std::vector<std::string> m_After;
+        std::vector<std::string> m_Before;
+        bool m_Exclusive = false;
+        bool m_Declared = false;
+
+        friend class SystemManager;
+    };
+
     class LX_API ISystem
     {
     public:
         virtual ~ISystem() = default;
-        
+
         virtual std::string GetName() const = 0;
         bool IsEnabled() const { return m_Enabled; }
         void SetEnabled(bool enabled) { m_Enabled = enabled; }
-        
+
+        // Called when the schedule gets built. Nothing declared means the system runs alone.
+        virtual void DeclareAccess(SystemAccess& access) const {}
+
         virtual void OnInit(Scene& scene) {}
         virtual void OnShutdown(Scene& scene) {}
         virtual void OnSceneStart(Scene& scene) {}
         virtual void OnSceneStop(Scene& scene) {}
-        
+
         virtual void OnUpdate(Scene& scene, float deltaTime) {}
         virtual void OnFixedUpdate(Scene& scene, float fixedDeltaTime) {}
         virtual void OnLateUpdate(Scene& scene, float deltaTime) {}
-        
+
     protected:
         bool m_Enabled = true;
     };
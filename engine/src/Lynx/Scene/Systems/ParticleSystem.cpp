@@ -23,7 +23,7 @@ namespace Lynx
         return min + RandomFloat() * (max - min);
     }
     
-    void ParticleSystem::OnUpdate(float ts, Scene* scene, const glm::vec3& cameraPos)
+    void ParticleSystem::OnUpdate(float ts, Scene* scene, const glm::vec3& cameraPos, uint32_t cullingMask)
     {
         auto view = scene->Reg().view<TransformComponent, ParticleEmitterComponent>();
         for (auto entity : view)
@@ -87,8 +87,14 @@ namespace Lynx
                 activeParticles.push_back(data);
             }
 
+            if (!(emitter.Layers & cullingMask))
+                continue;
+
+            auto mat = emitter.Material ? emitter.Material.Get() : nullptr;
+
             // TODO: Check if we actually need this?
-            if (emitter.DepthSorting)
+            // Weighted blended materials are order independent, no need to sort those
+            if (emitter.DepthSorting && !(mat && mat->IsWeightedBlended()))
             {
                 std::sort(activeParticles.begin(), activeParticles.end(),
                 [cameraPos](const ParticleInstanceData& a, const ParticleInstanceData& b)
@@ -99,13 +105,9 @@ namespace Lynx
                 });
             }
 
-            if (!activeParticles.empty() && emitter.Material)
+            if (!activeParticles.empty() && mat)
             {
-                auto mat = emitter.Material.Get();
-                if (mat)
-                {
-                    Engine::Get().GetRenderer().SubmitParticles(mat.get(), activeParticles);
-                }
+                Engine::Get().GetRenderer().SubmitParticles(mat.get(), activeParticles);
             }
         }
     }
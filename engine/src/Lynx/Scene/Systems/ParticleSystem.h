@@ -11,7 +11,8 @@ namespace Lynx
     public:
         ParticleSystem() = default;
 
-        void OnUpdate(float ts, Scene* scene, const glm::vec3& cameraPos);
+        // Emitters outside the culling mask still simulate, they just don't get submitted
+        void OnUpdate(float ts, Scene* scene, const glm::vec3& cameraPos, uint32_t cullingMask);
 
     private:
         void EmitParticle(ParticleEmitterComponent& emitter, const glm::vec3& sourcePos);
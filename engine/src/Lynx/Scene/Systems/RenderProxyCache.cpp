@@ -0,0 +1,149 @@
+#include "RenderProxyCache.h"
+
+#include "Lynx/Scene/Components/Components.h"
+#include "Lynx/Scene/Components/PhysicsComponents.h"
+#include "StaticBatcher.h"
+
+namespace Lynx
+{
+    void RenderProxyCache::Init(entt::registry& registry)
+    {
+        Connect<MeshComponent>(registry);
+        Connect<TransformComponent>(registry);
+        Connect<DisabledComponent>(registry);
+        Connect<StaticBatchedComponent>(registry);
+        Connect<CharacterControllerComponent>(registry);
+
+        registry.on_update<MeshComponent>().connect<&RenderProxyCache::MarkDirty>(this);
+        registry.on_update<TransformComponent>().connect<&RenderProxyCache::MarkDirty>(this);
+    }
+
+    void RenderProxyCache::Shutdown(entt::registry& registry)
+    {
+        registry.on_construct<MeshComponent>().disconnect(this);
+        registry.on_update<MeshComponent>().disconnect(this);
+        registry.on_destroy<MeshComponent>().disconnect(this);
+        registry.on_construct<TransformComponent>().disconnect(this);
+        registry.on_update<TransformComponent>().disconnect(this);
+        registry.on_destroy<TransformComponent>().disconnect(this);
+        registry.on_construct<DisabledComponent>().disconnect(this);
+        registry.on_destroy<DisabledComponent>().disconnect(this);
+        registry.on_construct<StaticBatchedComponent>().disconnect(this);
+        registry.on_destroy<StaticBatchedComponent>().disconnect(this);
+        registry.on_construct<CharacterControllerComponent>().disconnect(this);
+        registry.on_destroy<CharacterControllerComponent>().disconnect(this);
+    }
+
+    void RenderProxyCache::MarkDirty(entt::registry& registry, entt::entity entity)
+    {
+        // Just remember it, components can still change before the next Flush (and on_destroy fires before the removal)
+        m_Dirty.push_back(entity);
+    }
+
+    void RenderProxyCache::Flush(entt::registry& registry)
+    {
+        // Mesh reloads don't go through the registry, catch them here
+        for (size_t i = 0; i < m_Proxies.size(); i++)
+        {
+            if (m_Proxies[i].Mesh->GetVersion() != m_Proxies[i].MeshVersion)
+                m_Dirty.push_back(m_Entities[i]);
+        }
+
+        m_Dirty.insert(m_Dirty.end(), m_Pending.begin(), m_Pending.end());
+        m_Pending.clear();
+
+        if (m_Dirty.empty())
+            return;
+
+        std::ranges::sort(m_Dirty);
+        auto duplicates = std::ranges::unique(m_Dirty);
+        m_Dirty.erase(duplicates.begin(), duplicates.end());
+
+        RenderProxy proxy;
+        for (auto entity : m_Dirty)
+        {
+            if (!BuildProxy(registry, entity, proxy))
+            {
+                RemoveProxy(entity);
+                continue;
+            }
+
+            auto it = m_Lookup.find(entity);
+            if (it != m_Lookup.end())
+            {
+                m_Proxies[it->second] = std::move(proxy);
+            }
+            else
+            {
+                m_Lookup[entity] = (uint32_t)m_Proxies.size();
+                m_Proxies.push_back(std::move(proxy));
+                m_Entities.push_back(entity);
+            }
+            proxy = RenderProxy();
+        }
+        m_Dirty.clear();
+    }
+
+    bool RenderProxyCache::BuildProxy(entt::registry& registry, entt::entity entity, RenderProxy& proxy)
+    {
+        if (!registry.valid(entity) || !registry.all_of<TransformComponent, MeshComponent>(entity))
+            return false;
+        if (registry.any_of<DisabledComponent, StaticBatchedComponent, CharacterControllerComponent>(entity))
+            return false;
+
+        const auto& meshComp = registry.get<MeshComponent>(entity);
+        if (!meshComp.Mesh)
+            return false;
+
+        auto mesh = meshComp.Mesh.Get();
+        if (!mesh || mesh->IsError())
+            return false;
+        if (!mesh->IsLoaded())
+        {
+            // Nothing signals when it's done, try again next Flush
+            m_Pending.push_back(entity);
+            return false;
+        }
+
+        const auto& transform = registry.get<TransformComponent>(entity);
+        const AABB& bounds = mesh->GetBounds();
+
+        proxy.Mesh = mesh;
+        proxy.MeshVersion = mesh->GetVersion();
+        proxy.Layers = meshComp.Layers;
+        proxy.InstanceData = { transform.WorldMatrix, (int)entity };
+        proxy.WorldBounds = TransformAABB(bounds, transform.WorldMatrix);
+
+        const glm::mat4& world = transform.WorldMatrix;
+        float maxScale = std::max({ glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2])) });
+        proxy.Center = glm::vec3(world * glm::vec4((bounds.Min + bounds.Max) * 0.5f, 1.0f));
+        proxy.Radius = glm::length(bounds.Max - bounds.Min) * 0.5f * maxScale;
+
+        proxy.Materials.clear();
+        for (const auto& submesh : mesh->GetSubmeshes())
+            proxy.Materials.push_back(submesh.Material.get());
+
+        return true;
+    }
+
+    void RenderProxyCache::RemoveProxy(entt::entity entity)
+    {
+        auto it = m_Lookup.find(entity);
+        if (it == m_Lookup.end())
+            return;
+
+        // Swap with the last one to keep the array dense
+        uint32_t index = it->second;
+        uint32_t last = (uint32_t)m_Proxies.size() - 1;
+        if (index != last)
+        {
+            m_Proxies[index] = std::move(m_Proxies[last]);
+            m_Entities[index] = m_Entities[last];
+            m_Lookup[m_Entities[index]] = index;
+        }
+
+        m_Proxies.pop_back();
+        m_Entities.pop_back();
+        m_Lookup.erase(entity);
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "Lynx/Renderer/RenderPass.h"
+
+namespace Lynx
+{
+    // Dense array of RenderProxies for every mesh entity that goes through the normal submission path
+    // (not disabled, not static batched, no character controller, those get interpolated).
+    // Only registry signals mark entities dirty, dirty ones get rebuilt in Flush. Code that changes a MeshComponent
+    // or a WorldMatrix in place has to patch() it, UpdateGlobalTransforms does that for the transforms.
+    // Entities whose mesh is still loading stay dirty until it's ready.
+    class RenderProxyCache
+    {
+    public:
+        RenderProxyCache() = default;
+
+        void Init(entt::registry& registry);
+        void Shutdown(entt::registry& registry);
+
+        void Flush(entt::registry& registry);
+
+        const std::vector<RenderProxy>& GetProxies() const { return m_Proxies; }
+        // Same order as GetProxies
+        const std::vector<entt::entity>& GetEntities() const { return m_Entities; }
+
+    private:
+        void MarkDirty(entt::registry& registry, entt::entity entity);
+        bool BuildProxy(entt::registry& registry, entt::entity entity, RenderProxy& proxy);
+        void RemoveProxy(entt::entity entity);
+
+        template<typename T>
+        void Connect(entt::registry& registry)
+        {
+            registry.on_construct<T>().template connect<&RenderProxyCache::MarkDirty>(this);
+            registry.on_destroy<T>().template connect<&RenderProxyCache::MarkDirty>(this);
+        }
+
+    private:
+        std::vector<RenderProxy> m_Proxies;
+        std::vector<entt::entity> m_Entities;
+        std::unordered_map<entt::entity, uint32_t> m_Lookup;
+
+        std::vector<entt::entity> m_Dirty;
+        // Mesh still loading, these get another try every Flush
+        std::vector<entt::entity> m_Pending;
+    };
+}
@@ -0,0 +1,312 @@
+#include "SpatialIndex.h"
+
+#include "Lynx/Scene/Components/Components.h"
+
+namespace Lynx
+{
+    // 21 bits per axis, wraps after ~2 million cells which is fine for the sizes we use
+    static constexpr uint64_t CellMask = (1ull << 21) - 1;
+
+    static uint64_t PackCell(const glm::ivec3& coord)
+    {
+        return (((uint64_t)coord.x & CellMask) << 42) | (((uint64_t)coord.y & CellMask) << 21) | ((uint64_t)coord.z & CellMask);
+    }
+
+    void SpatialIndex::Init(entt::registry& registry)
+    {
+        registry.on_construct<SpatialComponent>().connect<&SpatialIndex::OnSpatialChanged>(this);
+        registry.on_update<SpatialComponent>().connect<&SpatialIndex::OnSpatialChanged>(this);
+        registry.on_destroy<SpatialComponent>().connect<&SpatialIndex::OnSpatialDestroyed>(this);
+        // Construct too, copies can add the transform after the SpatialComponent
+        registry.on_construct<TransformComponent>().connect<&SpatialIndex::OnTransformChanged>(this);
+        registry.on_update<TransformComponent>().connect<&SpatialIndex::OnTransformChanged>(this);
+        registry.on_construct<DisabledComponent>().connect<&SpatialIndex::OnDisabled>(this);
+        registry.on_destroy<DisabledComponent>().connect<&SpatialIndex::OnEnabled>(this);
+    }
+
+    void SpatialIndex::Shutdown(entt::registry& registry)
+    {
+        registry.on_construct<SpatialComponent>().disconnect(this);
+        registry.on_update<SpatialComponent>().disconnect(this);
+        registry.on_destroy<SpatialComponent>().disconnect(this);
+        registry.on_construct<TransformComponent>().disconnect(this);
+        registry.on_update<TransformComponent>().disconnect(this);
+        registry.on_construct<DisabledComponent>().disconnect(this);
+        registry.on_destroy<DisabledComponent>().disconnect(this);
+    }
+
+    void SpatialIndex::SetCellSize(float cellSize)
+    {
+        if (cellSize <= 0.0f || cellSize == m_CellSize)
+            return;
+
+        m_CellSize = cellSize;
+        m_InvCellSize = 1.0f / cellSize;
+
+        m_Cells.clear();
+        m_EmptyCells = 0;
+        m_MinCell = glm::ivec3(std::numeric_limits<int32_t>::max());
+        m_MaxCell = glm::ivec3(std::numeric_limits<int32_t>::min());
+        for (uint32_t i = 0; i < (uint32_t)m_Items.size(); i++)
+            AddToCell(i);
+        m_Stats.Cells = (uint32_t)m_Cells.size();
+    }
+
+    uint32_t SpatialIndex::QueryRadius(const glm::vec3& center, float radius, uint32_t layers, std::vector<entt::entity>& outEntities) const
+    {
+        outEntities.clear();
+        ForEachInBounds(center - radius, center + radius, layers, [&](const Item& item)
+        {
+            glm::vec3 offset = item.Position - center;
+            float reach = radius + item.Radius;
+            if (glm::dot(offset, offset) <= reach * reach)
+                outEntities.push_back(item.Entity);
+        });
+        return (uint32_t)outEntities.size();
+    }
+
+    uint32_t SpatialIndex::QueryBox(const glm::vec3& min, const glm::vec3& max, uint32_t layers, std::vector<entt::entity>& outEntities) const
+    {
+        outEntities.clear();
+        ForEachInBounds(min, max, layers, [&](const Item& item)
+        {
+            glm::vec3 offset = item.Position - glm::clamp(item.Position, min, max);
+            if (glm::dot(offset, offset) <= item.Radius * item.Radius)
+                outEntities.push_back(item.Entity);
+        });
+        return (uint32_t)outEntities.size();
+    }
+
+    uint32_t SpatialIndex::QueryNearest(const glm::vec3& center, float maxDistance, uint32_t layers, std::span<SpatialHit> outHits) const
+    {
+        if (outHits.empty())
+            return 0;
+
+        uint32_t count = 0;
+        uint32_t capacity = (uint32_t)outHits.size();
+        ForEachInBounds(center - maxDistance, center + maxDistance, layers, [&](const Item& item)
+        {
+            glm::vec3 offset = item.Position - center;
+            float reach = maxDistance + item.Radius;
+            float distanceSq = glm::dot(offset, offset);
+            if (distanceSq > reach * reach)
+                return;
+
+            float distance = std::max(std::sqrt(distanceSq) - item.Radius, 0.0f);
+            if (count == capacity && distance >= outHits[count - 1].Distance)
+                return;
+
+            // Insertion sort, k is small. Drops the farthest one when full.
+            uint32_t i = count < capacity ? count++ : count - 1;
+            for (; i > 0 && outHits[i - 1].Distance > distance; i--)
+                outHits[i] = outHits[i - 1];
+            outHits[i] = { item.Entity, distance };
+        });
+        return count;
+    }
+
+    entt::entity SpatialIndex::FindNearest(const glm::vec3& center, float maxDistance, uint32_t layers) const
+    {
+        SpatialHit hit;
+        return QueryNearest(center, maxDistance, layers, std::span<SpatialHit>(&hit, 1)) > 0 ? hit.Entity : entt::null;
+    }
+
+    template<typename Func>
+    void SpatialIndex::ForEachInBounds(const glm::vec3& min, const glm::vec3& max, uint32_t layers, Func&& func) const
+    {
+        if (m_Items.empty())
+            return;
+
+        glm::ivec3 first = glm::max(GetCellCoord(min - m_MaxRadius), m_MinCell);
+        glm::ivec3 last = glm::min(GetCellCoord(max + m_MaxRadius), m_MaxCell);
+        if (glm::any(glm::greaterThan(first, last)))
+            return;
+
+        // Big queries over a sparse grid are cheaper as one linear pass over everything
+        uint64_t cells = (uint64_t)(last.x - first.x + 1) * (uint64_t)(last.y - first.y + 1) * (uint64_t)(last.z - first.z + 1);
+        if (cells > m_Items.size())
+        {
+            for (const Item& item : m_Items)
+            {
+                if (item.Layers & layers)
+                    func(item);
+            }
+            return;
+        }
+
+        for (int32_t x = first.x; x <= last.x; x++)
+        {
+            for (int32_t y = first.y; y <= last.y; y++)
+            {
+                for (int32_t z = first.z; z <= last.z; z++)
+                {
+                    auto it = m_Cells.find(PackCell({ x, y, z }));
+                    if (it == m_Cells.end())
+                        continue;
+
+                    for (uint32_t index : it->second.Items)
+                    {
+                        const Item& item = m_Items[index];
+                        if (item.Layers & layers)
+                            func(item);
+                    }
+                }
+            }
+        }
+    }
+
+    glm::ivec3 SpatialIndex::GetCellCoord(const glm::vec3& position) const
+    {
+        return glm::ivec3(glm::floor(position * m_InvCellSize));
+    }
+
+    void SpatialIndex::Refresh(entt::registry& registry, entt::entity entity)
+    {
+        const auto& spatial = registry.get<SpatialComponent>(entity);
+        const auto* transform = registry.try_get<TransformComponent>(entity);
+        glm::vec3 position = transform ? transform->GetWorldTranslation() : glm::vec3(0.0f);
+
+        auto [it, inserted] = m_Lookup.try_emplace(entity, (uint32_t)m_Items.size());
+        if (inserted)
+        {
+            m_Items.push_back({ entity, position, 0.0f, 0, 0, InvalidSlot });
+            m_Stats.Entities = (uint32_t)m_Items.size();
+        }
+
+        Item& item = m_Items[it->second];
+        item.Radius = spatial.Radius;
+        item.Layers = spatial.Layers;
+        m_MaxRadius = std::max(m_MaxRadius, spatial.Radius);
+        Move(it->second, position);
+    }
+
+    void SpatialIndex::Move(uint32_t index, const glm::vec3& position)
+    {
+        Item& item = m_Items[index];
+        item.Position = position;
+
+        if (item.Slot != InvalidSlot)
+        {
+            if (PackCell(GetCellCoord(position)) == item.Cell)
+                return;
+
+            RemoveFromCell(index);
+            m_Stats.Moves++;
+        }
+
+        AddToCell(index);
+        PruneCells();
+    }
+
+    void SpatialIndex::Remove(entt::entity entity)
+    {
+        auto it = m_Lookup.find(entity);
+        if (it == m_Lookup.end())
+            return;
+
+        uint32_t index = it->second;
+        m_Lookup.erase(it);
+        RemoveFromCell(index);
+
+        // Swap with the last one and point its cell at the new index
+        uint32_t last = (uint32_t)m_Items.size() - 1;
+        if (index != last)
+        {
+            Item& moved = m_Items[index] = m_Items[last];
+            m_Lookup[moved.Entity] = index;
+            m_Cells.find(moved.Cell)->second.Items[moved.Slot] = index;
+        }
+        m_Items.pop_back();
+
+        m_Stats.Entities = (uint32_t)m_Items.size();
+        PruneCells();
+    }
+
+    void SpatialIndex::AddToCell(uint32_t index)
+    {
+        Item& item = m_Items[index];
+        glm::ivec3 coord = GetCellCoord(item.Position);
+        item.Cell = PackCell(coord);
+
+        auto [it, inserted] = m_Cells.try_emplace(item.Cell);
+        Cell& cell = it->second;
+        if (inserted)
+        {
+            cell.Coord = coord;
+            m_MinCell = glm::min(m_MinCell, coord);
+            m_MaxCell = glm::max(m_MaxCell, coord);
+            m_Stats.Cells = (uint32_t)m_Cells.size();
+        }
+        else if (cell.Items.empty())
+        {
+            m_EmptyCells--;
+        }
+
+        item.Slot = (uint32_t)cell.Items.size();
+        cell.Items.push_back(index);
+    }
+
+    void SpatialIndex::RemoveFromCell(uint32_t index)
+    {
+        Item& item = m_Items[index];
+        auto& items = m_Cells.find(item.Cell)->second.Items;
+
+        uint32_t last = items.back();
+        items[item.Slot] = last;
+        m_Items[last].Slot = item.Slot;
+        items.pop_back();
+        item.Slot = InvalidSlot;
+
+        if (items.empty())
+            m_EmptyCells++;
+    }
+
+    void SpatialIndex::PruneCells()
+    {
+        // Empty cells stay around so entities going back and forth don't reallocate, until they're the majority
+        if (m_EmptyCells < 64 || m_EmptyCells * 2 < m_Cells.size())
+            return;
+
+        std::erase_if(m_Cells, [](const auto& entry) { return entry.second.Items.empty(); });
+        m_EmptyCells = 0;
+
+        m_MinCell = glm::ivec3(std::numeric_limits<int32_t>::max());
+        m_MaxCell = glm::ivec3(std::numeric_limits<int32_t>::min());
+        for (const auto& [key, cell] : m_Cells)
+        {
+            m_MinCell = glm::min(m_MinCell, cell.Coord);
+            m_MaxCell = glm::max(m_MaxCell, cell.Coord);
+        }
+        m_Stats.Cells = (uint32_t)m_Cells.size();
+    }
+
+    void SpatialIndex::OnSpatialChanged(entt::registry& registry, entt::entity entity)
+    {
+        if (!registry.all_of<DisabledComponent>(entity))
+            Refresh(registry, entity);
+    }
+
+    void SpatialIndex::OnSpatialDestroyed(entt::registry& registry, entt::entity entity)
+    {
+        Remove(entity);
+    }
+
+    void SpatialIndex::OnTransformChanged(entt::registry& registry, entt::entity entity)
+    {
+        auto it = m_Lookup.find(entity);
+        if (it != m_Lookup.end())
+            Move(it->second, registry.get<TransformComponent>(entity).GetWorldTranslation());
+    }
+
+    void SpatialIndex::OnDisabled(entt::registry& registry, entt::entity entity)
+    {
+        Remove(entity);
+    }
+
+    void SpatialIndex::OnEnabled(entt::registry& registry, entt::entity entity)
+    {
+        // Still has the DisabledComponent at this point
+        if (registry.all_of<SpatialComponent>(entity))
+            Refresh(registry, entity);
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <span>
+
+namespace Lynx
+{
+    // Puts an entity into the scene's SpatialIndex. Runtime only, not serialized, add it when spawning.
+    struct SpatialComponent
+    {
+        uint32_t Layers = 1; // Bitmask, the meaning of the bits is up to the game
+        float Radius = 0.5f;
+    };
+
+    struct SpatialHit
+    {
+        entt::entity Entity = entt::null;
+        float Distance = 0.0f; // To the entity's sphere, 0 if inside
+    };
+
+    // Hashed uniform grid over the world positions of every enabled entity with a SpatialComponent, for gameplay
+    // proximity queries that don't need to go through physics. Entities are spheres and only move when their world
+    // matrix gets patched (UpdateGlobalTransforms does that), so positions are the ones of the last transform update.
+    // Queries don't change anything, any thread can run them as long as no transforms get updated at the same time.
+    class SpatialIndex
+    {
+    public:
+        struct Stats
+        {
+            uint32_t Entities = 0;
+            uint32_t Cells = 0;
+            uint32_t Moves = 0; // Cell changes since the last ResetStats
+        };
+
+        SpatialIndex() = default;
+
+        void Init(entt::registry& registry);
+        void Shutdown(entt::registry& registry);
+
+        // Rebuilds the grid. Somewhere around the usual query radius works best.
+        void SetCellSize(float cellSize);
+        float GetCellSize() const { return m_CellSize; }
+
+        // Results go into the caller's buffer, which gets cleared first. Returns the number of hits.
+        uint32_t QueryRadius(const glm::vec3& center, float radius, uint32_t layers, std::vector<entt::entity>& outEntities) const;
+        uint32_t QueryBox(const glm::vec3& min, const glm::vec3& max, uint32_t layers, std::vector<entt::entity>& outEntities) const;
+        // The outHits.size() closest entities within maxDistance, nearest first
+        uint32_t QueryNearest(const glm::vec3& center, float maxDistance, uint32_t layers, std::span<SpatialHit> outHits) const;
+        entt::entity FindNearest(const glm::vec3& center, float maxDistance, uint32_t layers) const;
+
+        const Stats& GetStats() const { return m_Stats; }
+        void ResetStats() { m_Stats.Moves = 0; }
+
+    private:
+        struct Item
+        {
+            entt::entity Entity;
+            glm::vec3 Position;
+            float Radius;
+            uint32_t Layers;
+            uint64_t Cell;
+            uint32_t Slot; // Position in the cell's list
+        };
+
+        struct Cell
+        {
+            glm::ivec3 Coord;
+            std::vector<uint32_t> Items; // Indices into m_Items
+        };
+
+        static constexpr uint32_t InvalidSlot = std::numeric_limits<uint32_t>::max();
+
+        glm::ivec3 GetCellCoord(const glm::vec3& position) const;
+        void Refresh(entt::registry& registry, entt::entity entity);
+        void Move(uint32_t index, const glm::vec3& position);
+        void Remove(entt::entity entity);
+        void AddToCell(uint32_t index);
+        void RemoveFromCell(uint32_t index);
+        void PruneCells();
+
+        template<typename Func>
+        void ForEachInBounds(const glm::vec3& min, const glm::vec3& max, uint32_t layers, Func&& func) const;
+
+        void OnSpatialChanged(entt::registry& registry, entt::entity entity);
+        void OnSpatialDestroyed(entt::registry& registry, entt::entity entity);
+        void OnTransformChanged(entt::registry& registry, entt::entity entity);
+        void OnDisabled(entt::registry& registry, entt::entity entity);
+        void OnEnabled(entt::registry& registry, entt::entity entity);
+
+    private:
+        float m_CellSize = 4.0f;
+        float m_InvCellSize = 0.25f;
+
+        std::vector<Item> m_Items;
+        std::unordered_map<entt::entity, uint32_t> m_Lookup;
+        std::unordered_map<uint64_t, Cell> m_Cells;
+        uint32_t m_EmptyCells = 0;
+
+        // Cell range that ever held something (since the last prune), queries are clamped to it.
+        // Keeps flat worlds from looking through a column of empty cells.
+        glm::ivec3 m_MinCell = glm::ivec3(std::numeric_limits<int32_t>::max());
+        glm::ivec3 m_MaxCell = glm::ivec3(std::numeric_limits<int32_t>::min());
+        // Largest radius in the index, queries grow by it since entities only live in the cell of their center
+        float m_MaxRadius = 0.0f;
+
+        Stats m_Stats;
+    };
+}
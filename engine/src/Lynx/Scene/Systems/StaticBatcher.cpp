@@ -0,0 +1,198 @@
+#include "StaticBatcher.h"
+
+#include "Lynx/Asset/StaticMesh.h"
+#include "Lynx/Scene/Components/Components.h"
+#include "Lynx/Scene/Scene.h"
+
+namespace Lynx
+{
+    void StaticBatcher::Init(entt::registry& registry)
+    {
+        registry.on_destroy<StaticBatchedComponent>().connect<&StaticBatcher::OnBatchedEntityRemoved>(this);
+    }
+
+    void StaticBatcher::Shutdown(entt::registry& registry)
+    {
+        registry.on_destroy<StaticBatchedComponent>().disconnect(this);
+    }
+
+    void StaticBatcher::OnBatchedEntityRemoved(entt::registry& registry, entt::entity entity)
+    {
+        // Only mark it, the entity list gets cleaned up in RebuildCluster
+        auto& batched = registry.get<StaticBatchedComponent>(entity);
+        auto it = m_Clusters.find(batched.Cell);
+        if (it != m_Clusters.end())
+            it->second.Dirty = true;
+    }
+
+    void StaticBatcher::Update(Scene* scene, bool validateEdits)
+    {
+        auto& registry = scene->Reg();
+        m_Stats.Rebuilds = 0;
+
+        // 1. Drop entities that changed since they got baked, this rebuilds their cluster
+        std::vector<entt::entity> changed;
+        if (validateEdits)
+        {
+            auto view = registry.view<StaticBatchedComponent>();
+            for (auto entity : view)
+            {
+                const auto& batched = view.get<StaticBatchedComponent>(entity);
+                const auto* meshComp = registry.try_get<MeshComponent>(entity);
+                const auto* transform = registry.try_get<TransformComponent>(entity);
+
+                bool valid = meshComp && transform && meshComp->IsStatic && meshComp->Layers == RenderLayer::Default
+                    && !registry.all_of<DisabledComponent>(entity)
+                    && meshComp->Mesh.Get().get() == batched.Mesh
+                    && batched.Mesh->GetVersion() == batched.MeshVersion
+                    && transform->WorldMatrix == batched.Transform;
+                if (!valid)
+                    changed.push_back(entity);
+            }
+        }
+        else
+        {
+            auto disabledView = registry.view<StaticBatchedComponent, DisabledComponent>();
+            changed.assign(disabledView.begin(), disabledView.end());
+        }
+        registry.remove<StaticBatchedComponent>(changed.begin(), changed.end());
+
+        // 2. New static entities
+        auto candidates = registry.view<TransformComponent, MeshComponent>(entt::exclude<StaticBatchedComponent, DisabledComponent>);
+        for (auto entity : candidates)
+        {
+            auto [transform, meshComp] = candidates.get<TransformComponent, MeshComponent>(entity);
+            // Clusters are culled as a whole, so only the default layer gets merged
+            if (!meshComp.IsStatic || !meshComp.Mesh || meshComp.Layers != RenderLayer::Default)
+                continue;
+
+            auto mesh = meshComp.Mesh.Get();
+            if (!mesh || !mesh->IsLoaded() || !CanBatch(*mesh))
+                continue;
+
+            glm::ivec3 cell = GetCell(transform.GetWorldTranslation());
+            registry.emplace<StaticBatchedComponent>(entity, cell, transform.WorldMatrix, mesh.get(), mesh->GetVersion());
+
+            Cluster& cluster = m_Clusters[cell];
+            cluster.Entities.push_back(entity);
+            cluster.Dirty = true;
+        }
+
+        // 3. Rebuild what changed
+        m_Stats.BatchedEntities = 0;
+        for (auto it = m_Clusters.begin(); it != m_Clusters.end();)
+        {
+            if (it->second.Dirty)
+                RebuildCluster(registry, it->first, it->second);
+
+            if (it->second.Entities.empty())
+            {
+                it = m_Clusters.erase(it);
+                continue;
+            }
+
+            m_Stats.BatchedEntities += (uint32_t)it->second.Entities.size();
+            ++it;
+        }
+        m_Stats.Clusters = (uint32_t)m_Clusters.size();
+    }
+
+    void StaticBatcher::Clear(Scene* scene)
+    {
+        if (m_Clusters.empty())
+            return;
+
+        auto& registry = scene->Reg();
+        registry.clear<StaticBatchedComponent>();
+        m_Clusters.clear();
+        m_Stats = Stats();
+    }
+
+    bool StaticBatcher::CanBatch(StaticMesh& mesh)
+    {
+        auto rejected = m_RejectedMeshes.find(&mesh);
+        if (rejected != m_RejectedMeshes.end() && rejected->second == mesh.GetVersion())
+            return false;
+
+        // Blended submeshes have to be sorted per object, skinned ones move
+        bool canBatch = mesh.GetType() == AssetType::StaticMesh && mesh.LoadCPUGeometry();
+        for (const auto& submesh : mesh.GetSubmeshes())
+        {
+            if (!submesh.Material || submesh.Material->Mode == AlphaMode::Translucent || submesh.Material->Mode == AlphaMode::Additive)
+                canBatch = false;
+        }
+
+        if (!canBatch)
+            m_RejectedMeshes[&mesh] = mesh.GetVersion();
+        return canBatch;
+    }
+
+    void StaticBatcher::RebuildCluster(entt::registry& registry, const glm::ivec3& cell, Cluster& cluster)
+    {
+        std::ranges::sort(cluster.Entities);
+        auto duplicates = std::ranges::unique(cluster.Entities);
+        cluster.Entities.erase(duplicates.begin(), duplicates.end());
+        std::erase_if(cluster.Entities, [&](entt::entity entity)
+        {
+            const auto* batched = registry.valid(entity) ? registry.try_get<StaticBatchedComponent>(entity) : nullptr;
+            return !batched || batched->Cell != cell;
+        });
+
+        std::vector<MeshGeometry> geometry;
+        std::vector<std::shared_ptr<Material>> materials;
+        std::unordered_map<Material*, size_t> materialIndices;
+
+        for (auto entity : cluster.Entities)
+        {
+            const auto& batched = registry.get<StaticBatchedComponent>(entity);
+            const auto& submeshes = batched.Mesh->GetSubmeshes();
+            const auto& sourceGeometry = batched.Mesh->GetCPUGeometry();
+            if (sourceGeometry.size() != submeshes.size())
+                continue;
+
+            glm::mat3 basis = glm::mat3(batched.Transform);
+            glm::mat3 normalMatrix = glm::transpose(glm::inverse(basis));
+            // Mirrored transforms flip the winding and the tangent handedness
+            bool mirrored = glm::determinant(basis) < 0.0f;
+
+            for (size_t i = 0; i < submeshes.size(); i++)
+            {
+                auto [it, inserted] = materialIndices.try_emplace(submeshes[i].Material.get(), geometry.size());
+                if (inserted)
+                {
+                    geometry.emplace_back();
+                    materials.push_back(submeshes[i].Material);
+                }
+
+                MeshGeometry& target = geometry[it->second];
+                const MeshGeometry& source = sourceGeometry[i];
+                uint32_t baseVertex = (uint32_t)target.Vertices.size();
+
+                for (const auto& vertex : source.Vertices)
+                {
+                    Vertex& out = target.Vertices.emplace_back(vertex);
+                    out.Position = glm::vec3(batched.Transform * glm::vec4(vertex.Position, 1.0f));
+                    out.Normal = glm::normalize(normalMatrix * vertex.Normal);
+                    out.Tangent = glm::vec4(glm::normalize(basis * glm::vec3(vertex.Tangent)), mirrored ? -vertex.Tangent.w : vertex.Tangent.w);
+                }
+
+                for (size_t index = 0; index + 2 < source.Indices.size(); index += 3)
+                {
+                    target.Indices.push_back(baseVertex + source.Indices[index]);
+                    target.Indices.push_back(baseVertex + source.Indices[index + (mirrored ? 2 : 1)]);
+                    target.Indices.push_back(baseVertex + source.Indices[index + (mirrored ? 1 : 2)]);
+                }
+            }
+        }
+
+        cluster.Mesh = geometry.empty() ? nullptr : std::make_shared<StaticMesh>(geometry, materials, "StaticBatch");
+        cluster.Bounds = cluster.Mesh ? cluster.Mesh->GetBounds() : AABB();
+        cluster.Dirty = false;
+        m_Stats.Rebuilds++;
+    }
+
+    glm::ivec3 StaticBatcher::GetCell(const glm::vec3& position) const
+    {
+        return glm::ivec3(glm::floor(position / m_CellSize));
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include "Lynx/Renderer/Frustum.h"
+
+namespace Lynx
+{
+    class Scene;
+    class StaticMesh;
+
+    // Added to static entities once they are part of a cluster, SubmitScene skips them.
+    // Keeps what got baked so edits can be detected.
+    struct StaticBatchedComponent
+    {
+        glm::ivec3 Cell = glm::ivec3(0);
+        glm::mat4 Transform = glm::mat4(1.0f);
+        StaticMesh* Mesh = nullptr;
+        uint32_t MeshVersion = 0;
+    };
+
+    // Merges static MeshComponents into one combined mesh per grid cell (one submesh per material).
+    // Only meshes on RenderLayer::Default are merged, everything else stays a regular proxy.
+    // Batched geometry is drawn with entity ID -1, so it can't be picked in the viewport.
+    class StaticBatcher
+    {
+    public:
+        struct Cluster
+        {
+            std::vector<entt::entity> Entities;
+            std::shared_ptr<StaticMesh> Mesh;
+            AABB Bounds;
+            bool Dirty = true;
+        };
+
+        struct CellHasher
+        {
+            size_t operator()(const glm::ivec3& cell) const
+            {
+                return (size_t)cell.x * 73856093 ^ (size_t)cell.y * 19349663 ^ (size_t)cell.z * 83492791;
+            }
+        };
+
+        struct Stats
+        {
+            uint32_t Clusters = 0;
+            uint32_t BatchedEntities = 0;
+            uint32_t Rebuilds = 0; // Last update
+        };
+
+        StaticBatcher() = default;
+
+        void Init(entt::registry& registry);
+        void Shutdown(entt::registry& registry);
+
+        // Picks up new static entities and rebuilds dirty clusters.
+        // With validateEdits every batched entity is checked for changes (editor), otherwise only removals are noticed.
+        void Update(Scene* scene, bool validateEdits);
+        void Clear(Scene* scene);
+
+        const std::unordered_map<glm::ivec3, Cluster, CellHasher>& GetClusters() const { return m_Clusters; }
+        const Stats& GetStats() const { return m_Stats; }
+
+    private:
+        void OnBatchedEntityRemoved(entt::registry& registry, entt::entity entity);
+        bool CanBatch(StaticMesh& mesh);
+        void RebuildCluster(entt::registry& registry, const glm::ivec3& cell, Cluster& cluster);
+        glm::ivec3 GetCell(const glm::vec3& position) const;
+
+    private:
+        std::unordered_map<glm::ivec3, Cluster, CellHasher> m_Clusters;
+        // Meshes that can't be batched (translucent or no CPU geometry), by the version that got rejected
+        std::unordered_map<StaticMesh*, uint32_t> m_RejectedMeshes;
+        float m_CellSize = 32.0f;
+        Stats m_Stats;
+    };
+}
@@ -1,7 +1,92 @@
 #include "SystemManager.h"
 
+#include "Lynx/Engine.h"
+#include "Lynx/Scene/Scene.h"
+
+#include <chrono>
+#include <set>
+
 namespace Lynx
 {
+    // The system the access checks are running for on this thread, null outside of checked systems
+    static thread_local const SystemAccess* t_CheckedAccess = nullptr;
+    static thread_local const std::string* t_CheckedSystem = nullptr;
+    // Warn once per system and component
+    static std::set<std::pair<std::string, entt::id_type>> s_ReportedAccess;
+
+    static void ReportAccess(const std::string& system, entt::id_type component, std::string_view name, const char* what)
+    {
+        if (s_ReportedAccess.emplace(system, component).second)
+            LX_CORE_WARN("SystemManager: {} {} '{}' without declaring it", system, what, name);
+    }
+
+    bool SystemAccess::Reads(entt::id_type component) const
+    {
+        return std::find(m_Reads.begin(), m_Reads.end(), component) != m_Reads.end();
+    }
+
+    bool SystemAccess::Writes(entt::id_type component) const
+    {
+        return std::find(m_Writes.begin(), m_Writes.end(), component) != m_Writes.end();
+    }
+
+    bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+    {
+        if (IsExclusive() || other.IsExclusive())
+            return true;
+
+        for (entt::id_type component : m_Writes)
+        {
+            if (other.Reads(component) || other.Writes(component))
+                return true;
+        }
+        for (entt::id_type component : other.m_Writes)
+        {
+            if (Reads(component))
+                return true;
+        }
+        return false;
+    }
+
+    void SystemAccess::CheckAccess(entt::id_type component, std::string_view name)
+    {
+        if (!t_CheckedAccess || t_CheckedAccess->IsExclusive())
+            return;
+
+        if (!t_CheckedAccess->Reads(component) && !t_CheckedAccess->Writes(component))
+            ReportAccess(*t_CheckedSystem, component, name, "views");
+    }
+
+    void SystemAccess::CheckWrite(entt::id_type component, std::string_view name)
+    {
+        if (!t_CheckedAccess || t_CheckedAccess->IsExclusive())
+            return;
+
+        if (!t_CheckedAccess->Writes(component))
+            ReportAccess(*t_CheckedSystem, component, name, "writes");
+    }
+
+    void SystemAccess::CreateStorages(entt::registry& registry) const
+    {
+        for (CreateStorageFunc createStorage : m_Storages)
+            createStorage(registry);
+    }
+
+    void SystemAccess::Add(std::vector<entt::id_type>& list, entt::id_type component, CreateStorageFunc createStorage)
+    {
+        if (std::find(list.begin(), list.end(), component) == list.end())
+            list.push_back(component);
+        if (std::find(m_Storages.begin(), m_Storages.end(), createStorage) == m_Storages.end())
+            m_Storages.push_back(createStorage);
+        m_Declared = true;
+    }
+
+    void SystemAccess::AddUpdateHook(UpdateHookFunc hook)
+    {
+        if (std::find(m_UpdateHooks.begin(), m_UpdateHooks.end(), hook) == m_UpdateHooks.end())
+            m_UpdateHooks.push_back(hook);
+    }
+
     void SystemManager::Init(Scene& scene)
     {
         for (auto& system : m_Systems)
@@ -36,25 +121,195 @@ namespace Lynx
 
     void SystemManager::Update(Scene& scene, float deltaTime)
     {
-        for (auto& system : m_Systems)
+        // A frame starts here, fixed and late update add to the same timings
+        for (auto& timing : m_Timings)
+            timing.Update = timing.FixedUpdate = timing.LateUpdate = 0.0f;
+
+        Run(scene, Phase::Update, deltaTime);
+    }
+
+    void SystemManager::FixedUpdate(Scene& scene, float fixedDeltaTime)
+    {
+        Run(scene, Phase::FixedUpdate, fixedDeltaTime);
+    }
+
+    void SystemManager::LateUpdate(Scene& scene, float deltaTime)
+    {
+        Run(scene, Phase::LateUpdate, deltaTime);
+    }
+
+    void SystemManager::BuildSchedule(Scene& scene)
+    {
+        m_ScheduleDirty = false;
+
+        uint32_t count = (uint32_t)m_Systems.size();
+        m_Access.assign(count, {});
+        std::unordered_map<std::string, uint32_t> byName;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            m_Systems[i]->DeclareAccess(m_Access[i]);
+            m_Access[i].CreateStorages(scene.Reg());
+            byName[m_Systems[i]->GetName()] = i;
+        }
+
+        // Explicit constraints, before[i][j] means i has to run before j
+        std::vector<std::vector<bool>> before(count, std::vector<bool>(count, false));
+        for (uint32_t i = 0; i < count; i++)
         {
-            system->OnUpdate(scene, deltaTime);
+            for (const auto& name : m_Access[i].m_After)
+            {
+                auto it = byName.find(name);
+                if (it != byName.end() && it->second != i)
+                    before[it->second][i] = true;
+            }
+            for (const auto& name : m_Access[i].m_Before)
+            {
+                auto it = byName.find(name);
+                if (it != byName.end() && it->second != i)
+                    before[i][it->second] = true;
+            }
+        }
+
+        // Total order: registration order, except where a constraint says otherwise. Always picks the earliest registered
+        // system that has nothing left to wait for, so the schedule doesn't change between runs.
+        std::vector<uint32_t> order;
+        std::vector<bool> placed(count, false);
+        while (order.size() < count)
+        {
+            uint32_t next = count;
+            for (uint32_t j = 0; j < count && next == count; j++)
+            {
+                if (placed[j])
+                    continue;
+
+                bool ready = true;
+                for (uint32_t i = 0; i < count && ready; i++)
+                    ready = placed[i] || !before[i][j];
+                if (ready)
+                    next = j;
+            }
+
+            if (next == count)
+            {
+                LX_CORE_ERROR("SystemManager: Cyclic Before/After constraints, running the remaining systems in registration order");
+                for (uint32_t j = 0; j < count; j++)
+                {
+                    if (!placed[j])
+                        order.push_back(j);
+                }
+                break;
+            }
+
+            placed[next] = true;
+            order.push_back(next);
+        }
+
+        // A system goes one wave after the last earlier system it conflicts with or has to wait for
+        std::vector<uint32_t> wave(count, 0);
+        m_Waves.clear();
+        for (size_t a = 0; a < order.size(); a++)
+        {
+            uint32_t j = order[a];
+            for (size_t b = 0; b < a; b++)
+            {
+                uint32_t i = order[b];
+                if (before[i][j] || m_Access[i].ConflictsWith(m_Access[j]))
+                    wave[j] = std::max(wave[j], wave[i] + 1);
+            }
+
+            if (wave[j] >= m_Waves.size())
+                m_Waves.resize(wave[j] + 1);
+            m_Waves[wave[j]].push_back(j);
+        }
+
+        m_Timings.assign(count, {});
+        for (uint32_t i = 0; i < count; i++)
+        {
+            m_Timings[i].Name = m_Systems[i]->GetName();
+            m_Timings[i].Wave = wave[i];
         }
     }
 
-    void SystemManager::FixedUpdate(Scene& scene, float fixedDeltaTime)
+    void SystemManager::Run(Scene& scene, Phase phase, float deltaTime)
     {
-        for (auto& system : m_Systems)
+        if (m_ScheduleDirty)
+            BuildSchedule(scene);
+
+        for (const auto& wave : m_Waves)
         {
-            system->OnFixedUpdate(scene, fixedDeltaTime);
+            if (wave.size() == 1 || m_AccessChecks)
+            {
+                for (uint32_t index : wave)
+                    RunSystem(scene, index, phase, deltaTime);
+                continue;
+            }
+
+            // First one on this thread, the rest on the workers
+            JobSystem& jobs = Engine::Get().GetJobSystem();
+            JobSystem::Counter counter;
+            for (size_t i = 1; i < wave.size(); i++)
+            {
+                uint32_t index = wave[i];
+                jobs.Run([this, &scene, index, phase, deltaTime]() { RunSystem(scene, index, phase, deltaTime); }, &counter);
+            }
+
+            RunSystem(scene, wave[0], phase, deltaTime);
+            jobs.Wait(counter);
         }
     }
 
-    void SystemManager::LateUpdate(Scene& scene, float deltaTime)
+    void SystemManager::RunSystem(Scene& scene, uint32_t index, Phase phase, float deltaTime)
     {
-        for (auto& system : m_Systems)
+        ISystem* system = m_Systems[index].get();
+        if (!system->IsEnabled())
+            return;
+
+        // Structural changes get played back in system order, no matter which thread ran what
+        SortKeyScope sortKey(scene.GetCommandBuffer(), CommandBuffer::SystemSortKey(index));
+
+        std::unordered_map<entt::id_type, size_t> storageSizes;
+        if (m_AccessChecks)
         {
-            system->OnLateUpdate(scene, deltaTime);
+            t_CheckedAccess = &m_Access[index];
+            t_CheckedSystem = &m_Timings[index].Name;
+            for (auto [id, storage] : scene.Reg().storage())
+                storageSizes[id] = storage.size();
+            for (auto hook : m_Access[index].m_UpdateHooks)
+                hook(scene.Reg(), true);
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        switch (phase)
+        {
+            case Phase::Update: system->OnUpdate(scene, deltaTime); break;
+            case Phase::FixedUpdate: system->OnFixedUpdate(scene, deltaTime); break;
+            case Phase::LateUpdate: system->OnLateUpdate(scene, deltaTime); break;
+        }
+        float time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        Timing& timing = m_Timings[index];
+        switch (phase)
+        {
+            case Phase::Update: timing.Update += time; break;
+            case Phase::FixedUpdate: timing.FixedUpdate += time; break;
+            case Phase::LateUpdate: timing.LateUpdate += time; break;
+        }
+
+        if (m_AccessChecks)
+        {
+            const SystemAccess& access = m_Access[index];
+            for (auto hook : access.m_UpdateHooks)
+                hook(scene.Reg(), false);
+            for (auto [id, storage] : scene.Reg().storage())
+            {
+                auto it = storageSizes.find(id);
+                size_t before = it != storageSizes.end() ? it->second : 0;
+                if (storage.size() != before && id != entt::type_hash<entt::entity>::value() && !access.IsExclusive() && !access.Writes(id))
+                    ReportAccess(timing.Name, id, storage.type().name(), "adds or removes");
+            }
+
+            t_CheckedAccess = nullptr;
+            t_CheckedSystem = nullptr;
         }
     }
 }
@@ -4,9 +4,21 @@
 
 namespace Lynx
 {
+    // Runs the game systems. The schedule is built from the declared access: systems go into waves in registration order
+    // (adjusted by their Before/After constraints), each wave holds systems that don't conflict and runs them in parallel.
     class SystemManager
     {
     public:
+        struct Timing
+        {
+            std::string Name;
+            uint32_t Wave = 0;
+            // Milliseconds this frame, fixed update summed over all steps
+            float Update = 0.0f;
+            float FixedUpdate = 0.0f;
+            float LateUpdate = 0.0f;
+        };
+
         template <typename T, typename... Args>
         T* AddSystem(Args&&... args)
         {
@@ -14,35 +26,32 @@ namespace Lynx
             auto system = std::make_unique<T>(std::forward<Args>(args)...);
             T* ptr = system.get();
             m_Systems.push_back(std::move(system));
+            m_SystemsByType[entt::type_hash<T>::value()] = ptr;
+            m_ScheduleDirty = true;
             return ptr;
         }
-        
+
         template <typename T>
         T* GetSystem()
         {
-            for (auto& sys : m_Systems)
-            {
-                if (auto* casted = dynamic_cast<T*>(sys.get()))
-                    return casted;
-            }
-            return nullptr;
+            auto it = m_SystemsByType.find(entt::type_hash<T>::value());
+            return it != m_SystemsByType.end() ? static_cast<T*>(it->second) : nullptr;
         }
-        
+
         template <typename T>
         bool RemoveSystem()
         {
-            auto it = std::find_if(m_Systems.begin(), m_Systems.end(), [](const auto& sys)
-            {
-                return dynamic_cast<T*>(sys.get()) != nullptr;
-            });
-            if (it != m_Systems.end())
-            {
-                m_Systems.erase(it);
-                return true;
-            }
-            return false;
+            auto it = m_SystemsByType.find(entt::type_hash<T>::value());
+            if (it == m_SystemsByType.end())
+                return false;
+
+            ISystem* system = it->second;
+            m_SystemsByType.erase(it);
+            std::erase_if(m_Systems, [system](const auto& sys) { return sys.get() == system; });
+            m_ScheduleDirty = true;
+            return true;
         }
-        
+
         void Init(Scene& scene);
         void Shutdown(Scene& scene);
         void SceneStart(Scene& scene);
@@ -50,11 +59,34 @@ namespace Lynx
         void Update(Scene& scene, float deltaTime);
         void FixedUpdate(Scene& scene, float fixedDeltaTime);
         void LateUpdate(Scene& scene, float deltaTime);
-        
+
+        // Runtime toggle, works in every build. Runs everything on the calling thread, one system after another, and warns
+        // about components a system views, adds/removes or patches without declaring them (patch/replace of Read ones).
+        // Only views through Scene and registry signals are seen, not raw registry access or writes through references.
+        void SetAccessChecks(bool enabled) { m_AccessChecks = enabled; }
+        bool GetAccessChecks() const { return m_AccessChecks; }
+
         const auto& GetSystems() { return m_Systems; }
-    
+        // Same order as GetSystems()
+        const std::vector<Timing>& GetTimings() const { return m_Timings; }
+
+    private:
+        enum class Phase { Update, FixedUpdate, LateUpdate };
+
+        void BuildSchedule(Scene& scene);
+        void Run(Scene& scene, Phase phase, float deltaTime);
+        void RunSystem(Scene& scene, uint32_t index, Phase phase, float deltaTime);
+
     private:
         std::vector<std::unique_ptr<ISystem>> m_Systems;
+        std::unordered_map<entt::id_type, ISystem*> m_SystemsByType;
+
+        std::vector<SystemAccess> m_Access;
+        // Indices into m_Systems, every wave only starts when the previous one is done
+        std::vector<std::vector<uint32_t>> m_Waves;
+        std::vector<Timing> m_Timings;
+        bool m_ScheduleDirty = true;
+        bool m_AccessChecks = false;
     };
 
 }
@@ -0,0 +1,186 @@
+#include "TransformHierarchy.h"
+
+#include <chrono>
+
+#include "Lynx/Engine.h"
+
+#include "Lynx/Scene/Components/Components.h"
+
+namespace Lynx
+{
+    void TransformHierarchy::Init(entt::registry& registry)
+    {
+        registry.on_construct<RelationshipComponent>().connect<&TransformHierarchy::OnRelationshipConstructed>(this);
+        registry.on_destroy<RelationshipComponent>().connect<&TransformHierarchy::OnRelationshipDestroyed>(this);
+    }
+
+    void TransformHierarchy::Shutdown(entt::registry& registry)
+    {
+        registry.on_construct<RelationshipComponent>().disconnect(this);
+        registry.on_destroy<RelationshipComponent>().disconnect(this);
+    }
+
+    void TransformHierarchy::OnRelationshipConstructed(entt::registry& registry, entt::entity entity)
+    {
+        if (m_Dirty)
+            return;
+
+        // A new root can go at the end, its position doesn't matter as long as nothing is attached to it
+        auto& rel = registry.get<RelationshipComponent>(entity);
+        if (rel.Parent != entt::null || rel.FirstChild != entt::null)
+        {
+            m_Dirty = true;
+            return;
+        }
+
+        rel.Depth = 0;
+        m_Nodes.push_back({ entity, InvalidIndex });
+    }
+
+    void TransformHierarchy::OnRelationshipDestroyed(entt::registry& registry, entt::entity entity)
+    {
+        if (m_Dirty)
+            return;
+
+        // Leaf roots just leave a dead node behind (skipped until the next rebuild), anything else changes the tree
+        const auto& rel = registry.get<RelationshipComponent>(entity);
+        if (rel.Parent != entt::null || rel.FirstChild != entt::null)
+            m_Dirty = true;
+        else
+            m_Removed++;
+    }
+
+    void TransformHierarchy::Rebuild(entt::registry& registry)
+    {
+        m_Nodes.clear();
+        m_Levels.clear();
+        m_Removed = 0;
+
+        auto& relationships = registry.storage<RelationshipComponent>();
+        auto& transforms = registry.storage<TransformComponent>();
+
+        for (auto [entity, rel] : relationships.each())
+        {
+            if (rel.Parent == entt::null && transforms.contains(entity))
+            {
+                rel.Depth = 0;
+                m_Nodes.push_back({ entity, InvalidIndex });
+            }
+        }
+
+        // Breadth first, so every depth ends up as one contiguous range
+        size_t levelBegin = 0;
+        while (levelBegin < m_Nodes.size())
+        {
+            m_Levels.push_back((uint32_t)levelBegin);
+            size_t levelEnd = m_Nodes.size();
+            for (size_t i = levelBegin; i < levelEnd; i++)
+            {
+                const auto& rel = relationships.get(m_Nodes[i].Entity);
+                uint32_t depth = rel.Depth + 1;
+                for (entt::entity child = rel.FirstChild; child != entt::null; child = relationships.get(child).NextSibling)
+                {
+                    relationships.get(child).Depth = depth;
+                    m_Nodes.push_back({ child, (uint32_t)i });
+                }
+            }
+            levelBegin = levelEnd;
+        }
+        m_Levels.push_back((uint32_t)m_Nodes.size());
+
+        m_Dirty = false;
+        m_Stats.Rebuilds++;
+    }
+
+    const std::vector<entt::entity>& TransformHierarchy::Update(entt::registry& registry)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        if (m_Removed > m_Nodes.size() / 4)
+            m_Dirty = true;
+        if (m_Dirty)
+            Rebuild(registry);
+
+        // Make sure the storage exists before the workers look it up
+        registry.storage<TransformComponent>();
+        m_Changed.assign(m_Nodes.size(), 0);
+        m_ChangedEntities.clear();
+
+        JobSystem& jobs = Engine::Get().GetJobSystem();
+        const size_t minNodesPerChunk = 1024;
+        size_t maxChunks = jobs.GetWorkerCount() + 1;
+        if (m_ChunkChanged.size() < maxChunks)
+            m_ChunkChanged.resize(maxChunks);
+
+        // Nodes of one depth only read their parent (one level up, already done), so each level can be split up.
+        // The last range holds the roots appended since the rebuild.
+        for (size_t level = 0; level < m_Levels.size(); level++)
+        {
+            size_t begin = m_Levels[level];
+            size_t end = level + 1 < m_Levels.size() ? m_Levels[level + 1] : m_Nodes.size();
+            size_t count = end - begin;
+            if (count == 0)
+                continue;
+
+            uint32_t chunkCount = jobs.GetChunkCount(count, minNodesPerChunk);
+            if (chunkCount == 1)
+            {
+                UpdateRange(registry, begin, end, m_ChangedEntities);
+                continue;
+            }
+
+            // Chunk 0 runs on this thread and can write the result directly
+            jobs.ParallelFor(count, minNodesPerChunk, [this, &registry, begin](size_t chunkBegin, size_t chunkEnd, uint32_t chunk)
+            {
+                auto& changed = chunk == 0 ? m_ChangedEntities : m_ChunkChanged[chunk];
+                if (chunk != 0)
+                    changed.clear();
+                UpdateRange(registry, begin + chunkBegin, begin + chunkEnd, changed);
+            });
+
+            for (size_t chunk = 1; chunk < chunkCount; chunk++)
+                m_ChangedEntities.insert(m_ChangedEntities.end(), m_ChunkChanged[chunk].begin(), m_ChunkChanged[chunk].end());
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        m_Stats.Nodes = (uint32_t)(m_Nodes.size() - m_Removed);
+        m_Stats.Depth = (uint32_t)m_Levels.size() - 1;
+        m_Stats.Updated = (uint32_t)m_ChangedEntities.size();
+        m_Stats.UpdateTime = std::chrono::duration<float, std::milli>(end - start).count();
+
+        return m_ChangedEntities;
+    }
+
+    void TransformHierarchy::UpdateRange(entt::registry& registry, size_t begin, size_t end, std::vector<entt::entity>& outChanged)
+    {
+        auto& transforms = registry.storage<TransformComponent>();
+        for (size_t i = begin; i < end; i++)
+        {
+            const Node& node = m_Nodes[i];
+            // Dead node, or the id got recycled (different version)
+            if (!transforms.contains(node.Entity))
+                continue;
+
+            auto& transform = transforms.get(node.Entity);
+            bool parentChanged = node.Parent != InvalidIndex && m_Changed[node.Parent];
+            if (!transform.LocalDirty && !transform.WorldDirty && !parentChanged)
+                continue;
+
+            if (transform.LocalDirty)
+                transform.LocalMatrix = transform.GetTransform();
+            transform.LocalDirty = false;
+            transform.WorldDirty = false;
+
+            glm::mat4 worldMatrix = transform.LocalMatrix;
+            if (node.Parent != InvalidIndex)
+                worldMatrix = transforms.get(m_Nodes[node.Parent].Entity).WorldMatrix * worldMatrix;
+
+            if (worldMatrix != transform.WorldMatrix)
+            {
+                transform.WorldMatrix = worldMatrix;
+                m_Changed[i] = 1;
+                outChanged.push_back(node.Entity);
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Lynx/Core.h"
+#include <entt/entt.hpp>
+
+namespace Lynx
+{
+    // Flat copy of the RelationshipComponent tree, parents always before their children and grouped by depth.
+    // World matrices get computed in one linear pass, every depth range runs in parallel.
+    // Reparenting only flags the order as stale, it gets rebuilt before the next pass.
+    class LX_API TransformHierarchy
+    {
+    public:
+        struct Stats
+        {
+            uint32_t Nodes = 0;
+            uint32_t Depth = 0;
+            uint32_t Updated = 0; // World matrices that changed last update
+            uint32_t Rebuilds = 0;
+            float UpdateTime = 0.0f; // ms
+        };
+
+        TransformHierarchy() = default;
+
+        void Init(entt::registry& registry);
+        void Shutdown(entt::registry& registry);
+
+        void MarkDirty() { m_Dirty = true; }
+
+        // Recomputes the world matrices below dirty transforms, returns the entities whose world matrix changed.
+        // Doesn't fire any signals, that's up to the caller.
+        const std::vector<entt::entity>& Update(entt::registry& registry);
+
+        const Stats& GetStats() const { return m_Stats; }
+
+    private:
+        struct Node
+        {
+            entt::entity Entity;
+            uint32_t Parent; // Index into m_Nodes, InvalidIndex for roots
+        };
+
+        static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        void Rebuild(entt::registry& registry);
+        void UpdateRange(entt::registry& registry, size_t begin, size_t end, std::vector<entt::entity>& outChanged);
+
+        void OnRelationshipConstructed(entt::registry& registry, entt::entity entity);
+        void OnRelationshipDestroyed(entt::registry& registry, entt::entity entity);
+
+    private:
+        std::vector<Node> m_Nodes;
+        // First node of every depth, the last entry ends the sorted part. Roots created after the rebuild get appended behind it.
+        std::vector<uint32_t> m_Levels;
+        // Per node, world matrix changed during the current pass
+        std::vector<uint8_t> m_Changed;
+        std::vector<std::vector<entt::entity>> m_ChunkChanged;
+        std::vector<entt::entity> m_ChangedEntities;
+
+        // Destroyed leaf roots, their nodes stay until the next rebuild
+        uint32_t m_Removed = 0;
+        bool m_Dirty = true;
+        Stats m_Stats;
+    };
+}
@@ -0,0 +1,336 @@
+#include "WorldPartition.h"
+
+#include <nlohmann/json.hpp>
+
+#include "Scene.h"
+#include "SceneSerializer.h"
+#include "Components/Components.h"
+#include "Lynx/Engine.h"
+
+namespace Lynx
+{
+    // Parsed cell file, filled on a background job and stitched in on the main thread
+    struct WorldPartition::PendingCell
+    {
+        std::atomic<bool> Done = false;
+        bool Failed = false;
+        nlohmann::json Entities;
+        size_t Next = 0; // Stitch progress
+        entt::entity Root = entt::null; // Subtree that's being stitched
+    };
+
+    static uint64_t PackCoord(const glm::ivec2& coord)
+    {
+        return ((uint64_t)(uint32_t)coord.x << 32) | (uint64_t)(uint32_t)coord.y;
+    }
+
+    static void ReadCell(const std::filesystem::path& path, WorldPartition::PendingCell& pending)
+    {
+        std::ifstream stream(path);
+        if (!stream.is_open())
+        {
+            LX_CORE_ERROR("WorldPartition: Could not open cell {}", path.string());
+            pending.Failed = true;
+            return;
+        }
+
+        try
+        {
+            nlohmann::json cellJson = nlohmann::json::parse(stream);
+            pending.Entities = std::move(cellJson["Entities"]);
+            pending.Failed = !pending.Entities.is_array();
+        }
+        catch (nlohmann::json::exception& e)
+        {
+            LX_CORE_ERROR("WorldPartition: Could not parse cell {}: {}", path.string(), e.what());
+            pending.Failed = true;
+        }
+    }
+
+    glm::ivec2 WorldPartition::GetCellCoord(const glm::vec3& position) const
+    {
+        return glm::ivec2(glm::floor(glm::vec2(position.x, position.z) / m_Settings.CellSize));
+    }
+
+    WorldPartition::Cell& WorldPartition::AddCell(const glm::ivec2& coord, const std::string& file)
+    {
+        Cell& cell = m_Cells[PackCoord(coord)];
+        cell.Coord = coord;
+        cell.File = file;
+        return cell;
+    }
+
+    WorldPartition::Cell* WorldPartition::FindCell(const glm::ivec2& coord)
+    {
+        auto it = m_Cells.find(PackCoord(coord));
+        return it != m_Cells.end() ? &it->second : nullptr;
+    }
+
+    void WorldPartition::LoadAll(Scene& scene)
+    {
+        for (auto& [key, cell] : m_Cells)
+        {
+            if (cell.State != CellState::Unloaded)
+                continue;
+
+            cell.Pending = std::make_shared<PendingCell>();
+            ReadCell(m_Directory / cell.File, *cell.Pending);
+            cell.State = CellState::Stitching;
+            Stitch(scene, cell, std::numeric_limits<uint32_t>::max());
+        }
+    }
+
+    void WorldPartition::Start(Scene& scene)
+    {
+        m_Running = true;
+        if (!m_Settings.Enabled)
+            return;
+
+        GatherSources(scene);
+        if (m_Sources.empty())
+            return;
+
+        // Nothing to hide the loading behind yet, read what's in range as regular jobs (this thread helps out while
+        // it waits) and stitch all of it before the first frame
+        auto& jobs = Engine::Get().GetJobSystem();
+        JobSystem::Counter counter;
+        for (auto& [key, cell] : m_Cells)
+        {
+            if (cell.State != CellState::Unloaded || GetDistance(cell) > m_Settings.LoadRadius)
+                continue;
+
+            auto pending = std::make_shared<PendingCell>();
+            cell.Pending = pending;
+            cell.State = CellState::Stitching;
+            std::filesystem::path path = m_Directory / cell.File;
+            jobs.Run([pending, path]() { ReadCell(path, *pending); }, &counter);
+        }
+        jobs.Wait(counter);
+
+        for (auto& [key, cell] : m_Cells)
+        {
+            if (cell.State == CellState::Stitching)
+                Stitch(scene, cell, std::numeric_limits<uint32_t>::max());
+        }
+    }
+
+    void WorldPartition::Stop()
+    {
+        m_Running = false;
+        m_Sources.clear();
+
+        // Running reads finish on their own, nobody looks at the result anymore
+        for (auto& [key, cell] : m_Cells)
+        {
+            if (cell.State == CellState::Reading || cell.State == CellState::Stitching)
+            {
+                cell.Pending.reset();
+                cell.State = cell.Roots.empty() ? CellState::Unloaded : CellState::Loaded;
+            }
+        }
+    }
+
+    void WorldPartition::Update(Scene& scene)
+    {
+        m_Stats.Stitched = 0;
+        if (!m_Running || !m_Settings.Enabled || m_Cells.empty())
+            return;
+
+        GatherSources(scene);
+
+        // Without a source we keep whatever is loaded
+        if (m_Sources.empty())
+            return;
+
+        uint32_t budget = std::max(m_Settings.EntitiesPerFrame, 1u);
+        m_Stats = { (uint32_t)m_Cells.size(), 0, 0, 0 };
+        for (auto& [key, cell] : m_Cells)
+        {
+            float distance = GetDistance(cell);
+            switch (cell.State)
+            {
+                case CellState::Unloaded:
+                    if (distance <= m_Settings.LoadRadius)
+                        BeginRead(cell);
+                    break;
+                case CellState::Reading:
+                    // Left the range before the file was even read, drop it
+                    if (distance > m_Settings.UnloadRadius)
+                    {
+                        cell.Pending.reset();
+                        cell.State = CellState::Unloaded;
+                    }
+                    else if (cell.Pending->Done.load(std::memory_order_acquire))
+                    {
+                        cell.State = CellState::Stitching;
+                    }
+                    break;
+                case CellState::Loaded:
+                    if (distance > m_Settings.UnloadRadius)
+                        cell.State = CellState::Unloading;
+                    break;
+                default:
+                    // Stitching finishes and unloading runs to the end, hysteresis takes care of the rest
+                    break;
+            }
+
+            if (cell.State == CellState::Stitching && budget > 0)
+            {
+                uint32_t stitched = Stitch(scene, cell, budget);
+                budget -= std::min(stitched, budget);
+                m_Stats.Stitched += stitched;
+            }
+            else if (cell.State == CellState::Unloading && budget > 0)
+            {
+                budget -= std::min(Unload(scene, cell, budget), budget);
+            }
+
+            if (cell.State == CellState::Loaded)
+                m_Stats.Loaded++;
+            else if (cell.State == CellState::Reading || cell.State == CellState::Stitching)
+                m_Stats.Loading++;
+        }
+    }
+
+    void WorldPartition::CopyFrom(const WorldPartition& other)
+    {
+        m_Settings = other.m_Settings;
+        m_Directory = other.m_Directory;
+        m_Cells.clear();
+        for (const auto& [key, cell] : other.m_Cells)
+        {
+            Cell& copy = m_Cells[key];
+            copy.Coord = cell.Coord;
+            copy.File = cell.File;
+            copy.Roots = cell.Roots;
+            copy.State = cell.State == CellState::Loaded ? CellState::Loaded : CellState::Unloaded;
+        }
+    }
+
+    void WorldPartition::GatherSources(Scene& scene)
+    {
+        auto& registry = scene.Reg();
+        m_Sources.clear();
+        for (auto [entity, transform] : registry.view<StreamingSourceComponent, TransformComponent>().each())
+            m_Sources.push_back(transform.GetWorldTranslation());
+
+        if (m_Sources.empty())
+        {
+            for (auto [entity, camera, transform] : registry.view<CameraComponent, TransformComponent>().each())
+            {
+                if (camera.Primary)
+                {
+                    m_Sources.push_back(transform.GetWorldTranslation());
+                    break;
+                }
+            }
+        }
+    }
+
+    float WorldPartition::GetDistance(const Cell& cell) const
+    {
+        glm::vec2 min = glm::vec2(cell.Coord) * m_Settings.CellSize;
+        glm::vec2 max = min + m_Settings.CellSize;
+
+        float closest = std::numeric_limits<float>::max();
+        for (const glm::vec3& source : m_Sources)
+        {
+            glm::vec2 point = { source.x, source.z };
+            closest = std::min(closest, glm::distance(point, glm::clamp(point, min, max)));
+        }
+        return closest;
+    }
+
+    void WorldPartition::BeginRead(Cell& cell)
+    {
+        auto pending = std::make_shared<PendingCell>();
+        cell.Pending = pending;
+        cell.State = CellState::Reading;
+
+        std::filesystem::path path = m_Directory / cell.File;
+        Engine::Get().GetJobSystem().RunBackground([pending, path]()
+        {
+            ReadCell(path, *pending);
+            pending->Done.store(true, std::memory_order_release);
+        });
+    }
+
+    uint32_t WorldPartition::Stitch(Scene& scene, Cell& cell, uint32_t budget)
+    {
+        PendingCell& pending = *cell.Pending;
+        if (pending.Failed)
+        {
+            // Don't try again every frame
+            cell.Pending.reset();
+            cell.State = CellState::Loaded;
+            return 0;
+        }
+
+        uint32_t created = 0;
+        const auto& entities = pending.Entities;
+        while (pending.Next < entities.size())
+        {
+            const auto& entityJson = entities[pending.Next];
+
+            // Parents come before their children, so the parent of everything but a root already exists
+            entt::entity parent = entt::null;
+            if (entityJson.contains("Relationship") && entityJson["Relationship"].contains("Parent"))
+                parent = scene.FindEntityByUUID(entityJson["Relationship"]["Parent"].get<uint64_t>());
+
+            // Only break between subtrees, a half loaded one would show its children at the wrong place
+            bool isRoot = parent == entt::null;
+            if (isRoot)
+            {
+                FinishSubtree(scene, pending);
+                if (created >= budget)
+                    break;
+            }
+
+            Entity entity = SceneSerializer::DeserializeEntity(&scene, entityJson);
+            if (isRoot)
+            {
+                cell.Roots.push_back(entity.GetUUID());
+                pending.Root = entity;
+            }
+            else
+            {
+                scene.AttachEntity(entity, parent);
+            }
+
+            pending.Next++;
+            created++;
+        }
+
+        if (pending.Next >= entities.size())
+        {
+            FinishSubtree(scene, pending);
+            cell.Pending.reset();
+            cell.State = CellState::Loaded;
+        }
+        return created;
+    }
+
+    uint32_t WorldPartition::Unload(Scene& scene, Cell& cell, uint32_t budget)
+    {
+        uint32_t destroyed = 0;
+        while (!cell.Roots.empty() && destroyed < budget)
+        {
+            // Anything that already got destroyed by the game just isn't found anymore
+            if (Entity root = scene.FindEntityByUUID(cell.Roots.back()))
+                scene.DestroyEntity(root, false);
+            cell.Roots.pop_back();
+            destroyed++;
+        }
+
+        if (cell.Roots.empty())
+            cell.State = CellState::Unloaded;
+        return destroyed;
+    }
+
+    void WorldPartition::FinishSubtree(Scene& scene, PendingCell& pending)
+    {
+        if (m_Running && pending.Root != entt::null)
+            scene.OnStreamedIn(pending.Root);
+        pending.Root = entt::null;
+    }
+}
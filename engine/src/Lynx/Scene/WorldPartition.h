@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Lynx/Core.h"
+#include "Lynx/UUID.h"
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <filesystem>
+
+namespace Lynx
+{
+    class Scene;
+
+    // Splits the streamed roots (StreamedComponent) of a scene into square cells on the XZ plane. Every cell gets saved
+    // into its own file next to the scene and is loaded/unloaded around the streaming sources at runtime: the file is
+    // read and parsed on a background job, the entities get stitched in at the start of a frame, a few subtrees per frame.
+    // Only scene roots stream, so a cell holds whole subtrees and never points at anything outside of itself.
+    class LX_API WorldPartition
+    {
+    public:
+        struct Settings
+        {
+            bool Enabled = false;
+            float CellSize = 64.0f;
+            // Cells closer than LoadRadius to a source get loaded, farther than UnloadRadius unloaded.
+            // The gap keeps cells from flickering while a source moves along a border.
+            float LoadRadius = 96.0f;
+            float UnloadRadius = 128.0f;
+            uint32_t EntitiesPerFrame = 256; // Stitched or destroyed per frame, whole subtrees only
+        };
+
+        struct Stats
+        {
+            uint32_t Cells = 0;
+            uint32_t Loaded = 0;
+            uint32_t Loading = 0; // Reading or stitching
+            uint32_t Stitched = 0; // Entities last frame
+        };
+
+        enum class CellState { Unloaded, Reading, Stitching, Loaded, Unloading };
+
+        struct PendingCell;
+
+        struct Cell
+        {
+            glm::ivec2 Coord = { 0, 0 };
+            std::string File; // Relative to the scene's directory
+            CellState State = CellState::Unloaded;
+            // Streamed roots that came from this cell, destroyed when it unloads
+            std::vector<UUID> Roots;
+            std::shared_ptr<PendingCell> Pending;
+        };
+
+        WorldPartition() = default;
+
+        Settings& GetSettings() { return m_Settings; }
+        const Settings& GetSettings() const { return m_Settings; }
+        const Stats& GetStats() const { return m_Stats; }
+
+        glm::ivec2 GetCellCoord(const glm::vec3& position) const;
+
+        // Scene file side, filled by the SceneSerializer
+        void SetDirectory(const std::filesystem::path& directory) { m_Directory = directory; }
+        const std::filesystem::path& GetDirectory() const { return m_Directory; }
+        Cell& AddCell(const glm::ivec2& coord, const std::string& file);
+        Cell* FindCell(const glm::ivec2& coord);
+        const std::unordered_map<uint64_t, Cell>& GetCells() const { return m_Cells; }
+        void ClearCells() { m_Cells.clear(); }
+
+        // Blocking, the editor works on the whole world
+        void LoadAll(Scene& scene);
+        // Runtime: Start loads everything around the sources right away (blocking), Update streams from there on
+        void Start(Scene& scene);
+        void Update(Scene& scene);
+        void Stop();
+
+        // Settings and cell states, for Scene::Copy. Loads that are still running stay with the source.
+        void CopyFrom(const WorldPartition& other);
+
+    private:
+        void GatherSources(Scene& scene);
+        float GetDistance(const Cell& cell) const;
+        void BeginRead(Cell& cell);
+        // Returns the number of entities created, stops after the first subtree that reaches the budget
+        uint32_t Stitch(Scene& scene, Cell& cell, uint32_t budget);
+        uint32_t Unload(Scene& scene, Cell& cell, uint32_t budget);
+        void FinishSubtree(Scene& scene, PendingCell& pending);
+
+    private:
+        Settings m_Settings;
+        Stats m_Stats;
+        std::filesystem::path m_Directory;
+        std::unordered_map<uint64_t, Cell> m_Cells;
+
+        std::vector<glm::vec3> m_Sources;
+        bool m_Running = false;
+    };
+}
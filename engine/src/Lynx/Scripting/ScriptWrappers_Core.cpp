@@ -13,6 +13,23 @@ namespace Lynx
 {
     namespace ScriptWrappers
     {
+        // What entity.MeshComponent hands out, writes need the entity to patch() so the render proxy notices
+        struct ScriptMeshComponent
+        {
+            Entity Owner;
+        };
+
+        static void SetMeshHandle(Entity entity, AssetHandle handle)
+        {
+            if (!entity || !entity.HasComponent<MeshComponent>())
+                return;
+
+            entity.GetScene()->Reg().patch<MeshComponent>((entt::entity)entity, [handle](MeshComponent& meshComp)
+            {
+                meshComp.Mesh = AssetRef<StaticMesh>(handle);
+            });
+        }
+
         void RegisterBasicTypes(sol::state& lua)
         {
             lua.new_usertype<UUID>("UUID",
@@ -37,27 +54,46 @@ namespace Lynx
                     }
                 ),
                 "MeshComponent", sol::property(
-                    [](Entity& entity) -> MeshComponent*
+                    [](Entity& entity) -> sol::optional<ScriptMeshComponent>
                     {
                         if (entity.HasComponent<MeshComponent>())
-                            return &entity.GetComponent<MeshComponent>();
-                        return nullptr;
+                            return ScriptMeshComponent{ entity };
+                        return sol::nullopt;
                     }
-                )
+                ),
+                "SetMesh", [](Entity& entity, AssetHandle handle) { SetMeshHandle(entity, handle); }
             );
 
+            // Copies out, assign the whole value back so the transform gets marked dirty
             lua.new_usertype<TransformComponent>("Transform",
-                "Translation", &TransformComponent::Translation,
-                "Scale", &TransformComponent::Scale,
+                "Translation", sol::property(
+                    [](TransformComponent& t) { return t.Translation; },
+                    [](TransformComponent& t, const glm::vec3& translation) { t.SetTranslation(translation); }
+                ),
+                "Scale", sol::property(
+                    [](TransformComponent& t) { return t.Scale; },
+                    [](TransformComponent& t, const glm::vec3& scale) { t.SetScale(scale); }
+                ),
                 "Rotation", sol::property(
                     [](TransformComponent& t) { return t.GetRotationDegrees(); },
                     [](TransformComponent& t, const glm::vec3& degrees) { t.SetRotionDegrees(degrees); }
                 ),
-                "RotationQuat", &TransformComponent::Rotation
+                "RotationQuat", sol::property(
+                    [](TransformComponent& t) { return t.Rotation; },
+                    [](TransformComponent& t, const glm::quat& rotation) { t.SetRotation(rotation); }
+                )
             );
 
-            lua.new_usertype<MeshComponent>("MeshComponent",
-                "MeshHandle", &MeshComponent::Mesh
+            lua.new_usertype<ScriptMeshComponent>("MeshComponent",
+                "MeshHandle", sol::property(
+                    [](ScriptMeshComponent& meshComp)
+                    {
+                        if (!meshComp.Owner || !meshComp.Owner.HasComponent<MeshComponent>())
+                            return AssetHandle::Null();
+                        return meshComp.Owner.GetComponent<MeshComponent>().Mesh.Handle;
+                    },
+                    [](ScriptMeshComponent& meshComp, AssetHandle handle) { SetMeshHandle(meshComp.Owner, handle); }
+                )
             );
             
             auto world = lua.create_named_table("World");
@@ -73,6 +109,37 @@ namespace Lynx
                 
                 return scene->InstantiatePrefab(AssetHandle(prefabID), parentEnt);
             });
+            world.set_function("FindEntityByName", [](const std::string& name) -> Entity
+            {
+                auto scene = Engine::Get().GetActiveScene();
+                if (!scene)
+                    return {};
+                
+                return scene->FindEntityByName(name);
+            });
+            // Plain Lua table, so ipairs and # work
+            world.set_function("FindEntitiesByName", [](const std::string& name)
+            {
+                std::vector<Entity> result;
+                if (auto scene = Engine::Get().GetActiveScene())
+                    result = scene->FindEntitiesByName(name);
+                
+                return sol::as_table(std::move(result));
+            });
+            world.set_function("FindEntityByUUID", [](uint64_t uuid) -> Entity
+            {
+                auto scene = Engine::Get().GetActiveScene();
+                if (!scene)
+                    return {};
+                
+                return scene->FindEntityByUUID(UUID(uuid));
+            });
+            // Deferred to the next sync point, like everything structural from scripts
+            world.set_function("Destroy", [](Entity entity, sol::optional<bool> excludeChildren)
+            {
+                if (auto scene = Engine::Get().GetActiveScene())
+                    scene->DestroyEntityDeferred(entity, excludeChildren.value_or(true));
+            });
         }
 
         void RegisterDebug(sol::state& lua)
@@ -83,6 +150,11 @@ namespace Lynx
                 DebugRenderer::DrawLine(start, end, color); 
             });
 
+            debug.set_function("DrawArrow", [](glm::vec3 start, glm::vec3 end, glm::vec4 color)
+            {
+                DebugRenderer::DrawArrow(start, end, color);
+            });
+
             debug.set_function("DrawBox", sol::overload(
                 [](glm::vec3 min, glm::vec3 max, glm::vec4 color) {
                     DebugRenderer::DrawBox(min, max, color);
@@ -13,24 +13,48 @@
 
 namespace Lynx
 {
+    namespace BinaryScene
+    {
+        class ColumnWriter;
+        class ColumnReader;
+    }
+
     using AddComponentFunc = std::function<void(entt::registry&, entt::entity)>;
+    // Default constructed components for a range of entities that don't have one yet, in one go
+    using InsertComponentFunc = std::function<void(entt::registry&, const entt::entity* first, const entt::entity* last)>;
     using HasComponentFunc = std::function<bool(entt::registry&, entt::entity)>;
     using RemoveComponentFunc = std::function<void(entt::registry&, entt::entity)>;
     using DrawComponentUIFunc = std::function<void(entt::registry&, entt::entity)>;
     using SerializeComponentFunc = std::function<void(entt::registry&, entt::entity, nlohmann::json&)>;
     using DeserializeComponentFunc = std::function<void(entt::registry&, entt::entity, const nlohmann::json&)>;
+    // Copies the whole pool from source to destination, both registries use the same entity ids
+    using CopyComponentFunc = std::function<void(entt::registry& source, entt::registry& destination)>;
+    // Copies the component of one source entity onto a range of destination entities (prefab instances)
+    using StampComponentFunc = std::function<void(entt::registry& source, entt::entity sourceEntity, entt::registry& destination,
+                                                  const entt::entity* first, const entt::entity* last)>;
+    // Binary scene columns, see SetColumnCodec
+    using WriteColumnFunc = std::function<void(entt::registry&, const entt::entity* first, const entt::entity* last, BinaryScene::ColumnWriter&)>;
+    using InsertColumnFunc = std::function<bool(entt::registry&, const entt::entity* first, const entt::entity* last, BinaryScene::ColumnReader&)>;
 
     struct ComponentInfo
     {
         std::string name;
+        entt::id_type TypeId; // Storage id in the registry
         AddComponentFunc add;
+        InsertComponentFunc insert;
         HasComponentFunc has;
         RemoveComponentFunc remove;
         DrawComponentUIFunc drawUI;
         SerializeComponentFunc serialize;
         DeserializeComponentFunc deserialize;
+        CopyComponentFunc copy;
+        StampComponentFunc stamp;
+        WriteColumnFunc writeColumn; // Optional, without one the component goes into binary scenes as json
+        InsertColumnFunc insertColumn;
         bool IsCore;
         bool InternalUseOnly;
+        bool CopyBySerialization = false; // Owns runtime state (Lua tables, UI trees) that a plain copy would share
+        bool KeepWhenPooled = false; // Stays on pooled entities instead of being stripped (physics bodies, script instances)
     };
 
     using ScriptBindFunc = std::function<void(NativeScriptComponent&)>;
@@ -125,6 +149,59 @@ namespace Lynx
             m_TypeToNameMap.clear();
         }
 
+        // Scene copies go through serialize/deserialize for this one instead of the copy constructor
+        void SetCopyBySerialization(const std::string& name)
+        {
+            auto it = m_RegisteredComponents.find(name);
+            if (it != m_RegisteredComponents.end())
+                it->second.CopyBySerialization = true;
+        }
+
+        // The EntityPool leaves this one on idle instances, so whatever it owns gets reused
+        void SetKeepWhenPooled(const std::string& name)
+        {
+            auto it = m_RegisteredComponents.find(name);
+            if (it != m_RegisteredComponents.end())
+                it->second.KeepWhenPooled = true;
+        }
+
+        // Binary scenes store this one as a packed column and insert the whole thing at once, instead of going through json.
+        // Read has to consume exactly what write wrote, change both together (and bump BinaryScene::Version).
+        template <typename T>
+        void SetColumnCodec(const std::string& name, void (*write)(const T&, BinaryScene::ColumnWriter&), bool (*read)(BinaryScene::ColumnReader&, T&))
+        {
+            auto it = m_RegisteredComponents.find(name);
+            if (it == m_RegisteredComponents.end())
+                return;
+
+            it->second.writeColumn = [write](entt::registry& registry, const entt::entity* first, const entt::entity* last, BinaryScene::ColumnWriter& writer)
+            {
+                for (; first != last; ++first)
+                {
+                    // Tags have no instances in their pool
+                    if constexpr (std::is_empty_v<T>)
+                        write(T{}, writer);
+                    else
+                        write(registry.get<T>(*first), writer);
+                }
+            };
+
+            it->second.insertColumn = [read](entt::registry& registry, const entt::entity* first, const entt::entity* last, BinaryScene::ColumnReader& reader)
+            {
+                std::vector<T> values((size_t)(last - first));
+                for (T& value : values)
+                {
+                    if (!read(reader, value))
+                        return false;
+                }
+                if constexpr (std::is_empty_v<T>)
+                    registry.insert<T>(first, last);
+                else
+                    registry.insert<T>(first, last, values.begin());
+                return true;
+            };
+        }
+
         const std::map<std::string, ComponentInfo>& GetRegisteredComponents() const
         {
             return m_RegisteredComponents;
@@ -151,6 +228,7 @@ namespace Lynx
         {
             ComponentInfo info;
             info.name = name;
+            info.TypeId = entt::type_hash<T>::value();
             info.InternalUseOnly = internalUseOnly;
 
             info.add = [](entt::registry& registry, entt::entity entity)
@@ -158,6 +236,11 @@ namespace Lynx
                 registry.emplace_or_replace<T>(entity);
             };
 
+            info.insert = [](entt::registry& registry, const entt::entity* first, const entt::entity* last)
+            {
+                registry.insert<T>(first, last);
+            };
+
             info.remove = [](entt::registry& registry, entt::entity entity)
             {
                 if (registry.all_of<T>(entity))
@@ -169,6 +252,29 @@ namespace Lynx
                 return registry.all_of<T>(entity);
             };
 
+            info.copy = [](entt::registry& source, entt::registry& destination)
+            {
+                if constexpr (std::is_empty_v<T>)
+                {
+                    for (auto entity : source.view<T>())
+                        destination.emplace_or_replace<T>(entity);
+                }
+                else
+                {
+                    for (auto [entity, component] : source.view<T>().each())
+                        destination.emplace_or_replace<T>(entity, component);
+                }
+            };
+
+            info.stamp = [](entt::registry& source, entt::entity sourceEntity, entt::registry& destination,
+                            const entt::entity* first, const entt::entity* last)
+            {
+                if constexpr (std::is_empty_v<T>)
+                    destination.insert<T>(first, last);
+                else
+                    destination.insert<T>(first, last, source.get<T>(sourceEntity));
+            };
+
             info.drawUI = uiFunc;
             info.serialize = serFunc;
             info.deserialize = deserFunc;
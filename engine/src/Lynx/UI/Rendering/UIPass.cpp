@@ -195,6 +195,10 @@ namespace Lynx
                 if (!tex || !tex->GetTextureHandle())
                     continue;
 
+                // No screen size info for UI quads, keep them sharp
+                if (ctx.Streamer)
+                    ctx.Streamer->RequestTexture(tex.get(), 0);
+
                 state.bindings = { GetBindingSet(ctx, tex.get()) };
                 ctx.CommandList->setGraphicsState(state);
 
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// SSE2 is always there on x64, everything else falls back to plain glm
+#if defined(_M_X64) || defined(__SSE2__)
+    #define LX_SIMD_SSE 1
+    #include <emmintrin.h>
+#endif
+
+namespace Lynx::SimdMath
+{
+#ifdef LX_SIMD_SSE
+    // Dot product broadcast into all lanes
+    inline __m128 Dot4(__m128 a, __m128 b)
+    {
+        __m128 mul = _mm_mul_ps(a, b);
+        __m128 sum = _mm_add_ps(mul, _mm_shuffle_ps(mul, mul, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    inline __m128 Lerp(__m128 a, __m128 b, __m128 t)
+    {
+        return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+    }
+
+    // Normalized lerp along the shortest path, good enough for neighbouring keys and blend weights
+    inline __m128 NLerpQuat(__m128 a, __m128 b, __m128 t)
+    {
+        __m128 sign = _mm_and_ps(_mm_cmplt_ps(Dot4(a, b), _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+        b = _mm_xor_ps(b, sign);
+
+        __m128 result = Lerp(a, b, t);
+        return _mm_div_ps(result, _mm_sqrt_ps(Dot4(result, result)));
+    }
+
+    inline void Lerp(const glm::vec4& a, const glm::vec4& b, float t, glm::vec4& out)
+    {
+        _mm_storeu_ps(&out.x, Lerp(_mm_loadu_ps(&a.x), _mm_loadu_ps(&b.x), _mm_set1_ps(t)));
+    }
+
+    // glm::quat is stored x, y, z, w
+    inline void NLerpQuat(const glm::quat& a, const glm::quat& b, float t, glm::quat& out)
+    {
+        _mm_storeu_ps(&out.x, NLerpQuat(_mm_loadu_ps(&a.x), _mm_loadu_ps(&b.x), _mm_set1_ps(t)));
+    }
+
+    // out = a * b, out may alias a or b
+    inline void MulMat4(const glm::mat4& a, const glm::mat4& b, glm::mat4& out)
+    {
+        __m128 a0 = _mm_loadu_ps(&a[0][0]);
+        __m128 a1 = _mm_loadu_ps(&a[1][0]);
+        __m128 a2 = _mm_loadu_ps(&a[2][0]);
+        __m128 a3 = _mm_loadu_ps(&a[3][0]);
+
+        __m128 columns[4];
+        for (int i = 0; i < 4; i++)
+        {
+            __m128 column = _mm_mul_ps(a0, _mm_set1_ps(b[i][0]));
+            column = _mm_add_ps(column, _mm_mul_ps(a1, _mm_set1_ps(b[i][1])));
+            column = _mm_add_ps(column, _mm_mul_ps(a2, _mm_set1_ps(b[i][2])));
+            column = _mm_add_ps(column, _mm_mul_ps(a3, _mm_set1_ps(b[i][3])));
+            columns[i] = column;
+        }
+
+        for (int i = 0; i < 4; i++)
+            _mm_storeu_ps(&out[i][0], columns[i]);
+    }
+#else
+    inline void Lerp(const glm::vec4& a, const glm::vec4& b, float t, glm::vec4& out)
+    {
+        out = a + (b - a) * t;
+    }
+
+    inline void NLerpQuat(const glm::quat& a, const glm::quat& b, float t, glm::quat& out)
+    {
+        glm::quat target = glm::dot(a, b) < 0.0f ? -b : b;
+        out = glm::normalize(glm::quat(
+            a.w + (target.w - a.w) * t,
+            a.x + (target.x - a.x) * t,
+            a.y + (target.y - a.y) * t,
+            a.z + (target.z - a.z) * t));
+    }
+
+    inline void MulMat4(const glm::mat4& a, const glm::mat4& b, glm::mat4& out)
+    {
+        out = a * b;
+    }
+#endif
+}
@@ -114,6 +114,13 @@ struct MagnetComponent
 
 struct DeadTag {};
 
+// SpatialComponent layers
+namespace SpatialLayers
+{
+    constexpr uint32_t Enemy = 1 << 0;
+    constexpr uint32_t Pickup = 1 << 1;
+}
+
 struct SpringArmComponent // TODO: Maybe move to engine?
 {
     float TargetArmLength = 15.0f;
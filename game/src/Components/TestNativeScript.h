@@ -14,6 +14,7 @@ public:
     {
         auto& transform = GetComponent<Lynx::TransformComponent>();
         transform.Translation.x += 5.0f * deltaTime;
+        transform.MarkDirty();
     }
 
     void OnDestroy() override
@@ -408,6 +408,8 @@ void MyGame::OnStart()
     
     scene->AddSystem<CharacterMovementSystem>();
     scene->AddSystem<EnemySystem>();
+    scene->AddSystem<PickupSystem>();
+    scene->AddSystem<DamageTextSystem>();
 }
 
 void MyGame::OnUpdate(float deltaTime)
@@ -424,7 +426,6 @@ void MyGame::OnUpdate(float deltaTime)
     // 2. Combat & Action
     WeaponSystem::Update(scene, deltaTime);
     ProjectileSystem::Update(scene, deltaTime);
-    PickupSystem::Update(scene, deltaTime);
 
     // 3. Rules & Logic
     HealthSystem::Update(scene);
@@ -436,7 +437,6 @@ void MyGame::OnUpdate(float deltaTime)
     // 5. Presentation (Visuals)
     CameraSystem::Update(scene, deltaTime);
     HUDSystem::Update(scene, deltaTime);
-    DamageTextSystem::Update(deltaTime, scene);
 }
 
 void MyGame::OnShutdown()
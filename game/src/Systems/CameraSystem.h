@@ -61,8 +61,8 @@ public:
             
             //float lerpSpeed = spring.LerpSpeed * dt;
             //transform.Translation = glm::lerp(transform.Translation, finalPos, glm::clamp(lerpSpeed, 0.0f, 1.0f));
-            transform.Translation = finalPos;
-            transform.Rotation = glm::quatLookAt(glm::normalize(lookAtTarget - transform.Translation), glm::vec3(0.0f, 1.0f, 0.0f));
+            transform.SetTranslation(finalPos);
+            transform.SetRotation(glm::quatLookAt(glm::normalize(lookAtTarget - transform.Translation), glm::vec3(0.0f, 1.0f, 0.0f)));
         }
     }
 };
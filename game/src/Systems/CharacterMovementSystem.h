@@ -8,6 +8,12 @@ class CharacterMovementSystem : public ISystem
 {
 public:
     std::string GetName() const override { return "CharacterMovementSystem"; }
+
+    void DeclareAccess(SystemAccess& access) const override
+    {
+        access.Read<TransformComponent, CameraComponent>()
+              .Write<CharacterControllerComponent, CharacterMovementComponent>();
+    }
     
     void OnUpdate(Scene& scene, float deltaTime) override
     {
@@ -14,9 +14,20 @@ struct FloatingText
     glm::vec3 Velocity = { 0.0f, 50.0f, 0.0f };
 };
 
-class DamageTextSystem
+// The texts and their pool are static, Spawn gets called from the game module outside of the system schedule
+class DamageTextSystem : public ISystem
 {
 public:
+    std::string GetName() const override { return "DamageTextSystem"; }
+
+    void DeclareAccess(SystemAccess& access) const override
+    {
+        // Moves, fades and returns its texts, which are children of the canvas. s_ActiveTexts is only shared
+        // with Spawn, which runs outside the schedule.
+        access.Write<UICanvasComponent>();
+    }
+    
+
     static void Init(std::shared_ptr<Scene> scene)
     {
         auto view = scene->View<UICanvasComponent>();
@@ -56,7 +67,7 @@ public:
         s_ActiveTexts.push_back({text, worldPos, 1.0f, 1.0f});
     }
     
-    static void Update(float dt, std::shared_ptr<Scene> scene)
+    void OnUpdate(Scene& scene, float dt) override
     {
         if (s_ActiveTexts.empty())
             return;
@@ -10,6 +10,13 @@ class EnemySystem : public ISystem
 public:
     std::string GetName() const override { return "EnemySystem"; }
 
+    void DeclareAccess(SystemAccess& access) const override
+    {
+        // Activating bodies goes through Jolt's locking body interface
+        access.Read<PlayerComponent, EnemyComponent, RigidBodyComponent>()
+              .Write<TransformComponent>();
+    }
+
     void OnFixedUpdate(Scene& scene, float fixedDeltaTime) override
     {
         // --- AI / Movement Logic
@@ -35,11 +42,11 @@ public:
                 direction = glm::normalize(direction);
 
                 float targetAngle = atan2(direction.x, direction.z);
-                transform.Rotation = glm::angleAxis(targetAngle, glm::vec3(0, 1, 0));
+                transform.SetRotation(glm::angleAxis(targetAngle, glm::vec3(0, 1, 0)));
 
                 // For Kinematic bodies, we MUST update the transform.Translation.
                 // The PhysicsSystem will then sync this to the physics body.
-                transform.Translation += direction * enemy.MoveSpeed * fixedDeltaTime;
+                transform.SetTranslation(transform.Translation + direction * enemy.MoveSpeed * fixedDeltaTime);
                 
                 // Optional: We can still update physics rotation directly for better responsiveness 
                 // but SyncTransformsToPhysics will do it anyway.
@@ -15,6 +15,9 @@ public:
             if (health.CurrentHealth <= 0.0f)
             {
                 scene->Reg().emplace<DeadTag>(entity);
+                // Weapons and projectiles already ran this frame. It leaves the spatial index at the next sync point
+                // (fixed or late update), so next frame nobody targets or hits it anymore.
+                scene->GetCommandBuffer().Remove<SpatialComponent>(entity);
             }
         }
     }
@@ -23,10 +23,16 @@ public:
             }
         }
         
+        // Enemies come from the wave pools, everything else that died just goes away.
+        // Both deferred, so the view stays intact while we walk it.
+        auto& commands = scene->GetCommandBuffer();
         auto deadView = reg.view<DeadTag>();
         for (auto entity : deadView)
         {
-            scene->DestroyEntity(entity);
+            if (reg.all_of<EnemyComponent>(entity))
+                commands.ReleaseToPool(entity);
+            else
+                commands.Destroy(entity);
         }
     }
 };
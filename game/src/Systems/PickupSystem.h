@@ -2,63 +2,93 @@
 #include "Lynx.h"
 #include "Components/GameComponents.h"
 
-class PickupSystem
+class PickupSystem : public ISystem
 {
 public:
+    std::string GetName() const override { return "PickupSystem"; }
+
+    void DeclareAccess(SystemAccess& access) const override
+    {
+        // Collected pickups go back to the pool through the command buffer
+        access.Read<MagnetComponent, CharacterStatsComponent>()
+              .Write<TransformComponent, PickupComponent, ExperienceComponent, HealthComponent>();
+    }
+    
+
     // TODO: Shouldnt this be events? I mean this could listen to a enemy dead event or so...
     static void SpawnPickup(std::shared_ptr<Scene> scene, std::shared_ptr<Prefab> prefab, glm::vec3 position, float amount)
     {
-        auto entity = scene->InstantiatePrefab(prefab);
+        auto entity = scene->SpawnPooled(prefab);
         
         auto& transform = entity.GetComponent<TransformComponent>();
-        transform.Translation = position;
+        transform.SetTranslation(position);
         // TODO: multiply scale by the amount! So more XP->Bigger Orb
         
         auto& pickup = entity.GetComponent<PickupComponent>();
         pickup.Value = amount;
+        
+        // Collected by distance to the center, the radius only matters for the magnet
+        entity.AddOrReplaceComponent<SpatialComponent>(SpatialLayers::Pickup, 0.0f);
     }
     
-    static void Update(std::shared_ptr<Scene> scene, float deltaTime)
+    void OnUpdate(Scene& scene, float deltaTime) override
     {
-        auto& reg = scene->Reg();
+        auto& reg = scene.Reg();
+        auto& spatial = *scene.GetSpatialIndex();
         
-        auto playerView = reg.view<TransformComponent, MagnetComponent, ExperienceComponent, HealthComponent, CharacterStatsComponent>();
-        auto pickupView = reg.view<TransformComponent, PickupComponent>();
+        auto playerView = scene.View<TransformComponent, MagnetComponent, ExperienceComponent, HealthComponent, CharacterStatsComponent>();
+        auto pickupView = scene.View<TransformComponent, PickupComponent>();
+        std::vector<entt::entity> nearby;
         
         for (auto playerEntity : playerView)
         {
             auto [pTrans, magnet, xpComp, hpComp, stats] = playerView.get(playerEntity);
             glm::vec3 pPos = pTrans.GetWorldTranslation();
             
-            for (auto pickupEntity : pickupView)
+            // Everything that gets into the magnet radius starts flying towards this player
+            spatial.QueryRadius(pPos, stats.MagnetRadius, SpatialLayers::Pickup, nearby);
+            for (auto pickupEntity : nearby)
             {
-                auto [pickupTrans, pickup] = pickupView.get(pickupEntity);
-                
-                glm::vec3 pickupPos = pickupTrans.GetWorldTranslation();
-                float distSq = glm::distance2(pPos, pickupPos);
-                if (pickup.Magnetic && ((pickup.IsMagnetized && pickup.MagentizedBy == playerEntity) || (!pickup.IsMagnetized && distSq < (stats.MagnetRadius * stats.MagnetRadius))))
+                auto& pickup = reg.get<PickupComponent>(pickupEntity);
+                if (pickup.Magnetic && !pickup.IsMagnetized)
                 {
                     pickup.IsMagnetized = true;
                     pickup.MagentizedBy = playerEntity;
-                    glm::vec3 dir = glm::normalize(pPos - pickupPos);
-                    pickupTrans.Translation += dir * magnet.Strength * deltaTime;
                 }
-                
-                if (distSq < 1.0f)
+            }
+            
+            spatial.QueryRadius(pPos, 1.0f, SpatialLayers::Pickup, nearby);
+            for (auto pickupEntity : nearby)
+            {
+                auto& pickup = reg.get<PickupComponent>(pickupEntity);
+                switch (pickup.Type)
                 {
-                    switch (pickup.Type)
-                    {
-                        case PickupType::XP:
-                            xpComp.CurrentXP += pickup.Value;
-                            break;
-                        case PickupType::Health:
-                            hpComp.CurrentHealth = glm::min(hpComp.CurrentHealth + pickup.Value, hpComp.MaxHealth);
-                            break;
-                    }
-                        
-                    scene->DestroyEntityDeferred(pickupEntity);
+                    case PickupType::XP:
+                        xpComp.CurrentXP += pickup.Value;
+                        break;
+                    case PickupType::Health:
+                        hpComp.CurrentHealth = glm::min(hpComp.CurrentHealth + pickup.Value, hpComp.MaxHealth);
+                        break;
                 }
+                    
+                scene.ReleaseToPool({ pickupEntity, &scene });
             }
         }
+        
+        // Only the magnetized ones move
+        for (auto pickupEntity : pickupView)
+        {
+            auto [pickupTrans, pickup] = pickupView.get(pickupEntity);
+            if (!pickup.IsMagnetized || !reg.valid(pickup.MagentizedBy))
+                continue;
+            
+            auto* magnet = reg.try_get<MagnetComponent>(pickup.MagentizedBy);
+            if (!magnet)
+                continue;
+            
+            glm::vec3 pPos = reg.get<TransformComponent>(pickup.MagentizedBy).GetWorldTranslation();
+            glm::vec3 dir = glm::normalize(pPos - pickupTrans.GetWorldTranslation());
+            pickupTrans.SetTranslation(pickupTrans.Translation + dir * magnet->Strength * deltaTime);
+        }
     }
 };
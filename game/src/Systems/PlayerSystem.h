@@ -53,7 +53,7 @@ public:
                 targetHorizontalVel = moveInput * stats.MoveSpeed;
                 
                 float targetAngle = atan2(targetHorizontalVel.x, targetHorizontalVel.z);
-                transform.Rotation = glm::angleAxis(targetAngle, glm::vec3(0.0f, 1.0f, 0.0f));
+                transform.SetRotation(glm::angleAxis(targetAngle, glm::vec3(0.0f, 1.0f, 0.0f)));
             }
             
             glm::vec3 currentPhysicsVel = controller.Velocity;
@@ -9,41 +9,38 @@ class ProjectileSystem
 public:
     static void Update(std::shared_ptr<Scene> scene, float dt)
     {
-        auto bulletView = scene->Reg().view<TransformComponent, ProjectileComponent>();
+        auto& reg = scene->Reg();
+        auto& spatial = *scene->GetSpatialIndex();
+        auto bulletView = reg.view<TransformComponent, ProjectileComponent>();
+        std::vector<entt::entity> targets;
 
         for (auto entity : bulletView)
         {
             auto [transform, projectile] = bulletView.get<TransformComponent, ProjectileComponent>(entity);
 
-            transform.Translation += projectile.Velocity * dt;
+            transform.SetTranslation(transform.Translation + projectile.Velocity * dt);
             projectile.Lifetime -= dt;
             if (projectile.Lifetime <= 0.0f)
             {
-                scene->DestroyEntityDeferred(entity);
+                scene->ReleaseToPool({ entity, scene.get() });
                 continue;
             }
 
-            auto targetView = scene->Reg().view<TransformComponent, EnemyComponent, HealthComponent>(entt::exclude<DeadTag>);
-            for (auto targetEntity : targetView)
+            // Enemies are spheres in the index, so this already includes their radius
+            spatial.QueryRadius(transform.Translation, projectile.Radius, SpatialLayers::Enemy, targets);
+            for (auto targetEntity : targets)
             {
-                auto& targetTransform = targetView.get<TransformComponent>(targetEntity);
-                glm::vec3 targetPosition = targetTransform.GetWorldTranslation();
+                auto* targetHealth = reg.try_get<HealthComponent>(targetEntity);
+                if (!targetHealth)
+                    continue;
 
-                float distSq = glm::distance2(transform.Translation, targetPosition);
-                float hitRadius = 0.5f + projectile.Radius;
+                auto& targetTransform = reg.get<TransformComponent>(targetEntity);
+                targetHealth->CurrentHealth -= projectile.Damage;
 
-                if (distSq < (hitRadius * hitRadius))
-                {
-                    auto& enemy = targetView.get<EnemyComponent>(targetEntity);
-                    auto& targetHealth = targetView.get<HealthComponent>(targetEntity);
-                    
-                    targetHealth.CurrentHealth -= projectile.Damage;
+                DamageTextSystem::Spawn(targetTransform.Translation, (int)(projectile.Damage));
 
-                    DamageTextSystem::Spawn(targetTransform.Translation, (int)(projectile.Damage));
-
-                    scene->DestroyEntityDeferred(entity);
-                    break;
-                }
+                scene->ReleaseToPool({ entity, scene.get() });
+                break;
             }
         }
     }
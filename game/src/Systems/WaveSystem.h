@@ -56,24 +56,22 @@ public:
                 float& timer = mgr.WaveSpawnTimers[i];
                 timer += deltaTime;
                 
-                if (timer >= wave.SpawnInterval)
+                // Catch up on everything that was due, a long frame spawns them in one batch
+                uint32_t count = (uint32_t)(timer / wave.SpawnInterval);
+                if (count > 0)
                 {
-                    SpawnEnemy(scene, wave.EnemyPrefab);
-                    timer = 0.0f;
+                    SpawnEnemies(scene, wave.EnemyPrefab, count);
+                    timer -= count * wave.SpawnInterval;
                 }
             }
         }
     }
     
-    static void SpawnEnemy(std::shared_ptr<Scene> scene, std::shared_ptr<Prefab> prefab)
+    static void SpawnEnemies(std::shared_ptr<Scene> scene, std::shared_ptr<Prefab> prefab, uint32_t count)
     {
         if (!prefab || !prefab->GetHandle().IsValid())
             return;
         
-        float angle = (float)rand() / RAND_MAX * 6.28f;
-        float radius = 20.0f;
-        glm::vec3 offset = { cos(angle) * radius, 0.0f, sin(angle) * radius };
-        
         // TODO: dont query player every frame...
         glm::vec3 center = { 0, 0, 0 };
         auto playerView = scene->Reg().view<PlayerComponent, TransformComponent>();
@@ -84,13 +82,16 @@ public:
             break;
         }
         
-        glm::vec3 spawnPos = center + offset;
-        spawnPos.y = 1.0f;
-        
-        auto enemy = scene->InstantiatePrefab(prefab);
-        if (enemy)
+        for (auto enemy : scene->SpawnPooledBatch(prefab, count))
         {
-            enemy.GetComponent<TransformComponent>().Translation = spawnPos;
+            float angle = (float)rand() / RAND_MAX * 6.28f;
+            float radius = 20.0f;
+            glm::vec3 offset = { cos(angle) * radius, 0.0f, sin(angle) * radius };
+            
+            glm::vec3 spawnPos = center + offset;
+            spawnPos.y = 1.0f;
+            enemy.GetComponent<TransformComponent>().SetTranslation(spawnPos);
+            enemy.AddOrReplaceComponent<SpatialComponent>(SpatialLayers::Enemy, 0.5f);
         }
     }
 };
\ No newline at end of file
@@ -23,26 +23,10 @@ public:
                 continue;
             }
 
-            entt::entity target = entt::null;
-            float closestDistSq = weapon.Range * weapon.Range;
-            glm::vec3 targetPos = { 0, 0, 0 };
-
-            auto targetView = scene->Reg().view<TransformComponent, EnemyComponent>();
-            for (auto targetEntity: targetView)
-            {
-                auto& targetTransform = targetView.get<TransformComponent>(targetEntity);
-                float distSq = glm::distance2(sourceTransform.Translation, targetTransform.Translation);
-
-                if (distSq < closestDistSq)
-                {
-                    closestDistSq = distSq;
-                    target = targetEntity;
-                    targetPos = targetTransform.Translation;
-                }
-            }
-
+            entt::entity target = scene->GetSpatialIndex()->FindNearest(sourceTransform.GetWorldTranslation(), weapon.Range, SpatialLayers::Enemy);
             if (target != entt::null)
             {
+                glm::vec3 targetPos = scene->Reg().get<TransformComponent>(target).Translation;
                 SpawnProjectile(scene, entity, assetManager, sourceTransform.Translation, targetPos, weapon);
                 weapon.CooldownTimer = weapon.FireRate;
             }
@@ -54,12 +38,12 @@ private:
     {
         if (weapon.ProjectilePrefab)
         {
-            auto bullet = scene->InstantiatePrefab(weapon.ProjectilePrefab.Get());
+            auto bullet = scene->SpawnPooled(weapon.ProjectilePrefab.Get());
             
             glm::vec3 direction = glm::normalize(target - start);
             auto& transform = bullet.GetComponent<TransformComponent>();
-            transform.Translation = start + glm::vec3(0, 0.5f, 0);
-            transform.Scale = { 0.2f, 0.2f, 0.2f };
+            transform.SetTranslation(start + glm::vec3(0, 0.5f, 0));
+            transform.SetScale({ 0.2f, 0.2f, 0.2f });
             
             if (!bullet.HasComponent<ProjectileComponent>())
                 bullet.AddComponent<ProjectileComponent>();
@@ -0,0 +1,85 @@
+#include "Benchmark.h"
+
+#include <Lynx/Animation/AnimationClip.h>
+
+#include <cmath>
+
+using namespace Lynx;
+
+namespace
+{
+    constexpr size_t JointCount = 64;
+    constexpr float Duration = 10.0f;
+    constexpr int Characters = 1000;
+
+    // Smooth motion on every joint, noisy enough that curve reduction can't drop most of the keys
+    AnimationClip CreateClip()
+    {
+        AnimationCompressionSettings settings;
+        uint32_t frameCount = (uint32_t)std::ceil(Duration * settings.SampleRate) + 1;
+
+        std::vector<RawJointTrack> tracks(JointCount);
+        for (size_t j = 0; j < JointCount; j++)
+        {
+            for (uint32_t f = 0; f < frameCount; f++)
+            {
+                float t = (float)f / settings.SampleRate;
+                float phase = t * (1.0f + j * 0.37f);
+                tracks[j].Translations.push_back(glm::vec3(std::sin(phase), std::cos(phase * 0.5f), 0.1f * j));
+                tracks[j].Rotations.push_back(glm::angleAxis(std::sin(phase) * 1.5f, glm::normalize(glm::vec3(1.0f, j % 3, 0.5f))));
+                tracks[j].Scales.push_back(glm::vec3(1.0f));
+            }
+        }
+
+        AnimationClip clip;
+        clip.Compress("Benchmark", Duration, tracks, settings);
+        return clip;
+    }
+}
+
+LX_BENCHMARK(AnimationSample)
+{
+    AnimationClip clip = CreateClip();
+    std::printf("  %zu joints, %zu KB raw -> %zu KB compressed\n", JointCount, clip.GetRawSize() / 1024, clip.GetCompressedSize() / 1024);
+
+    // A crowd, every character at a different time so nothing stays in cache between samples
+    std::vector<JointTransform> pose(JointCount);
+    float time = 0.0f;
+    Benchmarking::Measure("Sample x1000 characters", 100, [&]
+    {
+        for (int c = 0; c < Characters; c++)
+        {
+            time = std::fmod(time + 0.137f, Duration);
+            clip.Sample(time, pose.data(), JointCount);
+        }
+        Benchmarking::DoNotOptimize(pose);
+    });
+}
+
+LX_BENCHMARK(AnimationPalette)
+{
+    Skeleton skeleton;
+    for (size_t j = 0; j < JointCount; j++)
+    {
+        skeleton.Parents.push_back(j == 0 ? -1 : (int)(j - 1) / 2);
+        skeleton.InverseBindMatrices.push_back(glm::mat4(1.0f));
+        skeleton.BindPose.emplace_back();
+    }
+    skeleton.RootTransforms.push_back(glm::mat4(1.0f));
+
+    AnimationClip clip = CreateClip();
+    std::vector<JointTransform> pose(JointCount);
+    std::vector<glm::mat4> model(JointCount);
+    std::vector<glm::mat4> palette(JointCount);
+    clip.Sample(1.0f, pose.data(), JointCount);
+
+    Benchmarking::Measure("LocalToModel + palette x1000", 100, [&]
+    {
+        for (int c = 0; c < Characters; c++)
+        {
+            PoseUtils::LocalToModel(skeleton, pose.data(), model.data());
+            PoseUtils::BuildSkinningPalette(skeleton, model.data(), palette.data());
+        }
+        Benchmarking::DoNotOptimize(palette);
+    });
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+// Same idea as Testing.h. LX_BENCHMARK registers a function, Measure times one piece of it and prints the result.
+namespace Lynx::Benchmarking
+{
+    struct BenchmarkCase
+    {
+        const char* Name;
+        void (*Func)();
+    };
+
+    inline std::vector<BenchmarkCase>& GetBenchmarks()
+    {
+        static std::vector<BenchmarkCase> s_Benchmarks;
+        return s_Benchmarks;
+    }
+
+    struct BenchmarkRegistrar
+    {
+        BenchmarkRegistrar(const char* name, void (*func)()) { GetBenchmarks().push_back({ name, func }); }
+    };
+
+    // Peak working set of the whole process so far, in bytes
+    inline size_t GetPeakMemory()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters = {};
+        GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+        return counters.PeakWorkingSetSize;
+#elif defined(__APPLE__)
+        rusage usage = {};
+        getrusage(RUSAGE_SELF, &usage);
+        return (size_t)usage.ru_maxrss;
+#else
+        rusage usage = {};
+        getrusage(RUSAGE_SELF, &usage);
+        return (size_t)usage.ru_maxrss * 1024;
+#endif
+    }
+
+    // Runs func iterations times and prints the average, returns it in milliseconds
+    template<typename Func>
+    double Measure(const char* label, int iterations, Func&& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+            func();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        double average = elapsed.count() / iterations;
+        std::printf("  %-40s %10.3f ms  (%d runs, peak %zu MB)\n", label, average, iterations, GetPeakMemory() / (1024 * 1024));
+        return average;
+    }
+
+    inline const void* volatile s_Sink = nullptr;
+
+    // Keeps the optimizer from dropping a result nobody reads
+    template<typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+        s_Sink = &value;
+    }
+}
+
+#define LX_BENCHMARK(name) \
+    static void name(); \
+    static ::Lynx::Benchmarking::BenchmarkRegistrar name##_Registrar(#name, &name); \
+    static void name()
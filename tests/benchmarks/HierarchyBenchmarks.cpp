@@ -0,0 +1,100 @@
+#include "Benchmark.h"
+
+#include <Lynx/Scene/Scene.h>
+#include <Lynx/Scene/Entity.h>
+#include <Lynx/Scene/Components/Components.h>
+
+using namespace Lynx;
+
+namespace
+{
+    constexpr uint32_t NodeCount = 100000;
+
+    // chains * length nodes, every chain hanging off its own root. One chain of NodeCount is the deep case, a root with NodeCount - 1 children the wide one.
+    struct HierarchyScene
+    {
+        std::shared_ptr<Scene> SceneRef;
+        std::vector<entt::entity> Roots;
+        std::vector<entt::entity> Nodes;
+    };
+
+    HierarchyScene CreateHierarchy(uint32_t roots, bool deep)
+    {
+        HierarchyScene result;
+        result.SceneRef = std::make_shared<Scene>();
+        Scene& scene = *result.SceneRef;
+        result.Nodes.reserve(NodeCount);
+
+        uint32_t perRoot = NodeCount / roots;
+        for (uint32_t r = 0; r < roots; r++)
+        {
+            entt::entity parent = scene.CreateEntity("Root");
+            result.Roots.push_back(parent);
+            result.Nodes.push_back(parent);
+            for (uint32_t i = 1; i < perRoot; i++)
+            {
+                entt::entity node = scene.CreateEntity("Node");
+                scene.Reg().get<TransformComponent>(node).SetTranslation({ 0.0f, 1.0f, 0.0f });
+                scene.AttachEntity(node, deep ? parent : result.Roots.back());
+                result.Nodes.push_back(node);
+                parent = node;
+            }
+        }
+        return result;
+    }
+
+    void RunHierarchy(const char* name, uint32_t roots, bool deep)
+    {
+        std::printf(" %s\n", name);
+
+        HierarchyScene hierarchy;
+        Benchmarking::Measure("Create + attach", 1, [&] { hierarchy = CreateHierarchy(roots, deep); });
+
+        Scene& scene = *hierarchy.SceneRef;
+        auto& registry = scene.Reg();
+        TransformHierarchy& transforms = *scene.GetTransformHierarchy();
+
+        Benchmarking::Measure("Rebuild + first update", 1, [&] { transforms.Update(registry); });
+        std::printf("  %u nodes, depth %u\n", transforms.GetStats().Nodes, transforms.GetStats().Depth);
+
+        float offset = 0.0f;
+        Benchmarking::Measure("Move roots (every node changes)", 20, [&]
+        {
+            offset += 1.0f;
+            for (entt::entity root : hierarchy.Roots)
+                registry.get<TransformComponent>(root).SetTranslation({ offset, 0.0f, 0.0f });
+            transforms.Update(registry);
+        });
+
+        Benchmarking::Measure("Move 1% of the nodes", 20, [&]
+        {
+            offset += 1.0f;
+            for (size_t i = 0; i < hierarchy.Nodes.size(); i += 100)
+                registry.get<TransformComponent>(hierarchy.Nodes[i]).SetScale(glm::vec3(1.0f + offset * 0.001f));
+            transforms.Update(registry);
+        });
+
+        Benchmarking::Measure("Nothing dirty", 20, [&] { transforms.Update(registry); });
+
+        // Reparenting only flags the order as stale, the next update pays for the rebuild
+        Benchmarking::Measure("Reparent one node + update", 20, [&]
+        {
+            entt::entity node = hierarchy.Nodes[hierarchy.Nodes.size() / 2];
+            scene.DetachEntity(node);
+            scene.AttachEntity(node, hierarchy.Roots[0]);
+            transforms.Update(registry);
+        });
+    }
+}
+
+LX_BENCHMARK(HierarchyDeep)
+{
+    RunHierarchy("One chain, 100k deep", 1, true);
+    RunHierarchy("100 chains, 1000 deep", 100, true);
+}
+
+LX_BENCHMARK(HierarchyWide)
+{
+    RunHierarchy("One root, 100k children", 1, false);
+    RunHierarchy("1000 roots, 100 children each", 1000, false);
+}
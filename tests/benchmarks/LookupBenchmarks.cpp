@@ -0,0 +1,89 @@
+#include "Benchmark.h"
+
+#include <Lynx/Scene/Scene.h>
+#include <Lynx/Scene/Entity.h>
+#include <Lynx/Scene/Components/Components.h>
+
+#include <string>
+
+using namespace Lynx;
+
+namespace
+{
+    constexpr int Lookups = 100000;
+
+    // Unique names plus every 10th entity in a shared "Enemy" group
+    std::shared_ptr<Scene> CreateScene(uint32_t entityCount, std::vector<UUID>& outIDs, std::vector<std::string>& outNames)
+    {
+        auto scene = std::make_shared<Scene>();
+        for (uint32_t i = 0; i < entityCount; i++)
+        {
+            std::string name = i % 10 == 0 ? "Enemy" : "Entity " + std::to_string(i);
+            Entity entity = scene->CreateEntity(name);
+            outIDs.push_back(entity.GetUUID());
+            if (i % 10 != 0)
+                outNames.push_back(name);
+        }
+        return scene;
+    }
+}
+
+// Lookup cost shouldn't move with the scene size, the linear scan (what FindEntityByName used to do) is there for comparison
+LX_BENCHMARK(EntityLookup)
+{
+    for (uint32_t entityCount : { 1000u, 10000u, 100000u })
+    {
+        std::printf(" %u entities\n", entityCount);
+
+        std::vector<UUID> ids;
+        std::vector<std::string> names;
+        auto scene = CreateScene(entityCount, ids, names);
+
+        // Strided so consecutive lookups don't hit neighbouring slots
+        size_t cursor = 0;
+        auto next = [&cursor](size_t size) { cursor = (cursor + 7919) % size; return cursor; };
+
+        Benchmarking::Measure("FindEntityByUUID x100k", 10, [&]
+        {
+            uint32_t found = 0;
+            for (int i = 0; i < Lookups; i++)
+                found += (bool)scene->FindEntityByUUID(ids[next(ids.size())]);
+            Benchmarking::DoNotOptimize(found);
+        });
+
+        Benchmarking::Measure("FindEntityByName x100k", 10, [&]
+        {
+            uint32_t found = 0;
+            for (int i = 0; i < Lookups; i++)
+                found += (bool)scene->FindEntityByName(names[next(names.size())]);
+            Benchmarking::DoNotOptimize(found);
+        });
+
+        Benchmarking::Measure("FindEntitiesByName group x1k", 10, [&]
+        {
+            size_t found = 0;
+            for (int i = 0; i < 1000; i++)
+                found += scene->FindEntitiesByName("Enemy").size();
+            Benchmarking::DoNotOptimize(found);
+        });
+
+        auto& registry = scene->Reg();
+        Benchmarking::Measure("Linear tag scan x100", 10, [&]
+        {
+            uint32_t found = 0;
+            for (int i = 0; i < 100; i++)
+            {
+                const std::string& name = names[next(names.size())];
+                for (auto [entity, tag] : registry.view<TagComponent>().each())
+                {
+                    if (tag.Tag == name)
+                    {
+                        found++;
+                        break;
+                    }
+                }
+            }
+            Benchmarking::DoNotOptimize(found);
+        });
+    }
+}
@@ -0,0 +1,143 @@
+#include "Benchmark.h"
+
+#include <Lynx/Scene/Scene.h>
+#include <Lynx/Scene/Entity.h>
+#include <Lynx/Scene/SceneSerializer.h>
+#include <Lynx/Scene/Components/Components.h>
+#include <Lynx/Scene/Components/PhysicsComponents.h>
+#include <nlohmann/json.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace Lynx;
+
+namespace
+{
+    constexpr uint32_t EntityCount = 100000;
+
+    // Roughly what a level looks like: groups of props under a root, most of them with a mesh, some with physics
+    std::shared_ptr<Scene> CreateLargeScene()
+    {
+        auto scene = std::make_shared<Scene>();
+        Entity group;
+        for (uint32_t i = 0; i < EntityCount; i++)
+        {
+            bool isGroup = i % 100 == 0;
+            Entity entity = scene->CreateEntity(isGroup ? "Group " + std::to_string(i / 100) : "Prop");
+            auto& transform = entity.GetComponent<TransformComponent>();
+            transform.SetTranslation({ (float)(i % 317), 0.0f, (float)(i / 317) });
+            transform.SetRotation(glm::angleAxis(i * 0.01f, glm::vec3(0.0f, 1.0f, 0.0f)));
+            if (isGroup)
+            {
+                group = entity;
+                continue;
+            }
+
+            scene->AttachEntity(entity, group);
+            if (i % 5 != 0)
+                entity.AddComponent<MeshComponent>().Mesh = AssetRef<StaticMesh>(AssetHandle(1000 + i % 50));
+            if (i % 10 == 1)
+            {
+                entity.AddComponent<BoxColliderComponent>().HalfSize = { 0.5f, 0.5f, 0.5f };
+                entity.AddComponent<RigidBodyComponent>();
+            }
+        }
+        return scene;
+    }
+
+    size_t GetFileSize(const std::filesystem::path& path)
+    {
+        return (size_t)std::filesystem::file_size(path) / 1024;
+    }
+
+    // Same layout as the serializer writes, printed straight to the file. Building the scene (or a json DOM) to save it
+    // would push the peak working set past whatever loading it takes, and the peak is what we're after.
+    std::filesystem::path WriteLargeJsonScene()
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "LynxBenchmark100k.json";
+        FILE* file = std::fopen(path.string().c_str(), "w");
+        std::fprintf(file, "{\"Scene\":\"Benchmark\",\"Entities\":[");
+        uint64_t groupID = 0;
+        for (uint32_t i = 0; i < EntityCount; i++)
+        {
+            uint64_t id = 100000 + i;
+            bool isGroup = i % 100 == 0;
+            std::fprintf(file, "%s{\"ID\":%llu,\"Tag\":{\"Tag\":\"%s\"},", i == 0 ? "" : ",", (unsigned long long)id, isGroup ? "Group" : "Prop");
+            std::fprintf(file, "\"Transform\":{\"Translation\":[%.1f,0.0,%.1f],\"Rotation\":[1.0,0.0,0.0,0.0],\"Scale\":[1.0,1.0,1.0]}",
+                (float)(i % 317), (float)(i / 317));
+            if (isGroup)
+            {
+                groupID = id;
+            }
+            else
+            {
+                std::fprintf(file, ",\"Relationship\":{\"Parent\":%llu}", (unsigned long long)groupID);
+                if (i % 5 != 0)
+                    std::fprintf(file, ",\"Mesh\":{\"Mesh\":%u,\"Static\":false,\"Layers\":1}", 1000 + i % 50);
+            }
+            std::fprintf(file, "}");
+        }
+        std::fprintf(file, "]}");
+        std::fclose(file);
+        return path;
+    }
+}
+
+// Same scene saved both ways, loaded into a fresh scene every run
+LX_BENCHMARK(SceneLoad)
+{
+    std::filesystem::path binaryPath = std::filesystem::temp_directory_path() / "LynxBenchmark.lxscene";
+    std::filesystem::path jsonPath = std::filesystem::temp_directory_path() / "LynxBenchmark.json";
+    {
+        auto scene = CreateLargeScene();
+        SceneSerializer(scene).Serialize(binaryPath.string());
+        SceneSerializer(scene).ExportJson(jsonPath.string());
+    }
+    std::printf("  %u entities, binary %zu KB, json %zu KB\n", EntityCount, GetFileSize(binaryPath), GetFileSize(jsonPath));
+
+    Benchmarking::Measure("Binary (columns + json values)", 5, [&]
+    {
+        auto scene = std::make_shared<Scene>();
+        SceneSerializer(scene).Deserialize(binaryPath.string());
+    });
+
+    Benchmarking::Measure("Json (SAX)", 5, [&]
+    {
+        auto scene = std::make_shared<Scene>();
+        SceneSerializer(scene).Deserialize(jsonPath.string());
+    });
+
+    std::filesystem::remove(binaryPath);
+    std::filesystem::remove(jsonPath);
+}
+
+// Peak working set never goes down, run these two on their own ("benchmarks SceneJson") for numbers that can be compared.
+// Sax is what SceneSerializer does, Dom is what it used to do before creating a single entity.
+LX_BENCHMARK(SceneJsonSaxLoad)
+{
+    std::filesystem::path path = WriteLargeJsonScene();
+    std::printf("  %u entities, %zu KB, peak before %zu MB\n", EntityCount, GetFileSize(path), Benchmarking::GetPeakMemory() / (1024 * 1024));
+
+    Benchmarking::Measure("Sax parse + create entities", 3, [&]
+    {
+        auto scene = std::make_shared<Scene>();
+        SceneSerializer(scene).Deserialize(path.string());
+    });
+    std::filesystem::remove(path);
+}
+
+LX_BENCHMARK(SceneJsonDomParse)
+{
+    std::filesystem::path path = WriteLargeJsonScene();
+    std::printf("  %u entities, %zu KB, peak before %zu MB\n", EntityCount, GetFileSize(path), Benchmarking::GetPeakMemory() / (1024 * 1024));
+
+    Benchmarking::Measure("Dom parse only, nothing created", 3, [&]
+    {
+        std::ifstream stream(path);
+        nlohmann::json sceneJson = nlohmann::json::parse(stream);
+        Benchmarking::DoNotOptimize(sceneJson);
+    });
+    std::filesystem::remove(path);
+}
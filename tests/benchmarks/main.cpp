@@ -0,0 +1,25 @@
+#include "Benchmark.h"
+
+#include <Lynx/Engine.h>
+
+#include <cstring>
+
+// benchmarks [filter], runs every benchmark whose name contains the filter
+int main(int argc, char** argv)
+{
+    Lynx::Engine engine;
+    engine.InitializeHeadless();
+
+    const char* filter = argc > 1 ? argv[1] : "";
+    for (const auto& benchmark : Lynx::Benchmarking::GetBenchmarks())
+    {
+        if (!std::strstr(benchmark.Name, filter))
+            continue;
+
+        std::printf("%s\n", benchmark.Name);
+        benchmark.Func();
+    }
+
+    engine.Shutdown();
+    return 0;
+}
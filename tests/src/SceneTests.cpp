@@ -0,0 +1,179 @@
+#include "Testing.h"
+
+#include <Lynx/Scene/Scene.h>
+#include <Lynx/Scene/Entity.h>
+#include <Lynx/Scene/SceneSerializer.h>
+#include <Lynx/Scene/BinaryScene.h>
+#include <Lynx/Scene/Components/Components.h>
+#include <Lynx/Scene/Components/IDComponent.h>
+#include <Lynx/Scene/Components/PhysicsComponents.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+using namespace Lynx;
+
+// A bit of everything: nested hierarchy, siblings, core and regular components
+static std::shared_ptr<Scene> CreateTestScene()
+{
+    auto scene = std::make_shared<Scene>();
+
+    Entity sun = scene->CreateEntity("Sun");
+    auto& light = sun.AddComponent<DirectionalLightComponent>();
+    light.Color = { 1.0f, 0.9f, 0.7f };
+    light.Intensity = 3.0f;
+
+    Entity camera = scene->CreateEntity("Camera");
+    camera.GetComponent<TransformComponent>().SetTranslation({ 0.0f, 2.0f, -10.0f });
+    camera.AddComponent<CameraComponent>().Primary = true;
+
+    Entity building = scene->CreateEntity("Building");
+    building.GetComponent<TransformComponent>().SetTranslation({ 20.0f, 0.0f, 5.0f });
+    for (int floor = 0; floor < 3; floor++)
+    {
+        Entity floorEntity = scene->CreateEntity("Floor " + std::to_string(floor));
+        scene->AttachEntity(floorEntity, building);
+        floorEntity.GetComponent<TransformComponent>().SetTranslation({ 0.0f, 3.0f * floor, 0.0f });
+
+        for (int crate = 0; crate < 2; crate++)
+        {
+            Entity crateEntity = scene->CreateEntity("Crate");
+            scene->AttachEntity(crateEntity, floorEntity);
+            crateEntity.GetComponent<TransformComponent>().SetScale({ 0.5f, 0.5f, 0.5f });
+            crateEntity.AddComponent<BoxColliderComponent>().HalfSize = { 0.25f, 0.25f, 0.25f };
+            auto& body = crateEntity.AddComponent<RigidBodyComponent>();
+            body.Type = BodyType::Dynamic;
+            body.Mass = 2.0f + crate;
+
+            // Handles don't have to be registered, they only have to come back the same. One without a mesh.
+            auto& mesh = crateEntity.AddComponent<MeshComponent>();
+            if (crate == 0)
+                mesh.Mesh = AssetRef<StaticMesh>(AssetHandle(0x1234 + floor));
+            mesh.IsStatic = floor == 2;
+            mesh.Layers = 1u << floor;
+        }
+    }
+
+    return scene;
+}
+
+// Roots come out in storage order, which doesn't have to survive a copy or a load. The entity json itself has to match.
+static nlohmann::json SortedEntities(const std::string& serialized)
+{
+    nlohmann::json sceneJson = nlohmann::json::parse(serialized);
+    auto& entities = sceneJson["Entities"];
+    std::sort(entities.begin(), entities.end(), [](const nlohmann::json& a, const nlohmann::json& b)
+    {
+        return a["ID"].get<uint64_t>() < b["ID"].get<uint64_t>();
+    });
+    return sceneJson;
+}
+
+LX_TEST(SceneCopyMatchesSerialization)
+{
+    auto scene = CreateTestScene();
+    auto copy = Scene::Copy(*scene);
+
+    std::string original = SceneSerializer(scene).SerializeToString();
+    std::string copied = SceneSerializer(copy).SerializeToString();
+    LX_CHECK(SortedEntities(original) == SortedEntities(copied));
+
+    // Same entity ids, so the hierarchy has to line up handle for handle
+    for (auto [entity, rel] : scene->Reg().view<RelationshipComponent>().each())
+    {
+        LX_CHECK(copy->Reg().valid(entity));
+        const auto& copiedRel = copy->Reg().get<RelationshipComponent>(entity);
+        LX_CHECK(copiedRel.Parent == rel.Parent);
+        LX_CHECK(copiedRel.FirstChild == rel.FirstChild);
+        LX_CHECK(copiedRel.NextSibling == rel.NextSibling);
+    }
+}
+
+LX_TEST(SceneCopyIsIndependent)
+{
+    auto scene = CreateTestScene();
+    auto copy = Scene::Copy(*scene);
+
+    Entity building = copy->FindEntityByName("Building");
+    LX_CHECK(building);
+    building.GetComponent<TransformComponent>().SetTranslation({ -1.0f, -1.0f, -1.0f });
+    copy->DestroyEntity(copy->FindEntityByName("Camera"));
+
+    LX_CHECK(scene->FindEntityByName("Camera"));
+    LX_CHECK(scene->FindEntityByName("Building").GetComponent<TransformComponent>().Translation == glm::vec3(20.0f, 0.0f, 5.0f));
+}
+
+static std::vector<uint8_t> ReadFile(const std::filesystem::path& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+static void WriteFile(const std::filesystem::path& path, const std::vector<uint8_t>& data)
+{
+    std::ofstream stream(path, std::ios::binary);
+    stream.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)data.size());
+}
+
+LX_TEST(BinarySceneRoundTrip)
+{
+    auto scene = CreateTestScene();
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "LynxRoundTrip.lxscene";
+    SceneSerializer(scene).Serialize(path.string());
+    std::vector<uint8_t> written = ReadFile(path);
+    LX_CHECK(written.size() > sizeof(BinaryScene::FileHeader) && std::memcmp(written.data(), BinaryScene::Magic, sizeof(BinaryScene::Magic)) == 0);
+
+    auto loaded = std::make_shared<Scene>();
+    LX_CHECK(SceneSerializer(loaded).Deserialize(path.string()));
+    LX_CHECK(SortedEntities(SceneSerializer(scene).SerializeToString()) == SortedEntities(SceneSerializer(loaded).SerializeToString()));
+
+    // Columns go through the name index like everything else
+    LX_CHECK(loaded->FindEntitiesByName("Crate").size() == 6);
+
+    // Plain data skips the json, and the hierarchy comes back as saved even for rigid bodies
+    BinaryScene::Reader reader(written.data(), written.size());
+    for (const auto& chunk : reader.GetChunks())
+    {
+        if (reader.GetString(chunk.Name) == "RigidBody" || reader.GetString(chunk.Name) == "BoxCollider")
+            LX_CHECK(chunk.Layout == BinaryScene::ChunkLayout::Column);
+    }
+    for (Entity crate : loaded->FindEntitiesByName("Crate"))
+        LX_CHECK(crate.GetComponent<RelationshipComponent>().Parent != entt::null);
+    std::filesystem::remove(path);
+}
+
+LX_TEST(BinarySceneRejectsBadParents)
+{
+    auto scene = CreateTestScene();
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "LynxBadParents.lxscene";
+    SceneSerializer(scene).Serialize(path.string());
+
+    // One entity parented to itself, and the first one (a root) to the last one, which hangs below it
+    std::vector<uint8_t> data = ReadFile(path);
+    BinaryScene::FileHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    uint32_t* parents = reinterpret_cast<uint32_t*>(data.data() + header.EntitiesOffset + header.EntityCount * sizeof(uint64_t));
+    uint32_t last = header.EntityCount - 1;
+    LX_CHECK(parents[last] != BinaryScene::NoParent);
+    parents[last] = last;
+    parents[0] = last;
+    WriteFile(path, data);
+
+    auto loaded = std::make_shared<Scene>();
+    LX_CHECK(SceneSerializer(loaded).Deserialize(path.string()));
+    LX_CHECK(loaded->Reg().view<IDComponent>().size() == header.EntityCount);
+
+    // Every chain of parents has to end at a root
+    auto& registry = loaded->Reg();
+    for (auto [entity, rel] : registry.view<RelationshipComponent>().each())
+    {
+        LX_CHECK(rel.Parent != entity);
+        uint32_t steps = 0;
+        for (entt::entity parent = rel.Parent; parent != entt::null && steps <= header.EntityCount; steps++)
+            parent = registry.get<RelationshipComponent>(parent).Parent;
+        LX_CHECK(steps <= header.EntityCount);
+    }
+    std::filesystem::remove(path);
+}
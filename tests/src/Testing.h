@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+// Just enough of a test framework for the engine tests. LX_TEST registers a function, LX_CHECK reports and keeps going.
+namespace Lynx::Testing
+{
+    struct TestCase
+    {
+        const char* Name;
+        void (*Func)();
+    };
+
+    inline std::vector<TestCase>& GetTests()
+    {
+        static std::vector<TestCase> s_Tests;
+        return s_Tests;
+    }
+
+    inline int& GetFailureCount()
+    {
+        static int s_Failures = 0;
+        return s_Failures;
+    }
+
+    inline void ReportFailure(const char* expression, const char* file, int line)
+    {
+        std::printf("  FAILED: %s (%s:%d)\n", expression, file, line);
+        GetFailureCount()++;
+    }
+
+    struct TestRegistrar
+    {
+        TestRegistrar(const char* name, void (*func)()) { GetTests().push_back({ name, func }); }
+    };
+}
+
+#define LX_TEST(name) \
+    static void name(); \
+    static ::Lynx::Testing::TestRegistrar name##_Registrar(#name, &name); \
+    static void name()
+
+#define LX_CHECK(expression) \
+    do { if (!(expression)) ::Lynx::Testing::ReportFailure(#expression, __FILE__, __LINE__); } while (false)
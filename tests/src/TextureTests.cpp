@@ -0,0 +1,109 @@
+#include "Testing.h"
+
+#include <Lynx/Asset/BC7Encoder.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace Lynx;
+
+// Mode 6 decoder, enough to check what BC7Encoder writes
+static bool DecodeBC7Mode6(const uint8_t* block, uint8_t* outRGBA)
+{
+    static constexpr int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    int position = 0;
+    auto read = [&](int bits)
+    {
+        int value = 0;
+        for (int i = 0; i < bits; i++, position++)
+            value |= ((block[position >> 3] >> (position & 7)) & 1) << i;
+        return value;
+    };
+
+    if (read(7) != (1 << 6))
+        return false;
+
+    int endpoints[2][4];
+    for (int c = 0; c < 4; c++)
+    {
+        endpoints[0][c] = read(7);
+        endpoints[1][c] = read(7);
+    }
+    int pBits[2] = { read(1), read(1) };
+
+    int indices[16];
+    indices[0] = read(3);
+    for (int i = 1; i < 16; i++)
+        indices[i] = read(4);
+
+    for (int i = 0; i < 16; i++)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            int a = (endpoints[0][c] << 1) | pBits[0];
+            int b = (endpoints[1][c] << 1) | pBits[1];
+            outRGBA[i * 4 + c] = (uint8_t)(((64 - weights[indices[i]]) * a + weights[indices[i]] * b + 32) >> 6);
+        }
+    }
+    return true;
+}
+
+static double GetMeanSquaredError(const uint8_t* a, const uint8_t* b)
+{
+    double error = 0.0;
+    for (int i = 0; i < 64; i++)
+        error += (a[i] - b[i]) * (a[i] - b[i]);
+    return error / 64.0;
+}
+
+LX_TEST(BC7EncodesGradients)
+{
+    srand(7);
+    double worstError = 0.0;
+    for (int test = 0; test < 1000; test++)
+    {
+        uint8_t from[4], to[4];
+        for (int c = 0; c < 4; c++)
+        {
+            from[c] = (uint8_t)(rand() % 256);
+            to[c] = (uint8_t)(rand() % 256);
+        }
+
+        uint8_t pixels[64];
+        for (int i = 0; i < 16; i++)
+        {
+            float t = (rand() % 1000) / 999.0f;
+            for (int c = 0; c < 4; c++)
+                pixels[i * 4 + c] = (uint8_t)(from[c] + (to[c] - from[c]) * t);
+        }
+
+        uint8_t block[16], decoded[64];
+        BC7Encoder::CompressBlock(block, pixels);
+        LX_CHECK(DecodeBC7Mode6(block, decoded));
+        worstError = std::max(worstError, GetMeanSquaredError(pixels, decoded));
+    }
+
+    // A line through RGBA space is exactly what one subset can do, only quantization is left
+    LX_CHECK(worstError < 16.0);
+}
+
+LX_TEST(BC7KeepsOpaqueAlpha)
+{
+    srand(11);
+    for (int test = 0; test < 100; test++)
+    {
+        uint8_t pixels[64];
+        for (int i = 0; i < 64; i++)
+            pixels[i] = (i % 4 == 3) ? 255 : (uint8_t)(rand() % 256);
+
+        uint8_t block[16], decoded[64];
+        BC7Encoder::CompressBlock(block, pixels);
+        LX_CHECK(DecodeBC7Mode6(block, decoded));
+
+        bool opaque = true;
+        for (int i = 0; i < 16; i++)
+            opaque &= decoded[i * 4 + 3] == 255;
+        LX_CHECK(opaque);
+    }
+}
@@ -0,0 +1,23 @@
+#include "Testing.h"
+
+#include <Lynx/Engine.h>
+
+int main()
+{
+    Lynx::Engine engine;
+    engine.InitializeHeadless();
+
+    int failedTests = 0;
+    for (const auto& test : Lynx::Testing::GetTests())
+    {
+        int failuresBefore = Lynx::Testing::GetFailureCount();
+        std::printf("%s\n", test.Name);
+        test.Func();
+        if (Lynx::Testing::GetFailureCount() != failuresBefore)
+            failedTests++;
+    }
+
+    std::printf("%zu tests, %d failed\n", Lynx::Testing::GetTests().size(), failedTests);
+    engine.Shutdown();
+    return failedTests == 0 ? 0 : 1;
+}